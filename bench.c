@@ -0,0 +1,962 @@
+#define _POSIX_C_SOURCE 200809L
+#include "geometry.h"
+#include "geometry_buffer.h"
+#include "geometry_binary.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+// Benchmark of every function declared in geometry.h and of batch kernels over
+// structure-of-arrays buffers (geometry_buffer.h, geometry_binary.h), whose speed
+// depends the most on precision of geometry_real (make bench_compare).
+// Every case runs one function over arrays of objects of a few sizes, so both
+// cost of call and effects of cache are visible. Results go out as CSV, one line
+// for every case and size:
+//      function,size,ops,ns_per_op,ops_per_second,allocations_per_op,bytes_per_op
+// For constructors bytes_per_op is memory taken by one object.
+// Allocations are counted by wrapping malloc family at link time (make bench).
+// Usage: bench.o [output.csv [function name filter]]
+
+#define GEOMETRY_BENCH_MIN_TIME 10000000
+#define GEOMETRY_BENCH_MAX_PASSES 100000
+#define GEOMETRY_BENCH_MATRIX_COLUMNS 16
+#define GEOMETRY_BENCH_ARENA_OBJECT 32
+
+typedef struct geometry_bench_data {
+    size_t size;
+    unsigned long pass;
+    geometry_point** points;
+    geometry_segment** segments;
+    geometry_triangle** triangles;
+    geometry_triangle** right_triangles;
+    // objects created (or to be destroyed) by current pass
+    geometry_point** created_points;
+    geometry_segment** created_segments;
+    geometry_triangle** created_triangles;
+    geometry_rotation** created_rotations;
+    geometry_transform** created_transforms;
+    geometry_arena** created_arenas;
+    void** created_blocks;
+    // allocator passed to _with functions, copy of the one currently set
+    geometry_allocator allocator;
+    geometry_point* reference;
+    geometry_rotation* rotation;
+    geometry_transform* transform;
+    geometry_arena* arena;
+    bool* disjoint;
+    // the same points and triangles in structure-of-arrays buffers, results of their kernels
+    geometry_point_buffer* point_buffer;
+    geometry_point_buffer* column_buffer;
+    geometry_triangle_buffer* triangle_buffer;
+    geometry_real* results;
+    // results are added here, so compiler can't drop calls
+    volatile double sink;
+} geometry_bench_data;
+
+typedef struct geometry_bench_case {
+    const char* name;
+    // prepare and cleanup are not timed, any of them may be NULL
+    void (*prepare)(geometry_bench_data* data);
+    void (*run)(geometry_bench_data* data);
+    void (*cleanup)(geometry_bench_data* data);
+    // number of operations in one pass for given size
+    size_t (*count)(size_t size);
+} geometry_bench_case;
+
+static size_t geometry_bench_allocations = 0;
+static size_t geometry_bench_bytes = 0;
+static bool geometry_bench_counting = false;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+void __real_free(void* pointer);
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static unsigned long long geometry_bench_now(void);
+static double geometry_bench_random(void);
+static bool geometry_bench_createData(geometry_bench_data* data, size_t size);
+static void geometry_bench_destroyData(geometry_bench_data* data);
+static void geometry_bench_runCase(const geometry_bench_case* bench_case, geometry_bench_data* data, FILE* output);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Functions replacing malloc family when linked with -Wl,--wrap=malloc,...
+*   Calls are counted while geometry_bench_counting is set and passed to real functions
+*/
+void* __wrap_malloc(size_t size){
+    if(geometry_bench_counting){
+        geometry_bench_allocations++;
+        geometry_bench_bytes += size;
+    }
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size){
+    if(geometry_bench_counting){
+        geometry_bench_allocations++;
+        geometry_bench_bytes += count * size;
+    }
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size){
+    if(geometry_bench_counting){
+        geometry_bench_allocations++;
+        geometry_bench_bytes += size;
+    }
+    return __real_realloc(pointer, size);
+}
+
+void __wrap_free(void* pointer){
+    __real_free(pointer);
+}
+
+/**
+*   Function to read monotonic clock
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       unsigned long long      time in nanoseconds
+*/
+static unsigned long long geometry_bench_now(void){
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (unsigned long long)time.tv_sec * 1000000000ull + (unsigned long long)time.tv_nsec;
+}
+
+/**
+*   Function to draw coordinate from range [-100, 100)
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       double          random coordinate
+*/
+static double geometry_bench_random(void){
+    return rand() / (RAND_MAX + 1.0) * 200.0 - 100.0;
+}
+
+/**
+*   Functions returning number of operations in one pass of case for given size
+*/
+static size_t geometry_bench_countEach(size_t size){
+    return size;
+}
+
+static size_t geometry_bench_countOnce(size_t size){
+    (void)size;
+    return 1;
+}
+
+static size_t geometry_bench_countMatrix(size_t size){
+    return size * GEOMETRY_BENCH_MATRIX_COLUMNS;
+}
+
+/**
+*   Function to create objects used by benchmark cases
+*   In params:
+*       size_t size                     number of objects of every kind
+*
+*   Out params:
+*       geometry_bench_data* data       created objects
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+static bool geometry_bench_createData(geometry_bench_data* data, size_t size){
+    memset(data, 0, sizeof(*data));
+    data->size = size;
+    data->points = calloc(size, sizeof(*data->points));
+    data->segments = calloc(size, sizeof(*data->segments));
+    data->triangles = calloc(size, sizeof(*data->triangles));
+    data->right_triangles = calloc(size, sizeof(*data->right_triangles));
+    data->created_points = calloc(size, sizeof(*data->created_points));
+    data->created_segments = calloc(size, sizeof(*data->created_segments));
+    data->created_triangles = calloc(size, sizeof(*data->created_triangles));
+    data->created_rotations = calloc(size, sizeof(*data->created_rotations));
+    data->created_transforms = calloc(size, sizeof(*data->created_transforms));
+    data->created_arenas = calloc(size, sizeof(*data->created_arenas));
+    data->created_blocks = calloc(size, sizeof(*data->created_blocks));
+    data->allocator = geometry_get_allocator();
+    data->disjoint = calloc(size * GEOMETRY_BENCH_MATRIX_COLUMNS, sizeof(*data->disjoint));
+    data->point_buffer = geometry_point_buffer_new(size);
+    data->column_buffer = geometry_point_buffer_new(GEOMETRY_BENCH_MATRIX_COLUMNS);
+    data->results = calloc(size * GEOMETRY_BENCH_MATRIX_COLUMNS, sizeof(*data->results));
+    data->reference = geometry_point_new(1.0, -2.0);
+    data->rotation = geometry_rotation_new(0.001, data->reference);
+    data->transform = geometry_transform_new();
+    data->arena = geometry_arena_new(0);
+    if(data->points == NULL || data->segments == NULL || data->triangles == NULL || data->right_triangles == NULL
+        || data->created_points == NULL || data->created_segments == NULL || data->created_triangles == NULL
+        || data->created_rotations == NULL || data->created_transforms == NULL || data->created_arenas == NULL || data->created_blocks == NULL
+        || data->disjoint == NULL || data->point_buffer == NULL || data->column_buffer == NULL || data->results == NULL || data->reference == NULL || data->rotation == NULL || data->transform == NULL || data->arena == NULL){
+        return false;
+    }
+    geometry_transform_rotateByAngle(data->transform, 0.001, data->reference);
+    geometry_transform_moveByVector(data->transform, 0.01, -0.01);
+    for(size_t i = 0; i < size; i++){
+        double x = geometry_bench_random();
+        double y = geometry_bench_random();
+        geometry_point* first = geometry_point_new(x, y);
+        geometry_point* second = geometry_point_new(x + geometry_bench_random() / 10, y + geometry_bench_random() / 10);
+        geometry_point* third = geometry_point_new(x + geometry_bench_random() / 10, y + geometry_bench_random() / 10);
+        geometry_point* right = geometry_point_new(geometry_point_getX(second), y);
+        data->points[i] = geometry_point_new(x, y);
+        data->segments[i] = geometry_segment_new(first, second);
+        data->triangles[i] = geometry_triangle_new(first, second, third, false);
+        data->right_triangles[i] = geometry_triangle_new(first, right, second, true);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+        geometry_point_destroy(right);
+        if(data->points[i] == NULL || data->segments[i] == NULL || data->triangles[i] == NULL || data->right_triangles[i] == NULL
+            || !geometry_point_buffer_push(data->point_buffer, x, y)){
+            return false;
+        }
+        if(i < GEOMETRY_BENCH_MATRIX_COLUMNS && !geometry_point_buffer_push(data->column_buffer, x, y)){
+            return false;
+        }
+    }
+    data->triangle_buffer = geometry_triangle_buffer_new(data->triangles, size);
+    return data->triangle_buffer != NULL;
+}
+
+/**
+*   Function to destroy objects used by benchmark cases
+*   In params:
+*       geometry_bench_data* data       objects to destroy
+*
+*   Out params/return:
+*       none
+*/
+static void geometry_bench_destroyData(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        if(data->points != NULL){
+            geometry_point_destroy(data->points[i]);
+        }
+        if(data->segments != NULL){
+            geometry_segment_destroy(data->segments[i]);
+        }
+        if(data->triangles != NULL){
+            geometry_triangle_destroy(data->triangles[i]);
+        }
+        if(data->right_triangles != NULL){
+            geometry_triangle_destroy(data->right_triangles[i]);
+        }
+    }
+    free(data->points);
+    free(data->segments);
+    free(data->triangles);
+    free(data->right_triangles);
+    free(data->created_points);
+    free(data->created_segments);
+    free(data->created_triangles);
+    free(data->created_rotations);
+    free(data->created_transforms);
+    free(data->created_arenas);
+    free(data->created_blocks);
+    free(data->disjoint);
+    geometry_point_buffer_destroy(data->point_buffer);
+    geometry_point_buffer_destroy(data->column_buffer);
+    geometry_triangle_buffer_destroy(data->triangle_buffer);
+    free(data->results);
+    geometry_point_destroy(data->reference);
+    geometry_rotation_destroy(data->rotation);
+    geometry_transform_destroy(data->transform);
+    geometry_arena_destroy(data->arena);
+}
+
+/**
+*   Functions creating and destroying objects of current pass, used as prepare and cleanup steps
+*/
+static void geometry_bench_createPoints(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_points[i] = geometry_point_new(i, -(double)i);
+    }
+}
+
+static void geometry_bench_destroyPoints(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_point_destroy(data->created_points[i]);
+    }
+}
+
+static void geometry_bench_createSegments(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_segments[i] = geometry_segment_new(data->points[i], data->reference);
+    }
+}
+
+static void geometry_bench_destroySegments(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_segment_destroy(data->created_segments[i]);
+    }
+}
+
+static void geometry_bench_createTriangles(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_triangles[i] = geometry_triangle_new(data->points[i], data->reference, data->points[(i + 1) % data->size], false);
+    }
+}
+
+static void geometry_bench_destroyTriangles(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_destroy(data->created_triangles[i]);
+    }
+}
+
+static void geometry_bench_createRotations(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_rotations[i] = geometry_rotation_new(0.5, data->reference);
+    }
+}
+
+static void geometry_bench_destroyRotations(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_rotation_destroy(data->created_rotations[i]);
+    }
+}
+
+static void geometry_bench_createTransforms(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_transforms[i] = geometry_transform_new();
+    }
+}
+
+static void geometry_bench_destroyTransforms(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_transform_destroy(data->created_transforms[i]);
+    }
+}
+
+static void geometry_bench_createArenas(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_arenas[i] = geometry_arena_new(0);
+    }
+}
+
+static void geometry_bench_destroyArenas(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_arena_destroy(data->created_arenas[i]);
+    }
+}
+
+static void geometry_bench_createPointsWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_points[i] = geometry_point_new_with(&data->allocator, i, -(double)i);
+    }
+}
+
+static void geometry_bench_destroyPointsWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_point_destroy_with(&data->allocator, data->created_points[i]);
+    }
+}
+
+static void geometry_bench_createSegmentsWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_segments[i] = geometry_segment_new_with(&data->allocator, data->points[i], data->reference);
+    }
+}
+
+static void geometry_bench_destroySegmentsWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_segment_destroy_with(&data->allocator, data->created_segments[i]);
+    }
+}
+
+static void geometry_bench_createTrianglesWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_triangles[i] = geometry_triangle_new_with(&data->allocator, data->points[i], data->reference, data->points[(i + 1) % data->size], false);
+    }
+}
+
+static void geometry_bench_destroyTrianglesWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_destroy_with(&data->allocator, data->created_triangles[i]);
+    }
+}
+
+static void geometry_bench_createRotationsWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_rotations[i] = geometry_rotation_new_with(&data->allocator, 0.5, data->reference);
+    }
+}
+
+static void geometry_bench_destroyRotationsWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_rotation_destroy_with(&data->allocator, data->created_rotations[i]);
+    }
+}
+
+static void geometry_bench_createTransformsWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_transforms[i] = geometry_transform_new_with(&data->allocator);
+    }
+}
+
+static void geometry_bench_destroyTransformsWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_transform_destroy_with(&data->allocator, data->created_transforms[i]);
+    }
+}
+
+static void geometry_bench_createArenasWith(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_arenas[i] = geometry_arena_new_with(&data->allocator, 0);
+    }
+}
+
+static void geometry_bench_createBlocks(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_blocks[i] = geometry_allocator_allocate(&data->allocator, GEOMETRY_BENCH_ARENA_OBJECT);
+    }
+}
+
+static void geometry_bench_createZeroedBlocks(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_blocks[i] = geometry_allocator_allocateZeroed(&data->allocator, 1, GEOMETRY_BENCH_ARENA_OBJECT);
+    }
+}
+
+static void geometry_bench_destroyBlocks(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_allocator_free(&data->allocator, data->created_blocks[i]);
+    }
+}
+
+static void geometry_bench_fillArena(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_arena_allocate(data->arena, GEOMETRY_BENCH_ARENA_OBJECT);
+    }
+}
+
+static void geometry_bench_resetArena(geometry_bench_data* data){
+    geometry_arena_reset(data->arena);
+}
+
+static void geometry_bench_invalidateTriangles(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_invalidateCache(data->triangles[i]);
+    }
+}
+
+/**
+*   Functions running one pass of benchmark cases, named after benchmarked functions
+*/
+static void geometry_bench_arenaAllocate(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_arena_allocate(data->arena, GEOMETRY_BENCH_ARENA_OBJECT) != NULL;
+    }
+}
+
+static void geometry_bench_allocatorReallocate(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        void* block = geometry_allocator_reallocate(&data->allocator, data->created_blocks[i], GEOMETRY_BENCH_ARENA_OBJECT, 2 * GEOMETRY_BENCH_ARENA_OBJECT);
+        if(block != NULL){
+            data->created_blocks[i] = block;
+        }
+    }
+}
+
+static void geometry_bench_setAllocator(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_set_allocator(data->allocator.allocate, data->allocator.free, data->allocator.user_data);
+    }
+}
+
+static void geometry_bench_getAllocator(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_get_allocator().user_data == data->allocator.user_data;
+    }
+}
+
+static void geometry_bench_transformMoveByVector(geometry_bench_data* data){
+    double direction = data->pass % 2 ? -1e-3 : 1e-3;
+    for(size_t i = 0; i < data->size; i++){
+        geometry_transform_moveByVector(data->transform, direction, -direction);
+    }
+}
+
+static void geometry_bench_transformRotateByAngle(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_transform_rotateByAngle(data->transform, 1e-3, data->points[i]);
+    }
+}
+
+static void geometry_bench_transformCompose(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_transforms[i] = geometry_transform_compose(data->transform, data->transform);
+    }
+}
+
+static void geometry_bench_transformInvert(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_transforms[i] = geometry_transform_invert(data->transform);
+    }
+}
+
+static void geometry_bench_transformGetCoefficients(geometry_bench_data* data){
+    geometry_real coefficients[6];
+    for(size_t i = 0; i < data->size; i++){
+        geometry_transform_getCoefficients(data->transform, coefficients);
+        data->sink += coefficients[2];
+    }
+}
+
+static void geometry_bench_pointNewIn(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_points[i] = geometry_point_new_in(data->arena, i, -(double)i);
+    }
+}
+
+static void geometry_bench_pointGetX(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_point_getX(data->points[i]);
+    }
+}
+
+static void geometry_bench_pointGetY(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_point_getY(data->points[i]);
+    }
+}
+
+static void geometry_bench_pointMoveByVector(geometry_bench_data* data){
+    double direction = data->pass % 2 ? -1e-3 : 1e-3;
+    for(size_t i = 0; i < data->size; i++){
+        geometry_point_moveByVector(data->points[i], direction, -direction);
+    }
+}
+
+static void geometry_bench_pointRotateByAngle(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_point_rotateByAngle(data->points[i], 1e-3, data->reference);
+    }
+}
+
+static void geometry_bench_pointRotateBy(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_point_rotateBy(data->points[i], data->rotation);
+    }
+}
+
+static void geometry_bench_pointApplyTransform(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_point_applyTransform(data->points[i], data->transform);
+    }
+}
+
+static void geometry_bench_pointCalculateDistance(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_point_calculateDistance(data->points[i], data->points[(i + 1) % data->size]);
+    }
+}
+
+static void geometry_bench_pointLiesOnSegment(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_point_liesOnSegment(data->points[i], data->segments[i]);
+    }
+}
+
+static void geometry_bench_segmentNewIn(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_segments[i] = geometry_segment_new_in(data->arena, data->points[i], data->reference);
+    }
+}
+
+static void geometry_bench_segmentGetPoints(geometry_bench_data* data){
+    geometry_point* start = NULL;
+    geometry_point* end = NULL;
+    for(size_t i = 0; i < data->size; i++){
+        geometry_segment_getPoints(data->segments[i], &start, &end);
+        data->sink += start != end;
+    }
+}
+
+static void geometry_bench_segmentMoveByVector(geometry_bench_data* data){
+    double direction = data->pass % 2 ? -1e-3 : 1e-3;
+    for(size_t i = 0; i < data->size; i++){
+        geometry_segment_moveByVector(data->segments[i], direction, -direction);
+    }
+}
+
+static void geometry_bench_segmentRotateByAngle(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_segment_rotateByAngle(data->segments[i], 1e-3, data->reference);
+    }
+}
+
+static void geometry_bench_segmentRotateBy(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_segment_rotateBy(data->segments[i], data->rotation);
+    }
+}
+
+static void geometry_bench_segmentApplyTransform(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_segment_applyTransform(data->segments[i], data->transform);
+    }
+}
+
+static void geometry_bench_segmentCalculateLength(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_segment_calculateLength(data->segments[i]);
+    }
+}
+
+static void geometry_bench_segmentAreParallel(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_segment_areParallel(data->segments[i], data->segments[(i + 1) % data->size]);
+    }
+}
+
+static void geometry_bench_segmentArePerpendicular(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_segment_arePerpendicular(data->segments[i], data->segments[(i + 1) % data->size]);
+    }
+}
+
+static void geometry_bench_segmentCalculateIntersection(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_points[i] = geometry_segment_calculateIntersection(data->segments[i], data->segments[(i + 1) % data->size]);
+    }
+}
+
+static void geometry_bench_triangleNewIn(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->created_triangles[i] = geometry_triangle_new_in(data->arena, data->points[i], data->reference, data->points[(i + 1) % data->size], false);
+    }
+}
+
+static void geometry_bench_triangleNewFromCoordinates(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_real xs[3] = {geometry_point_getX(data->points[i]), geometry_point_getX(data->reference), geometry_point_getX(data->points[(i + 1) % data->size])};
+        geometry_real ys[3] = {geometry_point_getY(data->points[i]), geometry_point_getY(data->reference), geometry_point_getY(data->points[(i + 1) % data->size])};
+        data->created_triangles[i] = geometry_triangle_newFromCoordinates(NULL, &data->allocator, xs, ys, false);
+    }
+}
+
+static void geometry_bench_triangleGetPoints(geometry_bench_data* data){
+    geometry_point* first = NULL;
+    geometry_point* second = NULL;
+    geometry_point* third = NULL;
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_getPoints(data->triangles[i], &first, &second, &third);
+        data->sink += first != third;
+    }
+}
+
+static void geometry_bench_triangleGetCoordinates(geometry_bench_data* data){
+    geometry_real xs[3];
+    geometry_real ys[3];
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_getCoordinates(data->triangles[i], xs, ys);
+        data->sink += xs[0] + ys[2];
+    }
+}
+
+static void geometry_bench_triangleGetIsRight(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_triangle_getIsRight(data->triangles[i]);
+    }
+}
+
+static void geometry_bench_triangleGetBoundingBox(geometry_bench_data* data){
+    geometry_real min_x, min_y, max_x, max_y;
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_getBoundingBox(data->triangles[i], &min_x, &min_y, &max_x, &max_y);
+        data->sink += max_x - min_x;
+    }
+}
+
+static void geometry_bench_triangleGetCentroid(geometry_bench_data* data){
+    geometry_real x, y;
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_getCentroid(data->triangles[i], &x, &y);
+        data->sink += x;
+    }
+}
+
+static void geometry_bench_triangleGetRightAngleVertex(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_triangle_getRightAngleVertex(data->right_triangles[i]) != NULL;
+    }
+}
+
+static void geometry_bench_triangleInvalidateCache(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_invalidateCache(data->triangles[i]);
+    }
+}
+
+static void geometry_bench_triangleFillCache(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_fillCache(data->triangles[i]);
+    }
+}
+
+static void geometry_bench_triangleMoveByVector(geometry_bench_data* data){
+    double direction = data->pass % 2 ? -1e-3 : 1e-3;
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_moveByVector(data->triangles[i], direction, -direction);
+    }
+}
+
+static void geometry_bench_triangleRotateByAngle(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_rotateByAngle(data->triangles[i], 1e-3, data->reference);
+    }
+}
+
+static void geometry_bench_triangleRotateBy(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_rotateBy(data->triangles[i], data->rotation);
+    }
+}
+
+static void geometry_bench_triangleApplyTransform(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        geometry_triangle_applyTransform(data->triangles[i], data->transform);
+    }
+}
+
+static void geometry_bench_triangleCalculatePerimeter(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_triangle_calculatePerimeter(data->triangles[i]);
+    }
+}
+
+static void geometry_bench_triangleCalculateArea(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_triangle_calculateArea(data->triangles[i]);
+    }
+}
+
+static void geometry_bench_triangleAreDisjoint(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_triangle_areDisjoint(data->triangles[i], data->triangles[(i + 1) % data->size]);
+    }
+}
+
+static void geometry_bench_triangleAreDisjointBatch(geometry_bench_data* data){
+    data->sink += geometry_triangle_areDisjointBatch(data->triangles[0], data->triangles, data->size, data->disjoint);
+}
+
+static void geometry_bench_triangleAreDisjointMatrix(geometry_bench_data* data){
+    size_t columns = data->size < GEOMETRY_BENCH_MATRIX_COLUMNS ? data->size : GEOMETRY_BENCH_MATRIX_COLUMNS;
+    data->sink += geometry_triangle_areDisjointMatrix(data->triangles, data->size, data->triangles, columns, data->disjoint);
+}
+
+static void geometry_bench_pointBufferMoveByVector(geometry_bench_data* data){
+    double direction = data->pass % 2 ? -1e-3 : 1e-3;
+    geometry_point_buffer_moveByVector(data->point_buffer, direction, -direction);
+}
+
+static void geometry_bench_pointBufferRotateByAngle(geometry_bench_data* data){
+    geometry_point_buffer_rotateByAngle(data->point_buffer, 0.001, data->reference);
+}
+
+static void geometry_bench_pointBufferApplyTransform(geometry_bench_data* data){
+    geometry_point_buffer_applyTransform(data->point_buffer, data->transform);
+}
+
+static void geometry_bench_pointBufferCalculateDistances(geometry_bench_data* data){
+    geometry_point_buffer_calculateDistances(data->point_buffer, data->reference, data->results);
+    data->sink += data->results[0];
+}
+
+static void geometry_bench_pointBufferCalculateSquaredDistanceMatrix(geometry_bench_data* data){
+    data->sink += geometry_point_buffer_calculateSquaredDistanceMatrix(data->point_buffer, data->column_buffer, data->results);
+}
+
+static void geometry_bench_triangleBufferCalculateAreas(geometry_bench_data* data){
+    data->sink += geometry_triangle_buffer_calculateAreas(data->triangle_buffer, data->results);
+}
+
+static void geometry_bench_triangleBufferCalculatePerimeters(geometry_bench_data* data){
+    data->sink += geometry_triangle_buffer_calculatePerimeters(data->triangle_buffer, data->results);
+}
+
+static void geometry_bench_triangleCalculateHypotenuse(geometry_bench_data* data){
+    for(size_t i = 0; i < data->size; i++){
+        data->sink += geometry_triangle_calculateHypotenuse(data->right_triangles[i]);
+    }
+}
+
+/**
+*   Function to run benchmark case for size of given data and write its CSV line
+*   Passes are repeated until they take at least GEOMETRY_BENCH_MIN_TIME nanoseconds
+*   In params:
+*       geometry_bench_case* bench_case     case to run
+*       geometry_bench_data* data           objects used by case
+*       FILE* output                        output stream
+*
+*   Out params/return:
+*       none
+*/
+static void geometry_bench_runCase(const geometry_bench_case* bench_case, geometry_bench_data* data, FILE* output){
+    unsigned long long total_time = 0;
+    size_t total_ops = 0;
+    size_t allocations = 0;
+    size_t bytes = 0;
+    // first pass warms caches and is not counted
+    for(unsigned long pass = 0; pass <= GEOMETRY_BENCH_MAX_PASSES && (pass < 2 || total_time < GEOMETRY_BENCH_MIN_TIME); pass++){
+        data->pass = pass;
+        if(bench_case->prepare != NULL){
+            bench_case->prepare(data);
+        }
+        geometry_bench_allocations = 0;
+        geometry_bench_bytes = 0;
+        geometry_bench_counting = true;
+        unsigned long long start = geometry_bench_now();
+        bench_case->run(data);
+        unsigned long long end = geometry_bench_now();
+        geometry_bench_counting = false;
+        if(bench_case->cleanup != NULL){
+            bench_case->cleanup(data);
+        }
+        if(pass > 0){
+            total_time += end - start;
+            total_ops += bench_case->count(data->size);
+            allocations += geometry_bench_allocations;
+            bytes += geometry_bench_bytes;
+        }
+    }
+    double ns_per_op = (double)total_time / total_ops;
+    fprintf(output, "%s,%zu,%zu,%.3f,%.0f,%.3f,%.1f\n", bench_case->name, data->size, total_ops, ns_per_op,
+            ns_per_op > 0 ? 1e9 / ns_per_op : 0.0, (double)allocations / total_ops, (double)bytes / total_ops);
+    fflush(output);
+}
+
+int main(int argc, char** argv){
+    static const geometry_bench_case cases[] = {
+        {"geometry_set_allocator", NULL, geometry_bench_setAllocator, NULL, geometry_bench_countEach},
+        {"geometry_get_allocator", NULL, geometry_bench_getAllocator, NULL, geometry_bench_countEach},
+        {"geometry_allocator_allocate", NULL, geometry_bench_createBlocks, geometry_bench_destroyBlocks, geometry_bench_countEach},
+        {"geometry_allocator_allocateZeroed", NULL, geometry_bench_createZeroedBlocks, geometry_bench_destroyBlocks, geometry_bench_countEach},
+        {"geometry_allocator_reallocate", geometry_bench_createBlocks, geometry_bench_allocatorReallocate, geometry_bench_destroyBlocks, geometry_bench_countEach},
+        {"geometry_allocator_free", geometry_bench_createBlocks, geometry_bench_destroyBlocks, NULL, geometry_bench_countEach},
+        {"geometry_arena_new", NULL, geometry_bench_createArenas, geometry_bench_destroyArenas, geometry_bench_countEach},
+        {"geometry_arena_new_with", NULL, geometry_bench_createArenasWith, geometry_bench_destroyArenas, geometry_bench_countEach},
+        {"geometry_arena_destroy", geometry_bench_createArenas, geometry_bench_destroyArenas, NULL, geometry_bench_countEach},
+        {"geometry_arena_allocate", NULL, geometry_bench_arenaAllocate, geometry_bench_resetArena, geometry_bench_countEach},
+        {"geometry_arena_reset", geometry_bench_fillArena, geometry_bench_resetArena, NULL, geometry_bench_countOnce},
+        {"geometry_rotation_new", NULL, geometry_bench_createRotations, geometry_bench_destroyRotations, geometry_bench_countEach},
+        {"geometry_rotation_new_with", NULL, geometry_bench_createRotationsWith, geometry_bench_destroyRotationsWith, geometry_bench_countEach},
+        {"geometry_rotation_destroy", geometry_bench_createRotations, geometry_bench_destroyRotations, NULL, geometry_bench_countEach},
+        {"geometry_rotation_destroy_with", geometry_bench_createRotationsWith, geometry_bench_destroyRotationsWith, NULL, geometry_bench_countEach},
+        {"geometry_transform_new", NULL, geometry_bench_createTransforms, geometry_bench_destroyTransforms, geometry_bench_countEach},
+        {"geometry_transform_new_with", NULL, geometry_bench_createTransformsWith, geometry_bench_destroyTransformsWith, geometry_bench_countEach},
+        {"geometry_transform_destroy", geometry_bench_createTransforms, geometry_bench_destroyTransforms, NULL, geometry_bench_countEach},
+        {"geometry_transform_destroy_with", geometry_bench_createTransformsWith, geometry_bench_destroyTransformsWith, NULL, geometry_bench_countEach},
+        {"geometry_transform_moveByVector", NULL, geometry_bench_transformMoveByVector, NULL, geometry_bench_countEach},
+        {"geometry_transform_rotateByAngle", NULL, geometry_bench_transformRotateByAngle, NULL, geometry_bench_countEach},
+        {"geometry_transform_compose", NULL, geometry_bench_transformCompose, geometry_bench_destroyTransforms, geometry_bench_countEach},
+        {"geometry_transform_invert", NULL, geometry_bench_transformInvert, geometry_bench_destroyTransforms, geometry_bench_countEach},
+        {"geometry_transform_getCoefficients", NULL, geometry_bench_transformGetCoefficients, NULL, geometry_bench_countEach},
+        {"geometry_point_new", NULL, geometry_bench_createPoints, geometry_bench_destroyPoints, geometry_bench_countEach},
+        {"geometry_point_new_in", NULL, geometry_bench_pointNewIn, geometry_bench_resetArena, geometry_bench_countEach},
+        {"geometry_point_new_with", NULL, geometry_bench_createPointsWith, geometry_bench_destroyPointsWith, geometry_bench_countEach},
+        {"geometry_point_destroy", geometry_bench_createPoints, geometry_bench_destroyPoints, NULL, geometry_bench_countEach},
+        {"geometry_point_destroy_with", geometry_bench_createPointsWith, geometry_bench_destroyPointsWith, NULL, geometry_bench_countEach},
+        {"geometry_point_getX", NULL, geometry_bench_pointGetX, NULL, geometry_bench_countEach},
+        {"geometry_point_getY", NULL, geometry_bench_pointGetY, NULL, geometry_bench_countEach},
+        {"geometry_point_moveByVector", NULL, geometry_bench_pointMoveByVector, NULL, geometry_bench_countEach},
+        {"geometry_point_rotateByAngle", NULL, geometry_bench_pointRotateByAngle, NULL, geometry_bench_countEach},
+        {"geometry_point_rotateBy", NULL, geometry_bench_pointRotateBy, NULL, geometry_bench_countEach},
+        {"geometry_point_applyTransform", NULL, geometry_bench_pointApplyTransform, NULL, geometry_bench_countEach},
+        {"geometry_point_calculateDistance", NULL, geometry_bench_pointCalculateDistance, NULL, geometry_bench_countEach},
+        {"geometry_point_liesOnSegment", NULL, geometry_bench_pointLiesOnSegment, NULL, geometry_bench_countEach},
+        {"geometry_segment_new", NULL, geometry_bench_createSegments, geometry_bench_destroySegments, geometry_bench_countEach},
+        {"geometry_segment_new_in", NULL, geometry_bench_segmentNewIn, geometry_bench_resetArena, geometry_bench_countEach},
+        {"geometry_segment_new_with", NULL, geometry_bench_createSegmentsWith, geometry_bench_destroySegmentsWith, geometry_bench_countEach},
+        {"geometry_segment_destroy", geometry_bench_createSegments, geometry_bench_destroySegments, NULL, geometry_bench_countEach},
+        {"geometry_segment_destroy_with", geometry_bench_createSegmentsWith, geometry_bench_destroySegmentsWith, NULL, geometry_bench_countEach},
+        {"geometry_segment_getPoints", NULL, geometry_bench_segmentGetPoints, NULL, geometry_bench_countEach},
+        {"geometry_segment_moveByVector", NULL, geometry_bench_segmentMoveByVector, NULL, geometry_bench_countEach},
+        {"geometry_segment_rotateByAngle", NULL, geometry_bench_segmentRotateByAngle, NULL, geometry_bench_countEach},
+        {"geometry_segment_rotateBy", NULL, geometry_bench_segmentRotateBy, NULL, geometry_bench_countEach},
+        {"geometry_segment_applyTransform", NULL, geometry_bench_segmentApplyTransform, NULL, geometry_bench_countEach},
+        {"geometry_segment_calculateLength", NULL, geometry_bench_segmentCalculateLength, NULL, geometry_bench_countEach},
+        {"geometry_segment_areParallel", NULL, geometry_bench_segmentAreParallel, NULL, geometry_bench_countEach},
+        {"geometry_segment_arePerpendicular", NULL, geometry_bench_segmentArePerpendicular, NULL, geometry_bench_countEach},
+        {"geometry_segment_calculateIntersection", NULL, geometry_bench_segmentCalculateIntersection, geometry_bench_destroyPoints, geometry_bench_countEach},
+        {"geometry_triangle_new", NULL, geometry_bench_createTriangles, geometry_bench_destroyTriangles, geometry_bench_countEach},
+        {"geometry_triangle_new_in", NULL, geometry_bench_triangleNewIn, geometry_bench_resetArena, geometry_bench_countEach},
+        {"geometry_triangle_new_with", NULL, geometry_bench_createTrianglesWith, geometry_bench_destroyTrianglesWith, geometry_bench_countEach},
+        {"geometry_triangle_newFromCoordinates", NULL, geometry_bench_triangleNewFromCoordinates, geometry_bench_destroyTrianglesWith, geometry_bench_countEach},
+        {"geometry_triangle_destroy", geometry_bench_createTriangles, geometry_bench_destroyTriangles, NULL, geometry_bench_countEach},
+        {"geometry_triangle_destroy_with", geometry_bench_createTrianglesWith, geometry_bench_destroyTrianglesWith, NULL, geometry_bench_countEach},
+        {"geometry_triangle_getPoints", NULL, geometry_bench_triangleGetPoints, NULL, geometry_bench_countEach},
+        {"geometry_triangle_getCoordinates", NULL, geometry_bench_triangleGetCoordinates, NULL, geometry_bench_countEach},
+        {"geometry_triangle_getIsRight", NULL, geometry_bench_triangleGetIsRight, NULL, geometry_bench_countEach},
+        {"geometry_triangle_getBoundingBox", NULL, geometry_bench_triangleGetBoundingBox, NULL, geometry_bench_countEach},
+        {"geometry_triangle_getCentroid", NULL, geometry_bench_triangleGetCentroid, NULL, geometry_bench_countEach},
+        {"geometry_triangle_getRightAngleVertex", NULL, geometry_bench_triangleGetRightAngleVertex, NULL, geometry_bench_countEach},
+        {"geometry_triangle_invalidateCache", NULL, geometry_bench_triangleInvalidateCache, NULL, geometry_bench_countEach},
+        {"geometry_triangle_fillCache", geometry_bench_invalidateTriangles, geometry_bench_triangleFillCache, NULL, geometry_bench_countEach},
+        {"geometry_triangle_moveByVector", NULL, geometry_bench_triangleMoveByVector, NULL, geometry_bench_countEach},
+        {"geometry_triangle_rotateByAngle", NULL, geometry_bench_triangleRotateByAngle, NULL, geometry_bench_countEach},
+        {"geometry_triangle_rotateBy", NULL, geometry_bench_triangleRotateBy, NULL, geometry_bench_countEach},
+        {"geometry_triangle_applyTransform", NULL, geometry_bench_triangleApplyTransform, NULL, geometry_bench_countEach},
+        {"geometry_triangle_calculatePerimeter", NULL, geometry_bench_triangleCalculatePerimeter, NULL, geometry_bench_countEach},
+        {"geometry_triangle_calculatePerimeter_uncached", geometry_bench_invalidateTriangles, geometry_bench_triangleCalculatePerimeter, NULL, geometry_bench_countEach},
+        {"geometry_triangle_calculateArea", NULL, geometry_bench_triangleCalculateArea, NULL, geometry_bench_countEach},
+        {"geometry_triangle_calculateArea_uncached", geometry_bench_invalidateTriangles, geometry_bench_triangleCalculateArea, NULL, geometry_bench_countEach},
+        {"geometry_triangle_areDisjoint", NULL, geometry_bench_triangleAreDisjoint, NULL, geometry_bench_countEach},
+        {"geometry_triangle_areDisjoint_uncached", geometry_bench_invalidateTriangles, geometry_bench_triangleAreDisjoint, NULL, geometry_bench_countEach},
+        {"geometry_triangle_areDisjointBatch", NULL, geometry_bench_triangleAreDisjointBatch, NULL, geometry_bench_countEach},
+        {"geometry_triangle_areDisjointMatrix", NULL, geometry_bench_triangleAreDisjointMatrix, NULL, geometry_bench_countMatrix},
+        {"geometry_triangle_calculateHypotenuse", NULL, geometry_bench_triangleCalculateHypotenuse, NULL, geometry_bench_countEach},
+        {"geometry_point_buffer_moveByVector", NULL, geometry_bench_pointBufferMoveByVector, NULL, geometry_bench_countEach},
+        {"geometry_point_buffer_rotateByAngle", NULL, geometry_bench_pointBufferRotateByAngle, NULL, geometry_bench_countEach},
+        {"geometry_point_buffer_applyTransform", NULL, geometry_bench_pointBufferApplyTransform, NULL, geometry_bench_countEach},
+        {"geometry_point_buffer_calculateDistances", NULL, geometry_bench_pointBufferCalculateDistances, NULL, geometry_bench_countEach},
+        {"geometry_point_buffer_calculateSquaredDistanceMatrix", NULL, geometry_bench_pointBufferCalculateSquaredDistanceMatrix, NULL, geometry_bench_countMatrix},
+        {"geometry_triangle_buffer_calculateAreas", NULL, geometry_bench_triangleBufferCalculateAreas, NULL, geometry_bench_countEach},
+        {"geometry_triangle_buffer_calculatePerimeters", NULL, geometry_bench_triangleBufferCalculatePerimeters, NULL, geometry_bench_countEach},
+    };
+    static const size_t sizes[] = {16, 1024, 65536};
+    FILE* output = stdout;
+    if(argc > 1){
+        output = fopen(argv[1], "w");
+        if(output == NULL){
+            fprintf(stderr, "bench: cannot open %s\n", argv[1]);
+            return 1;
+        }
+    }
+    const char* filter = argc > 2 ? argv[2] : NULL;
+    srand(1);
+    fprintf(output, "function,size,ops,ns_per_op,ops_per_second,allocations_per_op,bytes_per_op\n");
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++){
+        geometry_bench_data data;
+        if(!geometry_bench_createData(&data, sizes[s])){
+            fprintf(stderr, "bench: cannot create objects\n");
+            geometry_bench_destroyData(&data);
+            return 1;
+        }
+        for(size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++){
+            if(filter == NULL || strstr(cases[c].name, filter) != NULL){
+                geometry_bench_runCase(&cases[c], &data, output);
+            }
+        }
+        geometry_bench_destroyData(&data);
+    }
+    if(output != stdout){
+        fclose(output);
+    }
+    return 0;
+}
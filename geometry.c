@@ -1,35 +1,989 @@
 #include "geometry.h"
+#include "geometry_stats.h"
+#include "geometry_predicates.h"
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include <math.h>
 
+#define GEOMETRY_ARENA_DEFAULT_BLOCK_SIZE 65536
+#define GEOMETRY_ARENA_ALIGNMENT _Alignof(max_align_t)
+
 struct geometry_point {
-    double x;
-    double y;
+    geometry_real x;
+    geometry_real y;
+};
+
+// Vertices are kept by value, so every shape is a single contiguous allocation
+struct geometry_segment {
+    geometry_point start;
+    geometry_point end;
+};
+
+// Cached values are split into three groups: shape (side lengths, area,
+// perimeter, right angle) that survives every rigid motion, bounds
+// (bounding box, centroid) that is shifted on move and dropped on rotation,
+// and axes (edge normals with triangle's projections on them) used for
+// disjointness tests, that are shifted on move and dropped on rotation too
+#define GEOMETRY_TRIANGLE_CACHE_SHAPE 0x1
+#define GEOMETRY_TRIANGLE_CACHE_BOUNDS 0x2
+#define GEOMETRY_TRIANGLE_CACHE_AXES 0x4
+
+struct geometry_triangle {
+    geometry_point first;
+    geometry_point second;
+    geometry_point third;
+    bool is_right;
+    unsigned char cache_flags;
+    // index of vertex with (closest to) right angle: 0 - first, 1 - second, 2 - third
+    unsigned char right_vertex;
+    // lengths of sides first-second, first-third and second-third
+    geometry_real side_lengths[3];
+    geometry_real perimeter;
+    geometry_real area;
+    geometry_real hypotenuse;
+    geometry_real min_x;
+    geometry_real min_y;
+    geometry_real max_x;
+    geometry_real max_y;
+    geometry_real centroid_x;
+    geometry_real centroid_y;
+    // normals of sides first-second, second-third and third-first (not normalized)
+    geometry_real normal_x[3];
+    geometry_real normal_y[3];
+    // projection of the triangle on each normal
+    geometry_real axis_min[3];
+    geometry_real axis_max[3];
 };
 
-struct geometry_segment {
-    geometry_point* start;
-    geometry_point* end;
-};
+// Single chunk of arena memory, objects are placed one after another in data
+typedef struct geometry_arena_block {
+    struct geometry_arena_block* next;
+    size_t capacity;
+    size_t used;
+    _Alignas(max_align_t) unsigned char data[];
+} geometry_arena_block;
+
+struct geometry_arena {
+    geometry_arena_block* first;
+    geometry_arena_block* current;
+    size_t block_size;
+    // blocks are taken from and released to it
+    geometry_allocator allocator;
+};
+
+// Maps (x, y) to (a*x + b*y + tx, c*x + d*y + ty)
+struct geometry_transform {
+    geometry_real a;
+    geometry_real b;
+    geometry_real tx;
+    geometry_real c;
+    geometry_real d;
+    geometry_real ty;
+};
+
+struct geometry_rotation {
+    geometry_real cos_angle;
+    geometry_real sin_angle;
+    geometry_real reference_x;
+    geometry_real reference_y;
+};
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static void* geometry_allocator_defaultAllocate(size_t size, void* user_data);
+static void geometry_allocator_defaultFree(void* pointer, void* user_data);
+static geometry_arena_block* geometry_arena_block_new(const geometry_allocator* allocator, size_t capacity);
+static void geometry_rotation_init(geometry_rotation* rotation, geometry_real angle, geometry_point* reference_point);
+static int geometry_point_orientation(geometry_point* first, geometry_point* second, geometry_point* third);
+static geometry_triangle* geometry_triangle_updateShape(geometry_triangle* triangle);
+static geometry_triangle* geometry_triangle_updateBounds(geometry_triangle* triangle);
+static geometry_triangle* geometry_triangle_updateAxes(geometry_triangle* triangle);
+static bool geometry_triangle_separatedOnAxes(geometry_triangle* axes_triangle, geometry_triangle* other_triangle);
+static bool geometry_triangle_separated(geometry_triangle* first_triangle, geometry_triangle* second_triangle);
+static void geometry_transform_setMatrix(geometry_transform* transform, geometry_real a, geometry_real b, geometry_real tx, geometry_real c, geometry_real d, geometry_real ty);
+static void geometry_transform_multiply(geometry_transform* outer, geometry_transform* inner, geometry_transform* result);
+
+// allocator used when none is given, set by geometry_set_allocator
+static geometry_allocator geometry_allocator_current = {geometry_allocator_defaultAllocate, geometry_allocator_defaultFree, NULL};
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to allocate memory with malloc, default allocation function
+*   In params:
+*       size_t size                     number of bytes to allocate
+*       void* user_data                 unused
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*                           pointer to allocated memory, NULL if error occured
+*/
+static void* geometry_allocator_defaultAllocate(size_t size, void* user_data){
+    (void)user_data;
+    return malloc(size);
+}
+
+/**
+*   Function to release memory with free, default release function
+*   In params:
+*       void* pointer                   memory to release
+*       void* user_data                 unused
+*
+*   Out params/return:
+*       none
+*/
+static void geometry_allocator_defaultFree(void* pointer, void* user_data){
+    (void)user_data;
+    free(pointer);
+}
+
+/**
+*   Function to create new memory block for arena
+*   In params:
+*       const geometry_allocator* allocator     allocator to take block from
+*       size_t capacity                         number of bytes that can be allocated from block
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_arena_block*                   pointer to created block, NULL if error occured
+*/
+static geometry_arena_block* geometry_arena_block_new(const geometry_allocator* allocator, size_t capacity){
+    if(capacity > SIZE_MAX - sizeof(geometry_arena_block)){
+        return NULL;
+    }
+    geometry_arena_block* new_block = geometry_allocator_allocate(allocator, sizeof(*new_block) + capacity);
+    if(new_block == NULL){
+        return NULL;
+    }
+    new_block->next = NULL;
+    new_block->capacity = capacity;
+    new_block->used = 0;
+    return new_block;
+}
+
+/**
+*   Function to fill given geometry_rotation structure
+*   In params:
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotations will be calculated
+*
+*   Out params:
+*       geometry_rotation* rotation         filled rotation structure
+*
+*   Return:
+*       none
+*/
+static void geometry_rotation_init(geometry_rotation* rotation, geometry_real angle, geometry_point* reference_point){
+    rotation->cos_angle = GEOMETRY_COS(angle);
+    rotation->sin_angle = GEOMETRY_SIN(angle);
+    rotation->reference_x = reference_point->x;
+    rotation->reference_y = reference_point->y;
+}
+
+/**
+*   Function to set all coefficients of given transform
+*   In params:
+*       geometry_real a, b, tx, c, d, ty  coefficients, transform maps (x, y)
+*                                         to (a*x + b*y + tx, c*x + d*y + ty)
+*
+*   Out params:
+*       geometry_transform* transform   filled transform structure
+*
+*   Return:
+*       none
+*/
+static void geometry_transform_setMatrix(geometry_transform* transform, geometry_real a, geometry_real b, geometry_real tx, geometry_real c, geometry_real d, geometry_real ty){
+    transform->a = a;
+    transform->b = b;
+    transform->tx = tx;
+    transform->c = c;
+    transform->d = d;
+    transform->ty = ty;
+}
+
+/**
+*   Function to multiply two transform matrices
+*   Result is equal to applying inner transform first and outer one after it,
+*   it may point to the same structure as any of the arguments
+*   In params:
+*       geometry_transform* outer       transform applied second
+*       geometry_transform* inner       transform applied first
+*
+*   Out params:
+*       geometry_transform* result      composed transform
+*
+*   Return:
+*       none
+*/
+static void geometry_transform_multiply(geometry_transform* outer, geometry_transform* inner, geometry_transform* result){
+    geometry_transform_setMatrix(result,
+                                outer->a * inner->a + outer->b * inner->c,
+                                outer->a * inner->b + outer->b * inner->d,
+                                outer->a * inner->tx + outer->b * inner->ty + outer->tx,
+                                outer->c * inner->a + outer->d * inner->c,
+                                outer->c * inner->b + outer->d * inner->d,
+                                outer->c * inner->tx + outer->d * inner->ty + outer->ty);
+}
+
+/**
+*   Function to determine on which side of line going through first and second point
+*   lies third point
+*   In params:
+*       geometry_point* first       first point of line
+*       geometry_point* second      second point of line
+*       geometry_point* third       examined point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                         1 if third point lies on the left (counterclockwise turn),
+*                                   -1 if on the right, 0 if all points are colinear
+*/
+static int geometry_point_orientation(geometry_point* first, geometry_point* second, geometry_point* third){
+    return geometry_predicates_orientation(first->x, first->y, second->x, second->y, third->x, third->y);
+}
+
+/**
+*   Function to fill shape cache of given triangle if it is not valid
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*              given triangle with valid shape cache
+*/
+static geometry_triangle* geometry_triangle_updateShape(geometry_triangle* triangle){
+    if(triangle->cache_flags & GEOMETRY_TRIANGLE_CACHE_SHAPE){
+        return triangle;
+    }
+    GEOMETRY_STATS_EVENT(GEOMETRY_STATS_TRIANGLE_SHAPE_UPDATE);
+    geometry_real first_second_x = triangle->second.x - triangle->first.x;
+    geometry_real first_second_y = triangle->second.y - triangle->first.y;
+    geometry_real first_third_x = triangle->third.x - triangle->first.x;
+    geometry_real first_third_y = triangle->third.y - triangle->first.y;
+    geometry_real second_third_x = triangle->third.x - triangle->second.x;
+    geometry_real second_third_y = triangle->third.y - triangle->second.y;
+    geometry_real* lengths = triangle->side_lengths;
+    lengths[0] = GEOMETRY_SQRT(first_second_x * first_second_x + first_second_y * first_second_y);
+    lengths[1] = GEOMETRY_SQRT(first_third_x * first_third_x + first_third_y * first_third_y);
+    lengths[2] = GEOMETRY_SQRT(second_third_x * second_third_x + second_third_y * second_third_y);
+    triangle->perimeter = lengths[0] + lengths[1] + lengths[2];
+    // half of absolute cross product of two sides, the same as in geometry_triangle_buffer
+    // and geometry_mesh, exact for right triangles too and doesn't cancel like Heron's formula
+    geometry_real cross = first_second_x * first_third_y - first_third_x * first_second_y;
+    triangle->area = GEOMETRY_FABS(cross) / 2;
+    if(triangle->is_right){
+        // right angle is at the vertex where cosine of the angle is closest to 0,
+        // on exact data it is the vertex where sides are perpendicular
+        geometry_real cosines[3] = {
+            GEOMETRY_FABS(first_second_x * first_third_x + first_second_y * first_third_y) / (lengths[0] * lengths[1]),
+            GEOMETRY_FABS(first_second_x * second_third_x + first_second_y * second_third_y) / (lengths[0] * lengths[2]),
+            GEOMETRY_FABS(first_third_x * second_third_x + first_third_y * second_third_y) / (lengths[1] * lengths[2])
+        };
+        unsigned char right_vertex = 0;
+        if(cosines[1] < cosines[right_vertex]){
+            right_vertex = 1;
+        }
+        if(cosines[2] < cosines[right_vertex]){
+            right_vertex = 2;
+        }
+        // legs are the sides meeting at right angle vertex
+        geometry_real leg_one = lengths[right_vertex == 2 ? 1 : 0];
+        geometry_real leg_two = lengths[right_vertex == 0 ? 1 : 2];
+        triangle->right_vertex = right_vertex;
+        triangle->hypotenuse = GEOMETRY_SQRT(leg_one * leg_one + leg_two * leg_two);
+    }
+    else{
+        triangle->right_vertex = 0;
+        triangle->hypotenuse = -1;
+    }
+    triangle->cache_flags |= GEOMETRY_TRIANGLE_CACHE_SHAPE;
+    return triangle;
+    // For comments on theese equations please refer to documentation
+}
+
+/**
+*   Function to fill bounds cache of given triangle if it is not valid
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*              given triangle with valid bounds cache
+*/
+static geometry_triangle* geometry_triangle_updateBounds(geometry_triangle* triangle){
+    if(triangle->cache_flags & GEOMETRY_TRIANGLE_CACHE_BOUNDS){
+        return triangle;
+    }
+    GEOMETRY_STATS_EVENT(GEOMETRY_STATS_TRIANGLE_BOUNDS_UPDATE);
+    geometry_point* first = &triangle->first;
+    geometry_point* second = &triangle->second;
+    geometry_point* third = &triangle->third;
+    triangle->min_x = GEOMETRY_FMIN(first->x, GEOMETRY_FMIN(second->x, third->x));
+    triangle->min_y = GEOMETRY_FMIN(first->y, GEOMETRY_FMIN(second->y, third->y));
+    triangle->max_x = GEOMETRY_FMAX(first->x, GEOMETRY_FMAX(second->x, third->x));
+    triangle->max_y = GEOMETRY_FMAX(first->y, GEOMETRY_FMAX(second->y, third->y));
+    triangle->centroid_x = (first->x + second->x + third->x) / 3;
+    triangle->centroid_y = (first->y + second->y + third->y) / 3;
+    triangle->cache_flags |= GEOMETRY_TRIANGLE_CACHE_BOUNDS;
+    return triangle;
+}
+
+/**
+*   Function to fill axes cache of given triangle if it is not valid
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*              given triangle with valid axes cache
+*/
+static geometry_triangle* geometry_triangle_updateAxes(geometry_triangle* triangle){
+    if(triangle->cache_flags & GEOMETRY_TRIANGLE_CACHE_AXES){
+        return triangle;
+    }
+    GEOMETRY_STATS_EVENT(GEOMETRY_STATS_TRIANGLE_AXES_UPDATE);
+    geometry_point* vertices[3] = {&triangle->first, &triangle->second, &triangle->third};
+    for(int i = 0; i < 3; i++){
+        geometry_point* start = vertices[i];
+        geometry_point* end = vertices[(i + 1) % 3];
+        geometry_real normal_x = start->y - end->y;
+        geometry_real normal_y = end->x - start->x;
+        geometry_real first_projection = normal_x * vertices[0]->x + normal_y * vertices[0]->y;
+        geometry_real second_projection = normal_x * vertices[1]->x + normal_y * vertices[1]->y;
+        geometry_real third_projection = normal_x * vertices[2]->x + normal_y * vertices[2]->y;
+        triangle->normal_x[i] = normal_x;
+        triangle->normal_y[i] = normal_y;
+        triangle->axis_min[i] = GEOMETRY_FMIN(first_projection, GEOMETRY_FMIN(second_projection, third_projection));
+        triangle->axis_max[i] = GEOMETRY_FMAX(first_projection, GEOMETRY_FMAX(second_projection, third_projection));
+    }
+    triangle->cache_flags |= GEOMETRY_TRIANGLE_CACHE_AXES;
+    return triangle;
+}
+
+/**
+*   Function to check if one of the first triangle's edge normals separates triangles
+*   Both triangles must have valid axes cache
+*   In params:
+*       geometry_triangle* axes_triangle        triangle which normals are checked
+*       geometry_triangle* other_triangle       other triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true if projections on some normal don't overlap
+*/
+static bool geometry_triangle_separatedOnAxes(geometry_triangle* axes_triangle, geometry_triangle* other_triangle){
+    bool separated = false;
+    for(int i = 0; i < 3; i++){
+        geometry_real normal_x = axes_triangle->normal_x[i];
+        geometry_real normal_y = axes_triangle->normal_y[i];
+        geometry_real first_projection = normal_x * other_triangle->first.x + normal_y * other_triangle->first.y;
+        geometry_real second_projection = normal_x * other_triangle->second.x + normal_y * other_triangle->second.y;
+        geometry_real third_projection = normal_x * other_triangle->third.x + normal_y * other_triangle->third.y;
+        geometry_real projection_min = GEOMETRY_FMIN(first_projection, GEOMETRY_FMIN(second_projection, third_projection));
+        geometry_real projection_max = GEOMETRY_FMAX(first_projection, GEOMETRY_FMAX(second_projection, third_projection));
+        // all axes are checked without early exit, so the loop has no branches
+        separated |= (projection_max < axes_triangle->axis_min[i]) | (projection_min > axes_triangle->axis_max[i]);
+    }
+    return separated;
+}
+
+/**
+*   Function to check if two triangles are disjoint with separating axis theorem
+*   Both triangles must have valid bounds and axes cache
+*   In params:
+*       geometry_triangle* first_triangle       first triangle
+*       geometry_triangle* second_triangle      second triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true if triangles are disjoint
+*/
+static bool geometry_triangle_separated(geometry_triangle* first_triangle, geometry_triangle* second_triangle){
+    // bounding boxes reject most of far apart pairs with four comparisons
+    if((first_triangle->max_x < second_triangle->min_x) | (second_triangle->max_x < first_triangle->min_x)
+        | (first_triangle->max_y < second_triangle->min_y) | (second_triangle->max_y < first_triangle->min_y)){
+        return true;
+    }
+    return geometry_triangle_separatedOnAxes(first_triangle, second_triangle) | geometry_triangle_separatedOnAxes(second_triangle, first_triangle);
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to set allocator used by all following allocations of library
+*   It is not synchronized with other calls, so it should be called
+*   before objects are created, while no other thread uses library
+*   In params:
+*       geometry_allocate_function allocate     allocation function, NULL (together with free) for malloc
+*       geometry_free_function free             function releasing memory from allocate, NULL (together with allocate) for free
+*       void* user_data                         pointer passed to every call of allocate and free
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true on success, false if only one of functions is NULL
+*/
+bool geometry_set_allocator(geometry_allocate_function allocate, geometry_free_function free, void* user_data){
+    if((allocate == NULL) != (free == NULL)){
+        return false;
+    }
+    if(allocate == NULL){
+        allocate = geometry_allocator_defaultAllocate;
+        free = geometry_allocator_defaultFree;
+        user_data = NULL;
+    }
+    geometry_allocator_current.allocate = allocate;
+    geometry_allocator_current.free = free;
+    geometry_allocator_current.user_data = user_data;
+    return true;
+}
+
+/**
+*   Function to get allocator currently set
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_allocator          copy of allocator set by geometry_set_allocator
+*/
+geometry_allocator geometry_get_allocator(void){
+    return geometry_allocator_current;
+}
+
+/**
+*   Function to allocate memory from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t size                             number of bytes to allocate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*                                   pointer to allocated memory, NULL if error occured
+*/
+void* geometry_allocator_allocate(const geometry_allocator* allocator, size_t size){
+    if(allocator == NULL){
+        allocator = &geometry_allocator_current;
+    }
+    GEOMETRY_STATS_ALLOCATION(size);
+    return allocator->allocate(size, allocator->user_data);
+}
+
+/**
+*   Function to allocate zeroed array from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t count                            number of elements
+*       size_t size                             size of single element in bytes
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*                                   pointer to allocated memory, NULL if error occured
+*/
+void* geometry_allocator_allocateZeroed(const geometry_allocator* allocator, size_t count, size_t size){
+    if(size != 0 && count > SIZE_MAX / size){
+        return NULL;
+    }
+    void* memory = geometry_allocator_allocate(allocator, count * size);
+    if(memory != NULL){
+        memset(memory, 0, count * size);
+    }
+    return memory;
+}
+
+/**
+*   Function to change size of memory taken from given allocator
+*   Contents are kept up to smaller of sizes, on error old memory is left untouched
+*   In params:
+*       const geometry_allocator* allocator     allocator memory was taken from, NULL for the one currently set
+*       void* pointer                           memory to resize, NULL to allocate new one
+*       size_t old_size                         current size of memory in bytes
+*       size_t new_size                         requested size of memory in bytes
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*                                   pointer to resized memory, NULL if error occured
+*/
+void* geometry_allocator_reallocate(const geometry_allocator* allocator, void* pointer, size_t old_size, size_t new_size){
+    if(allocator == NULL){
+        allocator = &geometry_allocator_current;
+    }
+    GEOMETRY_STATS_ALLOCATION(new_size);
+    if(pointer != NULL){
+        GEOMETRY_STATS_FREE();
+    }
+    // malloc can often grow memory in place
+    if(allocator->allocate == geometry_allocator_defaultAllocate){
+        return realloc(pointer, new_size);
+    }
+    void* memory = allocator->allocate(new_size, allocator->user_data);
+    if(memory == NULL){
+        return NULL;
+    }
+    if(pointer != NULL){
+        memcpy(memory, pointer, old_size < new_size ? old_size : new_size);
+        allocator->free(pointer, allocator->user_data);
+    }
+    return memory;
+}
+
+/**
+*   Function to release memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator memory was taken from, NULL for the one currently set
+*       void* pointer                           memory to release, may be NULL
+*
+*   Out params/return:
+*       none
+*/
+void geometry_allocator_free(const geometry_allocator* allocator, void* pointer){
+    if(pointer == NULL){
+        return;
+    }
+    if(allocator == NULL){
+        allocator = &geometry_allocator_current;
+    }
+    GEOMETRY_STATS_FREE();
+    allocator->free(pointer, allocator->user_data);
+}
+
+/**
+*   Function to create new geometry_arena object
+*   Memory is reserved in blocks of given size, new blocks are added
+*   when current one runs out of space
+*   In params:
+*       size_t block_size       size of single memory block in bytes,
+*                               0 for default size
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_arena*         pointer to created object
+*/
+geometry_arena* geometry_arena_new(size_t block_size){
+    return geometry_arena_new_with(NULL, block_size);
+}
+
+/**
+*   Function to create new geometry_arena object with memory taken from given allocator
+*   Arena remembers allocator, its blocks are taken from it and released to it by geometry_arena_destroy
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t block_size                       size of single memory block in bytes,
+*                                               0 for default size
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_arena*                         pointer to created object, NULL if error occured
+*/
+geometry_arena* geometry_arena_new_with(const geometry_allocator* allocator, size_t block_size){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_ARENA_NEW);
+    if(allocator == NULL){
+        allocator = &geometry_allocator_current;
+    }
+    if(block_size == 0){
+        block_size = GEOMETRY_ARENA_DEFAULT_BLOCK_SIZE;
+    }
+    geometry_arena* new_arena = geometry_allocator_allocate(allocator, sizeof(*new_arena));
+    geometry_arena_block* first_block = geometry_arena_block_new(allocator, block_size);
+    if(new_arena == NULL || first_block == NULL){
+        geometry_allocator_free(allocator, new_arena);
+        geometry_allocator_free(allocator, first_block);
+        return NULL;
+    }
+    new_arena->first = first_block;
+    new_arena->current = first_block;
+    new_arena->block_size = block_size;
+    new_arena->allocator = *allocator;
+    return new_arena;
+}
+
+/**
+*   Function to destroy given geometry_arena object
+*   All objects created in this arena are freed too
+*   In params:
+*       geometry_arena* arena       arena object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_arena_destroy(geometry_arena* arena){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_ARENA_DESTROY);
+    if(arena == NULL){
+        return;
+    }
+    geometry_arena_block* block = arena->first;
+    while(block != NULL){
+        geometry_arena_block* next = block->next;
+        geometry_allocator_free(&arena->allocator, block);
+        block = next;
+    }
+    geometry_allocator allocator = arena->allocator;
+    geometry_allocator_free(&allocator, arena);
+}
+
+/**
+*   Function to release all objects created in given arena at once
+*   Memory blocks are kept and reused by next allocations
+*   In params:
+*       geometry_arena* arena       arena to be reset
+*
+*   Out params/return:
+*       none (all objects created in this arena become invalid)
+*/
+void geometry_arena_reset(geometry_arena* arena){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_ARENA_RESET);
+    if(arena == NULL){
+        return;
+    }
+    for(geometry_arena_block* block = arena->first; block != NULL; block = block->next){
+        block->used = 0;
+    }
+    arena->current = arena->first;
+}
+
+/**
+*   Function to allocate raw memory from given arena
+*   Returned memory is suitably aligned for any object type
+*   In params:
+*       geometry_arena* arena       arena to allocate from
+*       size_t size                 number of bytes to allocate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*                       pointer to allocated memory, NULL if error occured
+*/
+void* geometry_arena_allocate(geometry_arena* arena, size_t size){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_ARENA_ALLOCATE);
+    if(arena == NULL || size == 0){
+        return NULL;
+    }
+    // keep every allocation aligned, so next one can start right after it
+    size = (size + GEOMETRY_ARENA_ALIGNMENT - 1) & ~(size_t)(GEOMETRY_ARENA_ALIGNMENT - 1);
+    geometry_arena_block* block = arena->current;
+    // blocks kept after reset are reused before new ones are created
+    while(block->capacity - block->used < size && block->next != NULL){
+        block = block->next;
+    }
+    if(block->capacity - block->used < size){
+        size_t capacity = size > arena->block_size ? size : arena->block_size;
+        geometry_arena_block* new_block = geometry_arena_block_new(&arena->allocator, capacity);
+        if(new_block == NULL){
+            return NULL;
+        }
+        block->next = new_block;
+        block = new_block;
+    }
+    arena->current = block;
+    void* memory = block->data + block->used;
+    block->used += size;
+    return memory;
+}
+
+/**
+*   Function to create new geometry_rotation object
+*   User is expected to provide angle measured in radians
+*   calculated counterclockwise
+*   In params:
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotations will be calculated
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rotation*                  pointer to created object
+*/
+geometry_rotation* geometry_rotation_new(geometry_real angle, geometry_point* reference_point){
+    return geometry_rotation_new_with(NULL, angle, reference_point);
+}
 
-struct geometry_triangle {
-    geometry_point* first;
-    geometry_point* second;
-    geometry_point* third;
-    bool is_right;
-};
+/**
+*   Function to destroy given geometry_rotation object
+*   In params:
+*       geometry_rotation* rotation     rotation object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_rotation_destroy(geometry_rotation* rotation){
+    geometry_rotation_destroy_with(NULL, rotation);
+}
 
-// LOCAL FUNCTIONS DECLARATIONS
+/**
+*   Function to create new geometry_rotation object with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_real angle                     angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point         point around which rotations will be calculated
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rotation*                      pointer to created object, NULL if error occured
+*/
+geometry_rotation* geometry_rotation_new_with(const geometry_allocator* allocator, geometry_real angle, geometry_point* reference_point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_ROTATION_NEW);
+    if(reference_point == NULL){
+        return NULL;
+    }
+    geometry_rotation* new_rotation = geometry_allocator_allocate(allocator, sizeof(*new_rotation));
+    if(new_rotation == NULL){
+        return NULL;
+    }
+    geometry_rotation_init(new_rotation, angle, reference_point);
+    return new_rotation;
+}
 
-// LOCAL FUNCTIONS DEFINITIONS
+/**
+*   Function to destroy given geometry_rotation object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator rotation was created with, NULL for the one currently set
+*       geometry_rotation* rotation             rotation object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_rotation_destroy_with(const geometry_allocator* allocator, geometry_rotation* rotation){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_ROTATION_DESTROY);
+    geometry_allocator_free(allocator, rotation);
+}
 
-// GLOBAL FUNCTIONS DEFINITIONS
+/**
+*   Function to create new geometry_transform object equal to identity
+*   Operations appended to it are not applied to any shape until
+*   the transform is applied with one of _applyTransform functions
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_transform*             pointer to created object
+*/
+geometry_transform* geometry_transform_new(void){
+    return geometry_transform_new_with(NULL);
+}
+
+/**
+*   Function to destroy given geometry_transform object
+*   In params:
+*       geometry_transform* transform       transform object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_transform_destroy(geometry_transform* transform){
+    geometry_transform_destroy_with(NULL, transform);
+}
+
+/**
+*   Function to create new geometry_transform object equal to identity with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_transform*                     pointer to created object, NULL if error occured
+*/
+geometry_transform* geometry_transform_new_with(const geometry_allocator* allocator){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRANSFORM_NEW);
+    geometry_transform* new_transform = geometry_allocator_allocate(allocator, sizeof(*new_transform));
+    if(new_transform == NULL){
+        return NULL;
+    }
+    geometry_transform_setMatrix(new_transform, 1, 0, 0, 0, 1, 0);
+    return new_transform;
+}
+
+/**
+*   Function to destroy given geometry_transform object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator transform was created with, NULL for the one currently set
+*       geometry_transform* transform           transform object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_transform_destroy_with(const geometry_allocator* allocator, geometry_transform* transform){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRANSFORM_DESTROY);
+    geometry_allocator_free(allocator, transform);
+}
+
+/**
+*   Function to append moving by vector to given transform
+*   User is expected to provide vector in normalized form;
+*   i.e. unbouned or origin-bounded
+*   In parms:
+*       geometry_transform* transform       transform to be extended
+*       geometry_real vector_x              x coordinate of vector
+*       geometry_real vector_y              y coordinate of vector
+*
+*   Out params/return:
+*       none (transform object is changed)
+*/
+void geometry_transform_moveByVector(geometry_transform* transform, geometry_real vector_x, geometry_real vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRANSFORM_MOVE_BY_VECTOR);
+    if(transform == NULL){
+        return;
+    }
+    transform->tx += vector_x;
+    transform->ty += vector_y;
+}
+
+/**
+*   Function to append rotation through an angle around a point to given transform
+*   User is expected to provide angle measured in radians
+*   calculated counterclockwise
+*   In params:
+*       geometry_transform* transform       transform to be extended
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotation will be calculated
+*
+*   Out params/return:
+*       none (transform object is changed)
+*/
+void geometry_transform_rotateByAngle(geometry_transform* transform, geometry_real angle, geometry_point* reference_point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRANSFORM_ROTATE_BY_ANGLE);
+    if(transform == NULL || reference_point == NULL){
+        return;
+    }
+    geometry_real cos_angle = GEOMETRY_COS(angle);
+    geometry_real sin_angle = GEOMETRY_SIN(angle);
+    // rotation around reference point is x' = R(x - r) + r = Rx + (r - Rr)
+    geometry_transform rotation;
+    geometry_transform_setMatrix(&rotation, cos_angle, -sin_angle, reference_point->x - cos_angle * reference_point->x + sin_angle * reference_point->y,
+                                sin_angle, cos_angle, reference_point->y - sin_angle * reference_point->x - cos_angle * reference_point->y);
+    geometry_transform_multiply(&rotation, transform, transform);
+    // For comments on these equations please refer to documentation
+}
+
+/**
+*   Function to compose two transforms into one
+*   Applying result is equal to applying first transform and then second one
+*   In params:
+*       geometry_transform* first           transform applied first
+*       geometry_transform* second          transform applied second
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_transform*                 pointer to created object, NULL if error occured
+*/
+geometry_transform* geometry_transform_compose(geometry_transform* first, geometry_transform* second){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRANSFORM_COMPOSE);
+    if(first == NULL || second == NULL){
+        return NULL;
+    }
+    geometry_transform* new_transform = geometry_allocator_allocate(NULL, sizeof(*new_transform));
+    if(new_transform == NULL){
+        return NULL;
+    }
+    geometry_transform_multiply(second, first, new_transform);
+    return new_transform;
+}
+
+/**
+*   Function to calculate inverse of given transform
+*   In params:
+*       geometry_transform* transform       transform to invert
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_transform*                 pointer to created object,
+*                                           NULL if transform is not invertible or error occured
+*/
+geometry_transform* geometry_transform_invert(geometry_transform* transform){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRANSFORM_INVERT);
+    if(transform == NULL){
+        return NULL;
+    }
+    geometry_real determinant = transform->a * transform->d - transform->b * transform->c;
+    if(determinant == 0 || !isfinite(determinant)){
+        return NULL;
+    }
+    geometry_transform* new_transform = geometry_allocator_allocate(NULL, sizeof(*new_transform));
+    if(new_transform == NULL){
+        return NULL;
+    }
+    // inverse of x' = Mx + t is x = M^-1 x' - M^-1 t
+    geometry_real a = transform->d / determinant;
+    geometry_real b = -transform->b / determinant;
+    geometry_real c = -transform->c / determinant;
+    geometry_real d = transform->a / determinant;
+    geometry_transform_setMatrix(new_transform, a, b, -(a * transform->tx + b * transform->ty),
+                                c, d, -(c * transform->tx + d * transform->ty));
+    return new_transform;
+}
+
+/**
+*   Function to get coefficients of given transform
+*   Transform maps point (x, y) to (a*x + b*y + tx, c*x + d*y + ty)
+*   In params:
+*       geometry_transform* transform       transform
+*
+*   Out params:
+*       geometry_real coefficients[6]       coefficients in order a, b, tx, c, d, ty
+*
+*   Return:
+*       none
+*/
+void geometry_transform_getCoefficients(geometry_transform* transform, geometry_real coefficients[6]){
+    if(transform == NULL || coefficients == NULL){
+        return;
+    }
+    coefficients[0] = transform->a;
+    coefficients[1] = transform->b;
+    coefficients[2] = transform->tx;
+    coefficients[3] = transform->c;
+    coefficients[4] = transform->d;
+    coefficients[5] = transform->ty;
+}
 
 /**
 *   Function to create new gemetry_point object with given coordinates
 *   In params:
-*       double x        x coordinate
-*       double y        y coordinate
+*       geometry_real x    x coordinate
+*       geometry_real y    y coordinate
 *   
 *   Out params:
 *       none
@@ -37,8 +991,27 @@ struct geometry_triangle {
 *   Return:
 *       geometry_point* pointer to created object
 */
-geometry_point* geometry_point_new(double x, double y){
-    geometry_point* new_point = malloc(sizeof(*new_point));
+geometry_point* geometry_point_new(geometry_real x, geometry_real y){
+    return geometry_point_new_with(NULL, x, y);
+}
+
+/**
+*   Function to create new gemetry_point object with given coordinates inside given arena
+*   Created object is released with arena, it must not be passed to geometry_point_destroy
+*   In params:
+*       geometry_arena* arena       arena to allocate object from
+*       geometry_real x             x coordinate
+*       geometry_real y             y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point*             pointer to created object
+*/
+geometry_point* geometry_point_new_in(geometry_arena* arena, geometry_real x, geometry_real y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_NEW_IN);
+    geometry_point* new_point = geometry_arena_allocate(arena, sizeof(*new_point));
     if(new_point == NULL){
         return NULL;
     }
@@ -56,9 +1029,45 @@ geometry_point* geometry_point_new(double x, double y){
 *       none
 */
 void geometry_point_destroy(geometry_point* point){
-    if(point != NULL){
-        free(point);
+    geometry_point_destroy_with(NULL, point);
+}
+
+/**
+*   Function to create new gemetry_point object with given coordinates with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_real x                         x coordinate
+*       geometry_real y                         y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point*                         pointer to created object, NULL if error occured
+*/
+geometry_point* geometry_point_new_with(const geometry_allocator* allocator, geometry_real x, geometry_real y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_NEW);
+    geometry_point* new_point = geometry_allocator_allocate(allocator, sizeof(*new_point));
+    if(new_point == NULL){
+        return NULL;
     }
+    new_point->x = x;
+    new_point->y = y;
+    return new_point;
+}
+
+/**
+*   Function to destroy given geometry_point object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator point was created with, NULL for the one currently set
+*       geometry_point* point                   point object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_point_destroy_with(const geometry_allocator* allocator, geometry_point* point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_DESTROY);
+    geometry_allocator_free(allocator, point);
 }
 
 /**
@@ -70,9 +1079,9 @@ void geometry_point_destroy(geometry_point* point){
 *       none
 *
 *   Return:
-*       double                      x coordinate of given point
+*       geometry_real               x coordinate of given point
 */
-double geometry_point_getX(geometry_point* point){
+geometry_real geometry_point_getX(geometry_point* point){
     if(point != NULL){
         return point->x;
     }
@@ -88,9 +1097,9 @@ double geometry_point_getX(geometry_point* point){
 *       none
 *
 *   Return:
-*       double                      y coordinate of given point
+*       geometry_real               y coordinate of given point
 */
-double geometry_point_getY(geometry_point* point){
+geometry_real geometry_point_getY(geometry_point* point){
     if(point != NULL){
         return point->y;
     }
@@ -103,13 +1112,14 @@ double geometry_point_getY(geometry_point* point){
 *   i.e. unbouned or origin-bounded
 *   In parms:
 *       geometry_point* point       point to be moved
-*       double vector_x             x coordinate of vector
-*       double vector_y             y coordinate of vector
+*       geometry_real vector_x      x coordinate of vector
+*       geometry_real vector_y      y coordinate of vector
 *       
 *   Out params/return:
 *       none (point object is changed)
 */
-void geometry_point_moveByVector(geometry_point* point, double vector_x, double vector_y){
+void geometry_point_moveByVector(geometry_point* point, geometry_real vector_x, geometry_real vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_MOVE_BY_VECTOR);
     if(point == NULL){
         return;
     }
@@ -123,24 +1133,63 @@ void geometry_point_moveByVector(geometry_point* point, double vector_x, double
 *   calculated counterclockwise
 *   In params:
 *       geometry_point* rotated_point       point to be rotated
-*       double angle                        angle to rotate through in radians calculated counterclockwise
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
 *       geometry_point* reference_point     point around which rotations will be calculated
 *
 *   Out params/return:
 *       none (roated_point object is changed)       
 */
-void geometry_point_rotateByAngle(geometry_point* rotated_point, double angle, geometry_point* reference_point){
+void geometry_point_rotateByAngle(geometry_point* rotated_point, geometry_real angle, geometry_point* reference_point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_ROTATE_BY_ANGLE);
     if(rotated_point == NULL || reference_point == NULL){
         return;
     }
-    double rotate_x = rotated_point->x;
-    double rotate_y = rotated_point->y;
-    double reference_x = reference_point->x;
-    double reference_y = reference_point->y;
-    rotated_point->x = (rotate_x - reference_x) * cos(angle) - (rotate_y - reference_y) * sin(angle) + reference_x;
-    rotated_point->y = (rotate_x - reference_x) * sin(angle) + (rotate_y - reference_y) * cos(angle) + reference_y;
+    geometry_rotation rotation;
+    geometry_rotation_init(&rotation, angle, reference_point);
+    geometry_point_rotateBy(rotated_point, &rotation);
+}
+
+/**
+*   Function to rotate point with precomputed rotation
+*   Gives the same result as geometry_point_rotateByAngle, but sine and cosine
+*   are not calculated again
+*   In params:
+*       geometry_point* rotated_point           point to be rotated
+*       geometry_rotation* rotation             rotation to apply
+*
+*   Out params/return:
+*       none (rotated_point object is changed)
+*/
+void geometry_point_rotateBy(geometry_point* rotated_point, geometry_rotation* rotation){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_ROTATE_BY);
+    if(rotated_point == NULL || rotation == NULL){
+        return;
+    }
+    geometry_real rotate_x = rotated_point->x - rotation->reference_x;
+    geometry_real rotate_y = rotated_point->y - rotation->reference_y;
+    rotated_point->x = rotate_x * rotation->cos_angle - rotate_y * rotation->sin_angle + rotation->reference_x;
+    rotated_point->y = rotate_x * rotation->sin_angle + rotate_y * rotation->cos_angle + rotation->reference_y;
     // For comments on these equations please refer to documentation
-    // TODO: add testcases!!
+}
+
+/**
+*   Function to apply given transform to point
+*   In params:
+*       geometry_point* point                   transformed point
+*       geometry_transform* transform           transform to apply
+*
+*   Out params/return:
+*       none (point object is changed)
+*/
+void geometry_point_applyTransform(geometry_point* point, geometry_transform* transform){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_APPLY_TRANSFORM);
+    if(point == NULL || transform == NULL){
+        return;
+    }
+    geometry_real x = point->x;
+    geometry_real y = point->y;
+    point->x = transform->a * x + transform->b * y + transform->tx;
+    point->y = transform->c * x + transform->d * y + transform->ty;
 }
 
 /**
@@ -153,17 +1202,16 @@ void geometry_point_rotateByAngle(geometry_point* rotated_point, double angle, g
 *       none
 *
 *   Return:
-*       double                              euclidean distance between two given points
+*       geometry_real                       euclidean distance between two given points
 */
-double geometry_point_calculateDistance(geometry_point* first_point, geometry_point* second_point){
+geometry_real geometry_point_calculateDistance(geometry_point* first_point, geometry_point* second_point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_CALCULATE_DISTANCE);
     if(first_point == NULL || second_point == NULL){
         return -1;
     }
-    double first_x = geometry_point_getX(first_point);
-    double first_y = geometry_point_getY(first_point);
-    double second_x = geometry_point_getX(second_point);
-    double second_y = geometry_point_getY(second_point);
-    return sqrt(pow((first_x - second_x), 2) + pow((first_y - second_y), 2));
+    geometry_real dx = first_point->x - second_point->x;
+    geometry_real dy = first_point->y - second_point->y;
+    return GEOMETRY_SQRT(dx * dx + dy * dy);
 }
 
 /**
@@ -172,70 +1220,129 @@ double geometry_point_calculateDistance(geometry_point* first_point, geometry_po
 *       geometry_point* point               point
 *       geometry_segment* segment           segment
 *
-*   Out params:
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if point lies on a given segment,
+*                                           false otherwise
+*/
+bool geometry_point_liesOnSegment(geometry_point* point, geometry_segment* segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_LIES_ON_SEGMENT);
+    if(point == NULL || segment == NULL){
+        return false;
+    }
+    if(point->x < GEOMETRY_FMIN(segment->start.x, segment->end.x) || point->x > GEOMETRY_FMAX(segment->start.x, segment->end.x)
+        || point->y < GEOMETRY_FMIN(segment->start.y, segment->end.y) || point->y > GEOMETRY_FMAX(segment->start.y, segment->end.y)){
+        return false;
+    }
+    return geometry_point_orientation(&segment->start, &segment->end, point) == 0;
+}
+
+/**
+*   Function to create new gemetry_segment object with given points.
+*   Those points don't need to be proper dynamic-allocated objects
+*   In params:
+*       geometry_point* start           starting point of segment
+*       geometry_point* end             ending point of segment
+*   
+*   Out params:
+*       none
+*   
+*   Return:
+*       geometry_segment*               pointer to created object
+*/
+geometry_segment* geometry_segment_new(geometry_point* start, geometry_point* end){
+    return geometry_segment_new_with(NULL, start, end);
+}
+
+/**
+*   Function to create new gemetry_segment object with given points inside given arena.
+*   Those points don't need to be proper dynamic-allocated objects.
+*   Created object is released with arena, it must not be passed to geometry_segment_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_point* start           starting point of segment
+*       geometry_point* end             ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_segment*               pointer to created object
+*/
+geometry_segment* geometry_segment_new_in(geometry_arena* arena, geometry_point* start, geometry_point* end){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_NEW_IN);
+    if(arena == NULL || start == NULL || end == NULL){
+        return NULL;
+    }
+    geometry_segment* new_segment = geometry_arena_allocate(arena, sizeof(*new_segment));
+    if(new_segment == NULL){
+        return NULL;
+    }
+    new_segment->start = *start;
+    new_segment->end = *end;
+    return new_segment;
+}
+
+/**
+*   Function to destroy given geometry_segment object
+*   In params:
+*       geometry_segment* segment       segment object that should be freed
+*
+*   Out params/return:
 *       none
-*
-*   Return:
-*       bool                                true if point lies on a given segment,
-*                                           false otherwise
 */
-bool geometry_point_liesOnSegment(geometry_point* point, geometry_segment* segment){
-    if(point == NULL || segment == NULL){
-        return false;
-    }
-    return (segment->end->x - segment->start->x)*(point->y - segment->start->y) == (segment->end->y - segment->start->y)*(point->x - segment->start->x);
+void geometry_segment_destroy(geometry_segment* segment){
+    geometry_segment_destroy_with(NULL, segment);
 }
 
 /**
-*   Function to create new gemetry_segment object with given points.
+*   Function to create new gemetry_segment object with given points with memory taken from given allocator
 *   Those points don't need to be proper dynamic-allocated objects
 *   In params:
-*       geometry_point* start           starting point of segment
-*       geometry_point* end             ending point of segment
-*   
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_point* start                   starting point of segment
+*       geometry_point* end                     ending point of segment
+*
 *   Out params:
 *       none
-*   
+*
 *   Return:
-*       geometry_segment*               pointer to created object
+*       geometry_segment*                       pointer to created object, NULL if error occured
 */
-geometry_segment* geometry_segment_new(geometry_point* start, geometry_point* end){
+geometry_segment* geometry_segment_new_with(const geometry_allocator* allocator, geometry_point* start, geometry_point* end){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_NEW);
     if(start == NULL || end == NULL){
         return NULL;
     }
-    geometry_point* new_start = geometry_point_new(start->x, start->y);
-    geometry_point* new_end = geometry_point_new(end->x, end->y);
-    geometry_segment* new_segment = malloc(sizeof(*new_segment));
-    if(new_start == NULL || new_end == NULL || new_segment == NULL){
-        free(new_segment);
-        free(new_start);
-        free(new_end);
+    geometry_segment* new_segment = geometry_allocator_allocate(allocator, sizeof(*new_segment));
+    if(new_segment == NULL){
         return NULL;
     }
-    new_segment->start = new_start;
-    new_segment->end = new_end;
+    new_segment->start = *start;
+    new_segment->end = *end;
     return new_segment;
 }
 
 /**
-*   Function to destroy given geometry_segment object
+*   Function to destroy given geometry_segment object created with given allocator
 *   In params:
-*       geometry_segment* segment       segment object that should be freed
+*       const geometry_allocator* allocator     allocator segment was created with, NULL for the one currently set
+*       geometry_segment* segment               segment object that should be freed
 *
 *   Out params/return:
 *       none
 */
-void geometry_segment_destroy(geometry_segment* segment){
-    if(segment == NULL){
-        return;
-    }
-    free(segment->end);
-    free(segment->start);
-    free(segment);
+void geometry_segment_destroy_with(const geometry_allocator* allocator, geometry_segment* segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_DESTROY);
+    geometry_allocator_free(allocator, segment);
 }
 
 /**
 *   Function to get end points of given geometry_segment object
+*   Returned points are stored inside the segment, they are valid until segment is destroyed
+*   and must not be passed to geometry_point_destroy
 *   In params:
 *       geometry_segment* segment       segment object to get ending points
 *       
@@ -250,8 +1357,8 @@ void geometry_segment_getPoints(geometry_segment* segment, geometry_point** star
     if(segment == NULL){
         return;
     }
-    *start = segment->start;
-    *end = segment->end;
+    *start = &segment->start;
+    *end = &segment->end;
 }
 
 /**
@@ -260,18 +1367,19 @@ void geometry_segment_getPoints(geometry_segment* segment, geometry_point** star
 *   i.e. unbouned/origin-bounded
 *   In parms:
 *       geometry_segment* segment       segment to be moved
-*       double vector_x                 x coordinate of vector
-*       double vector_y                 y coordinate of vector
+*       geometry_real vector_x          x coordinate of vector
+*       geometry_real vector_y          y coordinate of vector
 *       
 *   Out params/return:
 *       none (segment object is changed)
 */
-void geometry_segment_moveByVector(geometry_segment* segment, double vector_x, double vector_y){
+void geometry_segment_moveByVector(geometry_segment* segment, geometry_real vector_x, geometry_real vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_MOVE_BY_VECTOR);
     if(segment == NULL){
         return;
     }
-    geometry_point_moveByVector(segment->start, vector_x, vector_y);
-    geometry_point_moveByVector(segment->end, vector_x, vector_y);
+    geometry_point_moveByVector(&segment->start, vector_x, vector_y);
+    geometry_point_moveByVector(&segment->end, vector_x, vector_y);
 }
 
 /**
@@ -280,22 +1388,59 @@ void geometry_segment_moveByVector(geometry_segment* segment, double vector_x, d
 *   calculated counterclockwise
 *   In params:
 *       geometry_segment* rotated_segment       segment to be rotated
-*       double angle                            angle to rotate through in radians calculated counterclockwise
+*       geometry_real angle                     angle to rotate through in radians calculated counterclockwise
 *       geometry_point* reference_point         point around which rotations will be calculated
 *
 *   Out params/return:
 *       none (roated_segment object is changed)       
 */
-void geometry_segment_rotateByAngle(geometry_segment* rotated_segment, double angle, geometry_point* reference_point){
+void geometry_segment_rotateByAngle(geometry_segment* rotated_segment, geometry_real angle, geometry_point* reference_point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_ROTATE_BY_ANGLE);
     if(rotated_segment == NULL || reference_point == NULL){
         return;
     }
-    geometry_point* start = rotated_segment->start;
-    geometry_point* end = rotated_segment->end;
-    geometry_point_rotateByAngle(start, angle, reference_point);
-    geometry_point_rotateByAngle(end, angle, reference_point);
-    // TODO: add testcases!!
-}   
+    geometry_rotation rotation;
+    geometry_rotation_init(&rotation, angle, reference_point);
+    geometry_segment_rotateBy(rotated_segment, &rotation);
+}
+
+/**
+*   Function to rotate segment with precomputed rotation
+*   Gives the same result as geometry_segment_rotateByAngle, but sine and cosine
+*   are not calculated again
+*   In params:
+*       geometry_segment* rotated_segment       segment to be rotated
+*       geometry_rotation* rotation             rotation to apply
+*
+*   Out params/return:
+*       none (rotated_segment object is changed)
+*/
+void geometry_segment_rotateBy(geometry_segment* rotated_segment, geometry_rotation* rotation){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_ROTATE_BY);
+    if(rotated_segment == NULL || rotation == NULL){
+        return;
+    }
+    geometry_point_rotateBy(&rotated_segment->start, rotation);
+    geometry_point_rotateBy(&rotated_segment->end, rotation);
+}
+
+/**
+*   Function to apply given transform to segment
+*   In params:
+*       geometry_segment* segment               transformed segment
+*       geometry_transform* transform           transform to apply
+*
+*   Out params/return:
+*       none (segment object is changed)
+*/
+void geometry_segment_applyTransform(geometry_segment* segment, geometry_transform* transform){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_APPLY_TRANSFORM);
+    if(segment == NULL || transform == NULL){
+        return;
+    }
+    geometry_point_applyTransform(&segment->start, transform);
+    geometry_point_applyTransform(&segment->end, transform);
+}
 
 /**
 *   Function to calculate length of given segment
@@ -306,9 +1451,10 @@ void geometry_segment_rotateByAngle(geometry_segment* rotated_segment, double an
 *       none
 *
 *   Return:
-*       double                          length of given segment
+*       geometry_real                   length of given segment
 */
-double geometry_segment_calculateLength(geometry_segment* segment){
+geometry_real geometry_segment_calculateLength(geometry_segment* segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_CALCULATE_LENGTH);
     if(segment == NULL){
         return -1;
     }
@@ -331,13 +1477,13 @@ double geometry_segment_calculateLength(geometry_segment* segment){
 *       bool                                    true if given segments are parallel, false otherwise
 */
 bool geometry_segment_areParallel(geometry_segment* first_segment, geometry_segment* second_segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_ARE_PARALLEL);
     if(first_segment == NULL || second_segment== NULL){
         return false;
     }
-    return (first_segment->end->x - first_segment->start->x)*(first_segment->start->y - first_segment->end->y) ==
-                (first_segment->end->y - first_segment->start->y)*(second_segment->start->x - second_segment->end->x);
     // For comments on theese equations please refer to documentation
-    // TODO: add testcases!!
+    return geometry_predicates_crossSign(first_segment->start.x, first_segment->start.y, first_segment->end.x, first_segment->end.y,
+                                            second_segment->start.x, second_segment->start.y, second_segment->end.x, second_segment->end.y) == 0;
 }
 
 /**
@@ -353,13 +1499,13 @@ bool geometry_segment_areParallel(geometry_segment* first_segment, geometry_segm
 *       bool                                    true if given segments are perpendicular, false otherwise
 */
 bool geometry_segment_arePerpendicular(geometry_segment* first_segment, geometry_segment* second_segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_ARE_PERPENDICULAR);
     if(first_segment == NULL || second_segment== NULL){
         return false;
     }
-    return (first_segment->end->x - first_segment->start->x)*(second_segment->start->x - second_segment->end->x) == 
-                -(first_segment->end->y - first_segment->start->y)*(second_segment->start->y - second_segment->end->y);
     // For comments on theese equations please refer to documentation
-    // TODO: add testcases!!
+    return geometry_predicates_dotSign(first_segment->start.x, first_segment->start.y, first_segment->end.x, first_segment->end.y,
+                                            second_segment->start.x, second_segment->start.y, second_segment->end.x, second_segment->end.y) == 0;
 }
 
 /**
@@ -373,11 +1519,50 @@ bool geometry_segment_arePerpendicular(geometry_segment* first_segment, geometry
 *
 *   Return:
 *       geometry_point*                         object of geometry_point structure(class) which is interesection
-*                                               of given segments, if segments are parallel, then NULL
+*                                               of given segments, if segments are parallel or don't intersect, then NULL.
+*                                               If segments only touch, touching end point is returned
 */
 geometry_point* geometry_segment_calculateIntersection(geometry_segment* first_segment, geometry_segment* second_segment){
-    // TODO
-    return NULL;
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_CALCULATE_INTERSECTION);
+    if(first_segment == NULL || second_segment == NULL){
+        return NULL;
+    }
+    geometry_point* first_start = &first_segment->start;
+    geometry_point* first_end = &first_segment->end;
+    geometry_point* second_start = &second_segment->start;
+    geometry_point* second_end = &second_segment->end;
+    int second_start_side = geometry_point_orientation(first_start, first_end, second_start);
+    int second_end_side = geometry_point_orientation(first_start, first_end, second_end);
+    int first_start_side = geometry_point_orientation(second_start, second_end, first_start);
+    int first_end_side = geometry_point_orientation(second_start, second_end, first_end);
+    if(second_start_side == 0 && second_end_side == 0){
+        // colinear segments are parallel
+        return NULL;
+    }
+    // segments intersect only if ends of each one lie on different sides of the other
+    if(second_start_side * second_end_side > 0 || first_start_side * first_end_side > 0){
+        return NULL;
+    }
+    if(second_start_side == 0){
+        return geometry_point_new(second_start->x, second_start->y);
+    }
+    if(second_end_side == 0){
+        return geometry_point_new(second_end->x, second_end->y);
+    }
+    if(first_start_side == 0){
+        return geometry_point_new(first_start->x, first_start->y);
+    }
+    if(first_end_side == 0){
+        return geometry_point_new(first_end->x, first_end->y);
+    }
+    geometry_real first_x = first_end->x - first_start->x;
+    geometry_real first_y = first_end->y - first_start->y;
+    geometry_real second_x = second_end->x - second_start->x;
+    geometry_real second_y = second_end->y - second_start->y;
+    geometry_real denominator = first_x * second_y - first_y * second_x;
+    geometry_real parameter = ((second_start->x - first_start->x) * second_y - (second_start->y - first_start->y) * second_x) / denominator;
+    return geometry_point_new(first_start->x + parameter * first_x, first_start->y + parameter * first_y);
+    // For comments on theese equations please refer to documentation
 }
 
 /**
@@ -395,24 +1580,40 @@ geometry_point* geometry_segment_calculateIntersection(geometry_segment* first_s
 *       geometry_triangle*               pointer to created object
 */
 geometry_triangle* geometry_triangle_new(geometry_point* first, geometry_point* second, geometry_point* third, bool is_right){
-    if(first == NULL || second == NULL || third == NULL){
+    return geometry_triangle_new_with(NULL, first, second, third, is_right);
+}
+
+/**
+*   Function to create new gemetry_triangle object with given points inside given arena.
+*   Those points don't need to be proper dynamic-allocated objects.
+*   Created object is released with arena, it must not be passed to geometry_triangle_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_point* first           first point of triangle
+*       geometry_point* second          second point of triangle
+*       geometry_point* third           third point of triangle
+*       bool is_right                   true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*               pointer to created object
+*/
+geometry_triangle* geometry_triangle_new_in(geometry_arena* arena, geometry_point* first, geometry_point* second, geometry_point* third, bool is_right){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_NEW_IN);
+    if(arena == NULL || first == NULL || second == NULL || third == NULL){
         return NULL;
     }
-    geometry_point* new_first = geometry_point_new(first->x, first->y);
-    geometry_point* new_second = geometry_point_new(second->x, second->y);
-    geometry_point* new_third = geometry_point_new(third->x, third->y);
-    geometry_triangle* new_triangle = malloc(sizeof(*new_triangle));
-    if(new_first == NULL || new_second == NULL || new_third == NULL || new_triangle == NULL){
-        free(new_first);
-        free(new_second);
-        free(new_third);
-        free(new_triangle);
+    geometry_triangle* new_triangle = geometry_arena_allocate(arena, sizeof(*new_triangle));
+    if(new_triangle == NULL){
         return NULL;
     }
-    new_triangle->first = new_first;
-    new_triangle->second = new_second;
-    new_triangle->third = new_third;
+    new_triangle->first = *first;
+    new_triangle->second = *second;
+    new_triangle->third = *third;
     new_triangle->is_right = is_right;
+    new_triangle->cache_flags = 0;
     return new_triangle;
 }
 
@@ -425,17 +1626,100 @@ geometry_triangle* geometry_triangle_new(geometry_point* first, geometry_point*
 *       none
 */
 void geometry_triangle_destroy(geometry_triangle* triangle){
-    if(triangle == NULL){
-        return;
+    geometry_triangle_destroy_with(NULL, triangle);
+}
+
+/**
+*   Function to create new gemetry_triangle object with given points with memory taken from given allocator
+*   Those points don't need to be proper dynamic-allocated objects
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_point* first                   first point of triangle
+*       geometry_point* second                  second point of triangle
+*       geometry_point* third                   third point of triangle
+*       bool is_right                           true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*                      pointer to created object, NULL if error occured
+*/
+geometry_triangle* geometry_triangle_new_with(const geometry_allocator* allocator, geometry_point* first, geometry_point* second, geometry_point* third, bool is_right){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_NEW);
+    if(first == NULL || second == NULL || third == NULL){
+        return NULL;
+    }
+    geometry_triangle* new_triangle = geometry_allocator_allocate(allocator, sizeof(*new_triangle));
+    if(new_triangle == NULL){
+        return NULL;
+    }
+    new_triangle->first = *first;
+    new_triangle->second = *second;
+    new_triangle->third = *third;
+    new_triangle->is_right = is_right;
+    new_triangle->cache_flags = 0;
+    return new_triangle;
+}
+
+/**
+*   Function to create new geometry_triangle object with points of given coordinates
+*   Object is taken from arena if it is given (it is released with arena then),
+*   otherwise from given allocator (it has to be destroyed with geometry_triangle_destroy_with)
+*   In params:
+*       geometry_arena* arena                   arena to allocate object from, NULL to use allocator
+*       const geometry_allocator* allocator     allocator used when arena is NULL, NULL for the one currently set
+*       const geometry_real* xs                 x coordinates of first, second and third point, array of 3 elements
+*       const geometry_real* ys                 y coordinates of first, second and third point, array of 3 elements
+*       bool is_right                           true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*                      pointer to created object, NULL if error occured
+*/
+geometry_triangle* geometry_triangle_newFromCoordinates(geometry_arena* arena, const geometry_allocator* allocator, const geometry_real* xs, const geometry_real* ys, bool is_right){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_NEW_FROM_COORDINATES);
+    if(xs == NULL || ys == NULL){
+        return NULL;
+    }
+    geometry_triangle* new_triangle = arena != NULL ? geometry_arena_allocate(arena, sizeof(*new_triangle)) : geometry_allocator_allocate(allocator, sizeof(*new_triangle));
+    if(new_triangle == NULL){
+        return NULL;
     }
-    free(triangle->first);
-    free(triangle->second);
-    free(triangle->third);
-    free(triangle);
+    new_triangle->first.x = xs[0];
+    new_triangle->first.y = ys[0];
+    new_triangle->second.x = xs[1];
+    new_triangle->second.y = ys[1];
+    new_triangle->third.x = xs[2];
+    new_triangle->third.y = ys[2];
+    new_triangle->is_right = is_right;
+    new_triangle->cache_flags = 0;
+    return new_triangle;
+}
+
+/**
+*   Function to destroy given geometry_triangle object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator triangle was created with, NULL for the one currently set
+*       geometry_triangle* triangle             triangle object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_triangle_destroy_with(const geometry_allocator* allocator, geometry_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_DESTROY);
+    geometry_allocator_free(allocator, triangle);
 }
 
 /**
 *   Function to get points of given geometry_triangle object
+*   Returned points are stored inside the triangle, they are valid until triangle is destroyed
+*   and must not be passed to geometry_point_destroy. Points may be changed through them,
+*   so values cached inside triangle are dropped (triangle is changed, so it mustn't be used
+*   by other threads meanwhile - geometry_triangle_getCoordinates only reads it). If cached
+*   values are used before points are changed, geometry_triangle_invalidateCache has to be called
 *   In params:
 *       geometry_triangle* triangle       triangle object to get ending points
 *       
@@ -451,9 +1735,35 @@ void geometry_triangle_getPoints(geometry_triangle* triangle, geometry_point** f
     if(triangle == NULL){
         return;
     }
-    *first = triangle->first;
-    *second = triangle->second;
-    *third = triangle->third;
+    triangle->cache_flags = 0;
+    *first = &triangle->first;
+    *second = &triangle->second;
+    *third = &triangle->third;
+}
+
+/**
+*   Function to get coordinates of points of given triangle without exposing the points
+*   Triangle is only read, so cached values stay valid
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       geometry_real* xs               x coordinates of first, second and third point, array of 3 elements
+*       geometry_real* ys               y coordinates of first, second and third point, array of 3 elements
+*
+*   Return:
+*       none
+*/
+void geometry_triangle_getCoordinates(geometry_triangle* triangle, geometry_real* xs, geometry_real* ys){
+    if(triangle == NULL){
+        return;
+    }
+    xs[0] = triangle->first.x;
+    ys[0] = triangle->first.y;
+    xs[1] = triangle->second.x;
+    ys[1] = triangle->second.y;
+    xs[2] = triangle->third.x;
+    ys[2] = triangle->third.y;
 }
 
 /**
@@ -474,25 +1784,153 @@ bool geometry_triangle_getIsRight(geometry_triangle* triangle){
     return false;
 }
 
+/**
+*   Function to get axis-aligned bounding box of given triangle
+*   Value is cached inside triangle, so repeated calls are cheap
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       geometry_real* min_x            smallest x coordinate of triangle's points
+*       geometry_real* min_y            smallest y coordinate of triangle's points
+*       geometry_real* max_x            largest x coordinate of triangle's points
+*       geometry_real* max_y            largest y coordinate of triangle's points
+*
+*   Return:
+*       none
+*/
+void geometry_triangle_getBoundingBox(geometry_triangle* triangle, geometry_real* min_x, geometry_real* min_y, geometry_real* max_x, geometry_real* max_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_GET_BOUNDING_BOX);
+    if(triangle == NULL){
+        return;
+    }
+    geometry_triangle_updateBounds(triangle);
+    *min_x = triangle->min_x;
+    *min_y = triangle->min_y;
+    *max_x = triangle->max_x;
+    *max_y = triangle->max_y;
+}
+
+/**
+*   Function to get centroid of given triangle
+*   Value is cached inside triangle, so repeated calls are cheap
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       geometry_real* x                x coordinate of centroid
+*       geometry_real* y                y coordinate of centroid
+*
+*   Return:
+*       none
+*/
+void geometry_triangle_getCentroid(geometry_triangle* triangle, geometry_real* x, geometry_real* y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_GET_CENTROID);
+    if(triangle == NULL){
+        return;
+    }
+    geometry_triangle_updateBounds(triangle);
+    *x = triangle->centroid_x;
+    *y = triangle->centroid_y;
+}
+
+/**
+*   Function to get vertex of right angle of given triangle
+*   User should provide a right-angled triangle. Vertex may be changed through returned
+*   pointer, so values cached inside triangle are dropped as in geometry_triangle_getPoints
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point*                 point stored inside triangle where its right angle is,
+*                                       NULL if given triangle is not right-angled
+*/
+geometry_point* geometry_triangle_getRightAngleVertex(geometry_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_GET_RIGHT_ANGLE_VERTEX);
+    if(triangle == NULL || !triangle->is_right){
+        return NULL;
+    }
+    geometry_point* vertices[3] = {&triangle->first, &triangle->second, &triangle->third};
+    geometry_point* vertex = vertices[geometry_triangle_updateShape(triangle)->right_vertex];
+    triangle->cache_flags = 0;
+    return vertex;
+}
+
+/**
+*   Function to drop all values cached inside given triangle
+*   Must be called after triangle's points were changed directly through pointers
+*   got from geometry_triangle_getPoints, if cached values were used since getting them
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params/return:
+*       none
+*/
+void geometry_triangle_invalidateCache(geometry_triangle* triangle){
+    if(triangle == NULL){
+        return;
+    }
+    triangle->cache_flags = 0;
+}
+
+/**
+*   Function to calculate all values cached inside given triangle at once
+*   Afterwards functions using cache (e.g. geometry_triangle_areDisjoint) only read
+*   triangle, so they may be called for it from many threads at the same time,
+*   as long as triangle isn't changed meanwhile
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params/return:
+*       none
+*/
+void geometry_triangle_fillCache(geometry_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_FILL_CACHE);
+    if(triangle == NULL){
+        return;
+    }
+    geometry_triangle_updateAxes(geometry_triangle_updateBounds(geometry_triangle_updateShape(triangle)));
+}
+
 /**
 *   Function to move triangle by vector
 *   User is expected to provide vector in normalized form;
 *   i.e. unbouned or origin-bounded
 *   In parms:
 *       geometry_triangle* triangle     triangle to be moved
-*       double vector_x                 x coordinate of vector
-*       double vector_y                 y coordinate of vector
+*       geometry_real vector_x          x coordinate of vector
+*       geometry_real vector_y          y coordinate of vector
 *       
 *   Out params/return:
 *       none (triangle object is changed)
 */
-void geometry_triangle_moveByVector(geometry_triangle* triangle, double vector_x, double vector_y){
+void geometry_triangle_moveByVector(geometry_triangle* triangle, geometry_real vector_x, geometry_real vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_MOVE_BY_VECTOR);
     if(triangle == NULL){
         return;
     }
-    geometry_point_moveByVector(triangle->first, vector_x, vector_y);
-    geometry_point_moveByVector(triangle->second, vector_x, vector_y);
-    geometry_point_moveByVector(triangle->third, vector_x, vector_y);
+    geometry_point_moveByVector(&triangle->first, vector_x, vector_y);
+    geometry_point_moveByVector(&triangle->second, vector_x, vector_y);
+    geometry_point_moveByVector(&triangle->third, vector_x, vector_y);
+    // shape doesn't change, bounds are just moved along with the triangle
+    if(triangle->cache_flags & GEOMETRY_TRIANGLE_CACHE_BOUNDS){
+        triangle->min_x += vector_x;
+        triangle->min_y += vector_y;
+        triangle->max_x += vector_x;
+        triangle->max_y += vector_y;
+        triangle->centroid_x += vector_x;
+        triangle->centroid_y += vector_y;
+    }
+    if(triangle->cache_flags & GEOMETRY_TRIANGLE_CACHE_AXES){
+        for(int i = 0; i < 3; i++){
+            geometry_real shift = triangle->normal_x[i] * vector_x + triangle->normal_y[i] * vector_y;
+            triangle->axis_min[i] += shift;
+            triangle->axis_max[i] += shift;
+        }
+    }
 }
 
 /**
@@ -501,23 +1939,64 @@ void geometry_triangle_moveByVector(geometry_triangle* triangle, double vector_x
 *   calculated counterclockwise
 *   In params:
 *       geometry_triangle* rotated_triangle         triangle to be rotated
-*       double angle                                angle to rotate through in radians calculated counterclockwise
+*       geometry_real angle                         angle to rotate through in radians calculated counterclockwise
 *       geometry_point* reference_point             point around which rotations will be calculated
 *
 *   Out params/return:
 *       none (roated_triangle object is changed)       
 */
-void geometry_triangle_rotateByAngle(geometry_triangle* rotated_triangle, double angle, geometry_point* reference_point){
+void geometry_triangle_rotateByAngle(geometry_triangle* rotated_triangle, geometry_real angle, geometry_point* reference_point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_ROTATE_BY_ANGLE);
     if(rotated_triangle == NULL || reference_point == NULL){
         return;
     }
-    geometry_point* first = rotated_triangle->first;
-    geometry_point* second = rotated_triangle->second;
-    geometry_point* third = rotated_triangle->third;
-    geometry_point_rotateByAngle(first, angle, reference_point);
-    geometry_point_rotateByAngle(second, angle, reference_point);
-    geometry_point_rotateByAngle(third, angle, reference_point);
-    // TODO: add testcases!!
+    geometry_rotation rotation;
+    geometry_rotation_init(&rotation, angle, reference_point);
+    geometry_triangle_rotateBy(rotated_triangle, &rotation);
+}
+
+/**
+*   Function to rotate triangle with precomputed rotation
+*   Gives the same result as geometry_triangle_rotateByAngle, but sine and cosine
+*   are not calculated again
+*   In params:
+*       geometry_triangle* rotated_triangle     triangle to be rotated
+*       geometry_rotation* rotation             rotation to apply
+*
+*   Out params/return:
+*       none (rotated_triangle object is changed)
+*/
+void geometry_triangle_rotateBy(geometry_triangle* rotated_triangle, geometry_rotation* rotation){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_ROTATE_BY);
+    if(rotated_triangle == NULL || rotation == NULL){
+        return;
+    }
+    geometry_point_rotateBy(&rotated_triangle->first, rotation);
+    geometry_point_rotateBy(&rotated_triangle->second, rotation);
+    geometry_point_rotateBy(&rotated_triangle->third, rotation);
+    // rotation is a rigid motion, only bounds and normals have to be recalculated
+    rotated_triangle->cache_flags &= ~(GEOMETRY_TRIANGLE_CACHE_BOUNDS | GEOMETRY_TRIANGLE_CACHE_AXES);
+}
+
+/**
+*   Function to apply given transform to triangle
+*   In params:
+*       geometry_triangle* triangle             transformed triangle
+*       geometry_transform* transform           transform to apply
+*
+*   Out params/return:
+*       none (triangle object is changed)
+*/
+void geometry_triangle_applyTransform(geometry_triangle* triangle, geometry_transform* transform){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_APPLY_TRANSFORM);
+    if(triangle == NULL || transform == NULL){
+        return;
+    }
+    geometry_point_applyTransform(&triangle->first, transform);
+    geometry_point_applyTransform(&triangle->second, transform);
+    geometry_point_applyTransform(&triangle->third, transform);
+    // affine transform may scale or shear, nothing cached stays valid
+    triangle->cache_flags = 0;
 }
 
 /**
@@ -529,21 +2008,15 @@ void geometry_triangle_rotateByAngle(geometry_triangle* rotated_triangle, double
 *       none
 *
 *   Return:
-*       double                          calculated perimeter of given triangle,
+*       geometry_real                   calculated perimeter of given triangle,
 *                                       -1 if error(s) occured
 */
-double geometry_triangle_calculatePerimeter(geometry_triangle* triangle){
+geometry_real geometry_triangle_calculatePerimeter(geometry_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_CALCULATE_PERIMETER);
     if(triangle == NULL){
         return -1;
     }
-    double length_1 = geometry_point_calculateDistance(triangle->first, triangle->second);
-    double length_2 = geometry_point_calculateDistance(triangle->first, triangle->third);
-    double length_3 = geometry_point_calculateDistance(triangle->second, triangle->third);
-    if(length_1 < 0 || length_2 < 0 || length_3 < 0){
-        return -1;
-    }
-    return length_1 + length_2 + length_3;
-    // TODO: add testcases!!
+    return geometry_triangle_updateShape(triangle)->perimeter;
 }
 
 /**
@@ -555,39 +2028,22 @@ double geometry_triangle_calculatePerimeter(geometry_triangle* triangle){
 *       none
 *
 *   Return:
-*       double                          calculated area of given triangle,
+*       geometry_real                   calculated area of given triangle,
 *                                       -1 if error(s) occured
 */
-double geometry_triangle_calculateArea(geometry_triangle* triangle){
+geometry_real geometry_triangle_calculateArea(geometry_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_CALCULATE_AREA);
     if(triangle == NULL){
         return -1;
     }
-    if(triangle->is_right){
-        geometry_segment* side_one = geometry_segment_new(triangle->first, triangle->second);
-        geometry_segment* side_two = geometry_segment_new(triangle->first, triangle->third);
-        if(geometry_segment_arePerpendicular(side_one, side_two)){
-            return geometry_segment_calculateLength(side_one) * geometry_segment_calculateLength(side_two) * 0.5;
-        }
-        geometry_segment* side_three = geometry_segment_new(triangle->second, triangle->third);
-        if(geometry_segment_arePerpendicular(side_one, side_three)){
-            return geometry_segment_calculateLength(side_one) * geometry_segment_calculateLength(side_three) * 0.5;
-        }
-        return geometry_segment_calculateLength(side_two) * geometry_segment_calculateLength(side_three) * 0.5;
-    }
-    else{
-        double side_one_length = geometry_point_calculateDistance(triangle->first, triangle->second);
-        double side_two_length = geometry_point_calculateDistance(triangle->first, triangle->second);
-        double side_three_length = geometry_point_calculateDistance(triangle->second, triangle->third);
-        double half_perimeter = (side_one_length + side_two_length + side_three_length) / 2;
-        return sqrt(half_perimeter * (half_perimeter - side_one_length) * (half_perimeter - side_two_length) * (half_perimeter - side_three_length));
-    }
-    return -1;
-    // For comments on theese equations please refer to documentation
-    // TODO: add testcases!!
+    return geometry_triangle_updateShape(triangle)->area;
 }
 
 /**
 *   Function to determine if two given triangles intersect
+*   Separating axis theorem is used - triangles are disjoint if their projections
+*   don't overlap on one of the edge normals. Triangles touching with sides or
+*   vertices intersect.
 *   In params:
 *       geometry_triangle* first_triangle       first triangle
 *       geometry_triangle* second_triangle      second triangle
@@ -600,8 +2056,98 @@ double geometry_triangle_calculateArea(geometry_triangle* triangle){
 *                                               false if they intersect
 */
 bool geometry_triangle_areDisjoint(geometry_triangle* first_triangle, geometry_triangle* second_triangle){
-    // TODO
-    return false;
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_ARE_DISJOINT);
+    if(first_triangle == NULL || second_triangle == NULL){
+        return false;
+    }
+    geometry_triangle_updateAxes(geometry_triangle_updateBounds(first_triangle));
+    geometry_triangle_updateAxes(geometry_triangle_updateBounds(second_triangle));
+    return geometry_triangle_separated(first_triangle, second_triangle);
+}
+
+/**
+*   Function to determine which of given triangles intersect one triangle
+*   Values cached in triangle are reused, so it is faster than calling
+*   geometry_triangle_areDisjoint for every pair
+*   In params:
+*       geometry_triangle* triangle             triangle tested against others
+*       geometry_triangle** triangles           array of triangles
+*       size_t count                            number of triangles in array
+*
+*   Out params:
+*       bool* disjoint                          array of count results, disjoint[i] is true
+*                                               if triangle and triangles[i] are disjoint
+*
+*   Return:
+*       size_t                                  number of triangles intersecting given one,
+*                                               (size_t)-1 if error occured
+*/
+size_t geometry_triangle_areDisjointBatch(geometry_triangle* triangle, geometry_triangle** triangles, size_t count, bool* disjoint){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_ARE_DISJOINT_BATCH);
+    if(triangle == NULL || (triangles == NULL && count > 0) || (disjoint == NULL && count > 0)){
+        return (size_t)-1;
+    }
+    for(size_t i = 0; i < count; i++){
+        if(triangles[i] == NULL){
+            return (size_t)-1;
+        }
+    }
+    geometry_triangle_updateAxes(geometry_triangle_updateBounds(triangle));
+    size_t intersecting = 0;
+    for(size_t i = 0; i < count; i++){
+        geometry_triangle* other = geometry_triangle_updateAxes(geometry_triangle_updateBounds(triangles[i]));
+        disjoint[i] = geometry_triangle_separated(triangle, other);
+        intersecting += !disjoint[i];
+    }
+    return intersecting;
+}
+
+/**
+*   Function to determine which pairs of triangles from two arrays intersect
+*   Cache of every triangle is filled once, then all pairs are tested
+*   In params:
+*       geometry_triangle** first_triangles     first array of triangles
+*       size_t first_count                      number of triangles in first array
+*       geometry_triangle** second_triangles    second array of triangles
+*       size_t second_count                     number of triangles in second array
+*
+*   Out params:
+*       bool* disjoint                          matrix of first_count * second_count results stored by rows,
+*                                               disjoint[i * second_count + j] is true if
+*                                               first_triangles[i] and second_triangles[j] are disjoint
+*
+*   Return:
+*       size_t                                  number of intersecting pairs,
+*                                               (size_t)-1 if error occured
+*/
+size_t geometry_triangle_areDisjointMatrix(geometry_triangle** first_triangles, size_t first_count, geometry_triangle** second_triangles, size_t second_count, bool* disjoint){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_ARE_DISJOINT_MATRIX);
+    if((first_triangles == NULL && first_count > 0) || (second_triangles == NULL && second_count > 0)
+        || (disjoint == NULL && first_count > 0 && second_count > 0)){
+        return (size_t)-1;
+    }
+    for(size_t i = 0; i < first_count; i++){
+        if(first_triangles[i] == NULL){
+            return (size_t)-1;
+        }
+        geometry_triangle_updateAxes(geometry_triangle_updateBounds(first_triangles[i]));
+    }
+    for(size_t j = 0; j < second_count; j++){
+        if(second_triangles[j] == NULL){
+            return (size_t)-1;
+        }
+        geometry_triangle_updateAxes(geometry_triangle_updateBounds(second_triangles[j]));
+    }
+    size_t intersecting = 0;
+    for(size_t i = 0; i < first_count; i++){
+        geometry_triangle* first = first_triangles[i];
+        bool* row = disjoint + i * second_count;
+        for(size_t j = 0; j < second_count; j++){
+            row[j] = geometry_triangle_separated(first, second_triangles[j]);
+            intersecting += !row[j];
+        }
+    }
+    return intersecting;
 }
 
 /**
@@ -614,25 +2160,16 @@ bool geometry_triangle_areDisjoint(geometry_triangle* first_triangle, geometry_t
 *       none
 *
 *   Return:
-*       double                          calculated hypotenuse of given triangle,
+*       geometry_real                   calculated hypotenuse of given triangle,
 *                                       -1 if given triangle is not right-angled
 */
-double geometry_triangle_calculateHypotenuse(geometry_triangle* triangle){
+geometry_real geometry_triangle_calculateHypotenuse(geometry_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_CALCULATE_HYPOTENUSE);
     if(triangle == NULL){
         return -1;
     }
     if(!triangle->is_right){
         return -1;
     }
-    geometry_segment* side_one = geometry_segment_new(triangle->first, triangle->second);
-    geometry_segment* side_two = geometry_segment_new(triangle->first, triangle->third);
-    if(geometry_segment_arePerpendicular(side_one, side_two)){
-        return sqrt(pow(geometry_segment_calculateLength(side_one), 2) + pow(geometry_segment_calculateLength(side_two), 2));
-    }
-    geometry_segment* side_three = geometry_segment_new(triangle->second, triangle->third);
-    if(geometry_segment_arePerpendicular(side_one, side_three)){
-        return sqrt(pow(geometry_segment_calculateLength(side_one), 2) + pow(geometry_segment_calculateLength(side_three), 2));
-    }
-    return sqrt(pow(geometry_segment_calculateLength(side_two), 2) + pow(geometry_segment_calculateLength(side_three), 2));
-    // TODO: add testcases!!
+    return geometry_triangle_updateShape(triangle)->hypotenuse;
 }
@@ -2,6 +2,34 @@
 #define GEOMETRY
 
 #include <stdbool.h>
+#include <stddef.h>
+
+// Type of coordinates, angles and results of all functions below - double by default,
+// float when compiled with GEOMETRY_REAL_FLOAT defined. Float halves size of every
+// object and fits twice as many coordinates in one vector register, at cost of precision.
+#ifdef GEOMETRY_REAL_FLOAT
+typedef float geometry_real;
+#else
+typedef double geometry_real;
+#endif
+
+// Math functions of the same precision as geometry_real (from math.h, which has to be
+// included where they are used), so float mode never computes in double.
+#ifdef GEOMETRY_REAL_FLOAT
+#define GEOMETRY_SQRT sqrtf
+#define GEOMETRY_SIN sinf
+#define GEOMETRY_COS cosf
+#define GEOMETRY_FABS fabsf
+#define GEOMETRY_FMIN fminf
+#define GEOMETRY_FMAX fmaxf
+#else
+#define GEOMETRY_SQRT sqrt
+#define GEOMETRY_SIN sin
+#define GEOMETRY_COS cos
+#define GEOMETRY_FABS fabs
+#define GEOMETRY_FMIN fmin
+#define GEOMETRY_FMAX fmax
+#endif
 
 // class objects-structures forward-declarations
 typedef struct geometry_point geometry_point;
@@ -13,6 +41,381 @@ typedef struct geometry_segment geometry_segment;
 // by field is_right. Using void* is overall ugly
 // and passing another argument in functions is bug-prone.
 typedef struct geometry_triangle geometry_triangle;
+// Bump allocator for short-lived objects, e.g. whole frame's geometry
+// can be created in one arena and then released with one call
+typedef struct geometry_arena geometry_arena;
+// Rotation through an angle around a point with sine and cosine
+// calculated once, so it can be applied to many shapes cheaply
+typedef struct geometry_rotation geometry_rotation;
+// Affine transform (2x3 matrix) collecting any chain of moves and rotations,
+// so it can be applied to a shape in a single pass over its vertices
+typedef struct geometry_transform geometry_transform;
+
+// Functions used by library to get and release memory, user_data is pointer given
+// together with them. Returned memory must be aligned for any object type (as from malloc),
+// allocation function returns NULL if memory can't be given
+typedef void* (*geometry_allocate_function)(size_t size, void* user_data);
+typedef void (*geometry_free_function)(void* pointer, void* user_data);
+
+// Allocation functions with their data, can be passed to _with functions
+// to take single objects from other memory (e.g. pool of one thread) than the rest
+typedef struct geometry_allocator {
+    geometry_allocate_function allocate;
+    geometry_free_function free;
+    void* user_data;
+} geometry_allocator;
+
+/*##################################################
+ GEOMETRY_ALLOCATOR functions (methods) declarations
+###################################################*/
+
+// Every object is created with allocator set by geometry_set_allocator (malloc and free by default),
+// unless other one is given to its _with constructor. Objects must be destroyed with allocator
+// they were created with - objects holding memory of their own (arenas, buffers, trees, ...)
+// remember it, single shapes, rotations and transforms don't, so they need
+// matching _destroy_with call. Memory used only during single call is taken
+// from allocator of object the call works on, or from the set one.
+// Batch functions of geometry_pool call allocator from many threads at once.
+
+/**
+*   Function to set allocator used by all following allocations of library
+*   It is not synchronized with other calls, so it should be called
+*   before objects are created, while no other thread uses library
+*   In params:
+*       geometry_allocate_function allocate     allocation function, NULL (together with free) for malloc
+*       geometry_free_function free             function releasing memory from allocate, NULL (together with allocate) for free
+*       void* user_data                         pointer passed to every call of allocate and free
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true on success, false if only one of functions is NULL
+*/
+bool geometry_set_allocator(geometry_allocate_function allocate, geometry_free_function free, void* user_data);
+
+/**
+*   Function to get allocator currently set
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_allocator          copy of allocator set by geometry_set_allocator
+*/
+geometry_allocator geometry_get_allocator(void);
+
+/**
+*   Function to allocate memory from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t size                             number of bytes to allocate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*                                   pointer to allocated memory, NULL if error occured
+*/
+void* geometry_allocator_allocate(const geometry_allocator* allocator, size_t size);
+
+/**
+*   Function to allocate zeroed array from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t count                            number of elements
+*       size_t size                             size of single element in bytes
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*                                   pointer to allocated memory, NULL if error occured
+*/
+void* geometry_allocator_allocateZeroed(const geometry_allocator* allocator, size_t count, size_t size);
+
+/**
+*   Function to change size of memory taken from given allocator
+*   Contents are kept up to smaller of sizes, on error old memory is left untouched
+*   In params:
+*       const geometry_allocator* allocator     allocator memory was taken from, NULL for the one currently set
+*       void* pointer                           memory to resize, NULL to allocate new one
+*       size_t old_size                         current size of memory in bytes
+*       size_t new_size                         requested size of memory in bytes
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*                                   pointer to resized memory, NULL if error occured
+*/
+void* geometry_allocator_reallocate(const geometry_allocator* allocator, void* pointer, size_t old_size, size_t new_size);
+
+/**
+*   Function to release memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator memory was taken from, NULL for the one currently set
+*       void* pointer                           memory to release, may be NULL
+*
+*   Out params/return:
+*       none
+*/
+void geometry_allocator_free(const geometry_allocator* allocator, void* pointer);
+
+/*##############################################
+ GEOMETRY_ARENA functions (methods) declarations
+###############################################*/
+
+/**
+*   Function to create new geometry_arena object
+*   Memory is reserved in blocks of given size, new blocks are added
+*   when current one runs out of space
+*   In params:
+*       size_t block_size       size of single memory block in bytes,
+*                               0 for default size
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_arena*         pointer to created object
+*/
+geometry_arena* geometry_arena_new(size_t block_size);
+
+/**
+*   Function to create new geometry_arena object with memory taken from given allocator
+*   Arena remembers allocator, its blocks are taken from it and released to it by geometry_arena_destroy
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t block_size                       size of single memory block in bytes,
+*                                               0 for default size
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_arena*                         pointer to created object, NULL if error occured
+*/
+geometry_arena* geometry_arena_new_with(const geometry_allocator* allocator, size_t block_size);
+
+/**
+*   Function to destroy given geometry_arena object
+*   All objects created in this arena are freed too
+*   In params:
+*       geometry_arena* arena       arena object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_arena_destroy(geometry_arena* arena);
+
+/**
+*   Function to release all objects created in given arena at once
+*   Memory blocks are kept and reused by next allocations
+*   In params:
+*       geometry_arena* arena       arena to be reset
+*
+*   Out params/return:
+*       none (all objects created in this arena become invalid)
+*/
+void geometry_arena_reset(geometry_arena* arena);
+
+/**
+*   Function to allocate raw memory from given arena
+*   Returned memory is suitably aligned for any object type
+*   In params:
+*       geometry_arena* arena       arena to allocate from
+*       size_t size                 number of bytes to allocate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*                       pointer to allocated memory, NULL if error occured
+*/
+void* geometry_arena_allocate(geometry_arena* arena, size_t size);
+
+/*#################################################
+ GEOMETRY_ROTATION functions (methods) declarations
+##################################################*/
+
+/**
+*   Function to create new geometry_rotation object
+*   User is expected to provide angle measured in radians
+*   calculated counterclockwise
+*   In params:
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotations will be calculated
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rotation*                  pointer to created object
+*/
+geometry_rotation* geometry_rotation_new(geometry_real angle, geometry_point* reference_point);
+
+/**
+*   Function to destroy given geometry_rotation object
+*   In params:
+*       geometry_rotation* rotation     rotation object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_rotation_destroy(geometry_rotation* rotation);
+
+/**
+*   Function to create new geometry_rotation object with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_real angle                     angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point         point around which rotations will be calculated
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rotation*                      pointer to created object, NULL if error occured
+*/
+geometry_rotation* geometry_rotation_new_with(const geometry_allocator* allocator, geometry_real angle, geometry_point* reference_point);
+
+/**
+*   Function to destroy given geometry_rotation object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator rotation was created with, NULL for the one currently set
+*       geometry_rotation* rotation             rotation object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_rotation_destroy_with(const geometry_allocator* allocator, geometry_rotation* rotation);
+
+/*##################################################
+ GEOMETRY_TRANSFORM functions (methods) declarations
+###################################################*/
+
+/**
+*   Function to create new geometry_transform object equal to identity
+*   Operations appended to it are not applied to any shape until
+*   the transform is applied with one of _applyTransform functions
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_transform*             pointer to created object
+*/
+geometry_transform* geometry_transform_new(void);
+
+/**
+*   Function to destroy given geometry_transform object
+*   In params:
+*       geometry_transform* transform       transform object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_transform_destroy(geometry_transform* transform);
+
+/**
+*   Function to create new geometry_transform object equal to identity with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_transform*                     pointer to created object, NULL if error occured
+*/
+geometry_transform* geometry_transform_new_with(const geometry_allocator* allocator);
+
+/**
+*   Function to destroy given geometry_transform object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator transform was created with, NULL for the one currently set
+*       geometry_transform* transform           transform object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_transform_destroy_with(const geometry_allocator* allocator, geometry_transform* transform);
+
+/**
+*   Function to append moving by vector to given transform
+*   User is expected to provide vector in normalized form;
+*   i.e. unbouned or origin-bounded
+*   In parms:
+*       geometry_transform* transform       transform to be extended
+*       geometry_real vector_x              x coordinate of vector
+*       geometry_real vector_y              y coordinate of vector
+*
+*   Out params/return:
+*       none (transform object is changed)
+*/
+void geometry_transform_moveByVector(geometry_transform* transform, geometry_real vector_x, geometry_real vector_y);
+
+/**
+*   Function to append rotation through an angle around a point to given transform
+*   User is expected to provide angle measured in radians
+*   calculated counterclockwise
+*   In params:
+*       geometry_transform* transform       transform to be extended
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotation will be calculated
+*
+*   Out params/return:
+*       none (transform object is changed)
+*/
+void geometry_transform_rotateByAngle(geometry_transform* transform, geometry_real angle, geometry_point* reference_point);
+
+/**
+*   Function to compose two transforms into one
+*   Applying result is equal to applying first transform and then second one
+*   In params:
+*       geometry_transform* first           transform applied first
+*       geometry_transform* second          transform applied second
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_transform*                 pointer to created object, NULL if error occured
+*/
+geometry_transform* geometry_transform_compose(geometry_transform* first, geometry_transform* second);
+
+/**
+*   Function to calculate inverse of given transform
+*   In params:
+*       geometry_transform* transform       transform to invert
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_transform*                 pointer to created object,
+*                                           NULL if transform is not invertible or error occured
+*/
+geometry_transform* geometry_transform_invert(geometry_transform* transform);
+
+/**
+*   Function to get coefficients of given transform
+*   Transform maps point (x, y) to (a*x + b*y + tx, c*x + d*y + ty)
+*   In params:
+*       geometry_transform* transform       transform
+*
+*   Out params:
+*       geometry_real coefficients[6]       coefficients in order a, b, tx, c, d, ty
+*
+*   Return:
+*       none
+*/
+void geometry_transform_getCoefficients(geometry_transform* transform, geometry_real coefficients[6]);
 
 /*##############################################
  GEOMETRY_POINT functions (methods) declarations
@@ -21,8 +424,8 @@ typedef struct geometry_triangle geometry_triangle;
 /**
 *   Function to create new gemetry_point object with given coordinates
 *   In params:
-*       double x        x coordinate
-*       double y        y coordinate
+*       geometry_real x    x coordinate
+*       geometry_real y    y coordinate
 *   
 *   Out params:
 *       none
@@ -30,7 +433,23 @@ typedef struct geometry_triangle geometry_triangle;
 *   Return:
 *       geometry_point* pointer to created object
 */
-geometry_point* geometry_point_new(double x, double y);
+geometry_point* geometry_point_new(geometry_real x, geometry_real y);
+
+/**
+*   Function to create new gemetry_point object with given coordinates inside given arena
+*   Created object is released with arena, it must not be passed to geometry_point_destroy
+*   In params:
+*       geometry_arena* arena       arena to allocate object from
+*       geometry_real x             x coordinate
+*       geometry_real y             y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point*             pointer to created object
+*/
+geometry_point* geometry_point_new_in(geometry_arena* arena, geometry_real x, geometry_real y);
 
 /**
 *   Function to destroy given geometry_point object
@@ -42,6 +461,32 @@ geometry_point* geometry_point_new(double x, double y);
 */
 void geometry_point_destroy(geometry_point* point);
 
+/**
+*   Function to create new gemetry_point object with given coordinates with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_real x                         x coordinate
+*       geometry_real y                         y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point*                         pointer to created object, NULL if error occured
+*/
+geometry_point* geometry_point_new_with(const geometry_allocator* allocator, geometry_real x, geometry_real y);
+
+/**
+*   Function to destroy given geometry_point object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator point was created with, NULL for the one currently set
+*       geometry_point* point                   point object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_point_destroy_with(const geometry_allocator* allocator, geometry_point* point);
+
 /**
 *   Function to get x coordinate of given point
 *   In params:
@@ -51,9 +496,9 @@ void geometry_point_destroy(geometry_point* point);
 *       none
 *
 *   Return:
-*       double                      x coordinate of given point
+*       geometry_real               x coordinate of given point
 */
-double geometry_point_getX(geometry_point* point);
+geometry_real geometry_point_getX(geometry_point* point);
 
 /**
 *   Function to get y coordinate of given point
@@ -64,22 +509,22 @@ double geometry_point_getX(geometry_point* point);
 *       none
 *
 *   Return:
-*       double                      y coordinate of given point
+*       geometry_real               y coordinate of given point
 */
-double geometry_point_getY(geometry_point* point);
+geometry_real geometry_point_getY(geometry_point* point);
 
 /**
 *   Function to move point by vector
 *   User is expected to provide terminal point of a vector with initial point in (0,0)
 *   In parms:
 *       geometry_point* point       point to be moved
-*       double vector_x             x coordinate of vector
-*       double vector_y             y coordinate of vector
+*       geometry_real vector_x      x coordinate of vector
+*       geometry_real vector_y      y coordinate of vector
 *       
 *   Out params/return:
 *       none (point object is changed)
 */
-void geometry_point_moveByVector(geometry_point* point, double vector_x, double vector_y);
+void geometry_point_moveByVector(geometry_point* point, geometry_real vector_x, geometry_real vector_y);
 
 /**
 *   Function to rotate point through an angle around another point
@@ -87,13 +532,37 @@ void geometry_point_moveByVector(geometry_point* point, double vector_x, double
 *   calculated counterclockwise
 *   In params:
 *       geometry_point* rotated_point       point to be rotated
-*       double angle                        angle to rotate through in radians calculated counterclockwise
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
 *       geometry_point* reference_point     point around which rotations will be calculated
 *
 *   Out params/return:
 *       none (roated_point object is changed)       
 */
-void geometry_point_rotateByAngle(geometry_point* rotated_point, double angle, geometry_point* reference_point);
+void geometry_point_rotateByAngle(geometry_point* rotated_point, geometry_real angle, geometry_point* reference_point);
+
+/**
+*   Function to rotate point with precomputed rotation
+*   Gives the same result as geometry_point_rotateByAngle, but sine and cosine
+*   are not calculated again
+*   In params:
+*       geometry_point* rotated_point           point to be rotated
+*       geometry_rotation* rotation             rotation to apply
+*
+*   Out params/return:
+*       none (rotated_point object is changed)
+*/
+void geometry_point_rotateBy(geometry_point* rotated_point, geometry_rotation* rotation);
+
+/**
+*   Function to apply given transform to point
+*   In params:
+*       geometry_point* point                   transformed point
+*       geometry_transform* transform           transform to apply
+*
+*   Out params/return:
+*       none (point object is changed)
+*/
+void geometry_point_applyTransform(geometry_point* point, geometry_transform* transform);
 
 /**
 *   Function to calculate distance between two given points
@@ -105,9 +574,9 @@ void geometry_point_rotateByAngle(geometry_point* rotated_point, double angle, g
 *       none
 *
 *   Return:
-*       double                              euclidean distance between two given points
+*       geometry_real                       euclidean distance between two given points
 */
-double geometry_point_calculateDistance(geometry_point* first_point, geometry_point* second_point);
+geometry_real geometry_point_calculateDistance(geometry_point* first_point, geometry_point* second_point);
 
 /**
 *   Function to determine if given point lies on given segment
@@ -142,6 +611,23 @@ bool geometry_point_liesOnSegment(geometry_point* point, geometry_segment* segme
 */
 geometry_segment* geometry_segment_new(geometry_point* start, geometry_point* end);
 
+/**
+*   Function to create new gemetry_segment object with given points inside given arena.
+*   Those points don't need to be proper dynamic-allocated objects.
+*   Created object is released with arena, it must not be passed to geometry_segment_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_point* start           starting point of segment
+*       geometry_point* end             ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_segment*               pointer to created object
+*/
+geometry_segment* geometry_segment_new_in(geometry_arena* arena, geometry_point* start, geometry_point* end);
+
 /**
 *   Function to destroy given geometry_segment object
 *   In params:
@@ -152,8 +638,37 @@ geometry_segment* geometry_segment_new(geometry_point* start, geometry_point* en
 */
 void geometry_segment_destroy(geometry_segment* segment);
 
+/**
+*   Function to create new gemetry_segment object with given points with memory taken from given allocator
+*   Those points don't need to be proper dynamic-allocated objects
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_point* start                   starting point of segment
+*       geometry_point* end                     ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_segment*                       pointer to created object, NULL if error occured
+*/
+geometry_segment* geometry_segment_new_with(const geometry_allocator* allocator, geometry_point* start, geometry_point* end);
+
+/**
+*   Function to destroy given geometry_segment object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator segment was created with, NULL for the one currently set
+*       geometry_segment* segment               segment object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_segment_destroy_with(const geometry_allocator* allocator, geometry_segment* segment);
+
 /**
 *   Function to get end points of given geometry_segment object
+*   Returned points are stored inside the segment, they are valid until segment is destroyed
+*   and must not be passed to geometry_point_destroy
 *   In params:
 *       geometry_segment* segment       segment object to get ending points
 *       
@@ -171,13 +686,13 @@ void geometry_segment_getPoints(geometry_segment* segment, geometry_point** star
 *   User is expected to provide terminal point of a vector with initial point in (0,0)
 *   In parms:
 *       geometry_segment* segment       segment to be moved
-*       double vector_x                 x coordinate of vector
-*       double vector_y                 y coordinate of vector
+*       geometry_real vector_x          x coordinate of vector
+*       geometry_real vector_y          y coordinate of vector
 *       
 *   Out params/return:
 *       none (segment object is changed)
 */
-void geometry_segment_moveByVector(geometry_segment* segment, double vector_x, double vector_y);
+void geometry_segment_moveByVector(geometry_segment* segment, geometry_real vector_x, geometry_real vector_y);
 
 /**
 *   Function to rotate segment through an angle around another point
@@ -185,13 +700,37 @@ void geometry_segment_moveByVector(geometry_segment* segment, double vector_x, d
 *   calculated counterclockwise
 *   In params:
 *       geometry_segment* rotated_segment       segment to be rotated
-*       double angle                            angle to rotate through in radians calculated counterclockwise
+*       geometry_real angle                     angle to rotate through in radians calculated counterclockwise
 *       geometry_point* reference_point         point around which rotations will be calculated
 *
 *   Out params/return:
 *       none (roated_segment object is changed)       
 */
-void geometry_segment_rotateByAngle(geometry_segment* rotated_segment, double angle, geometry_point* reference_point);
+void geometry_segment_rotateByAngle(geometry_segment* rotated_segment, geometry_real angle, geometry_point* reference_point);
+
+/**
+*   Function to rotate segment with precomputed rotation
+*   Gives the same result as geometry_segment_rotateByAngle, but sine and cosine
+*   are not calculated again
+*   In params:
+*       geometry_segment* rotated_segment       segment to be rotated
+*       geometry_rotation* rotation             rotation to apply
+*
+*   Out params/return:
+*       none (rotated_segment object is changed)
+*/
+void geometry_segment_rotateBy(geometry_segment* rotated_segment, geometry_rotation* rotation);
+
+/**
+*   Function to apply given transform to segment
+*   In params:
+*       geometry_segment* segment               transformed segment
+*       geometry_transform* transform           transform to apply
+*
+*   Out params/return:
+*       none (segment object is changed)
+*/
+void geometry_segment_applyTransform(geometry_segment* segment, geometry_transform* transform);
 
 /**
 *   Function to calculate length of given segment
@@ -202,9 +741,9 @@ void geometry_segment_rotateByAngle(geometry_segment* rotated_segment, double an
 *       none
 *
 *   Return:
-*       double                          length of given segment
+*       geometry_real                   length of given segment
 */
-double geometry_segment_calculateLength(geometry_segment* segment);
+geometry_real geometry_segment_calculateLength(geometry_segment* segment);
 
 /**
 *   Function to determine if given segments are parrarel
@@ -245,7 +784,8 @@ bool geometry_segment_arePerpendicular(geometry_segment* first_segment, geometry
 *
 *   Return:
 *       geometry_point*                         object of geometry_point structure(class) which is interesection
-*                                               of given segments, if segments are parallel, then NULL
+*                                               of given segments, if segments are parallel or don't intersect, then NULL.
+*                                               If segments only touch, touching end point is returned
 */
 geometry_point* geometry_segment_calculateIntersection(geometry_segment* first_segment, geometry_segment* second_segment);
 
@@ -270,6 +810,25 @@ geometry_point* geometry_segment_calculateIntersection(geometry_segment* first_s
 */
 geometry_triangle* geometry_triangle_new(geometry_point* first, geometry_point* second, geometry_point* third, bool is_right);
 
+/**
+*   Function to create new gemetry_triangle object with given points inside given arena.
+*   Those points don't need to be proper dynamic-allocated objects.
+*   Created object is released with arena, it must not be passed to geometry_triangle_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_point* first           first point of triangle
+*       geometry_point* second          second point of triangle
+*       geometry_point* third           third point of triangle
+*       bool is_right                   true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*               pointer to created object
+*/
+geometry_triangle* geometry_triangle_new_in(geometry_arena* arena, geometry_point* first, geometry_point* second, geometry_point* third, bool is_right);
+
 /**
 *   Function to destroy given geometry_triangle object
 *   In params:
@@ -280,8 +839,61 @@ geometry_triangle* geometry_triangle_new(geometry_point* first, geometry_point*
 */
 void geometry_triangle_destroy(geometry_triangle* triangle);
 
+/**
+*   Function to create new gemetry_triangle object with given points with memory taken from given allocator
+*   Those points don't need to be proper dynamic-allocated objects
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_point* first                   first point of triangle
+*       geometry_point* second                  second point of triangle
+*       geometry_point* third                   third point of triangle
+*       bool is_right                           true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*                      pointer to created object, NULL if error occured
+*/
+geometry_triangle* geometry_triangle_new_with(const geometry_allocator* allocator, geometry_point* first, geometry_point* second, geometry_point* third, bool is_right);
+
+/**
+*   Function to create new geometry_triangle object with points of given coordinates
+*   Object is taken from arena if it is given (it is released with arena then),
+*   otherwise from given allocator (it has to be destroyed with geometry_triangle_destroy_with)
+*   In params:
+*       geometry_arena* arena                   arena to allocate object from, NULL to use allocator
+*       const geometry_allocator* allocator     allocator used when arena is NULL, NULL for the one currently set
+*       const geometry_real* xs                 x coordinates of first, second and third point, array of 3 elements
+*       const geometry_real* ys                 y coordinates of first, second and third point, array of 3 elements
+*       bool is_right                           true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*                      pointer to created object, NULL if error occured
+*/
+geometry_triangle* geometry_triangle_newFromCoordinates(geometry_arena* arena, const geometry_allocator* allocator, const geometry_real* xs, const geometry_real* ys, bool is_right);
+
+/**
+*   Function to destroy given geometry_triangle object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator triangle was created with, NULL for the one currently set
+*       geometry_triangle* triangle             triangle object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_triangle_destroy_with(const geometry_allocator* allocator, geometry_triangle* triangle);
+
 /**
 *   Function to get points of given geometry_triangle object
+*   Returned points are stored inside the triangle, they are valid until triangle is destroyed
+*   and must not be passed to geometry_point_destroy. Points may be changed through them,
+*   so values cached inside triangle are dropped (triangle is changed, so it mustn't be used
+*   by other threads meanwhile - geometry_triangle_getCoordinates only reads it). If cached
+*   values are used before points are changed, geometry_triangle_invalidateCache has to be called
 *   In params:
 *       geometry_triangle* triangle         triangle object to get ending points
 *       
@@ -295,6 +907,21 @@ void geometry_triangle_destroy(geometry_triangle* triangle);
 */
 void geometry_triangle_getPoints(geometry_triangle* triangle, geometry_point** first, geometry_point** second, geometry_point** third);
 
+/**
+*   Function to get coordinates of points of given triangle without exposing the points
+*   Triangle is only read, so cached values stay valid
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       geometry_real* xs               x coordinates of first, second and third point, array of 3 elements
+*       geometry_real* ys               y coordinates of first, second and third point, array of 3 elements
+*
+*   Return:
+*       none
+*/
+void geometry_triangle_getCoordinates(geometry_triangle* triangle, geometry_real* xs, geometry_real* ys);
+
 /**
 *   Function to get is_right field of given triangle
 *   In params:
@@ -308,18 +935,91 @@ void geometry_triangle_getPoints(geometry_triangle* triangle, geometry_point** f
 */
 bool geometry_triangle_getIsRight(geometry_triangle* triangle);
 
+/**
+*   Function to get axis-aligned bounding box of given triangle
+*   Value is cached inside triangle, so repeated calls are cheap
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       geometry_real* min_x            smallest x coordinate of triangle's points
+*       geometry_real* min_y            smallest y coordinate of triangle's points
+*       geometry_real* max_x            largest x coordinate of triangle's points
+*       geometry_real* max_y            largest y coordinate of triangle's points
+*
+*   Return:
+*       none
+*/
+void geometry_triangle_getBoundingBox(geometry_triangle* triangle, geometry_real* min_x, geometry_real* min_y, geometry_real* max_x, geometry_real* max_y);
+
+/**
+*   Function to get centroid of given triangle
+*   Value is cached inside triangle, so repeated calls are cheap
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       geometry_real* x                x coordinate of centroid
+*       geometry_real* y                y coordinate of centroid
+*
+*   Return:
+*       none
+*/
+void geometry_triangle_getCentroid(geometry_triangle* triangle, geometry_real* x, geometry_real* y);
+
+/**
+*   Function to get vertex of right angle of given triangle
+*   User should provide a right-angled triangle. Vertex may be changed through returned
+*   pointer, so values cached inside triangle are dropped as in geometry_triangle_getPoints
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point*                 point stored inside triangle where its right angle is,
+*                                       NULL if given triangle is not right-angled
+*/
+geometry_point* geometry_triangle_getRightAngleVertex(geometry_triangle* triangle);
+
+/**
+*   Function to drop all values cached inside given triangle
+*   Must be called after triangle's points were changed directly through pointers
+*   got from geometry_triangle_getPoints, if cached values were used since getting them
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params/return:
+*       none
+*/
+void geometry_triangle_invalidateCache(geometry_triangle* triangle);
+
+/**
+*   Function to calculate all values cached inside given triangle at once
+*   Afterwards functions using cache (e.g. geometry_triangle_areDisjoint) only read
+*   triangle, so they may be called for it from many threads at the same time,
+*   as long as triangle isn't changed meanwhile
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params/return:
+*       none
+*/
+void geometry_triangle_fillCache(geometry_triangle* triangle);
+
 /**
 *   Function to move triangle by vector
 *   User is expected to provide terminal point of a vector with initial point in (0,0)
 *   In parms:
 *       geometry_triangle* triangle     triangle to be moved
-*       double vector_x                 x coordinate of vector
-*       double vector_y                 y coordinate of vector
+*       geometry_real vector_x          x coordinate of vector
+*       geometry_real vector_y          y coordinate of vector
 *       
 *   Out params/return:
 *       none (triangle object is changed)
 */
-void geometry_triangle_moveByVector(geometry_triangle* triangle, double vector_x, double vector_y);
+void geometry_triangle_moveByVector(geometry_triangle* triangle, geometry_real vector_x, geometry_real vector_y);
 
 /**
 *   Function to rotate triangle through an angle around another point
@@ -327,13 +1027,37 @@ void geometry_triangle_moveByVector(geometry_triangle* triangle, double vector_x
 *   calculated counterclockwise
 *   In params:
 *       geometry_triangle* rotated_triangle         triangle to be rotated
-*       double angle                                angle to rotate through in radians calculated counterclockwise
+*       geometry_real angle                         angle to rotate through in radians calculated counterclockwise
 *       geometry_point* reference_point             point around which rotations will be calculated
 *
 *   Out params/return:
 *       none (roated_triangle object is changed)       
 */
-void geometry_triangle_rotateByAngle(geometry_triangle* rotated_triangle, double angle, geometry_point* reference_point);
+void geometry_triangle_rotateByAngle(geometry_triangle* rotated_triangle, geometry_real angle, geometry_point* reference_point);
+
+/**
+*   Function to rotate triangle with precomputed rotation
+*   Gives the same result as geometry_triangle_rotateByAngle, but sine and cosine
+*   are not calculated again
+*   In params:
+*       geometry_triangle* rotated_triangle     triangle to be rotated
+*       geometry_rotation* rotation             rotation to apply
+*
+*   Out params/return:
+*       none (rotated_triangle object is changed)
+*/
+void geometry_triangle_rotateBy(geometry_triangle* rotated_triangle, geometry_rotation* rotation);
+
+/**
+*   Function to apply given transform to triangle
+*   In params:
+*       geometry_triangle* triangle             transformed triangle
+*       geometry_transform* transform           transform to apply
+*
+*   Out params/return:
+*       none (triangle object is changed)
+*/
+void geometry_triangle_applyTransform(geometry_triangle* triangle, geometry_transform* transform);
 
 /**
 *   Function to calculate perimeter of a given triangle
@@ -344,10 +1068,10 @@ void geometry_triangle_rotateByAngle(geometry_triangle* rotated_triangle, double
 *       none
 *
 *   Return:
-*       double                          calculated perimeter of given triangle,
+*       geometry_real                   calculated perimeter of given triangle,
 *                                       -1 if error(s) occured
 */
-double geometry_triangle_calculatePerimeter(geometry_triangle* triangle);
+geometry_real geometry_triangle_calculatePerimeter(geometry_triangle* triangle);
 
 /**
 *   Function to calculate area of a given triangle
@@ -358,13 +1082,16 @@ double geometry_triangle_calculatePerimeter(geometry_triangle* triangle);
 *       none
 *
 *   Return:
-*       double                          calculated area of given triangle,
+*       geometry_real                   calculated area of given triangle,
 *                                       -1 if error(s) occured
 */
-double geometry_triangle_calculateArea(geometry_triangle* triangle);
+geometry_real geometry_triangle_calculateArea(geometry_triangle* triangle);
 
 /**
 *   Function to determine if two given triangles intersect
+*   Separating axis theorem is used - triangles are disjoint if their projections
+*   don't overlap on one of the edge normals. Triangles touching with sides or
+*   vertices intersect.
 *   In params:
 *       geometry_triangle* first_triangle       first triangle
 *       geometry_triangle* second_triangle      second triangle
@@ -378,6 +1105,45 @@ double geometry_triangle_calculateArea(geometry_triangle* triangle);
 */
 bool geometry_triangle_areDisjoint(geometry_triangle* first_triangle, geometry_triangle* second_triangle);
 
+/**
+*   Function to determine which of given triangles intersect one triangle
+*   Values cached in triangle are reused, so it is faster than calling
+*   geometry_triangle_areDisjoint for every pair
+*   In params:
+*       geometry_triangle* triangle             triangle tested against others
+*       geometry_triangle** triangles           array of triangles
+*       size_t count                            number of triangles in array
+*
+*   Out params:
+*       bool* disjoint                          array of count results, disjoint[i] is true
+*                                               if triangle and triangles[i] are disjoint
+*
+*   Return:
+*       size_t                                  number of triangles intersecting given one,
+*                                               (size_t)-1 if error occured
+*/
+size_t geometry_triangle_areDisjointBatch(geometry_triangle* triangle, geometry_triangle** triangles, size_t count, bool* disjoint);
+
+/**
+*   Function to determine which pairs of triangles from two arrays intersect
+*   Cache of every triangle is filled once, then all pairs are tested
+*   In params:
+*       geometry_triangle** first_triangles     first array of triangles
+*       size_t first_count                      number of triangles in first array
+*       geometry_triangle** second_triangles    second array of triangles
+*       size_t second_count                     number of triangles in second array
+*
+*   Out params:
+*       bool* disjoint                          matrix of first_count * second_count results stored by rows,
+*                                               disjoint[i * second_count + j] is true if
+*                                               first_triangles[i] and second_triangles[j] are disjoint
+*
+*   Return:
+*       size_t                                  number of intersecting pairs,
+*                                               (size_t)-1 if error occured
+*/
+size_t geometry_triangle_areDisjointMatrix(geometry_triangle** first_triangles, size_t first_count, geometry_triangle** second_triangles, size_t second_count, bool* disjoint);
+
 /**
 *   Function to calculate hypotenuse of a given triangle.
 *   User should provide a right-angled triangle
@@ -388,8 +1154,8 @@ bool geometry_triangle_areDisjoint(geometry_triangle* first_triangle, geometry_t
 *       none
 *
 *   Return:
-*       double                          calculated hypotenuse of given triangle,
+*       geometry_real                   calculated hypotenuse of given triangle,
 *                                       -1 if given triangle is not right-angled
 */
-double geometry_triangle_calculateHypotenuse(geometry_triangle* triangle);
+geometry_real geometry_triangle_calculateHypotenuse(geometry_triangle* triangle);
 #endif
\ No newline at end of file
@@ -0,0 +1,668 @@
+// mmap, open and fstat are POSIX
+#define _POSIX_C_SOURCE 200809L
+#include "geometry_binary.h"
+#include "geometry_stats.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define GEOMETRY_BINARY_MAGIC "GEOMTRI"
+#define GEOMETRY_BINARY_HEADER_SIZE 64
+// bytes taken by one triangle in file - six coordinates and flags
+#define GEOMETRY_BINARY_TRIANGLE_SIZE (6 * sizeof(geometry_real) + 1)
+// number of coordinates byte-swapped at once when writing on big-endian machine
+#define GEOMETRY_BINARY_CHUNK_SIZE 512
+
+struct geometry_triangle_buffer {
+    // first x, first y, second x, second y, third x, third y of every triangle
+    const geometry_real* coordinates[6];
+    const unsigned char* flags;
+    size_t count;
+    // mapping of loaded file, NULL if data was copied to memory
+    void* mapping;
+    size_t mapping_size;
+    // memory with arrays, NULL if they point into mapping
+    void* data;
+    geometry_allocator allocator;
+};
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static bool geometry_binary_isLittleEndian(void);
+static uint32_t geometry_binary_readUint32(const unsigned char* bytes);
+static uint64_t geometry_binary_readUint64(const unsigned char* bytes);
+static void geometry_binary_writeUint32(unsigned char* bytes, uint32_t value);
+static void geometry_binary_writeUint64(unsigned char* bytes, uint64_t value);
+static double geometry_binary_readCoordinate(const unsigned char* bytes, size_t size);
+static geometry_real geometry_binary_swapReal(geometry_real value);
+static geometry_triangle_buffer* geometry_triangle_buffer_allocate(const geometry_allocator* allocator, size_t count);
+static void geometry_triangle_buffer_setArrays(geometry_triangle_buffer* buffer, const unsigned char* arrays);
+static bool geometry_triangle_buffer_writeCoordinates(FILE* file, const geometry_real* values, size_t count);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to check byte order of machine
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool        true if machine is little-endian
+*/
+static bool geometry_binary_isLittleEndian(void){
+    const uint16_t probe = 1;
+    return *(const unsigned char*)&probe == 1;
+}
+
+/**
+*   Function to read little-endian 32-bit number
+*   In params:
+*       const unsigned char* bytes      4 bytes of number
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       uint32_t                        number
+*/
+static uint32_t geometry_binary_readUint32(const unsigned char* bytes){
+    return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+/**
+*   Function to read little-endian 64-bit number
+*   In params:
+*       const unsigned char* bytes      8 bytes of number
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       uint64_t                        number
+*/
+static uint64_t geometry_binary_readUint64(const unsigned char* bytes){
+    return (uint64_t)geometry_binary_readUint32(bytes) | (uint64_t)geometry_binary_readUint32(bytes + 4) << 32;
+}
+
+/**
+*   Function to write 32-bit number as little-endian
+*   In params:
+*       uint32_t value                  number
+*
+*   Out params:
+*       unsigned char* bytes            4 bytes of number
+*
+*   Return:
+*       none
+*/
+static void geometry_binary_writeUint32(unsigned char* bytes, uint32_t value){
+    for(int i = 0; i < 4; i++){
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+/**
+*   Function to write 64-bit number as little-endian
+*   In params:
+*       uint64_t value                  number
+*
+*   Out params:
+*       unsigned char* bytes            8 bytes of number
+*
+*   Return:
+*       none
+*/
+static void geometry_binary_writeUint64(unsigned char* bytes, uint64_t value){
+    geometry_binary_writeUint32(bytes, (uint32_t)value);
+    geometry_binary_writeUint32(bytes + 4, (uint32_t)(value >> 32));
+}
+
+/**
+*   Function to read little-endian floating-point coordinate of given size
+*   In params:
+*       const unsigned char* bytes      bytes of number
+*       size_t size                     4 for float, 8 for double
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       double                          number (conversion from float is exact)
+*/
+static double geometry_binary_readCoordinate(const unsigned char* bytes, size_t size){
+    if(size == sizeof(float)){
+        uint32_t bits = geometry_binary_readUint32(bytes);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    uint64_t bits = geometry_binary_readUint64(bytes);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+*   Function to reverse order of bytes of geometry_real
+*   In params:
+*       geometry_real value     number
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real           number with bytes in reversed order
+*/
+static geometry_real geometry_binary_swapReal(geometry_real value){
+    unsigned char bytes[sizeof(geometry_real)];
+    memcpy(bytes, &value, sizeof(geometry_real));
+    for(size_t i = 0; i < sizeof(geometry_real) / 2; i++){
+        unsigned char byte = bytes[i];
+        bytes[i] = bytes[sizeof(geometry_real) - 1 - i];
+        bytes[sizeof(geometry_real) - 1 - i] = byte;
+    }
+    memcpy(&value, bytes, sizeof(geometry_real));
+    return value;
+}
+
+/**
+*   Function to allocate geometry_triangle_buffer object with no arrays set
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t count                            number of triangles
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle_buffer*               pointer to created object, NULL if error occured
+*/
+static geometry_triangle_buffer* geometry_triangle_buffer_allocate(const geometry_allocator* allocator, size_t count){
+    geometry_triangle_buffer* new_buffer = geometry_allocator_allocate(allocator, sizeof(*new_buffer));
+    if(new_buffer == NULL){
+        return NULL;
+    }
+    new_buffer->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    for(int i = 0; i < 6; i++){
+        new_buffer->coordinates[i] = NULL;
+    }
+    new_buffer->flags = NULL;
+    new_buffer->count = count;
+    new_buffer->mapping = NULL;
+    new_buffer->mapping_size = 0;
+    new_buffer->data = NULL;
+    return new_buffer;
+}
+
+/**
+*   Function to point arrays of buffer into memory laid out as in file (without header)
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer with count set
+*       const unsigned char* arrays         memory with six arrays of coordinates followed by flags,
+*                                           aligned for geometry_real
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       none
+*/
+static void geometry_triangle_buffer_setArrays(geometry_triangle_buffer* buffer, const unsigned char* arrays){
+    for(int i = 0; i < 6; i++){
+        buffer->coordinates[i] = (const geometry_real*)(const void*)(arrays + i * buffer->count * sizeof(geometry_real));
+    }
+    buffer->flags = arrays + 6 * buffer->count * sizeof(geometry_real);
+}
+
+/**
+*   Function to write array of coordinates to file as little-endian numbers
+*   In params:
+*       FILE* file                     open file
+*       const geometry_real* values    numbers
+*       size_t count                   number of numbers
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                           true on success, false if error occured
+*/
+static bool geometry_triangle_buffer_writeCoordinates(FILE* file, const geometry_real* values, size_t count){
+    if(geometry_binary_isLittleEndian()){
+        return fwrite(values, sizeof(geometry_real), count, file) == count;
+    }
+    geometry_real chunk[GEOMETRY_BINARY_CHUNK_SIZE];
+    for(size_t begin = 0; begin < count; begin += GEOMETRY_BINARY_CHUNK_SIZE){
+        size_t size = count - begin < GEOMETRY_BINARY_CHUNK_SIZE ? count - begin : GEOMETRY_BINARY_CHUNK_SIZE;
+        for(size_t i = 0; i < size; i++){
+            chunk[i] = geometry_binary_swapReal(values[begin + i]);
+        }
+        if(fwrite(chunk, sizeof(geometry_real), size, file) != size){
+            return false;
+        }
+    }
+    return true;
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new geometry_triangle_buffer object with copies of given triangles
+*   In params:
+*       geometry_triangle** triangles   array of triangles, none may be NULL
+*       size_t count                    number of triangles
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle_buffer*       pointer to created object, NULL if error occured
+*/
+geometry_triangle_buffer* geometry_triangle_buffer_new(geometry_triangle** triangles, size_t count){
+    return geometry_triangle_buffer_new_with(NULL, triangles, count);
+}
+
+/**
+*   Function to create new geometry_triangle_buffer object with copies of given triangles with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_triangle** triangles           array of triangles, none may be NULL
+*       size_t count                            number of triangles
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle_buffer*       pointer to created object, NULL if error occured
+*/
+geometry_triangle_buffer* geometry_triangle_buffer_new_with(const geometry_allocator* allocator, geometry_triangle** triangles, size_t count){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_BUFFER_NEW);
+    if((triangles == NULL && count > 0) || count > SIZE_MAX / GEOMETRY_BINARY_TRIANGLE_SIZE){
+        return NULL;
+    }
+    for(size_t i = 0; i < count; i++){
+        if(triangles[i] == NULL){
+            return NULL;
+        }
+    }
+    geometry_triangle_buffer* new_buffer = geometry_triangle_buffer_allocate(allocator, count);
+    if(new_buffer == NULL){
+        return NULL;
+    }
+    new_buffer->data = geometry_allocator_allocate(&new_buffer->allocator, count * GEOMETRY_BINARY_TRIANGLE_SIZE + 1);
+    if(new_buffer->data == NULL){
+        geometry_triangle_buffer_destroy(new_buffer);
+        return NULL;
+    }
+    geometry_real* coordinates[6];
+    for(int i = 0; i < 6; i++){
+        coordinates[i] = (geometry_real*)new_buffer->data + i * count;
+    }
+    unsigned char* flags = (unsigned char*)(coordinates[5] + count);
+    for(size_t i = 0; i < count; i++){
+        geometry_real xs[3];
+        geometry_real ys[3];
+        geometry_triangle_getCoordinates(triangles[i], xs, ys);
+        for(int j = 0; j < 3; j++){
+            coordinates[2 * j][i] = xs[j];
+            coordinates[2 * j + 1][i] = ys[j];
+        }
+        flags[i] = geometry_triangle_getIsRight(triangles[i]) ? GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT : 0;
+    }
+    geometry_triangle_buffer_setArrays(new_buffer, new_buffer->data);
+    return new_buffer;
+}
+
+/**
+*   Function to load geometry_triangle_buffer object from binary file
+*   On little-endian machines file with coordinates of geometry_real size is mapped to
+*   memory and arrays of buffer point straight into mapping, so no coordinates are copied.
+*   File must not be changed while buffer exists. File with coordinates of other size
+*   is read and converted.
+*   In params:
+*       const char* path                path of file
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle_buffer*       pointer to created object, NULL if file can't be read
+*                                       or is not valid triangle buffer file
+*/
+geometry_triangle_buffer* geometry_triangle_buffer_load(const char* path){
+    return geometry_triangle_buffer_load_with(NULL, path);
+}
+
+/**
+*   Function to load geometry_triangle_buffer object from binary file with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       const char* path                        path of file
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle_buffer*       pointer to created object, NULL if file can't be read
+*                                       or is not valid triangle buffer file
+*/
+geometry_triangle_buffer* geometry_triangle_buffer_load_with(const geometry_allocator* allocator, const char* path){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_BUFFER_LOAD);
+    if(path == NULL){
+        return NULL;
+    }
+    int descriptor = open(path, O_RDONLY);
+    if(descriptor < 0){
+        return NULL;
+    }
+    // header is read and checked with plain read, so mapping is made only for valid files
+    unsigned char header[GEOMETRY_BINARY_HEADER_SIZE];
+    struct stat status;
+    if(fstat(descriptor, &status) != 0 || read(descriptor, header, sizeof(header)) != (ssize_t)sizeof(header)){
+        close(descriptor);
+        return NULL;
+    }
+    uint32_t version = geometry_binary_readUint32(header + 8);
+    uint32_t header_size = geometry_binary_readUint32(header + 12);
+    uint64_t count = geometry_binary_readUint64(header + 16);
+    // files written before coordinate size was stored have zero there and hold doubles
+    uint32_t coordinate_size = geometry_binary_readUint32(header + 24);
+    coordinate_size = coordinate_size == 0 ? sizeof(double) : coordinate_size;
+    size_t triangle_size = 6 * (size_t)coordinate_size + 1;
+    if(memcmp(header, GEOMETRY_BINARY_MAGIC, sizeof(GEOMETRY_BINARY_MAGIC)) != 0 || version != GEOMETRY_TRIANGLE_BUFFER_VERSION
+       || header_size < GEOMETRY_BINARY_HEADER_SIZE || header_size % sizeof(double) != 0
+       || (coordinate_size != sizeof(float) && coordinate_size != sizeof(double))
+       || count > (SIZE_MAX - header_size) / triangle_size || count > SIZE_MAX / GEOMETRY_BINARY_TRIANGLE_SIZE
+       || (uint64_t)status.st_size != header_size + count * triangle_size){
+        close(descriptor);
+        return NULL;
+    }
+    geometry_triangle_buffer* new_buffer = geometry_triangle_buffer_allocate(allocator, (size_t)count);
+    if(new_buffer == NULL){
+        close(descriptor);
+        return NULL;
+    }
+    size_t file_size = (size_t)status.st_size;
+    if(geometry_binary_isLittleEndian() && coordinate_size == sizeof(geometry_real)){
+        void* mapping = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if(mapping == MAP_FAILED){
+            geometry_triangle_buffer_destroy(new_buffer);
+            return NULL;
+        }
+        new_buffer->mapping = mapping;
+        new_buffer->mapping_size = file_size;
+        geometry_triangle_buffer_setArrays(new_buffer, (const unsigned char*)mapping + header_size);
+        return new_buffer;
+    }
+    // on big-endian machine or for coordinates of other precision than geometry_real
+    // file has to be read and converted anyway
+    size_t data_size = file_size - header_size;
+    unsigned char* file_data = geometry_allocator_allocate(&new_buffer->allocator, data_size + 1);
+    bool loaded = file_data != NULL && lseek(descriptor, header_size, SEEK_SET) == (off_t)header_size;
+    for(size_t done = 0; loaded && done < data_size;){
+        ssize_t size = read(descriptor, file_data + done, data_size - done);
+        loaded = size > 0;
+        done += loaded ? (size_t)size : 0;
+    }
+    close(descriptor);
+    new_buffer->data = loaded ? geometry_allocator_allocate(&new_buffer->allocator, new_buffer->count * GEOMETRY_BINARY_TRIANGLE_SIZE + 1) : NULL;
+    if(new_buffer->data == NULL){
+        geometry_allocator_free(&new_buffer->allocator, file_data);
+        geometry_triangle_buffer_destroy(new_buffer);
+        return NULL;
+    }
+    geometry_real* coordinates = new_buffer->data;
+    for(size_t i = 0; i < 6 * new_buffer->count; i++){
+        coordinates[i] = (geometry_real)geometry_binary_readCoordinate(file_data + i * coordinate_size, coordinate_size);
+    }
+    memcpy(coordinates + 6 * new_buffer->count, file_data + 6 * new_buffer->count * coordinate_size, new_buffer->count);
+    geometry_allocator_free(&new_buffer->allocator, file_data);
+    geometry_triangle_buffer_setArrays(new_buffer, new_buffer->data);
+    return new_buffer;
+}
+
+/**
+*   Function to destroy given geometry_triangle_buffer object, mapping of file is released
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_triangle_buffer_destroy(geometry_triangle_buffer* buffer){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_BUFFER_DESTROY);
+    if(buffer == NULL){
+        return;
+    }
+    if(buffer->mapping != NULL){
+        munmap(buffer->mapping, buffer->mapping_size);
+    }
+    geometry_allocator allocator = buffer->allocator;
+    geometry_allocator_free(&allocator, buffer->data);
+    geometry_allocator_free(&allocator, buffer);
+}
+
+/**
+*   Function to write given buffer to binary file, file is replaced if it exists
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*       const char* path                    path of file
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_triangle_buffer_save(geometry_triangle_buffer* buffer, const char* path){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_BUFFER_SAVE);
+    if(buffer == NULL || path == NULL){
+        return false;
+    }
+    unsigned char header[GEOMETRY_BINARY_HEADER_SIZE] = {0};
+    memcpy(header, GEOMETRY_BINARY_MAGIC, sizeof(GEOMETRY_BINARY_MAGIC));
+    geometry_binary_writeUint32(header + 8, GEOMETRY_TRIANGLE_BUFFER_VERSION);
+    geometry_binary_writeUint32(header + 12, GEOMETRY_BINARY_HEADER_SIZE);
+    geometry_binary_writeUint64(header + 16, buffer->count);
+    geometry_binary_writeUint32(header + 24, sizeof(geometry_real));
+    FILE* file = fopen(path, "wb");
+    if(file == NULL){
+        return false;
+    }
+    bool written = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    for(int i = 0; written && i < 6; i++){
+        written = geometry_triangle_buffer_writeCoordinates(file, buffer->coordinates[i], buffer->count);
+    }
+    written = written && fwrite(buffer->flags, 1, buffer->count, file) == buffer->count;
+    // closing flushes buffered data, so its error means file is not complete
+    if(fclose(file) != 0){
+        written = false;
+    }
+    return written;
+}
+
+/**
+*   Function to get number of triangles in given buffer
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                              number of triangles, 0 if buffer is NULL
+*/
+size_t geometry_triangle_buffer_getSize(geometry_triangle_buffer* buffer){
+    if(buffer == NULL){
+        return 0;
+    }
+    return buffer->count;
+}
+
+/**
+*   Function to get arrays of coordinates of one vertex of all triangles
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*       size_t vertex                       0 for first, 1 for second and 2 for third vertex
+*
+*   Out params:
+*       const geometry_real** xs            x coordinates, array of buffer size elements
+*       const geometry_real** ys            y coordinates, array of buffer size elements
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_triangle_buffer_getCoordinates(geometry_triangle_buffer* buffer, size_t vertex, const geometry_real** xs, const geometry_real** ys){
+    if(buffer == NULL || vertex > 2 || xs == NULL || ys == NULL){
+        return false;
+    }
+    *xs = buffer->coordinates[2 * vertex];
+    *ys = buffer->coordinates[2 * vertex + 1];
+    return true;
+}
+
+/**
+*   Function to get array of flags of all triangles
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const unsigned char*                flags, array of buffer size elements, NULL if buffer is NULL
+*/
+const unsigned char* geometry_triangle_buffer_getFlags(geometry_triangle_buffer* buffer){
+    if(buffer == NULL){
+        return NULL;
+    }
+    return buffer->flags;
+}
+
+/**
+*   Function to check if triangle of given index is right-angled
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*       size_t index                        index of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if triangle is right-angled, false otherwise
+*                                           or if error occured
+*/
+bool geometry_triangle_buffer_getIsRight(geometry_triangle_buffer* buffer, size_t index){
+    if(buffer == NULL || index >= buffer->count){
+        return false;
+    }
+    return (buffer->flags[index] & GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT) != 0;
+}
+
+/**
+*   Function to create geometry_triangle object from triangle of given index
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*       size_t index                        index of triangle
+*       geometry_arena* arena               arena to allocate object from, NULL to take it from allocator of buffer
+*                                           (it must be freed with geometry_triangle_destroy_with then)
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*                  pointer to created object, NULL if error occured
+*/
+geometry_triangle* geometry_triangle_buffer_getTriangle(geometry_triangle_buffer* buffer, size_t index, geometry_arena* arena){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_BUFFER_GET_TRIANGLE);
+    if(buffer == NULL || index >= buffer->count){
+        return NULL;
+    }
+    geometry_real xs[3];
+    geometry_real ys[3];
+    for(int i = 0; i < 3; i++){
+        xs[i] = buffer->coordinates[2 * i][index];
+        ys[i] = buffer->coordinates[2 * i + 1][index];
+    }
+    return geometry_triangle_newFromCoordinates(arena, &buffer->allocator, xs, ys, geometry_triangle_buffer_getIsRight(buffer, index));
+}
+
+/**
+*   Function to calculate areas of all triangles of given buffer
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*
+*   Out params:
+*       geometry_real* areas                array of at least buffer size elements
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_triangle_buffer_calculateAreas(geometry_triangle_buffer* buffer, geometry_real* areas){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_BUFFER_CALCULATE_AREAS);
+    if(buffer == NULL || areas == NULL){
+        return false;
+    }
+    const geometry_real* first_x = buffer->coordinates[0];
+    const geometry_real* first_y = buffer->coordinates[1];
+    const geometry_real* second_x = buffer->coordinates[2];
+    const geometry_real* second_y = buffer->coordinates[3];
+    const geometry_real* third_x = buffer->coordinates[4];
+    const geometry_real* third_y = buffer->coordinates[5];
+    // half of absolute cross product of two sides, arrays are read in order so loop vectorizes
+    for(size_t i = 0; i < buffer->count; i++){
+        geometry_real cross = (second_x[i] - first_x[i]) * (third_y[i] - first_y[i]) - (third_x[i] - first_x[i]) * (second_y[i] - first_y[i]);
+        areas[i] = GEOMETRY_FABS(cross) / 2;
+    }
+    return true;
+}
+
+/**
+*   Function to calculate perimeters of all triangles of given buffer
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*
+*   Out params:
+*       geometry_real* perimeters           array of at least buffer size elements
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_triangle_buffer_calculatePerimeters(geometry_triangle_buffer* buffer, geometry_real* perimeters){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_BUFFER_CALCULATE_PERIMETERS);
+    if(buffer == NULL || perimeters == NULL){
+        return false;
+    }
+    const geometry_real* first_x = buffer->coordinates[0];
+    const geometry_real* first_y = buffer->coordinates[1];
+    const geometry_real* second_x = buffer->coordinates[2];
+    const geometry_real* second_y = buffer->coordinates[3];
+    const geometry_real* third_x = buffer->coordinates[4];
+    const geometry_real* third_y = buffer->coordinates[5];
+    for(size_t i = 0; i < buffer->count; i++){
+        geometry_real first_second_x = second_x[i] - first_x[i];
+        geometry_real first_second_y = second_y[i] - first_y[i];
+        geometry_real first_third_x = third_x[i] - first_x[i];
+        geometry_real first_third_y = third_y[i] - first_y[i];
+        geometry_real second_third_x = third_x[i] - second_x[i];
+        geometry_real second_third_y = third_y[i] - second_y[i];
+        perimeters[i] = GEOMETRY_SQRT(first_second_x * first_second_x + first_second_y * first_second_y)
+                        + GEOMETRY_SQRT(first_third_x * first_third_x + first_third_y * first_third_y)
+                        + GEOMETRY_SQRT(second_third_x * second_third_x + second_third_y * second_third_y);
+    }
+    return true;
+}
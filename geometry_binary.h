@@ -0,0 +1,223 @@
+#ifndef GEOMETRY_BINARY
+#define GEOMETRY_BINARY
+
+#include "geometry.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Read-only buffer of triangles kept as separate arrays of coordinates (structure of arrays),
+// together with binary file format that is exactly the same layout, so loading a file is
+// a single mmap - no parsing and no allocation per triangle.
+//
+// File format (version 1), all values little-endian:
+//      offset  size    content
+//      0       8       magic "GEOMTRI\0"
+//      8       4       version (uint32)
+//      12      4       header size in bytes (uint32), multiple of 8, at least 64
+//      16      8       number of triangles n (uint64)
+//      24      4       size of coordinate s in bytes (uint32), 8 for double, 4 for float,
+//                      0 in files written before it was stored means 8
+//      28      36      reserved, zeros
+//      header  6 * sn  arrays of n coordinates: first x, first y, second x, second y, third x, third y
+//      ...     n       flags of every triangle (uint8), see GEOMETRY_TRIANGLE_BUFFER_FLAG_*
+// Readers accept headers larger than 64 bytes, so fields can be added to header without
+// breaking older files, and ignore unknown flag bits.
+// Coordinates are saved with precision of geometry_real, file of the other precision
+// is converted when loaded instead of being mapped.
+typedef struct geometry_triangle_buffer geometry_triangle_buffer;
+
+#define GEOMETRY_TRIANGLE_BUFFER_VERSION 1u
+// triangle should be considered right-angled
+#define GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT 0x01u
+
+/*##########################################################
+ GEOMETRY_TRIANGLE_BUFFER functions (methods) declarations
+###########################################################*/
+
+/**
+*   Function to create new geometry_triangle_buffer object with copies of given triangles
+*   In params:
+*       geometry_triangle** triangles   array of triangles, none may be NULL
+*       size_t count                    number of triangles
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle_buffer*       pointer to created object, NULL if error occured
+*/
+geometry_triangle_buffer* geometry_triangle_buffer_new(geometry_triangle** triangles, size_t count);
+
+/**
+*   Function to create new geometry_triangle_buffer object with copies of given triangles with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_triangle** triangles           array of triangles, none may be NULL
+*       size_t count                            number of triangles
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle_buffer*       pointer to created object, NULL if error occured
+*/
+geometry_triangle_buffer* geometry_triangle_buffer_new_with(const geometry_allocator* allocator, geometry_triangle** triangles, size_t count);
+
+/**
+*   Function to load geometry_triangle_buffer object from binary file
+*   On little-endian machines file with coordinates of geometry_real size is mapped to
+*   memory and arrays of buffer point straight into mapping, so no coordinates are copied.
+*   File must not be changed while buffer exists. File with coordinates of other size
+*   is read and converted.
+*   In params:
+*       const char* path                path of file
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle_buffer*       pointer to created object, NULL if file can't be read
+*                                       or is not valid triangle buffer file
+*/
+geometry_triangle_buffer* geometry_triangle_buffer_load(const char* path);
+
+/**
+*   Function to load geometry_triangle_buffer object from binary file with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       const char* path                        path of file
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle_buffer*       pointer to created object, NULL if file can't be read
+*                                       or is not valid triangle buffer file
+*/
+geometry_triangle_buffer* geometry_triangle_buffer_load_with(const geometry_allocator* allocator, const char* path);
+
+/**
+*   Function to destroy given geometry_triangle_buffer object, mapping of file is released
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_triangle_buffer_destroy(geometry_triangle_buffer* buffer);
+
+/**
+*   Function to write given buffer to binary file, file is replaced if it exists
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*       const char* path                    path of file
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_triangle_buffer_save(geometry_triangle_buffer* buffer, const char* path);
+
+/**
+*   Function to get number of triangles in given buffer
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                              number of triangles, 0 if buffer is NULL
+*/
+size_t geometry_triangle_buffer_getSize(geometry_triangle_buffer* buffer);
+
+/**
+*   Function to get arrays of coordinates of one vertex of all triangles
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*       size_t vertex                       0 for first, 1 for second and 2 for third vertex
+*
+*   Out params:
+*       const geometry_real** xs            x coordinates, array of buffer size elements
+*       const geometry_real** ys            y coordinates, array of buffer size elements
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_triangle_buffer_getCoordinates(geometry_triangle_buffer* buffer, size_t vertex, const geometry_real** xs, const geometry_real** ys);
+
+/**
+*   Function to get array of flags of all triangles
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const unsigned char*                flags, array of buffer size elements, NULL if buffer is NULL
+*/
+const unsigned char* geometry_triangle_buffer_getFlags(geometry_triangle_buffer* buffer);
+
+/**
+*   Function to check if triangle of given index is right-angled
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*       size_t index                        index of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if triangle is right-angled, false otherwise
+*                                           or if error occured
+*/
+bool geometry_triangle_buffer_getIsRight(geometry_triangle_buffer* buffer, size_t index);
+
+/**
+*   Function to create geometry_triangle object from triangle of given index
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*       size_t index                        index of triangle
+*       geometry_arena* arena               arena to allocate object from, NULL to take it from allocator of buffer
+*                                           (it must be freed with geometry_triangle_destroy_with then)
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*                  pointer to created object, NULL if error occured
+*/
+geometry_triangle* geometry_triangle_buffer_getTriangle(geometry_triangle_buffer* buffer, size_t index, geometry_arena* arena);
+
+/**
+*   Function to calculate areas of all triangles of given buffer
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*
+*   Out params:
+*       geometry_real* areas                array of at least buffer size elements
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_triangle_buffer_calculateAreas(geometry_triangle_buffer* buffer, geometry_real* areas);
+
+/**
+*   Function to calculate perimeters of all triangles of given buffer
+*   In params:
+*       geometry_triangle_buffer* buffer    buffer
+*
+*   Out params:
+*       geometry_real* perimeters           array of at least buffer size elements
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_triangle_buffer_calculatePerimeters(geometry_triangle_buffer* buffer, geometry_real* perimeters);
+
+#endif
@@ -0,0 +1,646 @@
+#include "geometry_buffer.h"
+#include "geometry_stats.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#define GEOMETRY_POINT_BUFFER_MIN_CAPACITY 16
+// Side of square tile of distance matrix - coordinates of 256 rows and 256 columns
+// take 8 KB, so both of them stay in L1 cache while tile is being filled
+#define GEOMETRY_POINT_BUFFER_TILE_SIZE 256
+// Number of rows calculated together in streaming mode
+#define GEOMETRY_POINT_BUFFER_STREAM_ROWS 8
+
+struct geometry_point_buffer {
+    geometry_real* xs;
+    geometry_real* ys;
+    size_t size;
+    size_t capacity;
+    geometry_allocator allocator;
+};
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static void geometry_point_buffer_translateKernel(geometry_real* restrict xs, geometry_real* restrict ys, size_t size, geometry_real vector_x, geometry_real vector_y);
+static void geometry_point_buffer_rotateKernel(geometry_real* restrict xs, geometry_real* restrict ys, size_t size, geometry_real cos_angle, geometry_real sin_angle, geometry_real reference_x, geometry_real reference_y);
+static void geometry_point_buffer_affineKernel(geometry_real* restrict xs, geometry_real* restrict ys, size_t size, const geometry_real coefficients[6]);
+static void geometry_point_buffer_distanceKernel(const geometry_real* restrict xs, const geometry_real* restrict ys, size_t size, geometry_real point_x, geometry_real point_y, geometry_real* restrict distances);
+static void geometry_point_buffer_squaredDistanceKernel(const geometry_real* restrict xs, const geometry_real* restrict ys, size_t size, geometry_real point_x, geometry_real point_y, geometry_real* restrict distances);
+static void geometry_point_buffer_fillTile(const geometry_point_buffer* rows, size_t row_begin, size_t row_end, const geometry_point_buffer* columns, size_t column_begin, size_t column_end, bool squared, geometry_real* matrix, size_t stride);
+static void geometry_point_buffer_mirrorTile(geometry_real* matrix, size_t stride, size_t row_begin, size_t row_end, size_t column_begin, size_t column_end);
+static bool geometry_point_buffer_calculateMatrix(geometry_point_buffer* rows, geometry_point_buffer* columns, bool squared, geometry_real* matrix);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+// Kernels below are plain loops over restrict-qualified arrays without any
+// branches or calls inside, that is the shape compilers auto-vectorize.
+// GCC does it only from -O3 (at -O2 it skips loops of unknown length),
+// so optimized targets of makefile are built with OPTFLAGS; vector width
+// depends on target flags (SSE2 by default on x86-64, AVX2 with -march=native)
+
+/**
+*   Function to add vector to every point in coordinate arrays
+*   In params:
+*       geometry_real* xs         x coordinates
+*       geometry_real* ys         y coordinates
+*       size_t size               number of points
+*       geometry_real vector_x    x coordinate of vector
+*       geometry_real vector_y    y coordinate of vector
+*
+*   Out params/return:
+*       none (arrays are changed)
+*/
+static void geometry_point_buffer_translateKernel(geometry_real* restrict xs, geometry_real* restrict ys, size_t size, geometry_real vector_x, geometry_real vector_y){
+    for(size_t i = 0; i < size; i++){
+        xs[i] += vector_x;
+        ys[i] += vector_y;
+    }
+}
+
+/**
+*   Function to rotate every point in coordinate arrays around reference point
+*   In params:
+*       geometry_real* xs            x coordinates
+*       geometry_real* ys            y coordinates
+*       size_t size                  number of points
+*       geometry_real cos_angle      cosine of rotation angle
+*       geometry_real sin_angle      sine of rotation angle
+*       geometry_real reference_x    x coordinate of reference point
+*       geometry_real reference_y    y coordinate of reference point
+*
+*   Out params/return:
+*       none (arrays are changed)
+*/
+static void geometry_point_buffer_rotateKernel(geometry_real* restrict xs, geometry_real* restrict ys, size_t size, geometry_real cos_angle, geometry_real sin_angle, geometry_real reference_x, geometry_real reference_y){
+    for(size_t i = 0; i < size; i++){
+        geometry_real dx = xs[i] - reference_x;
+        geometry_real dy = ys[i] - reference_y;
+        xs[i] = dx * cos_angle - dy * sin_angle + reference_x;
+        ys[i] = dx * sin_angle + dy * cos_angle + reference_y;
+    }
+}
+
+/**
+*   Function to apply affine transform to every point in coordinate arrays
+*   In params:
+*       geometry_real* xs                      x coordinates
+*       geometry_real* ys                      y coordinates
+*       size_t size                            number of points
+*       const geometry_real coefficients[6]    transform coefficients in order a, b, tx, c, d, ty
+*
+*   Out params/return:
+*       none (arrays are changed)
+*/
+static void geometry_point_buffer_affineKernel(geometry_real* restrict xs, geometry_real* restrict ys, size_t size, const geometry_real coefficients[6]){
+    geometry_real a = coefficients[0];
+    geometry_real b = coefficients[1];
+    geometry_real tx = coefficients[2];
+    geometry_real c = coefficients[3];
+    geometry_real d = coefficients[4];
+    geometry_real ty = coefficients[5];
+    for(size_t i = 0; i < size; i++){
+        geometry_real x = xs[i];
+        geometry_real y = ys[i];
+        xs[i] = a * x + b * y + tx;
+        ys[i] = c * x + d * y + ty;
+    }
+}
+
+/**
+*   Function to calculate distance of every point in coordinate arrays to given point
+*   In params:
+*       geometry_real* xs           x coordinates
+*       geometry_real* ys           y coordinates
+*       size_t size                 number of points
+*       geometry_real point_x       x coordinate of point
+*       geometry_real point_y       y coordinate of point
+*
+*   Out params:
+*       geometry_real* distances    calculated distances
+*
+*   Return:
+*       none
+*/
+static void geometry_point_buffer_distanceKernel(const geometry_real* restrict xs, const geometry_real* restrict ys, size_t size, geometry_real point_x, geometry_real point_y, geometry_real* restrict distances){
+    // sqrt becomes single vector instruction only with -fno-math-errno (OPTFLAGS),
+    // otherwise call setting errno for negative argument keeps loop scalar
+    for(size_t i = 0; i < size; i++){
+        geometry_real dx = xs[i] - point_x;
+        geometry_real dy = ys[i] - point_y;
+        distances[i] = GEOMETRY_SQRT(dx * dx + dy * dy);
+    }
+}
+
+/**
+*   Function to calculate squared distance of every point in coordinate arrays to given point
+*   In params:
+*       geometry_real* xs           x coordinates
+*       geometry_real* ys           y coordinates
+*       size_t size                 number of points
+*       geometry_real point_x       x coordinate of point
+*       geometry_real point_y       y coordinate of point
+*
+*   Out params:
+*       geometry_real* distances    calculated squared distances
+*
+*   Return:
+*       none
+*/
+static void geometry_point_buffer_squaredDistanceKernel(const geometry_real* restrict xs, const geometry_real* restrict ys, size_t size, geometry_real point_x, geometry_real point_y, geometry_real* restrict distances){
+    for(size_t i = 0; i < size; i++){
+        geometry_real dx = xs[i] - point_x;
+        geometry_real dy = ys[i] - point_y;
+        distances[i] = dx * dx + dy * dy;
+    }
+}
+
+/**
+*   Function to fill one tile of distance matrix
+*   In params:
+*       geometry_point_buffer* rows         points corresponding to rows of matrix
+*       size_t row_begin                    first row of tile
+*       size_t row_end                      row after last row of tile
+*       geometry_point_buffer* columns      points corresponding to columns of matrix
+*       size_t column_begin                 first column of tile
+*       size_t column_end                   column after last column of tile
+*       bool squared                        true if squared distances should be calculated
+*       size_t stride                       number of elements in one row of matrix
+*
+*   Out params:
+*       geometry_real* matrix               matrix with filled tile, row row_begin starts at matrix[0]
+*
+*   Return:
+*       none
+*/
+static void geometry_point_buffer_fillTile(const geometry_point_buffer* rows, size_t row_begin, size_t row_end, const geometry_point_buffer* columns, size_t column_begin, size_t column_end, bool squared, geometry_real* matrix, size_t stride){
+    const geometry_real* xs = columns->xs + column_begin;
+    const geometry_real* ys = columns->ys + column_begin;
+    size_t size = column_end - column_begin;
+    for(size_t i = row_begin; i < row_end; i++){
+        geometry_real* row = matrix + (i - row_begin) * stride + column_begin;
+        if(squared){
+            geometry_point_buffer_squaredDistanceKernel(xs, ys, size, rows->xs[i], rows->ys[i], row);
+        }
+        else{
+            geometry_point_buffer_distanceKernel(xs, ys, size, rows->xs[i], rows->ys[i], row);
+        }
+    }
+}
+
+/**
+*   Function to copy tile of square matrix to its symmetric place
+*   In params:
+*       size_t stride               number of elements in one row of matrix
+*       size_t row_begin            first row of tile
+*       size_t row_end              row after last row of tile
+*       size_t column_begin         first column of tile
+*       size_t column_end           column after last column of tile
+*
+*   Out params:
+*       geometry_real* matrix       matrix with copied tile
+*
+*   Return:
+*       none
+*/
+static void geometry_point_buffer_mirrorTile(geometry_real* matrix, size_t stride, size_t row_begin, size_t row_end, size_t column_begin, size_t column_end){
+    for(size_t i = row_begin; i < row_end; i++){
+        for(size_t j = column_begin; j < column_end; j++){
+            matrix[j * stride + i] = matrix[i * stride + j];
+        }
+    }
+}
+
+/**
+*   Function to calculate (squared) distance matrix tile by tile
+*   In params:
+*       geometry_point_buffer* rows         points corresponding to rows of matrix
+*       geometry_point_buffer* columns      points corresponding to columns of matrix
+*       bool squared                        true if squared distances should be calculated
+*
+*   Out params:
+*       geometry_real* matrix               calculated matrix
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+static bool geometry_point_buffer_calculateMatrix(geometry_point_buffer* rows, geometry_point_buffer* columns, bool squared, geometry_real* matrix){
+    if(rows == NULL || columns == NULL || matrix == NULL){
+        return false;
+    }
+    size_t row_count = rows->size;
+    size_t column_count = columns->size;
+    if(column_count != 0 && row_count > SIZE_MAX / sizeof(geometry_real) / column_count){
+        return false;
+    }
+    // Distance is symmetric, so for the same buffer only tiles on and above
+    // diagonal are calculated, tiles below are their copies
+    bool symmetric = rows == columns;
+    for(size_t row_begin = 0; row_begin < row_count; row_begin += GEOMETRY_POINT_BUFFER_TILE_SIZE){
+        size_t row_end = row_begin + GEOMETRY_POINT_BUFFER_TILE_SIZE < row_count ? row_begin + GEOMETRY_POINT_BUFFER_TILE_SIZE : row_count;
+        size_t first_column = symmetric ? row_begin : 0;
+        for(size_t column_begin = first_column; column_begin < column_count; column_begin += GEOMETRY_POINT_BUFFER_TILE_SIZE){
+            size_t column_end = column_begin + GEOMETRY_POINT_BUFFER_TILE_SIZE < column_count ? column_begin + GEOMETRY_POINT_BUFFER_TILE_SIZE : column_count;
+            geometry_point_buffer_fillTile(rows, row_begin, row_end, columns, column_begin, column_end, squared,
+                                            matrix + row_begin * column_count, column_count);
+            if(symmetric && column_begin != row_begin){
+                geometry_point_buffer_mirrorTile(matrix, column_count, row_begin, row_end, column_begin, column_end);
+            }
+        }
+    }
+    return true;
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new empty geometry_point_buffer object
+*   In params:
+*       size_t capacity                 number of points for which memory is reserved upfront
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point_buffer*          pointer to created object
+*/
+geometry_point_buffer* geometry_point_buffer_new(size_t capacity){
+    return geometry_point_buffer_new_with(NULL, capacity);
+}
+
+/**
+*   Function to create new empty geometry_point_buffer object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t capacity                         number of points for which memory is reserved upfront
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point_buffer*          pointer to created object
+*/
+geometry_point_buffer* geometry_point_buffer_new_with(const geometry_allocator* allocator, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_NEW);
+    geometry_point_buffer* new_buffer = geometry_allocator_allocate(allocator, sizeof(*new_buffer));
+    if(new_buffer == NULL){
+        return NULL;
+    }
+    new_buffer->xs = NULL;
+    new_buffer->ys = NULL;
+    new_buffer->size = 0;
+    new_buffer->capacity = 0;
+    new_buffer->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    if(!geometry_point_buffer_reserve(new_buffer, capacity)){
+        geometry_allocator_free(&new_buffer->allocator, new_buffer);
+        return NULL;
+    }
+    return new_buffer;
+}
+
+/**
+*   Function to destroy given geometry_point_buffer object
+*   In params:
+*       geometry_point_buffer* buffer       buffer object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_point_buffer_destroy(geometry_point_buffer* buffer){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_DESTROY);
+    if(buffer == NULL){
+        return;
+    }
+    geometry_allocator allocator = buffer->allocator;
+    geometry_allocator_free(&allocator, buffer->xs);
+    geometry_allocator_free(&allocator, buffer->ys);
+    geometry_allocator_free(&allocator, buffer);
+}
+
+/**
+*   Function to reserve memory for given number of points
+*   In params:
+*       geometry_point_buffer* buffer       buffer to grow
+*       size_t capacity                     requested number of points
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if memory couldn't be reserved
+*/
+bool geometry_point_buffer_reserve(geometry_point_buffer* buffer, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_RESERVE);
+    if(buffer == NULL){
+        return false;
+    }
+    if(capacity <= buffer->capacity){
+        return true;
+    }
+    if(capacity < GEOMETRY_POINT_BUFFER_MIN_CAPACITY){
+        capacity = GEOMETRY_POINT_BUFFER_MIN_CAPACITY;
+    }
+    if(capacity > SIZE_MAX / sizeof(geometry_real)){
+        return false;
+    }
+    geometry_real* new_xs = geometry_allocator_reallocate(&buffer->allocator, buffer->xs, buffer->capacity * sizeof(*new_xs), capacity * sizeof(*new_xs));
+    if(new_xs == NULL){
+        return false;
+    }
+    buffer->xs = new_xs;
+    geometry_real* new_ys = geometry_allocator_reallocate(&buffer->allocator, buffer->ys, buffer->capacity * sizeof(*new_ys), capacity * sizeof(*new_ys));
+    if(new_ys == NULL){
+        return false;
+    }
+    buffer->ys = new_ys;
+    buffer->capacity = capacity;
+    return true;
+}
+
+/**
+*   Function to remove all points from given buffer, reserved memory is kept
+*   In params:
+*       geometry_point_buffer* buffer       buffer to be cleared
+*
+*   Out params/return:
+*       none
+*/
+void geometry_point_buffer_clear(geometry_point_buffer* buffer){
+    if(buffer == NULL){
+        return;
+    }
+    buffer->size = 0;
+}
+
+/**
+*   Function to append point with given coordinates at the end of given buffer
+*   In params:
+*       geometry_point_buffer* buffer       buffer to append point to
+*       geometry_real x                     x coordinate
+*       geometry_real y                     y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_point_buffer_push(geometry_point_buffer* buffer, geometry_real x, geometry_real y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_PUSH);
+    if(buffer == NULL){
+        return false;
+    }
+    if(buffer->size == buffer->capacity && !geometry_point_buffer_reserve(buffer, buffer->capacity * 2 + 1)){
+        return false;
+    }
+    buffer->xs[buffer->size] = x;
+    buffer->ys[buffer->size] = y;
+    buffer->size++;
+    return true;
+}
+
+/**
+*   Function to get number of points stored in given buffer
+*   In params:
+*       geometry_point_buffer* buffer       buffer
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                              number of points, 0 if buffer is NULL
+*/
+size_t geometry_point_buffer_getSize(geometry_point_buffer* buffer){
+    if(buffer == NULL){
+        return 0;
+    }
+    return buffer->size;
+}
+
+/**
+*   Function to get x coordinate of point with given index
+*   In params:
+*       geometry_point_buffer* buffer       buffer
+*       size_t index                        index of point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       x coordinate of point, 0 if index is out of range
+*/
+geometry_real geometry_point_buffer_getX(geometry_point_buffer* buffer, size_t index){
+    if(buffer == NULL || index >= buffer->size){
+        return 0;
+    }
+    return buffer->xs[index];
+}
+
+/**
+*   Function to get y coordinate of point with given index
+*   In params:
+*       geometry_point_buffer* buffer       buffer
+*       size_t index                        index of point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       y coordinate of point, 0 if index is out of range
+*/
+geometry_real geometry_point_buffer_getY(geometry_point_buffer* buffer, size_t index){
+    if(buffer == NULL || index >= buffer->size){
+        return 0;
+    }
+    return buffer->ys[index];
+}
+
+/**
+*   Function to get direct access to coordinate arrays of given buffer
+*   Arrays are valid until next operation that changes size of buffer
+*   In params:
+*       geometry_point_buffer* buffer       buffer
+*
+*   Out params:
+*       geometry_real** xs                  array of x coordinates
+*       geometry_real** ys                  array of y coordinates
+*
+*   Return:
+*       none
+*/
+void geometry_point_buffer_getCoordinates(geometry_point_buffer* buffer, geometry_real** xs, geometry_real** ys){
+    if(buffer == NULL){
+        return;
+    }
+    *xs = buffer->xs;
+    *ys = buffer->ys;
+}
+
+/**
+*   Function to move all points of given buffer by vector
+*   User is expected to provide vector in normalized form;
+*   i.e. unbouned or origin-bounded
+*   In parms:
+*       geometry_point_buffer* buffer       points to be moved
+*       geometry_real vector_x              x coordinate of vector
+*       geometry_real vector_y              y coordinate of vector
+*
+*   Out params/return:
+*       none (buffer object is changed)
+*/
+void geometry_point_buffer_moveByVector(geometry_point_buffer* buffer, geometry_real vector_x, geometry_real vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_MOVE_BY_VECTOR);
+    if(buffer == NULL){
+        return;
+    }
+    geometry_point_buffer_translateKernel(buffer->xs, buffer->ys, buffer->size, vector_x, vector_y);
+}
+
+/**
+*   Function to rotate all points of given buffer through an angle around another point
+*   User is expected to provide angle measured in radians
+*   calculated counterclockwise
+*   In params:
+*       geometry_point_buffer* buffer       points to be rotated
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotations will be calculated
+*
+*   Out params/return:
+*       none (buffer object is changed)
+*/
+void geometry_point_buffer_rotateByAngle(geometry_point_buffer* buffer, geometry_real angle, geometry_point* reference_point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_ROTATE_BY_ANGLE);
+    if(buffer == NULL || reference_point == NULL){
+        return;
+    }
+    geometry_point_buffer_rotateKernel(buffer->xs, buffer->ys, buffer->size, GEOMETRY_COS(angle), GEOMETRY_SIN(angle),
+                                        geometry_point_getX(reference_point), geometry_point_getY(reference_point));
+    // For comments on these equations please refer to documentation
+}
+
+/**
+*   Function to apply given transform to all points of given buffer
+*   In params:
+*       geometry_point_buffer* buffer       points to be transformed
+*       geometry_transform* transform       transform to apply
+*
+*   Out params/return:
+*       none (buffer object is changed)
+*/
+void geometry_point_buffer_applyTransform(geometry_point_buffer* buffer, geometry_transform* transform){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_APPLY_TRANSFORM);
+    if(buffer == NULL || transform == NULL){
+        return;
+    }
+    geometry_real coefficients[6];
+    geometry_transform_getCoefficients(transform, coefficients);
+    geometry_point_buffer_affineKernel(buffer->xs, buffer->ys, buffer->size, coefficients);
+}
+
+/**
+*   Function to calculate distances between all points of given buffer and given point
+*   In params:
+*       geometry_point_buffer* buffer       points
+*       geometry_point* point               point to calculate distances to
+*
+*   Out params:
+*       geometry_real* distances            array of at least buffer size elements,
+*                                           i-th element is distance of i-th point
+*
+*   Return:
+*       none
+*/
+void geometry_point_buffer_calculateDistances(geometry_point_buffer* buffer, geometry_point* point, geometry_real* distances){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_CALCULATE_DISTANCES);
+    if(buffer == NULL || point == NULL || distances == NULL){
+        return;
+    }
+    geometry_point_buffer_distanceKernel(buffer->xs, buffer->ys, buffer->size,
+                                        geometry_point_getX(point), geometry_point_getY(point), distances);
+}
+
+/**
+*   Function to calculate distances between every point of first buffer and every point of second buffer
+*   Calculation goes in square tiles, so coordinates of both tiles stay in cache.
+*   If the same buffer is given twice, only half of matrix is calculated and the rest is mirrored.
+*   In params:
+*       geometry_point_buffer* rows         points corresponding to rows of matrix
+*       geometry_point_buffer* columns      points corresponding to columns of matrix
+*
+*   Out params:
+*       geometry_real* matrix               array of at least rows size * columns size elements,
+*                                           element [i * columns size + j] is distance between
+*                                           i-th point of rows and j-th point of columns
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_point_buffer_calculateDistanceMatrix(geometry_point_buffer* rows, geometry_point_buffer* columns, geometry_real* matrix){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_CALCULATE_DISTANCE_MATRIX);
+    return geometry_point_buffer_calculateMatrix(rows, columns, false, matrix);
+}
+
+/**
+*   Function to calculate squared distances between every point of first buffer and every point of second buffer
+*   Works as geometry_point_buffer_calculateDistanceMatrix without square roots,
+*   which is enough for comparing distances
+*   In params:
+*       geometry_point_buffer* rows         points corresponding to rows of matrix
+*       geometry_point_buffer* columns      points corresponding to columns of matrix
+*
+*   Out params:
+*       geometry_real* matrix               array of at least rows size * columns size elements,
+*                                           element [i * columns size + j] is squared distance between
+*                                           i-th point of rows and j-th point of columns
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_point_buffer_calculateSquaredDistanceMatrix(geometry_point_buffer* rows, geometry_point_buffer* columns, geometry_real* matrix){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_CALCULATE_SQUARED_DISTANCE_MATRIX);
+    return geometry_point_buffer_calculateMatrix(rows, columns, true, matrix);
+}
+
+/**
+*   Function to calculate distance matrix row by row and pass every row to given callback
+*   Only a few rows are kept in memory at once, so whole matrix never has to fit in memory.
+*   Rows are passed in increasing order.
+*   In params:
+*       geometry_point_buffer* rows                     points corresponding to rows of matrix
+*       geometry_point_buffer* columns                  points corresponding to columns of matrix
+*       bool squared                                    true if squared distances should be calculated
+*       geometry_point_buffer_row_callback callback     function called for every row
+*       void* context                                   pointer passed to every callback call
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                            true on success, false if error occured
+*/
+bool geometry_point_buffer_streamDistanceMatrix(geometry_point_buffer* rows, geometry_point_buffer* columns, bool squared, geometry_point_buffer_row_callback callback, void* context){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POINT_BUFFER_STREAM_DISTANCE_MATRIX);
+    if(rows == NULL || columns == NULL || callback == NULL){
+        return false;
+    }
+    size_t column_count = columns->size;
+    if(column_count > SIZE_MAX / sizeof(geometry_real) / GEOMETRY_POINT_BUFFER_STREAM_ROWS){
+        return false;
+    }
+    geometry_real* block = geometry_allocator_allocate(&rows->allocator, (column_count > 0 ? column_count : 1) * GEOMETRY_POINT_BUFFER_STREAM_ROWS * sizeof(*block));
+    if(block == NULL){
+        return false;
+    }
+    for(size_t row_begin = 0; row_begin < rows->size; row_begin += GEOMETRY_POINT_BUFFER_STREAM_ROWS){
+        size_t row_end = row_begin + GEOMETRY_POINT_BUFFER_STREAM_ROWS < rows->size ? row_begin + GEOMETRY_POINT_BUFFER_STREAM_ROWS : rows->size;
+        for(size_t column_begin = 0; column_begin < column_count; column_begin += GEOMETRY_POINT_BUFFER_TILE_SIZE){
+            size_t column_end = column_begin + GEOMETRY_POINT_BUFFER_TILE_SIZE < column_count ? column_begin + GEOMETRY_POINT_BUFFER_TILE_SIZE : column_count;
+            geometry_point_buffer_fillTile(rows, row_begin, row_end, columns, column_begin, column_end, squared, block, column_count);
+        }
+        for(size_t i = row_begin; i < row_end; i++){
+            callback(i, block + (i - row_begin) * column_count, column_count, context);
+        }
+    }
+    geometry_allocator_free(&rows->allocator, block);
+    return true;
+}
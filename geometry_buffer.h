@@ -0,0 +1,266 @@
+#ifndef GEOMETRY_BUFFER
+#define GEOMETRY_BUFFER
+
+#include "geometry.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Structure-of-arrays container for large sets of points.
+// Coordinates are kept in two separate arrays (all x, then all y),
+// so batch operations run over contiguous memory and can be vectorized
+// by compiler (at -O3 with GCC) instead of chasing one geometry_point* at a time.
+typedef struct geometry_point_buffer geometry_point_buffer;
+
+// Function called by geometry_point_buffer_streamDistanceMatrix for every row
+// of distance matrix - row is index of point in first buffer, distances[j] is
+// distance (or squared distance) between that point and j-th point of second
+// buffer. Distances array is valid only during the call.
+typedef void (*geometry_point_buffer_row_callback)(size_t row, const geometry_real* distances, size_t count, void* context);
+
+/*######################################################
+ GEOMETRY_POINT_BUFFER functions (methods) declarations
+#######################################################*/
+
+/**
+*   Function to create new empty geometry_point_buffer object
+*   In params:
+*       size_t capacity                 number of points for which memory is reserved upfront
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point_buffer*          pointer to created object
+*/
+geometry_point_buffer* geometry_point_buffer_new(size_t capacity);
+
+/**
+*   Function to create new empty geometry_point_buffer object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t capacity                         number of points for which memory is reserved upfront
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point_buffer*          pointer to created object
+*/
+geometry_point_buffer* geometry_point_buffer_new_with(const geometry_allocator* allocator, size_t capacity);
+
+/**
+*   Function to destroy given geometry_point_buffer object
+*   In params:
+*       geometry_point_buffer* buffer       buffer object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_point_buffer_destroy(geometry_point_buffer* buffer);
+
+/**
+*   Function to reserve memory for given number of points
+*   In params:
+*       geometry_point_buffer* buffer       buffer to grow
+*       size_t capacity                     requested number of points
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if memory couldn't be reserved
+*/
+bool geometry_point_buffer_reserve(geometry_point_buffer* buffer, size_t capacity);
+
+/**
+*   Function to remove all points from given buffer, reserved memory is kept
+*   In params:
+*       geometry_point_buffer* buffer       buffer to be cleared
+*
+*   Out params/return:
+*       none
+*/
+void geometry_point_buffer_clear(geometry_point_buffer* buffer);
+
+/**
+*   Function to append point with given coordinates at the end of given buffer
+*   In params:
+*       geometry_point_buffer* buffer       buffer to append point to
+*       geometry_real x                     x coordinate
+*       geometry_real y                     y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_point_buffer_push(geometry_point_buffer* buffer, geometry_real x, geometry_real y);
+
+/**
+*   Function to get number of points stored in given buffer
+*   In params:
+*       geometry_point_buffer* buffer       buffer
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                              number of points, 0 if buffer is NULL
+*/
+size_t geometry_point_buffer_getSize(geometry_point_buffer* buffer);
+
+/**
+*   Function to get x coordinate of point with given index
+*   In params:
+*       geometry_point_buffer* buffer       buffer
+*       size_t index                        index of point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       x coordinate of point, 0 if index is out of range
+*/
+geometry_real geometry_point_buffer_getX(geometry_point_buffer* buffer, size_t index);
+
+/**
+*   Function to get y coordinate of point with given index
+*   In params:
+*       geometry_point_buffer* buffer       buffer
+*       size_t index                        index of point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       y coordinate of point, 0 if index is out of range
+*/
+geometry_real geometry_point_buffer_getY(geometry_point_buffer* buffer, size_t index);
+
+/**
+*   Function to get direct access to coordinate arrays of given buffer
+*   Arrays are valid until next operation that changes size of buffer
+*   In params:
+*       geometry_point_buffer* buffer       buffer
+*
+*   Out params:
+*       geometry_real** xs                  array of x coordinates
+*       geometry_real** ys                  array of y coordinates
+*
+*   Return:
+*       none
+*/
+void geometry_point_buffer_getCoordinates(geometry_point_buffer* buffer, geometry_real** xs, geometry_real** ys);
+
+/**
+*   Function to move all points of given buffer by vector
+*   User is expected to provide vector in normalized form;
+*   i.e. unbouned or origin-bounded
+*   In parms:
+*       geometry_point_buffer* buffer       points to be moved
+*       geometry_real vector_x              x coordinate of vector
+*       geometry_real vector_y              y coordinate of vector
+*
+*   Out params/return:
+*       none (buffer object is changed)
+*/
+void geometry_point_buffer_moveByVector(geometry_point_buffer* buffer, geometry_real vector_x, geometry_real vector_y);
+
+/**
+*   Function to rotate all points of given buffer through an angle around another point
+*   User is expected to provide angle measured in radians
+*   calculated counterclockwise
+*   In params:
+*       geometry_point_buffer* buffer       points to be rotated
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotations will be calculated
+*
+*   Out params/return:
+*       none (buffer object is changed)
+*/
+void geometry_point_buffer_rotateByAngle(geometry_point_buffer* buffer, geometry_real angle, geometry_point* reference_point);
+
+/**
+*   Function to apply given transform to all points of given buffer
+*   In params:
+*       geometry_point_buffer* buffer       points to be transformed
+*       geometry_transform* transform       transform to apply
+*
+*   Out params/return:
+*       none (buffer object is changed)
+*/
+void geometry_point_buffer_applyTransform(geometry_point_buffer* buffer, geometry_transform* transform);
+
+/**
+*   Function to calculate distances between all points of given buffer and given point
+*   In params:
+*       geometry_point_buffer* buffer       points
+*       geometry_point* point               point to calculate distances to
+*
+*   Out params:
+*       geometry_real* distances            array of at least buffer size elements,
+*                                           i-th element is distance of i-th point
+*
+*   Return:
+*       none
+*/
+void geometry_point_buffer_calculateDistances(geometry_point_buffer* buffer, geometry_point* point, geometry_real* distances);
+
+/**
+*   Function to calculate distances between every point of first buffer and every point of second buffer
+*   Calculation goes in square tiles, so coordinates of both tiles stay in cache.
+*   If the same buffer is given twice, only half of matrix is calculated and the rest is mirrored.
+*   In params:
+*       geometry_point_buffer* rows         points corresponding to rows of matrix
+*       geometry_point_buffer* columns      points corresponding to columns of matrix
+*
+*   Out params:
+*       geometry_real* matrix               array of at least rows size * columns size elements,
+*                                           element [i * columns size + j] is distance between
+*                                           i-th point of rows and j-th point of columns
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_point_buffer_calculateDistanceMatrix(geometry_point_buffer* rows, geometry_point_buffer* columns, geometry_real* matrix);
+
+/**
+*   Function to calculate squared distances between every point of first buffer and every point of second buffer
+*   Works as geometry_point_buffer_calculateDistanceMatrix without square roots,
+*   which is enough for comparing distances
+*   In params:
+*       geometry_point_buffer* rows         points corresponding to rows of matrix
+*       geometry_point_buffer* columns      points corresponding to columns of matrix
+*
+*   Out params:
+*       geometry_real* matrix               array of at least rows size * columns size elements,
+*                                           element [i * columns size + j] is squared distance between
+*                                           i-th point of rows and j-th point of columns
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_point_buffer_calculateSquaredDistanceMatrix(geometry_point_buffer* rows, geometry_point_buffer* columns, geometry_real* matrix);
+
+/**
+*   Function to calculate distance matrix row by row and pass every row to given callback
+*   Only a few rows are kept in memory at once, so whole matrix never has to fit in memory.
+*   Rows are passed in increasing order.
+*   In params:
+*       geometry_point_buffer* rows                     points corresponding to rows of matrix
+*       geometry_point_buffer* columns                  points corresponding to columns of matrix
+*       bool squared                                    true if squared distances should be calculated
+*       geometry_point_buffer_row_callback callback     function called for every row
+*       void* context                                   pointer passed to every callback call
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                            true on success, false if error occured
+*/
+bool geometry_point_buffer_streamDistanceMatrix(geometry_point_buffer* rows, geometry_point_buffer* columns, bool squared, geometry_point_buffer_row_callback callback, void* context);
+
+#endif
@@ -0,0 +1,972 @@
+#include "geometry_bvh.h"
+#include "geometry_stats.h"
+#include "geometry_predicates.h"
+#include <stdlib.h>
+#include <math.h>
+
+#define GEOMETRY_BVH_NONE ((size_t)-1)
+#define GEOMETRY_BVH_MIN_CAPACITY 16
+// tree is balanced, so its height stays far below this even for billions of triangles
+#define GEOMETRY_BVH_STACK_SIZE 256
+
+typedef struct geometry_bvh_box {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+} geometry_bvh_box;
+
+// Node of tree - leaf holds triangle, inner node has two children.
+// Unused nodes form a list through parent field and have height -1.
+typedef struct geometry_bvh_node {
+    geometry_bvh_box box;
+    geometry_triangle* triangle;
+    size_t parent;
+    size_t first_child;
+    size_t second_child;
+    int height;
+} geometry_bvh_node;
+
+struct geometry_bvh {
+    geometry_bvh_node* nodes;
+    size_t node_capacity;
+    size_t first_free;
+    size_t root;
+    double margin;
+    geometry_allocator allocator;
+};
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static geometry_bvh_box geometry_bvh_union(geometry_bvh_box* first, geometry_bvh_box* second);
+static double geometry_bvh_perimeter(geometry_bvh_box* box);
+static bool geometry_bvh_overlap(geometry_bvh_box* first, geometry_bvh_box* second);
+static bool geometry_bvh_contains(geometry_bvh_box* outer, geometry_bvh_box* inner);
+static geometry_bvh_box geometry_bvh_triangleBox(geometry_triangle* triangle);
+static bool geometry_bvh_isLeaf(geometry_bvh* bvh, size_t id);
+static size_t geometry_bvh_allocateNode(geometry_bvh* bvh);
+static void geometry_bvh_freeNode(geometry_bvh* bvh, size_t node);
+static void geometry_bvh_fixUpwards(geometry_bvh* bvh, size_t node);
+static size_t geometry_bvh_balance(geometry_bvh* bvh, size_t node);
+static bool geometry_bvh_insertLeaf(geometry_bvh* bvh, size_t leaf);
+static void geometry_bvh_removeLeaf(geometry_bvh* bvh, size_t leaf);
+static bool geometry_bvh_containsPoint(geometry_triangle* triangle, double x, double y);
+static double geometry_bvh_rayBox(geometry_bvh_box* box, double origin_x, double origin_y, double direction_x, double direction_y);
+static double geometry_bvh_rayTriangle(geometry_triangle* triangle, double origin_x, double origin_y, double direction_x, double direction_y);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to calculate the smallest box containing two boxes
+*   In params:
+*       geometry_bvh_box* first     first box
+*       geometry_bvh_box* second    second box
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_bvh_box            union of boxes
+*/
+static geometry_bvh_box geometry_bvh_union(geometry_bvh_box* first, geometry_bvh_box* second){
+    geometry_bvh_box result;
+    result.min_x = fmin(first->min_x, second->min_x);
+    result.min_y = fmin(first->min_y, second->min_y);
+    result.max_x = fmax(first->max_x, second->max_x);
+    result.max_y = fmax(first->max_y, second->max_y);
+    return result;
+}
+
+/**
+*   Function to calculate perimeter of box, used as cost of node
+*   In params:
+*       geometry_bvh_box* box       box
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       double                      perimeter of box
+*/
+static double geometry_bvh_perimeter(geometry_bvh_box* box){
+    return 2 * ((box->max_x - box->min_x) + (box->max_y - box->min_y));
+}
+
+/**
+*   Function to check if two boxes overlap, touching boxes overlap
+*   In params:
+*       geometry_bvh_box* first     first box
+*       geometry_bvh_box* second    second box
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true if boxes overlap
+*/
+static bool geometry_bvh_overlap(geometry_bvh_box* first, geometry_bvh_box* second){
+    return first->min_x <= second->max_x && second->min_x <= first->max_x
+        && first->min_y <= second->max_y && second->min_y <= first->max_y;
+}
+
+/**
+*   Function to check if one box lies inside another one
+*   In params:
+*       geometry_bvh_box* outer     outer box
+*       geometry_bvh_box* inner     inner box
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true if inner box lies inside outer box
+*/
+static bool geometry_bvh_contains(geometry_bvh_box* outer, geometry_bvh_box* inner){
+    return outer->min_x <= inner->min_x && outer->min_y <= inner->min_y
+        && inner->max_x <= outer->max_x && inner->max_y <= outer->max_y;
+}
+
+/**
+*   Function to get bounding box of triangle
+*   In params:
+*       geometry_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_bvh_box                bounding box of triangle
+*/
+static geometry_bvh_box geometry_bvh_triangleBox(geometry_triangle* triangle){
+    geometry_real min_x, min_y, max_x, max_y;
+    geometry_triangle_getBoundingBox(triangle, &min_x, &min_y, &max_x, &max_y);
+    geometry_bvh_box box = {min_x, min_y, max_x, max_y};
+    return box;
+}
+
+/**
+*   Function to check if id is an id of triangle kept in tree
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t id               checked id
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true if id belongs to leaf of tree
+*/
+static bool geometry_bvh_isLeaf(geometry_bvh* bvh, size_t id){
+    return bvh != NULL && id < bvh->node_capacity && bvh->nodes[id].height == 0;
+}
+
+/**
+*   Function to take unused node, nodes array grows when there are none
+*   In params:
+*       geometry_bvh* bvh       tree
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  index of node, GEOMETRY_BVH_NONE if memory couldn't be reserved
+*/
+static size_t geometry_bvh_allocateNode(geometry_bvh* bvh){
+    if(bvh->first_free == GEOMETRY_BVH_NONE){
+        size_t capacity = bvh->node_capacity * 2;
+        geometry_bvh_node* nodes = geometry_allocator_reallocate(&bvh->allocator, bvh->nodes, bvh->node_capacity * sizeof(*nodes), capacity * sizeof(*nodes));
+        if(nodes == NULL){
+            return GEOMETRY_BVH_NONE;
+        }
+        for(size_t i = bvh->node_capacity; i < capacity; i++){
+            nodes[i].parent = i + 1 < capacity ? i + 1 : GEOMETRY_BVH_NONE;
+            nodes[i].height = -1;
+        }
+        bvh->first_free = bvh->node_capacity;
+        bvh->nodes = nodes;
+        bvh->node_capacity = capacity;
+    }
+    size_t node = bvh->first_free;
+    geometry_bvh_node* new_node = &bvh->nodes[node];
+    bvh->first_free = new_node->parent;
+    new_node->parent = GEOMETRY_BVH_NONE;
+    new_node->first_child = GEOMETRY_BVH_NONE;
+    new_node->second_child = GEOMETRY_BVH_NONE;
+    new_node->triangle = NULL;
+    new_node->height = 0;
+    return node;
+}
+
+/**
+*   Function to return node to the list of unused nodes
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t node             index of node
+*
+*   Out params/return:
+*       none (tree is changed)
+*/
+static void geometry_bvh_freeNode(geometry_bvh* bvh, size_t node){
+    bvh->nodes[node].parent = bvh->first_free;
+    bvh->nodes[node].height = -1;
+    bvh->nodes[node].triangle = NULL;
+    bvh->first_free = node;
+}
+
+/**
+*   Function to balance and recalculate boxes and heights of all ancestors starting from given node
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t node             first node to fix
+*
+*   Out params/return:
+*       none (tree is changed)
+*/
+static void geometry_bvh_fixUpwards(geometry_bvh* bvh, size_t node){
+    geometry_bvh_node* nodes = bvh->nodes;
+    while(node != GEOMETRY_BVH_NONE){
+        node = geometry_bvh_balance(bvh, node);
+        geometry_bvh_node* first = &nodes[nodes[node].first_child];
+        geometry_bvh_node* second = &nodes[nodes[node].second_child];
+        nodes[node].height = 1 + (first->height > second->height ? first->height : second->height);
+        nodes[node].box = geometry_bvh_union(&first->box, &second->box);
+        node = nodes[node].parent;
+    }
+}
+
+/**
+*   Function to rotate subtree if heights of its children differ by more than one
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t node             root of subtree
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  new root of subtree
+*/
+static size_t geometry_bvh_balance(geometry_bvh* bvh, size_t node){
+    geometry_bvh_node* nodes = bvh->nodes;
+    geometry_bvh_node* top = &nodes[node];
+    if(top->height < 2){
+        return node;
+    }
+    size_t first = top->first_child;
+    size_t second = top->second_child;
+    int balance = nodes[second].height - nodes[first].height;
+    if(balance >= -1 && balance <= 1){
+        return node;
+    }
+    // higher child goes up, its higher child stays with it and the lower one goes down
+    bool second_higher = balance > 1;
+    size_t raised = second_higher ? second : first;
+    size_t kept = second_higher ? first : second;
+    size_t raised_first = nodes[raised].first_child;
+    size_t raised_second = nodes[raised].second_child;
+    size_t stays = nodes[raised_first].height > nodes[raised_second].height ? raised_first : raised_second;
+    size_t moves = stays == raised_first ? raised_second : raised_first;
+    nodes[raised].parent = top->parent;
+    top->parent = raised;
+    if(nodes[raised].parent == GEOMETRY_BVH_NONE){
+        bvh->root = raised;
+    }
+    else if(nodes[nodes[raised].parent].first_child == node){
+        nodes[nodes[raised].parent].first_child = raised;
+    }
+    else{
+        nodes[nodes[raised].parent].second_child = raised;
+    }
+    nodes[raised].first_child = node;
+    nodes[raised].second_child = stays;
+    if(second_higher){
+        top->second_child = moves;
+    }
+    else{
+        top->first_child = moves;
+    }
+    nodes[moves].parent = node;
+    top->box = geometry_bvh_union(&nodes[kept].box, &nodes[moves].box);
+    top->height = 1 + (nodes[kept].height > nodes[moves].height ? nodes[kept].height : nodes[moves].height);
+    nodes[raised].box = geometry_bvh_union(&top->box, &nodes[stays].box);
+    nodes[raised].height = 1 + (top->height > nodes[stays].height ? top->height : nodes[stays].height);
+    return raised;
+}
+
+/**
+*   Function to put leaf into tree next to sibling giving the smallest growth of boxes
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t leaf             leaf node with box already set
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if memory couldn't be reserved
+*/
+static bool geometry_bvh_insertLeaf(geometry_bvh* bvh, size_t leaf){
+    if(bvh->root == GEOMETRY_BVH_NONE){
+        bvh->root = leaf;
+        bvh->nodes[leaf].parent = GEOMETRY_BVH_NONE;
+        return true;
+    }
+    // parent is allocated first, as it may move nodes array
+    size_t new_parent = geometry_bvh_allocateNode(bvh);
+    if(new_parent == GEOMETRY_BVH_NONE){
+        return false;
+    }
+    geometry_bvh_node* nodes = bvh->nodes;
+    geometry_bvh_box leaf_box = nodes[leaf].box;
+    size_t sibling = bvh->root;
+    while(nodes[sibling].height > 0){
+        geometry_bvh_box combined = geometry_bvh_union(&nodes[sibling].box, &leaf_box);
+        double combined_perimeter = geometry_bvh_perimeter(&combined);
+        // cost of making new parent for leaf and this node
+        double cost = 2 * combined_perimeter;
+        // every ancestor of leaf grows when it goes further down
+        double inherited_cost = 2 * (combined_perimeter - geometry_bvh_perimeter(&nodes[sibling].box));
+        double child_costs[2];
+        size_t children[2] = {nodes[sibling].first_child, nodes[sibling].second_child};
+        for(int i = 0; i < 2; i++){
+            geometry_bvh_box child_combined = geometry_bvh_union(&nodes[children[i]].box, &leaf_box);
+            child_costs[i] = geometry_bvh_perimeter(&child_combined) + inherited_cost;
+            if(nodes[children[i]].height > 0){
+                child_costs[i] -= geometry_bvh_perimeter(&nodes[children[i]].box);
+            }
+        }
+        if(cost < child_costs[0] && cost < child_costs[1]){
+            break;
+        }
+        sibling = child_costs[0] < child_costs[1] ? children[0] : children[1];
+    }
+    size_t old_parent = nodes[sibling].parent;
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].box = geometry_bvh_union(&nodes[sibling].box, &leaf_box);
+    nodes[new_parent].height = nodes[sibling].height + 1;
+    nodes[new_parent].first_child = sibling;
+    nodes[new_parent].second_child = leaf;
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+    if(old_parent == GEOMETRY_BVH_NONE){
+        bvh->root = new_parent;
+    }
+    else if(nodes[old_parent].first_child == sibling){
+        nodes[old_parent].first_child = new_parent;
+    }
+    else{
+        nodes[old_parent].second_child = new_parent;
+    }
+    geometry_bvh_fixUpwards(bvh, new_parent);
+    return true;
+}
+
+/**
+*   Function to take leaf out of tree, leaf node itself is not freed
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t leaf             leaf node
+*
+*   Out params/return:
+*       none (tree is changed)
+*/
+static void geometry_bvh_removeLeaf(geometry_bvh* bvh, size_t leaf){
+    geometry_bvh_node* nodes = bvh->nodes;
+    if(leaf == bvh->root){
+        bvh->root = GEOMETRY_BVH_NONE;
+        return;
+    }
+    size_t parent = nodes[leaf].parent;
+    size_t grandparent = nodes[parent].parent;
+    size_t sibling = nodes[parent].first_child == leaf ? nodes[parent].second_child : nodes[parent].first_child;
+    nodes[sibling].parent = grandparent;
+    if(grandparent == GEOMETRY_BVH_NONE){
+        bvh->root = sibling;
+    }
+    else if(nodes[grandparent].first_child == parent){
+        nodes[grandparent].first_child = sibling;
+    }
+    else{
+        nodes[grandparent].second_child = sibling;
+    }
+    geometry_bvh_freeNode(bvh, parent);
+    geometry_bvh_fixUpwards(bvh, grandparent);
+}
+
+/**
+*   Function to check if point lies inside triangle or on its side
+*   In params:
+*       geometry_triangle* triangle     triangle
+*       double x, y                     point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true if point lies in triangle
+*/
+static bool geometry_bvh_containsPoint(geometry_triangle* triangle, double x, double y){
+    geometry_real xs[3];
+    geometry_real ys[3];
+    geometry_triangle_getCoordinates(triangle, xs, ys);
+    geometry_real min_x, min_y, max_x, max_y;
+    geometry_triangle_getBoundingBox(triangle, &min_x, &min_y, &max_x, &max_y);
+    if(x < min_x || x > max_x || y < min_y || y > max_y){
+        return false;
+    }
+    bool positive = false;
+    bool negative = false;
+    for(int i = 0; i < 3; i++){
+        double start_x = xs[i];
+        double start_y = ys[i];
+        double end_x = xs[(i + 1) % 3];
+        double end_y = ys[(i + 1) % 3];
+        int side = geometry_predicates_orientation(start_x, start_y, end_x, end_y, x, y);
+        positive |= side > 0;
+        negative |= side < 0;
+    }
+    return !(positive && negative);
+}
+
+/**
+*   Function to calculate where ray enters box
+*   In params:
+*       geometry_bvh_box* box               box
+*       double origin_x, origin_y           origin of ray
+*       double direction_x, direction_y     direction of ray
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       double                              parameter of entry point (0 if origin is inside box),
+*                                           INFINITY if ray misses box
+*/
+static double geometry_bvh_rayBox(geometry_bvh_box* box, double origin_x, double origin_y, double direction_x, double direction_y){
+    double enter = 0;
+    double leave = INFINITY;
+    double origins[2] = {origin_x, origin_y};
+    double directions[2] = {direction_x, direction_y};
+    double mins[2] = {box->min_x, box->min_y};
+    double maxs[2] = {box->max_x, box->max_y};
+    for(int axis = 0; axis < 2; axis++){
+        if(directions[axis] == 0){
+            if(origins[axis] < mins[axis] || origins[axis] > maxs[axis]){
+                return INFINITY;
+            }
+            continue;
+        }
+        double first = (mins[axis] - origins[axis]) / directions[axis];
+        double second = (maxs[axis] - origins[axis]) / directions[axis];
+        enter = fmax(enter, fmin(first, second));
+        leave = fmin(leave, fmax(first, second));
+    }
+    return enter <= leave ? enter : INFINITY;
+}
+
+/**
+*   Function to calculate where ray hits triangle
+*   In params:
+*       geometry_triangle* triangle         triangle
+*       double origin_x, origin_y           origin of ray
+*       double direction_x, direction_y     direction of ray
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       double                              parameter of hit point (0 if origin is inside triangle),
+*                                           INFINITY if ray misses triangle
+*/
+static double geometry_bvh_rayTriangle(geometry_triangle* triangle, double origin_x, double origin_y, double direction_x, double direction_y){
+    if(geometry_bvh_containsPoint(triangle, origin_x, origin_y)){
+        return 0;
+    }
+    geometry_real xs[3];
+    geometry_real ys[3];
+    geometry_triangle_getCoordinates(triangle, xs, ys);
+    double hit = INFINITY;
+    for(int i = 0; i < 3; i++){
+        double start_x = xs[i];
+        double start_y = ys[i];
+        double side_x = xs[(i + 1) % 3] - start_x;
+        double side_y = ys[(i + 1) % 3] - start_y;
+        double offset_x = start_x - origin_x;
+        double offset_y = start_y - origin_y;
+        // origin + t * direction = start + u * side
+        double denominator = direction_x * side_y - direction_y * side_x;
+        if(denominator == 0){
+            // side parallel to ray, it is hit by its end only if it lies on ray
+            if(offset_x * direction_y - offset_y * direction_x == 0){
+                double length = direction_x * direction_x + direction_y * direction_y;
+                double first = (offset_x * direction_x + offset_y * direction_y) / length;
+                double second = ((offset_x + side_x) * direction_x + (offset_y + side_y) * direction_y) / length;
+                if(first >= 0){
+                    hit = fmin(hit, first);
+                }
+                if(second >= 0){
+                    hit = fmin(hit, second);
+                }
+            }
+            continue;
+        }
+        double t = (offset_x * side_y - offset_y * side_x) / denominator;
+        double u = (offset_x * direction_y - offset_y * direction_x) / denominator;
+        if(t >= 0 && u >= 0 && u <= 1){
+            hit = fmin(hit, t);
+        }
+    }
+    return hit;
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new empty geometry_bvh object
+*   In params:
+*       double margin           distance by which bounding boxes of leaves are enlarged,
+*                               bigger margin means less updates of tree but looser boxes
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_bvh*           pointer to created object, NULL if error occured
+*/
+geometry_bvh* geometry_bvh_new(double margin){
+    return geometry_bvh_new_with(NULL, margin);
+}
+
+/**
+*   Function to create new empty geometry_bvh object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       double margin                           distance by which bounding boxes of leaves are enlarged,
+*                                               bigger margin means less updates of tree but looser boxes
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_bvh*           pointer to created object, NULL if error occured
+*/
+geometry_bvh* geometry_bvh_new_with(const geometry_allocator* allocator, double margin){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_NEW);
+    if(!(margin >= 0) || isinf(margin)){
+        return NULL;
+    }
+    geometry_bvh* new_bvh = geometry_allocator_allocate(allocator, sizeof(*new_bvh));
+    geometry_bvh_node* nodes = geometry_allocator_allocate(allocator, GEOMETRY_BVH_MIN_CAPACITY * sizeof(*nodes));
+    if(new_bvh == NULL || nodes == NULL){
+        geometry_allocator_free(allocator, new_bvh);
+        geometry_allocator_free(allocator, nodes);
+        return NULL;
+    }
+    for(size_t i = 0; i < GEOMETRY_BVH_MIN_CAPACITY; i++){
+        nodes[i].parent = i + 1 < GEOMETRY_BVH_MIN_CAPACITY ? i + 1 : GEOMETRY_BVH_NONE;
+        nodes[i].height = -1;
+    }
+    new_bvh->nodes = nodes;
+    new_bvh->node_capacity = GEOMETRY_BVH_MIN_CAPACITY;
+    new_bvh->first_free = 0;
+    new_bvh->root = GEOMETRY_BVH_NONE;
+    new_bvh->margin = margin;
+    new_bvh->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    return new_bvh;
+}
+
+/**
+*   Function to destroy given geometry_bvh object
+*   Triangles kept in tree are not destroyed
+*   In params:
+*       geometry_bvh* bvh       tree object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_bvh_destroy(geometry_bvh* bvh){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_DESTROY);
+    if(bvh == NULL){
+        return;
+    }
+    geometry_allocator allocator = bvh->allocator;
+    geometry_allocator_free(&allocator, bvh->nodes);
+    geometry_allocator_free(&allocator, bvh);
+}
+
+/**
+*   Function to add triangle to tree
+*   In params:
+*       geometry_bvh* bvh               tree
+*       geometry_triangle* triangle     triangle to add
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                          id of triangle in tree, (size_t)-1 if error occured
+*/
+size_t geometry_bvh_insert(geometry_bvh* bvh, geometry_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_INSERT);
+    if(bvh == NULL || triangle == NULL){
+        return GEOMETRY_BVH_NONE;
+    }
+    size_t leaf = geometry_bvh_allocateNode(bvh);
+    if(leaf == GEOMETRY_BVH_NONE){
+        return GEOMETRY_BVH_NONE;
+    }
+    geometry_bvh_node* node = &bvh->nodes[leaf];
+    node->triangle = triangle;
+    node->box = geometry_bvh_triangleBox(triangle);
+    node->box.min_x -= bvh->margin;
+    node->box.min_y -= bvh->margin;
+    node->box.max_x += bvh->margin;
+    node->box.max_y += bvh->margin;
+    if(!geometry_bvh_insertLeaf(bvh, leaf)){
+        geometry_bvh_freeNode(bvh, leaf);
+        return GEOMETRY_BVH_NONE;
+    }
+    return leaf;
+}
+
+/**
+*   Function to remove triangle from tree
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t id               id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if there is no such triangle in tree
+*/
+bool geometry_bvh_remove(geometry_bvh* bvh, size_t id){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_REMOVE);
+    if(!geometry_bvh_isLeaf(bvh, id)){
+        return false;
+    }
+    geometry_bvh_removeLeaf(bvh, id);
+    geometry_bvh_freeNode(bvh, id);
+    return true;
+}
+
+/**
+*   Function to refit tree after triangle was changed (moved, rotated, transformed)
+*   Tree is changed only if triangle left its enlarged bounding box
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t id               id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if there is no such triangle in tree
+*/
+bool geometry_bvh_update(geometry_bvh* bvh, size_t id){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_UPDATE);
+    if(!geometry_bvh_isLeaf(bvh, id)){
+        return false;
+    }
+    geometry_bvh_box box = geometry_bvh_triangleBox(bvh->nodes[id].triangle);
+    if(geometry_bvh_contains(&bvh->nodes[id].box, &box)){
+        return true;
+    }
+    geometry_bvh_removeLeaf(bvh, id);
+    box.min_x -= bvh->margin;
+    box.min_y -= bvh->margin;
+    box.max_x += bvh->margin;
+    box.max_y += bvh->margin;
+    bvh->nodes[id].box = box;
+    // parent node freed by removal is reused, so it can't fail
+    return geometry_bvh_insertLeaf(bvh, id);
+}
+
+/**
+*   Function to refit tree after any number of triangles were changed
+*   In params:
+*       geometry_bvh* bvh       tree
+*
+*   Out params/return:
+*       none (tree is changed)
+*/
+void geometry_bvh_refit(geometry_bvh* bvh){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_REFIT);
+    if(bvh == NULL){
+        return;
+    }
+    // leaves keep their indices when reinserted, only inner nodes are replaced
+    size_t capacity = bvh->node_capacity;
+    for(size_t id = 0; id < capacity; id++){
+        if(bvh->nodes[id].height == 0){
+            geometry_bvh_update(bvh, id);
+        }
+    }
+}
+
+/**
+*   Function to move triangle kept in tree by vector and refit tree
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t id               id of triangle
+*       double vector_x         x coordinate of vector
+*       double vector_y         y coordinate of vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if there is no such triangle in tree
+*/
+bool geometry_bvh_moveByVector(geometry_bvh* bvh, size_t id, double vector_x, double vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_MOVE_BY_VECTOR);
+    if(!geometry_bvh_isLeaf(bvh, id)){
+        return false;
+    }
+    geometry_triangle_moveByVector(bvh->nodes[id].triangle, vector_x, vector_y);
+    return geometry_bvh_update(bvh, id);
+}
+
+/**
+*   Function to rotate triangle kept in tree through an angle and refit tree
+*   In params:
+*       geometry_bvh* bvh                   tree
+*       size_t id                           id of triangle
+*       double angle                        angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotation is calculated
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_bvh_rotateByAngle(geometry_bvh* bvh, size_t id, double angle, geometry_point* reference_point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_ROTATE_BY_ANGLE);
+    if(!geometry_bvh_isLeaf(bvh, id) || reference_point == NULL){
+        return false;
+    }
+    geometry_triangle_rotateByAngle(bvh->nodes[id].triangle, angle, reference_point);
+    return geometry_bvh_update(bvh, id);
+}
+
+/**
+*   Function to get triangle with given id
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t id               id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*      triangle, NULL if there is no such triangle in tree
+*/
+geometry_triangle* geometry_bvh_getTriangle(geometry_bvh* bvh, size_t id){
+    if(!geometry_bvh_isLeaf(bvh, id)){
+        return NULL;
+    }
+    return bvh->nodes[id].triangle;
+}
+
+/**
+*   Function to find triangles from tree intersecting given triangle
+*   Given triangle may be kept in tree as well, then it is reported too
+*   In params:
+*       geometry_bvh* bvh               tree
+*       geometry_triangle* triangle     examined triangle
+*       size_t capacity                 number of elements in ids array
+*
+*   Out params:
+*       size_t* ids                     ids of found triangles, at most capacity elements are written
+*
+*   Return:
+*       size_t                          number of all found triangles (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_bvh_queryTriangle(geometry_bvh* bvh, geometry_triangle* triangle, size_t* ids, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_QUERY_TRIANGLE);
+    if(bvh == NULL || triangle == NULL || (ids == NULL && capacity > 0)){
+        return GEOMETRY_BVH_NONE;
+    }
+    geometry_bvh_box box = geometry_bvh_triangleBox(triangle);
+    size_t stack[GEOMETRY_BVH_STACK_SIZE];
+    size_t stack_size = 0;
+    size_t found = 0;
+    if(bvh->root != GEOMETRY_BVH_NONE){
+        stack[stack_size++] = bvh->root;
+    }
+    while(stack_size > 0){
+        size_t node = stack[--stack_size];
+        geometry_bvh_node* current = &bvh->nodes[node];
+        if(!geometry_bvh_overlap(&current->box, &box)){
+            continue;
+        }
+        if(current->height == 0){
+            if(!geometry_triangle_areDisjoint(current->triangle, triangle)){
+                if(found < capacity){
+                    ids[found] = node;
+                }
+                found++;
+            }
+            continue;
+        }
+        stack[stack_size++] = current->first_child;
+        stack[stack_size++] = current->second_child;
+    }
+    return found;
+}
+
+/**
+*   Function to find triangles from tree containing given point
+*   Points lying on sides are contained
+*   In params:
+*       geometry_bvh* bvh           tree
+*       double x                    x coordinate of point
+*       double y                    y coordinate of point
+*       size_t capacity             number of elements in ids array
+*
+*   Out params:
+*       size_t* ids                 ids of found triangles, at most capacity elements are written
+*
+*   Return:
+*       size_t                      number of all found triangles (may be larger than capacity),
+*                                   (size_t)-1 if error occured
+*/
+size_t geometry_bvh_queryPoint(geometry_bvh* bvh, double x, double y, size_t* ids, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_QUERY_POINT);
+    if(bvh == NULL || (ids == NULL && capacity > 0)){
+        return GEOMETRY_BVH_NONE;
+    }
+    size_t stack[GEOMETRY_BVH_STACK_SIZE];
+    size_t stack_size = 0;
+    size_t found = 0;
+    if(bvh->root != GEOMETRY_BVH_NONE){
+        stack[stack_size++] = bvh->root;
+    }
+    while(stack_size > 0){
+        size_t node = stack[--stack_size];
+        geometry_bvh_node* current = &bvh->nodes[node];
+        if(x < current->box.min_x || x > current->box.max_x || y < current->box.min_y || y > current->box.max_y){
+            continue;
+        }
+        if(current->height == 0){
+            if(geometry_bvh_containsPoint(current->triangle, x, y)){
+                if(found < capacity){
+                    ids[found] = node;
+                }
+                found++;
+            }
+            continue;
+        }
+        stack[stack_size++] = current->first_child;
+        stack[stack_size++] = current->second_child;
+    }
+    return found;
+}
+
+/**
+*   Function to find first triangle hit by ray
+*   Points of ray are origin + t * direction for t >= 0
+*   In params:
+*       geometry_bvh* bvh           tree
+*       double origin_x             x coordinate of ray's origin
+*       double origin_y             y coordinate of ray's origin
+*       double direction_x          x coordinate of ray's direction
+*       double direction_y          y coordinate of ray's direction
+*
+*   Out params:
+*       double* t                   parameter of hit point (may be NULL), 0 if origin is inside triangle
+*
+*   Return:
+*       size_t                      id of hit triangle, (size_t)-1 if ray doesn't hit any triangle
+*/
+size_t geometry_bvh_castRay(geometry_bvh* bvh, double origin_x, double origin_y, double direction_x, double direction_y, double* t){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_CAST_RAY);
+    if(bvh == NULL || (direction_x == 0 && direction_y == 0)){
+        return GEOMETRY_BVH_NONE;
+    }
+    size_t stack[GEOMETRY_BVH_STACK_SIZE];
+    size_t stack_size = 0;
+    size_t best = GEOMETRY_BVH_NONE;
+    double best_t = INFINITY;
+    if(bvh->root != GEOMETRY_BVH_NONE){
+        stack[stack_size++] = bvh->root;
+    }
+    while(stack_size > 0){
+        size_t node = stack[--stack_size];
+        geometry_bvh_node* current = &bvh->nodes[node];
+        // boxes entered further than the best hit can't give better one
+        if(!(geometry_bvh_rayBox(&current->box, origin_x, origin_y, direction_x, direction_y) <= best_t)){
+            continue;
+        }
+        if(current->height == 0){
+            double hit = geometry_bvh_rayTriangle(current->triangle, origin_x, origin_y, direction_x, direction_y);
+            if(hit < best_t){
+                best_t = hit;
+                best = node;
+            }
+            continue;
+        }
+        stack[stack_size++] = current->first_child;
+        stack[stack_size++] = current->second_child;
+    }
+    if(t != NULL && best != GEOMETRY_BVH_NONE){
+        *t = best_t;
+    }
+    return best;
+}
+
+/**
+*   Function to find all pairs of intersecting triangles kept in tree
+*   In params:
+*       geometry_bvh* bvh               tree
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_bvh_pair* pairs        found pairs, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all intersecting pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_bvh_calculateIntersectingPairs(geometry_bvh* bvh, geometry_bvh_pair* pairs, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_BVH_CALCULATE_INTERSECTING_PAIRS);
+    if(bvh == NULL || (pairs == NULL && capacity > 0)){
+        return GEOMETRY_BVH_NONE;
+    }
+    size_t stack[GEOMETRY_BVH_STACK_SIZE];
+    size_t found = 0;
+    for(size_t leaf = 0; leaf < bvh->node_capacity; leaf++){
+        if(bvh->nodes[leaf].height != 0){
+            continue;
+        }
+        geometry_bvh_box* box = &bvh->nodes[leaf].box;
+        size_t stack_size = 0;
+        stack[stack_size++] = bvh->root;
+        while(stack_size > 0){
+            size_t node = stack[--stack_size];
+            geometry_bvh_node* current = &bvh->nodes[node];
+            if(!geometry_bvh_overlap(&current->box, box)){
+                continue;
+            }
+            if(current->height == 0){
+                // every pair is tested once, from the leaf with smaller id
+                if(node > leaf && !geometry_triangle_areDisjoint(bvh->nodes[leaf].triangle, current->triangle)){
+                    if(found < capacity){
+                        pairs[found].first = leaf;
+                        pairs[found].second = node;
+                    }
+                    found++;
+                }
+                continue;
+            }
+            stack[stack_size++] = current->first_child;
+            stack[stack_size++] = current->second_child;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,235 @@
+#ifndef GEOMETRY_BVH
+#define GEOMETRY_BVH
+
+#include "geometry.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Dynamic bounding volume hierarchy (AABB tree) over triangles.
+// Every triangle is a leaf with its bounding box enlarged by margin ("fat" box),
+// so small moves don't change the tree at all. Inner nodes bound their children
+// and tree is kept balanced with rotations. All nodes are kept in one flat array
+// and referenced by indices, so traversal stays in cache and ids are stable.
+// Triangles are referenced, not copied - they must stay alive while in tree.
+typedef struct geometry_bvh geometry_bvh;
+
+// Pair of triangles given by ids returned from geometry_bvh_insert, first < second
+typedef struct geometry_bvh_pair {
+    size_t first;
+    size_t second;
+} geometry_bvh_pair;
+
+/*##############################################
+ GEOMETRY_BVH functions (methods) declarations
+###############################################*/
+
+/**
+*   Function to create new empty geometry_bvh object
+*   In params:
+*       double margin           distance by which bounding boxes of leaves are enlarged,
+*                               bigger margin means less updates of tree but looser boxes
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_bvh*           pointer to created object, NULL if error occured
+*/
+geometry_bvh* geometry_bvh_new(double margin);
+
+/**
+*   Function to create new empty geometry_bvh object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       double margin                           distance by which bounding boxes of leaves are enlarged,
+*                                               bigger margin means less updates of tree but looser boxes
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_bvh*           pointer to created object, NULL if error occured
+*/
+geometry_bvh* geometry_bvh_new_with(const geometry_allocator* allocator, double margin);
+
+/**
+*   Function to destroy given geometry_bvh object
+*   Triangles kept in tree are not destroyed
+*   In params:
+*       geometry_bvh* bvh       tree object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_bvh_destroy(geometry_bvh* bvh);
+
+/**
+*   Function to add triangle to tree
+*   In params:
+*       geometry_bvh* bvh               tree
+*       geometry_triangle* triangle     triangle to add
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                          id of triangle in tree, (size_t)-1 if error occured
+*/
+size_t geometry_bvh_insert(geometry_bvh* bvh, geometry_triangle* triangle);
+
+/**
+*   Function to remove triangle from tree
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t id               id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if there is no such triangle in tree
+*/
+bool geometry_bvh_remove(geometry_bvh* bvh, size_t id);
+
+/**
+*   Function to refit tree after triangle was changed (moved, rotated, transformed)
+*   Tree is changed only if triangle left its enlarged bounding box
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t id               id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if there is no such triangle in tree
+*/
+bool geometry_bvh_update(geometry_bvh* bvh, size_t id);
+
+/**
+*   Function to refit tree after any number of triangles were changed
+*   In params:
+*       geometry_bvh* bvh       tree
+*
+*   Out params/return:
+*       none (tree is changed)
+*/
+void geometry_bvh_refit(geometry_bvh* bvh);
+
+/**
+*   Function to move triangle kept in tree by vector and refit tree
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t id               id of triangle
+*       double vector_x         x coordinate of vector
+*       double vector_y         y coordinate of vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if there is no such triangle in tree
+*/
+bool geometry_bvh_moveByVector(geometry_bvh* bvh, size_t id, double vector_x, double vector_y);
+
+/**
+*   Function to rotate triangle kept in tree through an angle and refit tree
+*   In params:
+*       geometry_bvh* bvh                   tree
+*       size_t id                           id of triangle
+*       double angle                        angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotation is calculated
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_bvh_rotateByAngle(geometry_bvh* bvh, size_t id, double angle, geometry_point* reference_point);
+
+/**
+*   Function to get triangle with given id
+*   In params:
+*       geometry_bvh* bvh       tree
+*       size_t id               id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*      triangle, NULL if there is no such triangle in tree
+*/
+geometry_triangle* geometry_bvh_getTriangle(geometry_bvh* bvh, size_t id);
+
+/**
+*   Function to find triangles from tree intersecting given triangle
+*   Given triangle may be kept in tree as well, then it is reported too
+*   In params:
+*       geometry_bvh* bvh               tree
+*       geometry_triangle* triangle     examined triangle
+*       size_t capacity                 number of elements in ids array
+*
+*   Out params:
+*       size_t* ids                     ids of found triangles, at most capacity elements are written
+*
+*   Return:
+*       size_t                          number of all found triangles (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_bvh_queryTriangle(geometry_bvh* bvh, geometry_triangle* triangle, size_t* ids, size_t capacity);
+
+/**
+*   Function to find triangles from tree containing given point
+*   Points lying on sides are contained
+*   In params:
+*       geometry_bvh* bvh           tree
+*       double x                    x coordinate of point
+*       double y                    y coordinate of point
+*       size_t capacity             number of elements in ids array
+*
+*   Out params:
+*       size_t* ids                 ids of found triangles, at most capacity elements are written
+*
+*   Return:
+*       size_t                      number of all found triangles (may be larger than capacity),
+*                                   (size_t)-1 if error occured
+*/
+size_t geometry_bvh_queryPoint(geometry_bvh* bvh, double x, double y, size_t* ids, size_t capacity);
+
+/**
+*   Function to find first triangle hit by ray
+*   Points of ray are origin + t * direction for t >= 0
+*   In params:
+*       geometry_bvh* bvh           tree
+*       double origin_x             x coordinate of ray's origin
+*       double origin_y             y coordinate of ray's origin
+*       double direction_x          x coordinate of ray's direction
+*       double direction_y          y coordinate of ray's direction
+*
+*   Out params:
+*       double* t                   parameter of hit point (may be NULL), 0 if origin is inside triangle
+*
+*   Return:
+*       size_t                      id of hit triangle, (size_t)-1 if ray doesn't hit any triangle
+*/
+size_t geometry_bvh_castRay(geometry_bvh* bvh, double origin_x, double origin_y, double direction_x, double direction_y, double* t);
+
+/**
+*   Function to find all pairs of intersecting triangles kept in tree
+*   In params:
+*       geometry_bvh* bvh               tree
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_bvh_pair* pairs        found pairs, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all intersecting pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_bvh_calculateIntersectingPairs(geometry_bvh* bvh, geometry_bvh_pair* pairs, size_t capacity);
+
+#endif
@@ -0,0 +1,735 @@
+#include "geometry_grid.h"
+#include "geometry_stats.h"
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <math.h>
+
+#define GEOMETRY_GRID_NONE ((size_t)-1)
+#define GEOMETRY_GRID_MIN_CELLS 64
+// cell coordinates are clamped, so far away triangles don't overflow int64_t
+#define GEOMETRY_GRID_MAX_CELL 4503599627370496.0
+
+// Triangle kept in grid with range of cells covered by its bounding box
+typedef struct geometry_grid_entry {
+    geometry_triangle* triangle;
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+    int64_t min_cell_x;
+    int64_t min_cell_y;
+    int64_t max_cell_x;
+    int64_t max_cell_y;
+    bool used;
+    // next unused entry, entries of removed triangles form a list
+    size_t next_free;
+} geometry_grid_entry;
+
+// Slot of hash table of cells, occupied slot may hold empty cell
+typedef struct geometry_grid_cell {
+    int64_t x;
+    int64_t y;
+    size_t* ids;
+    size_t count;
+    size_t capacity;
+    bool occupied;
+} geometry_grid_cell;
+
+struct geometry_grid {
+    double cell_size;
+    geometry_grid_entry* entries;
+    size_t entry_count;
+    size_t entry_capacity;
+    size_t first_free;
+    geometry_grid_cell* cells;
+    size_t cell_capacity;
+    size_t occupied_cells;
+    geometry_allocator allocator;
+};
+
+// Pairs found by one thread, merged after run
+typedef struct geometry_grid_pairs {
+    geometry_grid_pair* pairs;
+    size_t count;
+    size_t capacity;
+} geometry_grid_pairs;
+
+typedef struct geometry_grid_parallelContext {
+    geometry_grid* grid;
+    geometry_grid_pairs* found;
+    atomic_bool failed;
+} geometry_grid_parallelContext;
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static int64_t geometry_grid_cellCoordinate(geometry_grid* grid, double coordinate);
+static size_t geometry_grid_hash(int64_t x, int64_t y);
+static bool geometry_grid_rehash(geometry_grid* grid, size_t capacity);
+static geometry_grid_cell* geometry_grid_findCell(geometry_grid* grid, int64_t x, int64_t y);
+static bool geometry_grid_addToCell(geometry_grid* grid, int64_t x, int64_t y, size_t id);
+static void geometry_grid_removeFromCell(geometry_grid* grid, int64_t x, int64_t y, size_t id);
+static void geometry_grid_readBounds(geometry_grid* grid, geometry_grid_entry* entry);
+static size_t geometry_grid_collectCellPairs(geometry_grid* grid, geometry_grid_cell* cell, geometry_grid_pair* pairs, size_t found, size_t capacity, bool test_triangles);
+static size_t geometry_grid_collectPairs(geometry_grid* grid, geometry_grid_pair* pairs, size_t capacity, bool test_triangles);
+static void geometry_grid_collectCellTask(size_t slot, size_t thread, void* context);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to calculate coordinate of cell containing given coordinate
+*   In params:
+*       geometry_grid* grid     grid
+*       double coordinate       x or y coordinate of point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int64_t                 coordinate of cell
+*/
+static int64_t geometry_grid_cellCoordinate(geometry_grid* grid, double coordinate){
+    double cell = floor(coordinate / grid->cell_size);
+    if(!(cell > -GEOMETRY_GRID_MAX_CELL)){
+        cell = -GEOMETRY_GRID_MAX_CELL;
+    }
+    if(cell > GEOMETRY_GRID_MAX_CELL){
+        cell = GEOMETRY_GRID_MAX_CELL;
+    }
+    return (int64_t)cell;
+}
+
+/**
+*   Function to calculate hash of cell coordinates
+*   In params:
+*       int64_t x, y        coordinates of cell
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t              hash value
+*/
+static size_t geometry_grid_hash(int64_t x, int64_t y){
+    uint64_t hash = (uint64_t)x * 0x9E3779B97F4A7C15ULL ^ (uint64_t)y * 0xC2B2AE3D27D4EB4FULL;
+    hash ^= hash >> 29;
+    return (size_t)hash;
+}
+
+/**
+*   Function to move cells to new hash table of given capacity
+*   Empty cells are dropped on the way
+*   In params:
+*       geometry_grid* grid     grid
+*       size_t capacity         new number of slots, power of 2
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if memory couldn't be reserved
+*/
+static bool geometry_grid_rehash(geometry_grid* grid, size_t capacity){
+    GEOMETRY_STATS_EVENT(GEOMETRY_STATS_GRID_REHASH);
+    geometry_grid_cell* new_cells = geometry_allocator_allocateZeroed(&grid->allocator, capacity, sizeof(*new_cells));
+    if(new_cells == NULL){
+        return false;
+    }
+    size_t occupied_cells = 0;
+    for(size_t i = 0; i < grid->cell_capacity; i++){
+        geometry_grid_cell* cell = &grid->cells[i];
+        if(!cell->occupied){
+            continue;
+        }
+        if(cell->count == 0){
+            geometry_allocator_free(&grid->allocator, cell->ids);
+            continue;
+        }
+        size_t slot = geometry_grid_hash(cell->x, cell->y) & (capacity - 1);
+        while(new_cells[slot].occupied){
+            slot = (slot + 1) & (capacity - 1);
+        }
+        new_cells[slot] = *cell;
+        occupied_cells++;
+    }
+    geometry_allocator_free(&grid->allocator, grid->cells);
+    grid->cells = new_cells;
+    grid->cell_capacity = capacity;
+    grid->occupied_cells = occupied_cells;
+    return true;
+}
+
+/**
+*   Function to find cell with given coordinates
+*   In params:
+*       geometry_grid* grid     grid
+*       int64_t x, y            coordinates of cell
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_grid_cell*     found cell, NULL if cell isn't stored
+*/
+static geometry_grid_cell* geometry_grid_findCell(geometry_grid* grid, int64_t x, int64_t y){
+    size_t mask = grid->cell_capacity - 1;
+    for(size_t slot = geometry_grid_hash(x, y) & mask; grid->cells[slot].occupied; slot = (slot + 1) & mask){
+        if(grid->cells[slot].x == x && grid->cells[slot].y == y){
+            return &grid->cells[slot];
+        }
+    }
+    return NULL;
+}
+
+/**
+*   Function to add triangle id to cell with given coordinates, cell is created if needed
+*   In params:
+*       geometry_grid* grid     grid
+*       int64_t x, y            coordinates of cell
+*       size_t id               id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if memory couldn't be reserved
+*/
+static bool geometry_grid_addToCell(geometry_grid* grid, int64_t x, int64_t y, size_t id){
+    // keep hash table at most half full, empty cells are dropped while rehashing
+    if(2 * (grid->occupied_cells + 1) > grid->cell_capacity){
+        size_t capacity = grid->cell_capacity;
+        while(capacity < 4 * (grid->occupied_cells + 1)){
+            capacity *= 2;
+        }
+        if(!geometry_grid_rehash(grid, capacity)){
+            return false;
+        }
+    }
+    size_t mask = grid->cell_capacity - 1;
+    size_t slot = geometry_grid_hash(x, y) & mask;
+    while(grid->cells[slot].occupied && (grid->cells[slot].x != x || grid->cells[slot].y != y)){
+        slot = (slot + 1) & mask;
+    }
+    geometry_grid_cell* cell = &grid->cells[slot];
+    if(!cell->occupied){
+        cell->x = x;
+        cell->y = y;
+        cell->ids = NULL;
+        cell->count = 0;
+        cell->capacity = 0;
+        cell->occupied = true;
+        grid->occupied_cells++;
+    }
+    if(cell->count == cell->capacity){
+        size_t capacity = cell->capacity * 2 + 4;
+        size_t* ids = geometry_allocator_reallocate(&grid->allocator, cell->ids, cell->capacity * sizeof(*ids), capacity * sizeof(*ids));
+        if(ids == NULL){
+            return false;
+        }
+        cell->ids = ids;
+        cell->capacity = capacity;
+    }
+    cell->ids[cell->count++] = id;
+    return true;
+}
+
+/**
+*   Function to remove triangle id from cell with given coordinates
+*   In params:
+*       geometry_grid* grid     grid
+*       int64_t x, y            coordinates of cell
+*       size_t id               id of triangle
+*
+*   Out params/return:
+*       none (grid is changed)
+*/
+static void geometry_grid_removeFromCell(geometry_grid* grid, int64_t x, int64_t y, size_t id){
+    geometry_grid_cell* cell = geometry_grid_findCell(grid, x, y);
+    if(cell == NULL){
+        return;
+    }
+    for(size_t i = 0; i < cell->count; i++){
+        if(cell->ids[i] == id){
+            cell->ids[i] = cell->ids[--cell->count];
+            return;
+        }
+    }
+}
+
+/**
+*   Function to read bounding box of entry's triangle and range of cells it covers
+*   In params:
+*       geometry_grid* grid             grid
+*       geometry_grid_entry* entry      entry
+*
+*   Out params/return:
+*       none (entry is changed)
+*/
+static void geometry_grid_readBounds(geometry_grid* grid, geometry_grid_entry* entry){
+    geometry_real min_x, min_y, max_x, max_y;
+    geometry_triangle_getBoundingBox(entry->triangle, &min_x, &min_y, &max_x, &max_y);
+    entry->min_x = min_x;
+    entry->min_y = min_y;
+    entry->max_x = max_x;
+    entry->max_y = max_y;
+    entry->min_cell_x = geometry_grid_cellCoordinate(grid, entry->min_x);
+    entry->min_cell_y = geometry_grid_cellCoordinate(grid, entry->min_y);
+    entry->max_cell_x = geometry_grid_cellCoordinate(grid, entry->max_x);
+    entry->max_cell_y = geometry_grid_cellCoordinate(grid, entry->max_y);
+}
+
+/**
+*   Function to find pairs of triangles reported in given cell
+*   In params:
+*       geometry_grid* grid             grid
+*       geometry_grid_cell* cell        cell
+*       size_t found                    number of pairs found before
+*       size_t capacity                 number of elements in pairs array
+*       bool test_triangles             if true, only intersecting triangles are reported,
+*                                       otherwise all with overlapping bounding boxes
+*
+*   Out params:
+*       geometry_grid_pair* pairs       found pairs, written after pairs found before
+*
+*   Return:
+*       size_t                          number of pairs found before and in cell
+*/
+static size_t geometry_grid_collectCellPairs(geometry_grid* grid, geometry_grid_cell* cell, geometry_grid_pair* pairs, size_t found, size_t capacity, bool test_triangles){
+    geometry_grid_entry* entries = grid->entries;
+    for(size_t i = 0; i < cell->count; i++){
+        geometry_grid_entry* first = &entries[cell->ids[i]];
+        for(size_t j = i + 1; j < cell->count; j++){
+            geometry_grid_entry* second = &entries[cell->ids[j]];
+            if(first->max_x < second->min_x || second->max_x < first->min_x
+                || first->max_y < second->min_y || second->max_y < first->min_y){
+                continue;
+            }
+            // triangles may share many cells, pair is reported only in the
+            // lowest one of them, which is corner of common range of cells
+            int64_t owner_x = first->min_cell_x > second->min_cell_x ? first->min_cell_x : second->min_cell_x;
+            int64_t owner_y = first->min_cell_y > second->min_cell_y ? first->min_cell_y : second->min_cell_y;
+            if(owner_x != cell->x || owner_y != cell->y){
+                continue;
+            }
+            if(test_triangles && geometry_triangle_areDisjoint(first->triangle, second->triangle)){
+                continue;
+            }
+            if(found < capacity){
+                size_t first_id = cell->ids[i];
+                size_t second_id = cell->ids[j];
+                pairs[found].first = first_id < second_id ? first_id : second_id;
+                pairs[found].second = first_id < second_id ? second_id : first_id;
+            }
+            found++;
+        }
+    }
+    return found;
+}
+
+/**
+*   Function to find pairs of triangles sharing cells
+*   In params:
+*       geometry_grid* grid             grid
+*       size_t capacity                 number of elements in pairs array
+*       bool test_triangles             if true, only intersecting triangles are reported,
+*                                       otherwise all with overlapping bounding boxes
+*
+*   Out params:
+*       geometry_grid_pair* pairs       found pairs
+*
+*   Return:
+*       size_t                          number of all found pairs
+*/
+static size_t geometry_grid_collectPairs(geometry_grid* grid, geometry_grid_pair* pairs, size_t capacity, bool test_triangles){
+    size_t found = 0;
+    for(size_t slot = 0; slot < grid->cell_capacity; slot++){
+        if(grid->cells[slot].occupied){
+            found = geometry_grid_collectCellPairs(grid, &grid->cells[slot], pairs, found, capacity, test_triangles);
+        }
+    }
+    return found;
+}
+
+/**
+*   Function to test pairs of triangles reported in one cell, run by pool with work stealing
+*   In params:
+*       size_t slot         slot of hash table of cells
+*       size_t thread       index of thread, pairs go to its buffer
+*       void* context       geometry_grid_parallelContext of search
+*
+*   Out params/return:
+*       none (pairs are added to buffer)
+*/
+static void geometry_grid_collectCellTask(size_t slot, size_t thread, void* context){
+    geometry_grid_parallelContext* parallel_context = context;
+    geometry_grid* grid = parallel_context->grid;
+    geometry_grid_cell* cell = &grid->cells[slot];
+    geometry_grid_pairs* found = &parallel_context->found[thread];
+    if(!cell->occupied || atomic_load_explicit(&parallel_context->failed, memory_order_relaxed)){
+        return;
+    }
+    size_t count = geometry_grid_collectCellPairs(grid, cell, found->pairs, found->count, found->capacity, true);
+    if(count > found->capacity){
+        // buffer was too small, cell is tested once more after growing it
+        size_t capacity = count > 2 * found->capacity ? count : 2 * found->capacity;
+        geometry_grid_pair* pairs = geometry_allocator_reallocate(&grid->allocator, found->pairs, found->capacity * sizeof(*pairs), capacity * sizeof(*pairs));
+        if(pairs == NULL){
+            atomic_store_explicit(&parallel_context->failed, true, memory_order_relaxed);
+            return;
+        }
+        found->pairs = pairs;
+        found->capacity = capacity;
+        count = geometry_grid_collectCellPairs(grid, cell, found->pairs, found->count, found->capacity, true);
+    }
+    found->count = count;
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new empty geometry_grid object
+*   Cell size should be close to size of typical triangle - too small cells
+*   make every triangle land in many cells, too big ones give many false candidates
+*   In params:
+*       double cell_size        length of cell's side, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_grid*          pointer to created object, NULL if error occured
+*/
+geometry_grid* geometry_grid_new(double cell_size){
+    return geometry_grid_new_with(NULL, cell_size);
+}
+
+/**
+*   Function to create new empty geometry_grid object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   Cell size should be close to size of typical triangle - too small cells
+*   make every triangle land in many cells, too big ones give many false candidates
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       double cell_size                        length of cell's side, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_grid*          pointer to created object, NULL if error occured
+*/
+geometry_grid* geometry_grid_new_with(const geometry_allocator* allocator, double cell_size){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_GRID_NEW);
+    if(!(cell_size > 0) || isinf(cell_size)){
+        return NULL;
+    }
+    geometry_grid* new_grid = geometry_allocator_allocate(allocator, sizeof(*new_grid));
+    geometry_grid_cell* cells = geometry_allocator_allocateZeroed(allocator, GEOMETRY_GRID_MIN_CELLS, sizeof(*cells));
+    if(new_grid == NULL || cells == NULL){
+        geometry_allocator_free(allocator, new_grid);
+        geometry_allocator_free(allocator, cells);
+        return NULL;
+    }
+    new_grid->cell_size = cell_size;
+    new_grid->entries = NULL;
+    new_grid->entry_count = 0;
+    new_grid->entry_capacity = 0;
+    new_grid->first_free = GEOMETRY_GRID_NONE;
+    new_grid->cells = cells;
+    new_grid->cell_capacity = GEOMETRY_GRID_MIN_CELLS;
+    new_grid->occupied_cells = 0;
+    new_grid->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    return new_grid;
+}
+
+/**
+*   Function to destroy given geometry_grid object
+*   Triangles kept in grid are not destroyed
+*   In params:
+*       geometry_grid* grid         grid object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_grid_destroy(geometry_grid* grid){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_GRID_DESTROY);
+    if(grid == NULL){
+        return;
+    }
+    geometry_allocator allocator = grid->allocator;
+    for(size_t i = 0; i < grid->cell_capacity; i++){
+        geometry_allocator_free(&allocator, grid->cells[i].ids);
+    }
+    geometry_allocator_free(&allocator, grid->cells);
+    geometry_allocator_free(&allocator, grid->entries);
+    geometry_allocator_free(&allocator, grid);
+}
+
+/**
+*   Function to add triangle to grid
+*   In params:
+*       geometry_grid* grid             grid
+*       geometry_triangle* triangle     triangle to add
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                          id of triangle in grid, ids of removed triangles are reused,
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_grid_insert(geometry_grid* grid, geometry_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_GRID_INSERT);
+    if(grid == NULL || triangle == NULL){
+        return GEOMETRY_GRID_NONE;
+    }
+    size_t id = grid->first_free;
+    if(id == GEOMETRY_GRID_NONE){
+        if(grid->entry_count == grid->entry_capacity){
+            size_t capacity = grid->entry_capacity * 2 + 16;
+            geometry_grid_entry* entries = geometry_allocator_reallocate(&grid->allocator, grid->entries, grid->entry_capacity * sizeof(*entries), capacity * sizeof(*entries));
+            if(entries == NULL){
+                return GEOMETRY_GRID_NONE;
+            }
+            grid->entries = entries;
+            grid->entry_capacity = capacity;
+        }
+        id = grid->entry_count++;
+    }
+    else{
+        grid->first_free = grid->entries[id].next_free;
+    }
+    geometry_grid_entry* entry = &grid->entries[id];
+    entry->triangle = triangle;
+    entry->used = true;
+    entry->next_free = GEOMETRY_GRID_NONE;
+    geometry_grid_readBounds(grid, entry);
+    for(int64_t x = entry->min_cell_x; x <= entry->max_cell_x; x++){
+        for(int64_t y = entry->min_cell_y; y <= entry->max_cell_y; y++){
+            if(!geometry_grid_addToCell(grid, x, y, id)){
+                // cells added so far are also removed
+                geometry_grid_remove(grid, id);
+                return GEOMETRY_GRID_NONE;
+            }
+        }
+    }
+    return id;
+}
+
+/**
+*   Function to remove triangle from grid
+*   In params:
+*       geometry_grid* grid         grid
+*       size_t id                   id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true on success, false if there is no such triangle in grid
+*/
+bool geometry_grid_remove(geometry_grid* grid, size_t id){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_GRID_REMOVE);
+    if(grid == NULL || id >= grid->entry_count || !grid->entries[id].used){
+        return false;
+    }
+    geometry_grid_entry* entry = &grid->entries[id];
+    for(int64_t x = entry->min_cell_x; x <= entry->max_cell_x; x++){
+        for(int64_t y = entry->min_cell_y; y <= entry->max_cell_y; y++){
+            geometry_grid_removeFromCell(grid, x, y, id);
+        }
+    }
+    entry->triangle = NULL;
+    entry->used = false;
+    entry->next_free = grid->first_free;
+    grid->first_free = id;
+    return true;
+}
+
+/**
+*   Function to update cells of triangle after it was changed (moved, rotated, transformed)
+*   Only cells that triangle left or entered are touched
+*   In params:
+*       geometry_grid* grid         grid
+*       size_t id                   id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true on success, false if error occured
+*/
+bool geometry_grid_update(geometry_grid* grid, size_t id){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_GRID_UPDATE);
+    if(grid == NULL || id >= grid->entry_count || !grid->entries[id].used){
+        return false;
+    }
+    geometry_grid_entry old_entry = grid->entries[id];
+    geometry_grid_entry* entry = &grid->entries[id];
+    geometry_grid_readBounds(grid, entry);
+    if(entry->min_cell_x == old_entry.min_cell_x && entry->min_cell_y == old_entry.min_cell_y
+        && entry->max_cell_x == old_entry.max_cell_x && entry->max_cell_y == old_entry.max_cell_y){
+        return true;
+    }
+    for(int64_t x = old_entry.min_cell_x; x <= old_entry.max_cell_x; x++){
+        for(int64_t y = old_entry.min_cell_y; y <= old_entry.max_cell_y; y++){
+            if(x < entry->min_cell_x || x > entry->max_cell_x || y < entry->min_cell_y || y > entry->max_cell_y){
+                geometry_grid_removeFromCell(grid, x, y, id);
+            }
+        }
+    }
+    for(int64_t x = entry->min_cell_x; x <= entry->max_cell_x; x++){
+        for(int64_t y = entry->min_cell_y; y <= entry->max_cell_y; y++){
+            if(x < old_entry.min_cell_x || x > old_entry.max_cell_x || y < old_entry.min_cell_y || y > old_entry.max_cell_y){
+                if(!geometry_grid_addToCell(grid, x, y, id)){
+                    // triangle can't be kept in partially updated cells
+                    geometry_grid_remove(grid, id);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+*   Function to move triangle kept in grid by vector and update its cells
+*   Works as geometry_triangle_moveByVector followed by geometry_grid_update
+*   In params:
+*       geometry_grid* grid         grid
+*       size_t id                   id of triangle
+*       double vector_x             x coordinate of vector
+*       double vector_y             y coordinate of vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true on success, false if error occured
+*/
+bool geometry_grid_moveByVector(geometry_grid* grid, size_t id, double vector_x, double vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_GRID_MOVE_BY_VECTOR);
+    geometry_triangle* triangle = geometry_grid_getTriangle(grid, id);
+    if(triangle == NULL){
+        return false;
+    }
+    geometry_triangle_moveByVector(triangle, vector_x, vector_y);
+    return geometry_grid_update(grid, id);
+}
+
+/**
+*   Function to get triangle with given id
+*   In params:
+*       geometry_grid* grid         grid
+*       size_t id                   id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*          triangle, NULL if there is no such triangle in grid
+*/
+geometry_triangle* geometry_grid_getTriangle(geometry_grid* grid, size_t id){
+    if(grid == NULL || id >= grid->entry_count){
+        return NULL;
+    }
+    return grid->entries[id].triangle;
+}
+
+/**
+*   Function to find pairs of triangles which bounding boxes overlap
+*   Each pair is reported once, even if triangles share many cells
+*   In params:
+*       geometry_grid* grid             grid
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_grid_pair* pairs       found pairs, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all found pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_grid_calculateCandidatePairs(geometry_grid* grid, geometry_grid_pair* pairs, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_GRID_CALCULATE_CANDIDATE_PAIRS);
+    if(grid == NULL || (pairs == NULL && capacity > 0)){
+        return GEOMETRY_GRID_NONE;
+    }
+    return geometry_grid_collectPairs(grid, pairs, capacity, false);
+}
+
+/**
+*   Function to find pairs of intersecting triangles
+*   Candidate pairs are tested with geometry_triangle_areDisjoint
+*   In params:
+*       geometry_grid* grid             grid
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_grid_pair* pairs       found pairs, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all intersecting pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_grid_calculateIntersectingPairs(geometry_grid* grid, geometry_grid_pair* pairs, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_GRID_CALCULATE_INTERSECTING_PAIRS);
+    if(grid == NULL || (pairs == NULL && capacity > 0)){
+        return GEOMETRY_GRID_NONE;
+    }
+    return geometry_grid_collectPairs(grid, pairs, capacity, true);
+}
+
+/**
+*   Function to find pairs of intersecting triangles on threads of pool
+*   Works as geometry_grid_calculateIntersectingPairs, but cells are tested in parallel.
+*   Cost of cells differs a lot, so they are spread over threads with work stealing.
+*   In params:
+*       geometry_grid* grid             grid
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_grid_pair* pairs       found pairs, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all intersecting pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_grid_calculateIntersectingPairsParallel(geometry_grid* grid, geometry_pool* pool, geometry_grid_pair* pairs, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_GRID_CALCULATE_INTERSECTING_PAIRS_PARALLEL);
+    if(grid == NULL || (pairs == NULL && capacity > 0)){
+        return GEOMETRY_GRID_NONE;
+    }
+    for(size_t i = 0; i < grid->entry_count; i++){
+        if(grid->entries[i].used){
+            // afterwards tests only read triangles, so threads may share them
+            geometry_triangle_fillCache(grid->entries[i].triangle);
+        }
+    }
+    size_t thread_count = geometry_pool_getThreadCount(pool);
+    geometry_grid_parallelContext context;
+    context.grid = grid;
+    context.found = geometry_allocator_allocateZeroed(&grid->allocator, thread_count, sizeof(*context.found));
+    if(context.found == NULL){
+        return GEOMETRY_GRID_NONE;
+    }
+    atomic_init(&context.failed, false);
+    bool success = geometry_pool_runStealing(pool, grid->cell_capacity, geometry_grid_collectCellTask, &context)
+                    && !atomic_load_explicit(&context.failed, memory_order_relaxed);
+    size_t found = 0;
+    for(size_t i = 0; i < thread_count; i++){
+        for(size_t j = 0; j < context.found[i].count && success; j++){
+            if(found < capacity){
+                pairs[found] = context.found[i].pairs[j];
+            }
+            found++;
+        }
+        geometry_allocator_free(&grid->allocator, context.found[i].pairs);
+    }
+    geometry_allocator_free(&grid->allocator, context.found);
+    return success ? found : GEOMETRY_GRID_NONE;
+}
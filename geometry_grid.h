@@ -0,0 +1,198 @@
+#ifndef GEOMETRY_GRID
+#define GEOMETRY_GRID
+
+#include "geometry.h"
+#include "geometry_pool.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Uniform grid spatial hash for broad-phase collision of triangles.
+// Plane is divided into square cells and every triangle is put into all
+// cells its bounding box overlaps, so only triangles sharing a cell have
+// to be tested with geometry_triangle_areDisjoint. Only non-empty cells
+// are stored (in a hash table), so the plane doesn't have to be bounded.
+// Triangles are referenced, not copied - they must stay alive while in grid.
+typedef struct geometry_grid geometry_grid;
+
+// Pair of triangles given by ids returned from geometry_grid_insert, first < second
+typedef struct geometry_grid_pair {
+    size_t first;
+    size_t second;
+} geometry_grid_pair;
+
+/*###############################################
+ GEOMETRY_GRID functions (methods) declarations
+################################################*/
+
+/**
+*   Function to create new empty geometry_grid object
+*   Cell size should be close to size of typical triangle - too small cells
+*   make every triangle land in many cells, too big ones give many false candidates
+*   In params:
+*       double cell_size        length of cell's side, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_grid*          pointer to created object, NULL if error occured
+*/
+geometry_grid* geometry_grid_new(double cell_size);
+
+/**
+*   Function to create new empty geometry_grid object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   Cell size should be close to size of typical triangle - too small cells
+*   make every triangle land in many cells, too big ones give many false candidates
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       double cell_size                        length of cell's side, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_grid*          pointer to created object, NULL if error occured
+*/
+geometry_grid* geometry_grid_new_with(const geometry_allocator* allocator, double cell_size);
+
+/**
+*   Function to destroy given geometry_grid object
+*   Triangles kept in grid are not destroyed
+*   In params:
+*       geometry_grid* grid         grid object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_grid_destroy(geometry_grid* grid);
+
+/**
+*   Function to add triangle to grid
+*   In params:
+*       geometry_grid* grid             grid
+*       geometry_triangle* triangle     triangle to add
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                          id of triangle in grid, ids of removed triangles are reused,
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_grid_insert(geometry_grid* grid, geometry_triangle* triangle);
+
+/**
+*   Function to remove triangle from grid
+*   In params:
+*       geometry_grid* grid         grid
+*       size_t id                   id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true on success, false if there is no such triangle in grid
+*/
+bool geometry_grid_remove(geometry_grid* grid, size_t id);
+
+/**
+*   Function to update cells of triangle after it was changed (moved, rotated, transformed)
+*   Only cells that triangle left or entered are touched
+*   In params:
+*       geometry_grid* grid         grid
+*       size_t id                   id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true on success, false if error occured
+*/
+bool geometry_grid_update(geometry_grid* grid, size_t id);
+
+/**
+*   Function to move triangle kept in grid by vector and update its cells
+*   Works as geometry_triangle_moveByVector followed by geometry_grid_update
+*   In params:
+*       geometry_grid* grid         grid
+*       size_t id                   id of triangle
+*       double vector_x             x coordinate of vector
+*       double vector_y             y coordinate of vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true on success, false if error occured
+*/
+bool geometry_grid_moveByVector(geometry_grid* grid, size_t id, double vector_x, double vector_y);
+
+/**
+*   Function to get triangle with given id
+*   In params:
+*       geometry_grid* grid         grid
+*       size_t id                   id of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*          triangle, NULL if there is no such triangle in grid
+*/
+geometry_triangle* geometry_grid_getTriangle(geometry_grid* grid, size_t id);
+
+/**
+*   Function to find pairs of triangles which bounding boxes overlap
+*   Each pair is reported once, even if triangles share many cells
+*   In params:
+*       geometry_grid* grid             grid
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_grid_pair* pairs       found pairs, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all found pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_grid_calculateCandidatePairs(geometry_grid* grid, geometry_grid_pair* pairs, size_t capacity);
+
+/**
+*   Function to find pairs of intersecting triangles
+*   Candidate pairs are tested with geometry_triangle_areDisjoint
+*   In params:
+*       geometry_grid* grid             grid
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_grid_pair* pairs       found pairs, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all intersecting pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_grid_calculateIntersectingPairs(geometry_grid* grid, geometry_grid_pair* pairs, size_t capacity);
+
+/**
+*   Function to find pairs of intersecting triangles on threads of pool
+*   Works as geometry_grid_calculateIntersectingPairs, but cells are tested in parallel.
+*   Cost of cells differs a lot, so they are spread over threads with work stealing.
+*   In params:
+*       geometry_grid* grid             grid
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_grid_pair* pairs       found pairs, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all intersecting pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_grid_calculateIntersectingPairsParallel(geometry_grid* grid, geometry_pool* pool, geometry_grid_pair* pairs, size_t capacity);
+
+#endif
@@ -0,0 +1,1026 @@
+#include "geometry_int.h"
+#include "geometry_stats.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+#ifndef __SIZEOF_INT128__
+#error "geometry_int needs compiler with 128-bit integers"
+#endif
+
+#ifdef GEOMETRY_REAL_FLOAT
+#define GEOMETRY_INT_SQRT sqrtf
+#define GEOMETRY_INT_LDEXP ldexpf
+#else
+#define GEOMETRY_INT_SQRT sqrt
+#define GEOMETRY_INT_LDEXP ldexp
+#endif
+
+// Difference of two coordinates needs 33 bits, product of two differences 66 bits
+// and sum of two such products 67 bits, so products are calculated in 128 bits
+typedef __int128 geometry_int_wide;
+typedef unsigned __int128 geometry_int_unsignedWide;
+
+struct geometry_int_point {
+    geometry_int_coordinate x;
+    geometry_int_coordinate y;
+};
+
+// Vertices are kept by value, as in geometry_segment
+struct geometry_int_segment {
+    geometry_int_point start;
+    geometry_int_point end;
+};
+
+struct geometry_int_triangle {
+    geometry_int_point first;
+    geometry_int_point second;
+    geometry_int_point third;
+};
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static bool geometry_int_coordinate_move(geometry_int_coordinate coordinate, geometry_int_coordinate vector, geometry_int_coordinate* result);
+static geometry_int_wide geometry_int_point_cross(geometry_int_point* first, geometry_int_point* second, geometry_int_point* third);
+static int geometry_int_point_orientation(geometry_int_point* first, geometry_int_point* second, geometry_int_point* third);
+static bool geometry_int_point_inBox(geometry_int_point* point, geometry_int_point* start, geometry_int_point* end);
+static geometry_int_wide geometry_int_point_dot(geometry_int_point* vertex, geometry_int_point* first, geometry_int_point* second);
+static geometry_int_wide geometry_int_point_squaredDistance(geometry_int_point* first, geometry_int_point* second);
+static bool geometry_int_segment_intersect(geometry_int_point* first_start, geometry_int_point* first_end, geometry_int_point* second_start, geometry_int_point* second_end);
+static bool geometry_int_triangle_contains(geometry_int_triangle* triangle, geometry_int_point* point);
+static geometry_real geometry_int_wide_divide(geometry_int_wide numerator, geometry_int_wide denominator);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to move coordinate by vector, checking if result fits in coordinate type
+*   In params:
+*       geometry_int_coordinate coordinate      coordinate
+*       geometry_int_coordinate vector          coordinate of vector
+*
+*   Out params:
+*       geometry_int_coordinate* result         moved coordinate
+*
+*   Return:
+*       bool                                    true if moved coordinate fits in coordinate type
+*/
+static bool geometry_int_coordinate_move(geometry_int_coordinate coordinate, geometry_int_coordinate vector, geometry_int_coordinate* result){
+    int64_t moved = (int64_t)coordinate + vector;
+    if(moved < INT32_MIN || moved > INT32_MAX){
+        return false;
+    }
+    *result = (geometry_int_coordinate)moved;
+    return true;
+}
+
+/**
+*   Function to calculate cross product of vectors first->second and first->third
+*   In params:
+*       geometry_int_point* first       common start of vectors
+*       geometry_int_point* second      end of first vector
+*       geometry_int_point* third       end of second vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_wide               exact cross product (doubled signed area of triangle)
+*/
+static geometry_int_wide geometry_int_point_cross(geometry_int_point* first, geometry_int_point* second, geometry_int_point* third){
+    int64_t first_x = (int64_t)second->x - first->x;
+    int64_t first_y = (int64_t)second->y - first->y;
+    int64_t second_x = (int64_t)third->x - first->x;
+    int64_t second_y = (int64_t)third->y - first->y;
+    return (geometry_int_wide)first_x * second_y - (geometry_int_wide)first_y * second_x;
+}
+
+/**
+*   Function to determine on which side of line going through first and second point
+*   lies third point
+*   In params:
+*       geometry_int_point* first       first point of line
+*       geometry_int_point* second      second point of line
+*       geometry_int_point* third       examined point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                             1 if third point lies on the left (counterclockwise turn),
+*                                       -1 if on the right, 0 if all points are colinear
+*/
+static int geometry_int_point_orientation(geometry_int_point* first, geometry_int_point* second, geometry_int_point* third){
+    geometry_int_wide cross = geometry_int_point_cross(first, second, third);
+    return (cross > 0) - (cross < 0);
+}
+
+/**
+*   Function to check if point lies in bounding box of segment
+*   In params:
+*       geometry_int_point* point       point
+*       geometry_int_point* start       starting point of segment
+*       geometry_int_point* end         ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true if point lies in bounding box (borders included)
+*/
+static bool geometry_int_point_inBox(geometry_int_point* point, geometry_int_point* start, geometry_int_point* end){
+    geometry_int_coordinate min_x = start->x < end->x ? start->x : end->x;
+    geometry_int_coordinate max_x = start->x < end->x ? end->x : start->x;
+    geometry_int_coordinate min_y = start->y < end->y ? start->y : end->y;
+    geometry_int_coordinate max_y = start->y < end->y ? end->y : start->y;
+    return point->x >= min_x && point->x <= max_x && point->y >= min_y && point->y <= max_y;
+}
+
+/**
+*   Function to calculate dot product of vectors vertex->first and vertex->second
+*   In params:
+*       geometry_int_point* vertex      common start of vectors
+*       geometry_int_point* first       end of first vector
+*       geometry_int_point* second      end of second vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_wide               exact dot product
+*/
+static geometry_int_wide geometry_int_point_dot(geometry_int_point* vertex, geometry_int_point* first, geometry_int_point* second){
+    int64_t first_x = (int64_t)first->x - vertex->x;
+    int64_t first_y = (int64_t)first->y - vertex->y;
+    int64_t second_x = (int64_t)second->x - vertex->x;
+    int64_t second_y = (int64_t)second->y - vertex->y;
+    return (geometry_int_wide)first_x * second_x + (geometry_int_wide)first_y * second_y;
+}
+
+/**
+*   Function to calculate square of distance between two points
+*   In params:
+*       geometry_int_point* first       first point
+*       geometry_int_point* second      second point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_wide               exact square of distance
+*/
+static geometry_int_wide geometry_int_point_squaredDistance(geometry_int_point* first, geometry_int_point* second){
+    return geometry_int_point_dot(first, second, second);
+}
+
+/**
+*   Function to check if two segments given by end points have any common point
+*   In params:
+*       geometry_int_point* first_start     starting point of first segment
+*       geometry_int_point* first_end       ending point of first segment
+*       geometry_int_point* second_start    starting point of second segment
+*       geometry_int_point* second_end      ending point of second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if segments intersect (touching and overlapping included)
+*/
+static bool geometry_int_segment_intersect(geometry_int_point* first_start, geometry_int_point* first_end, geometry_int_point* second_start, geometry_int_point* second_end){
+    int second_start_side = geometry_int_point_orientation(first_start, first_end, second_start);
+    int second_end_side = geometry_int_point_orientation(first_start, first_end, second_end);
+    int first_start_side = geometry_int_point_orientation(second_start, second_end, first_start);
+    int first_end_side = geometry_int_point_orientation(second_start, second_end, first_end);
+    if(second_start_side * second_end_side < 0 && first_start_side * first_end_side < 0){
+        return true;
+    }
+    // end point lying on line of the other segment has to lie on the segment itself
+    return (second_start_side == 0 && geometry_int_point_inBox(second_start, first_start, first_end))
+        || (second_end_side == 0 && geometry_int_point_inBox(second_end, first_start, first_end))
+        || (first_start_side == 0 && geometry_int_point_inBox(first_start, second_start, second_end))
+        || (first_end_side == 0 && geometry_int_point_inBox(first_end, second_start, second_end));
+}
+
+/**
+*   Function to check if point lies strictly inside triangle
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*       geometry_int_point* point           point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if point lies inside triangle, false if it lies outside,
+*                                           on its border or triangle is degenerate
+*/
+static bool geometry_int_triangle_contains(geometry_int_triangle* triangle, geometry_int_point* point){
+    int orientation = geometry_int_point_orientation(&triangle->first, &triangle->second, &triangle->third);
+    if(orientation == 0){
+        return false;
+    }
+    return geometry_int_point_orientation(&triangle->first, &triangle->second, point) == orientation
+        && geometry_int_point_orientation(&triangle->second, &triangle->third, point) == orientation
+        && geometry_int_point_orientation(&triangle->third, &triangle->first, point) == orientation;
+}
+
+/**
+*   Function to divide two wide integers with single rounding to geometry_real
+*   In params:
+*       geometry_int_wide numerator         numerator, at most 101 bits
+*       geometry_int_wide denominator       non zero denominator, at most 67 bits
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       numerator / denominator rounded to nearest
+*/
+static geometry_real geometry_int_wide_divide(geometry_int_wide numerator, geometry_int_wide denominator){
+    bool negative = (numerator < 0) != (denominator < 0);
+    geometry_int_unsignedWide dividend = numerator < 0 ? -(geometry_int_unsignedWide)numerator : (geometry_int_unsignedWide)numerator;
+    geometry_int_unsignedWide divisor = denominator < 0 ? -(geometry_int_unsignedWide)denominator : (geometry_int_unsignedWide)denominator;
+    geometry_int_unsignedWide quotient = dividend / divisor;
+    geometry_int_unsignedWide remainder = dividend % divisor;
+    int exponent = 0;
+    // quotient is extended by 32 bits at a time until it has at least 66 significant bits, remainder
+    // stays below divisor (67 bits), so shifted remainder and quotient fit in 128 bits
+    while(remainder != 0 && quotient >> 66 == 0){
+        remainder <<= 32;
+        quotient = (quotient << 32) | (remainder / divisor);
+        remainder %= divisor;
+        exponent -= 32;
+    }
+    // non zero remainder is kept as sticky bit below rounding position, so that conversion of
+    // quotient is the only rounding
+    if(remainder != 0){
+        quotient |= 1;
+    }
+    geometry_real result = GEOMETRY_INT_LDEXP((geometry_real)quotient, exponent);
+    return negative ? -result : result;
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new geometry_int_point object with given coordinates
+*   In params:
+*       geometry_int_coordinate x       x coordinate
+*       geometry_int_coordinate y       y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_point*             pointer to created object, NULL if error occured
+*/
+geometry_int_point* geometry_int_point_new(geometry_int_coordinate x, geometry_int_coordinate y){
+    return geometry_int_point_new_with(NULL, x, y);
+}
+
+/**
+*   Function to create new geometry_int_point object with given coordinates inside given arena
+*   Created object is released with arena, it must not be passed to geometry_int_point_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_int_coordinate x       x coordinate
+*       geometry_int_coordinate y       y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_point*             pointer to created object, NULL if error occured
+*/
+geometry_int_point* geometry_int_point_new_in(geometry_arena* arena, geometry_int_coordinate x, geometry_int_coordinate y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_POINT_NEW_IN);
+    geometry_int_point* new_point = geometry_arena_allocate(arena, sizeof(*new_point));
+    if(new_point == NULL){
+        return NULL;
+    }
+    new_point->x = x;
+    new_point->y = y;
+    return new_point;
+}
+
+/**
+*   Function to create new geometry_int_point object with given coordinates with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_int_coordinate x               x coordinate
+*       geometry_int_coordinate y               y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_point*             pointer to created object, NULL if error occured
+*/
+geometry_int_point* geometry_int_point_new_with(const geometry_allocator* allocator, geometry_int_coordinate x, geometry_int_coordinate y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_POINT_NEW);
+    geometry_int_point* new_point = geometry_allocator_allocate(allocator, sizeof(*new_point));
+    if(new_point == NULL){
+        return NULL;
+    }
+    new_point->x = x;
+    new_point->y = y;
+    return new_point;
+}
+
+/**
+*   Function to destroy given geometry_int_point object
+*   In params:
+*       geometry_int_point* point       point object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_point_destroy(geometry_int_point* point){
+    geometry_int_point_destroy_with(NULL, point);
+}
+
+/**
+*   Function to destroy given geometry_int_point object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator point was created with, NULL for the one currently set
+*       geometry_int_point* point               point object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_point_destroy_with(const geometry_allocator* allocator, geometry_int_point* point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_POINT_DESTROY);
+    geometry_allocator_free(allocator, point);
+}
+
+/**
+*   Function to get x coordinate of given point
+*   In params:
+*       geometry_int_point* point       point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_coordinate         x coordinate of given point, 0 if point is NULL
+*/
+geometry_int_coordinate geometry_int_point_getX(geometry_int_point* point){
+    if(point != NULL){
+        return point->x;
+    }
+    return 0;
+}
+
+/**
+*   Function to get y coordinate of given point
+*   In params:
+*       geometry_int_point* point       point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_coordinate         y coordinate of given point, 0 if point is NULL
+*/
+geometry_int_coordinate geometry_int_point_getY(geometry_int_point* point){
+    if(point != NULL){
+        return point->y;
+    }
+    return 0;
+}
+
+/**
+*   Function to move point by vector
+*   In params:
+*       geometry_int_point* point               point to be moved
+*       geometry_int_coordinate vector_x        x coordinate of vector
+*       geometry_int_coordinate vector_y        y coordinate of vector
+*
+*   Out params:
+*       none (point object is changed)
+*
+*   Return:
+*       bool                                    true on success, false if moved point wouldn't fit
+*                                               in coordinate type (point is not changed then)
+*/
+bool geometry_int_point_moveByVector(geometry_int_point* point, geometry_int_coordinate vector_x, geometry_int_coordinate vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_POINT_MOVE_BY_VECTOR);
+    if(point == NULL){
+        return false;
+    }
+    geometry_int_point moved;
+    if(!geometry_int_coordinate_move(point->x, vector_x, &moved.x) || !geometry_int_coordinate_move(point->y, vector_y, &moved.y)){
+        return false;
+    }
+    *point = moved;
+    return true;
+}
+
+/**
+*   Function to check exactly if point lies on segment (ends included)
+*   In params:
+*       geometry_int_point* point       point
+*       geometry_int_segment* segment   segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true if point lies on segment
+*/
+bool geometry_int_point_liesOnSegment(geometry_int_point* point, geometry_int_segment* segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_POINT_LIES_ON_SEGMENT);
+    if(point == NULL || segment == NULL){
+        return false;
+    }
+    return geometry_int_point_inBox(point, &segment->start, &segment->end)
+        && geometry_int_point_orientation(&segment->start, &segment->end, point) == 0;
+}
+
+/**
+*   Function to create new geometry_int_segment object with copies of given points
+*   In params:
+*       geometry_int_point* start       starting point of segment
+*       geometry_int_point* end         ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_segment*           pointer to created object, NULL if error occured
+*/
+geometry_int_segment* geometry_int_segment_new(geometry_int_point* start, geometry_int_point* end){
+    return geometry_int_segment_new_with(NULL, start, end);
+}
+
+/**
+*   Function to create new geometry_int_segment object with copies of given points inside given arena
+*   Created object is released with arena, it must not be passed to geometry_int_segment_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_int_point* start       starting point of segment
+*       geometry_int_point* end         ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_segment*           pointer to created object, NULL if error occured
+*/
+geometry_int_segment* geometry_int_segment_new_in(geometry_arena* arena, geometry_int_point* start, geometry_int_point* end){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_SEGMENT_NEW_IN);
+    if(arena == NULL || start == NULL || end == NULL){
+        return NULL;
+    }
+    geometry_int_segment* new_segment = geometry_arena_allocate(arena, sizeof(*new_segment));
+    if(new_segment == NULL){
+        return NULL;
+    }
+    new_segment->start = *start;
+    new_segment->end = *end;
+    return new_segment;
+}
+
+/**
+*   Function to create new geometry_int_segment object with copies of given points with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_int_point* start               starting point of segment
+*       geometry_int_point* end                 ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_segment*           pointer to created object, NULL if error occured
+*/
+geometry_int_segment* geometry_int_segment_new_with(const geometry_allocator* allocator, geometry_int_point* start, geometry_int_point* end){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_SEGMENT_NEW);
+    if(start == NULL || end == NULL){
+        return NULL;
+    }
+    geometry_int_segment* new_segment = geometry_allocator_allocate(allocator, sizeof(*new_segment));
+    if(new_segment == NULL){
+        return NULL;
+    }
+    new_segment->start = *start;
+    new_segment->end = *end;
+    return new_segment;
+}
+
+/**
+*   Function to destroy given geometry_int_segment object
+*   In params:
+*       geometry_int_segment* segment   segment object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_segment_destroy(geometry_int_segment* segment){
+    geometry_int_segment_destroy_with(NULL, segment);
+}
+
+/**
+*   Function to destroy given geometry_int_segment object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator segment was created with, NULL for the one currently set
+*       geometry_int_segment* segment           segment object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_segment_destroy_with(const geometry_allocator* allocator, geometry_int_segment* segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_SEGMENT_DESTROY);
+    geometry_allocator_free(allocator, segment);
+}
+
+/**
+*   Function to get end points of given segment
+*   Returned points are stored inside the segment, they are valid until segment is destroyed
+*   and must not be passed to geometry_int_point_destroy
+*   In params:
+*       geometry_int_segment* segment   segment
+*
+*   Out params:
+*       geometry_int_point** start      pointer to starting point of given segment
+*       geometry_int_point** end        pointer to ending point of given segment
+*
+*   Return:
+*       none
+*/
+void geometry_int_segment_getPoints(geometry_int_segment* segment, geometry_int_point** start, geometry_int_point** end){
+    if(segment != NULL){
+        *start = &segment->start;
+        *end = &segment->end;
+    }
+}
+
+/**
+*   Function to move segment by vector
+*   In params:
+*       geometry_int_segment* segment           segment to be moved
+*       geometry_int_coordinate vector_x        x coordinate of vector
+*       geometry_int_coordinate vector_y        y coordinate of vector
+*
+*   Out params:
+*       none (segment object is changed)
+*
+*   Return:
+*       bool                                    true on success, false if moved segment wouldn't fit
+*                                               in coordinate type (segment is not changed then)
+*/
+bool geometry_int_segment_moveByVector(geometry_int_segment* segment, geometry_int_coordinate vector_x, geometry_int_coordinate vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_SEGMENT_MOVE_BY_VECTOR);
+    if(segment == NULL){
+        return false;
+    }
+    geometry_int_segment moved;
+    if(!geometry_int_coordinate_move(segment->start.x, vector_x, &moved.start.x) || !geometry_int_coordinate_move(segment->start.y, vector_y, &moved.start.y)
+        || !geometry_int_coordinate_move(segment->end.x, vector_x, &moved.end.x) || !geometry_int_coordinate_move(segment->end.y, vector_y, &moved.end.y)){
+        return false;
+    }
+    *segment = moved;
+    return true;
+}
+
+/**
+*   Function to calculate length of given segment
+*   Square of length is exact, only square root is rounded
+*   In params:
+*       geometry_int_segment* segment   segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                   length of given segment, -1 if segment is NULL
+*/
+geometry_real geometry_int_segment_calculateLength(geometry_int_segment* segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_SEGMENT_CALCULATE_LENGTH);
+    if(segment == NULL){
+        return -1;
+    }
+    return GEOMETRY_INT_SQRT((geometry_real)geometry_int_point_squaredDistance(&segment->start, &segment->end));
+}
+
+/**
+*   Function to check exactly if two segments are parallel (colinear included)
+*   In params:
+*       geometry_int_segment* first_segment     first segment
+*       geometry_int_segment* second_segment    second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true if segments are parallel
+*/
+bool geometry_int_segment_areParallel(geometry_int_segment* first_segment, geometry_int_segment* second_segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_SEGMENT_ARE_PARALLEL);
+    if(first_segment == NULL || second_segment == NULL){
+        return false;
+    }
+    int64_t first_x = (int64_t)first_segment->end.x - first_segment->start.x;
+    int64_t first_y = (int64_t)first_segment->end.y - first_segment->start.y;
+    int64_t second_x = (int64_t)second_segment->end.x - second_segment->start.x;
+    int64_t second_y = (int64_t)second_segment->end.y - second_segment->start.y;
+    return (geometry_int_wide)first_x * second_y == (geometry_int_wide)first_y * second_x;
+}
+
+/**
+*   Function to check exactly if two segments are perpendicular
+*   In params:
+*       geometry_int_segment* first_segment     first segment
+*       geometry_int_segment* second_segment    second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true if segments are perpendicular
+*/
+bool geometry_int_segment_arePerpendicular(geometry_int_segment* first_segment, geometry_int_segment* second_segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_SEGMENT_ARE_PERPENDICULAR);
+    if(first_segment == NULL || second_segment == NULL){
+        return false;
+    }
+    int64_t first_x = (int64_t)first_segment->end.x - first_segment->start.x;
+    int64_t first_y = (int64_t)first_segment->end.y - first_segment->start.y;
+    int64_t second_x = (int64_t)second_segment->end.x - second_segment->start.x;
+    int64_t second_y = (int64_t)second_segment->end.y - second_segment->start.y;
+    return (geometry_int_wide)first_x * second_x + (geometry_int_wide)first_y * second_y == 0;
+}
+
+/**
+*   Function to check exactly if two segments have any common point (ends and overlapping colinear segments included)
+*   In params:
+*       geometry_int_segment* first_segment     first segment
+*       geometry_int_segment* second_segment    second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true if segments intersect
+*/
+bool geometry_int_segment_areIntersecting(geometry_int_segment* first_segment, geometry_int_segment* second_segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_SEGMENT_ARE_INTERSECTING);
+    if(first_segment == NULL || second_segment == NULL){
+        return false;
+    }
+    return geometry_int_segment_intersect(&first_segment->start, &first_segment->end, &second_segment->start, &second_segment->end);
+}
+
+/**
+*   Function to calculate intersection point of two segments
+*   Whether segments intersect is decided exactly, only coordinates of point are rounded
+*   (they are rational numbers in general)
+*   In params:
+*       geometry_int_segment* first_segment     first segment
+*       geometry_int_segment* second_segment    second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point*                         pointer to created point, NULL if segments don't intersect,
+*                                               are colinear or error occured
+*/
+geometry_point* geometry_int_segment_calculateIntersection(geometry_int_segment* first_segment, geometry_int_segment* second_segment){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_SEGMENT_CALCULATE_INTERSECTION);
+    if(first_segment == NULL || second_segment == NULL){
+        return NULL;
+    }
+    geometry_int_point* first_start = &first_segment->start;
+    geometry_int_point* first_end = &first_segment->end;
+    geometry_int_point* second_start = &second_segment->start;
+    geometry_int_point* second_end = &second_segment->end;
+    int second_start_side = geometry_int_point_orientation(first_start, first_end, second_start);
+    int second_end_side = geometry_int_point_orientation(first_start, first_end, second_end);
+    int first_start_side = geometry_int_point_orientation(second_start, second_end, first_start);
+    int first_end_side = geometry_int_point_orientation(second_start, second_end, first_end);
+    if(second_start_side == 0 && second_end_side == 0){
+        // colinear segments are parallel, as in geometry_segment_calculateIntersection
+        return NULL;
+    }
+    if(second_start_side * second_end_side > 0 || first_start_side * first_end_side > 0){
+        return NULL;
+    }
+    if(second_start_side == 0){
+        return geometry_point_new(second_start->x, second_start->y);
+    }
+    if(second_end_side == 0){
+        return geometry_point_new(second_end->x, second_end->y);
+    }
+    if(first_start_side == 0){
+        return geometry_point_new(first_start->x, first_start->y);
+    }
+    if(first_end_side == 0){
+        return geometry_point_new(first_end->x, first_end->y);
+    }
+    // point is first_start + (numerator / denominator) * (first_end - first_start), both coordinates
+    // are calculated as exact fractions (at most 101 bits) and rounded once, by geometry_int_wide_divide
+    int64_t first_x = (int64_t)first_end->x - first_start->x;
+    int64_t first_y = (int64_t)first_end->y - first_start->y;
+    int64_t second_x = (int64_t)second_end->x - second_start->x;
+    int64_t second_y = (int64_t)second_end->y - second_start->y;
+    int64_t start_x = (int64_t)second_start->x - first_start->x;
+    int64_t start_y = (int64_t)second_start->y - first_start->y;
+    geometry_int_wide denominator = (geometry_int_wide)first_x * second_y - (geometry_int_wide)first_y * second_x;
+    geometry_int_wide numerator = (geometry_int_wide)start_x * second_y - (geometry_int_wide)start_y * second_x;
+    geometry_int_wide x = (geometry_int_wide)first_start->x * denominator + numerator * first_x;
+    geometry_int_wide y = (geometry_int_wide)first_start->y * denominator + numerator * first_y;
+    return geometry_point_new(geometry_int_wide_divide(x, denominator), geometry_int_wide_divide(y, denominator));
+}
+
+/**
+*   Function to create new geometry_int_triangle object with copies of given points
+*   In params:
+*       geometry_int_point* first       first point of triangle
+*       geometry_int_point* second      second point of triangle
+*       geometry_int_point* third       third point of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_triangle*          pointer to created object, NULL if error occured
+*/
+geometry_int_triangle* geometry_int_triangle_new(geometry_int_point* first, geometry_int_point* second, geometry_int_point* third){
+    return geometry_int_triangle_new_with(NULL, first, second, third);
+}
+
+/**
+*   Function to create new geometry_int_triangle object with copies of given points inside given arena
+*   Created object is released with arena, it must not be passed to geometry_int_triangle_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_int_point* first       first point of triangle
+*       geometry_int_point* second      second point of triangle
+*       geometry_int_point* third       third point of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_triangle*          pointer to created object, NULL if error occured
+*/
+geometry_int_triangle* geometry_int_triangle_new_in(geometry_arena* arena, geometry_int_point* first, geometry_int_point* second, geometry_int_point* third){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_TRIANGLE_NEW_IN);
+    if(arena == NULL || first == NULL || second == NULL || third == NULL){
+        return NULL;
+    }
+    geometry_int_triangle* new_triangle = geometry_arena_allocate(arena, sizeof(*new_triangle));
+    if(new_triangle == NULL){
+        return NULL;
+    }
+    new_triangle->first = *first;
+    new_triangle->second = *second;
+    new_triangle->third = *third;
+    return new_triangle;
+}
+
+/**
+*   Function to create new geometry_int_triangle object with copies of given points with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_int_point* first               first point of triangle
+*       geometry_int_point* second              second point of triangle
+*       geometry_int_point* third               third point of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_triangle*          pointer to created object, NULL if error occured
+*/
+geometry_int_triangle* geometry_int_triangle_new_with(const geometry_allocator* allocator, geometry_int_point* first, geometry_int_point* second, geometry_int_point* third){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_TRIANGLE_NEW);
+    if(first == NULL || second == NULL || third == NULL){
+        return NULL;
+    }
+    geometry_int_triangle* new_triangle = geometry_allocator_allocate(allocator, sizeof(*new_triangle));
+    if(new_triangle == NULL){
+        return NULL;
+    }
+    new_triangle->first = *first;
+    new_triangle->second = *second;
+    new_triangle->third = *third;
+    return new_triangle;
+}
+
+/**
+*   Function to destroy given geometry_int_triangle object
+*   In params:
+*       geometry_int_triangle* triangle     triangle object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_triangle_destroy(geometry_int_triangle* triangle){
+    geometry_int_triangle_destroy_with(NULL, triangle);
+}
+
+/**
+*   Function to destroy given geometry_int_triangle object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator triangle was created with, NULL for the one currently set
+*       geometry_int_triangle* triangle         triangle object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_triangle_destroy_with(const geometry_allocator* allocator, geometry_int_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_TRIANGLE_DESTROY);
+    geometry_allocator_free(allocator, triangle);
+}
+
+/**
+*   Function to get vertices of given triangle
+*   Returned points are stored inside the triangle, they are valid until triangle is destroyed
+*   and must not be passed to geometry_int_point_destroy
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       geometry_int_point** first          pointer to first point of given triangle
+*       geometry_int_point** second         pointer to second point of given triangle
+*       geometry_int_point** third          pointer to third point of given triangle
+*
+*   Return:
+*       none
+*/
+void geometry_int_triangle_getPoints(geometry_int_triangle* triangle, geometry_int_point** first, geometry_int_point** second, geometry_int_point** third){
+    if(triangle != NULL){
+        *first = &triangle->first;
+        *second = &triangle->second;
+        *third = &triangle->third;
+    }
+}
+
+/**
+*   Function to check exactly if given triangle is right-angled
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if two sides of triangle (of positive length) are perpendicular
+*/
+bool geometry_int_triangle_isRight(geometry_int_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_TRIANGLE_IS_RIGHT);
+    if(triangle == NULL){
+        return false;
+    }
+    geometry_int_point* vertices[3] = {&triangle->first, &triangle->second, &triangle->third};
+    for(int i = 0; i < 3; i++){
+        geometry_int_point* vertex = vertices[i];
+        geometry_int_point* next = vertices[(i + 1) % 3];
+        geometry_int_point* previous = vertices[(i + 2) % 3];
+        if(geometry_int_point_squaredDistance(vertex, next) != 0 && geometry_int_point_squaredDistance(vertex, previous) != 0
+            && geometry_int_point_dot(vertex, next, previous) == 0){
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+*   Function to move triangle by vector
+*   In params:
+*       geometry_int_triangle* triangle         triangle to be moved
+*       geometry_int_coordinate vector_x        x coordinate of vector
+*       geometry_int_coordinate vector_y        y coordinate of vector
+*
+*   Out params:
+*       none (triangle object is changed)
+*
+*   Return:
+*       bool                                    true on success, false if moved triangle wouldn't fit
+*                                               in coordinate type (triangle is not changed then)
+*/
+bool geometry_int_triangle_moveByVector(geometry_int_triangle* triangle, geometry_int_coordinate vector_x, geometry_int_coordinate vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_TRIANGLE_MOVE_BY_VECTOR);
+    if(triangle == NULL){
+        return false;
+    }
+    geometry_int_triangle moved;
+    if(!geometry_int_coordinate_move(triangle->first.x, vector_x, &moved.first.x) || !geometry_int_coordinate_move(triangle->first.y, vector_y, &moved.first.y)
+        || !geometry_int_coordinate_move(triangle->second.x, vector_x, &moved.second.x) || !geometry_int_coordinate_move(triangle->second.y, vector_y, &moved.second.y)
+        || !geometry_int_coordinate_move(triangle->third.x, vector_x, &moved.third.x) || !geometry_int_coordinate_move(triangle->third.y, vector_y, &moved.third.y)){
+        return false;
+    }
+    *triangle = moved;
+    return true;
+}
+
+/**
+*   Function to calculate area of given triangle
+*   Doubled area is calculated exactly, only conversion to geometry_real is rounded
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       area of given triangle, -1 if triangle is NULL
+*/
+geometry_real geometry_int_triangle_calculateArea(geometry_int_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_TRIANGLE_CALCULATE_AREA);
+    if(triangle == NULL){
+        return -1;
+    }
+    geometry_int_wide doubled_area = geometry_int_point_cross(&triangle->first, &triangle->second, &triangle->third);
+    if(doubled_area < 0){
+        doubled_area = -doubled_area;
+    }
+    return (geometry_real)doubled_area / 2;
+}
+
+/**
+*   Function to calculate perimeter of given triangle
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       perimeter of given triangle, -1 if triangle is NULL
+*/
+geometry_real geometry_int_triangle_calculatePerimeter(geometry_int_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_TRIANGLE_CALCULATE_PERIMETER);
+    if(triangle == NULL){
+        return -1;
+    }
+    return GEOMETRY_INT_SQRT((geometry_real)geometry_int_point_squaredDistance(&triangle->first, &triangle->second))
+        + GEOMETRY_INT_SQRT((geometry_real)geometry_int_point_squaredDistance(&triangle->second, &triangle->third))
+        + GEOMETRY_INT_SQRT((geometry_real)geometry_int_point_squaredDistance(&triangle->third, &triangle->first));
+}
+
+/**
+*   Function to calculate hypotenuse of given triangle
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       length of hypotenuse, -1 if triangle is NULL or is not right-angled
+*/
+geometry_real geometry_int_triangle_calculateHypotenuse(geometry_int_triangle* triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_TRIANGLE_CALCULATE_HYPOTENUSE);
+    if(!geometry_int_triangle_isRight(triangle)){
+        return -1;
+    }
+    // hypotenuse is the longest side, lengths are compared exactly
+    geometry_int_wide first_second = geometry_int_point_squaredDistance(&triangle->first, &triangle->second);
+    geometry_int_wide second_third = geometry_int_point_squaredDistance(&triangle->second, &triangle->third);
+    geometry_int_wide third_first = geometry_int_point_squaredDistance(&triangle->third, &triangle->first);
+    geometry_int_wide longest = first_second;
+    if(second_third > longest){
+        longest = second_third;
+    }
+    if(third_first > longest){
+        longest = third_first;
+    }
+    return GEOMETRY_INT_SQRT((geometry_real)longest);
+}
+
+/**
+*   Function to check exactly if two triangles are disjoint (touching triangles are not disjoint)
+*   In params:
+*       geometry_int_triangle* first_triangle       first triangle
+*       geometry_int_triangle* second_triangle      second triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                        true if triangles have no common point,
+*                                                   false otherwise or if error occured
+*/
+bool geometry_int_triangle_areDisjoint(geometry_int_triangle* first_triangle, geometry_int_triangle* second_triangle){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_INT_TRIANGLE_ARE_DISJOINT);
+    if(first_triangle == NULL || second_triangle == NULL){
+        return false;
+    }
+    geometry_int_point* first_vertices[3] = {&first_triangle->first, &first_triangle->second, &first_triangle->third};
+    geometry_int_point* second_vertices[3] = {&second_triangle->first, &second_triangle->second, &second_triangle->third};
+    // any common point of borders (degenerate triangle is covered by its sides too)
+    for(int i = 0; i < 3; i++){
+        for(int j = 0; j < 3; j++){
+            if(geometry_int_segment_intersect(first_vertices[i], first_vertices[(i + 1) % 3], second_vertices[j], second_vertices[(j + 1) % 3])){
+                return false;
+            }
+        }
+    }
+    // borders don't meet, so triangles are disjoint unless one lies inside the other
+    return !geometry_int_triangle_contains(first_triangle, second_vertices[0])
+        && !geometry_int_triangle_contains(second_triangle, first_vertices[0]);
+}
@@ -0,0 +1,496 @@
+#ifndef GEOMETRY_INT
+#define GEOMETRY_INT
+
+#include "geometry.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Points, segments and triangles with integer coordinates, e.g. for data snapped to grid.
+// Coordinates are 32-bit, so differences of coordinates fit in 64 bits and their products
+// in 128 bits - every predicate (orientation, parallelism, perpendicularity, intersection)
+// is calculated exactly with integer cross and dot products, without rounding errors
+// and without slower exact fallbacks needed for floating-point coordinates.
+// Needs compiler with 128-bit integers (GCC or Clang on 64-bit machines).
+typedef int32_t geometry_int_coordinate;
+typedef struct geometry_int_point geometry_int_point;
+typedef struct geometry_int_segment geometry_int_segment;
+// Whether triangle is right-angled is not given by user, it is checked exactly
+typedef struct geometry_int_triangle geometry_int_triangle;
+
+/*###################################################
+ GEOMETRY_INT_POINT functions (methods) declarations
+####################################################*/
+
+/**
+*   Function to create new geometry_int_point object with given coordinates
+*   In params:
+*       geometry_int_coordinate x       x coordinate
+*       geometry_int_coordinate y       y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_point*             pointer to created object, NULL if error occured
+*/
+geometry_int_point* geometry_int_point_new(geometry_int_coordinate x, geometry_int_coordinate y);
+
+/**
+*   Function to create new geometry_int_point object with given coordinates inside given arena
+*   Created object is released with arena, it must not be passed to geometry_int_point_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_int_coordinate x       x coordinate
+*       geometry_int_coordinate y       y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_point*             pointer to created object, NULL if error occured
+*/
+geometry_int_point* geometry_int_point_new_in(geometry_arena* arena, geometry_int_coordinate x, geometry_int_coordinate y);
+
+/**
+*   Function to create new geometry_int_point object with given coordinates with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_int_coordinate x               x coordinate
+*       geometry_int_coordinate y               y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_point*             pointer to created object, NULL if error occured
+*/
+geometry_int_point* geometry_int_point_new_with(const geometry_allocator* allocator, geometry_int_coordinate x, geometry_int_coordinate y);
+
+/**
+*   Function to destroy given geometry_int_point object
+*   In params:
+*       geometry_int_point* point       point object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_point_destroy(geometry_int_point* point);
+
+/**
+*   Function to destroy given geometry_int_point object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator point was created with, NULL for the one currently set
+*       geometry_int_point* point               point object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_point_destroy_with(const geometry_allocator* allocator, geometry_int_point* point);
+
+/**
+*   Function to get x coordinate of given point
+*   In params:
+*       geometry_int_point* point       point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_coordinate         x coordinate of given point, 0 if point is NULL
+*/
+geometry_int_coordinate geometry_int_point_getX(geometry_int_point* point);
+
+/**
+*   Function to get y coordinate of given point
+*   In params:
+*       geometry_int_point* point       point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_coordinate         y coordinate of given point, 0 if point is NULL
+*/
+geometry_int_coordinate geometry_int_point_getY(geometry_int_point* point);
+
+/**
+*   Function to move point by vector
+*   In params:
+*       geometry_int_point* point               point to be moved
+*       geometry_int_coordinate vector_x        x coordinate of vector
+*       geometry_int_coordinate vector_y        y coordinate of vector
+*
+*   Out params:
+*       none (point object is changed)
+*
+*   Return:
+*       bool                                    true on success, false if moved point wouldn't fit
+*                                               in coordinate type (point is not changed then)
+*/
+bool geometry_int_point_moveByVector(geometry_int_point* point, geometry_int_coordinate vector_x, geometry_int_coordinate vector_y);
+
+/**
+*   Function to check exactly if point lies on segment (ends included)
+*   In params:
+*       geometry_int_point* point       point
+*       geometry_int_segment* segment   segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true if point lies on segment
+*/
+bool geometry_int_point_liesOnSegment(geometry_int_point* point, geometry_int_segment* segment);
+
+/*#####################################################
+ GEOMETRY_INT_SEGMENT functions (methods) declarations
+######################################################*/
+
+/**
+*   Function to create new geometry_int_segment object with copies of given points
+*   In params:
+*       geometry_int_point* start       starting point of segment
+*       geometry_int_point* end         ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_segment*           pointer to created object, NULL if error occured
+*/
+geometry_int_segment* geometry_int_segment_new(geometry_int_point* start, geometry_int_point* end);
+
+/**
+*   Function to create new geometry_int_segment object with copies of given points inside given arena
+*   Created object is released with arena, it must not be passed to geometry_int_segment_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_int_point* start       starting point of segment
+*       geometry_int_point* end         ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_segment*           pointer to created object, NULL if error occured
+*/
+geometry_int_segment* geometry_int_segment_new_in(geometry_arena* arena, geometry_int_point* start, geometry_int_point* end);
+
+/**
+*   Function to create new geometry_int_segment object with copies of given points with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_int_point* start               starting point of segment
+*       geometry_int_point* end                 ending point of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_segment*           pointer to created object, NULL if error occured
+*/
+geometry_int_segment* geometry_int_segment_new_with(const geometry_allocator* allocator, geometry_int_point* start, geometry_int_point* end);
+
+/**
+*   Function to destroy given geometry_int_segment object
+*   In params:
+*       geometry_int_segment* segment   segment object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_segment_destroy(geometry_int_segment* segment);
+
+/**
+*   Function to destroy given geometry_int_segment object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator segment was created with, NULL for the one currently set
+*       geometry_int_segment* segment           segment object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_segment_destroy_with(const geometry_allocator* allocator, geometry_int_segment* segment);
+
+/**
+*   Function to get end points of given segment
+*   Returned points are stored inside the segment, they are valid until segment is destroyed
+*   and must not be passed to geometry_int_point_destroy
+*   In params:
+*       geometry_int_segment* segment   segment
+*
+*   Out params:
+*       geometry_int_point** start      pointer to starting point of given segment
+*       geometry_int_point** end        pointer to ending point of given segment
+*
+*   Return:
+*       none
+*/
+void geometry_int_segment_getPoints(geometry_int_segment* segment, geometry_int_point** start, geometry_int_point** end);
+
+/**
+*   Function to move segment by vector
+*   In params:
+*       geometry_int_segment* segment           segment to be moved
+*       geometry_int_coordinate vector_x        x coordinate of vector
+*       geometry_int_coordinate vector_y        y coordinate of vector
+*
+*   Out params:
+*       none (segment object is changed)
+*
+*   Return:
+*       bool                                    true on success, false if moved segment wouldn't fit
+*                                               in coordinate type (segment is not changed then)
+*/
+bool geometry_int_segment_moveByVector(geometry_int_segment* segment, geometry_int_coordinate vector_x, geometry_int_coordinate vector_y);
+
+/**
+*   Function to calculate length of given segment
+*   Square of length is exact, only square root is rounded
+*   In params:
+*       geometry_int_segment* segment   segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                   length of given segment, -1 if segment is NULL
+*/
+geometry_real geometry_int_segment_calculateLength(geometry_int_segment* segment);
+
+/**
+*   Function to check exactly if two segments are parallel (colinear included)
+*   In params:
+*       geometry_int_segment* first_segment     first segment
+*       geometry_int_segment* second_segment    second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true if segments are parallel
+*/
+bool geometry_int_segment_areParallel(geometry_int_segment* first_segment, geometry_int_segment* second_segment);
+
+/**
+*   Function to check exactly if two segments are perpendicular
+*   In params:
+*       geometry_int_segment* first_segment     first segment
+*       geometry_int_segment* second_segment    second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true if segments are perpendicular
+*/
+bool geometry_int_segment_arePerpendicular(geometry_int_segment* first_segment, geometry_int_segment* second_segment);
+
+/**
+*   Function to check exactly if two segments have any common point (ends and overlapping colinear segments included)
+*   In params:
+*       geometry_int_segment* first_segment     first segment
+*       geometry_int_segment* second_segment    second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                    true if segments intersect
+*/
+bool geometry_int_segment_areIntersecting(geometry_int_segment* first_segment, geometry_int_segment* second_segment);
+
+/**
+*   Function to calculate intersection point of two segments
+*   Whether segments intersect is decided exactly, only coordinates of point are rounded
+*   (they are rational numbers in general)
+*   In params:
+*       geometry_int_segment* first_segment     first segment
+*       geometry_int_segment* second_segment    second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_point*                         pointer to created point, NULL if segments don't intersect,
+*                                               are colinear or error occured
+*/
+geometry_point* geometry_int_segment_calculateIntersection(geometry_int_segment* first_segment, geometry_int_segment* second_segment);
+
+/*######################################################
+ GEOMETRY_INT_TRIANGLE functions (methods) declarations
+#######################################################*/
+
+/**
+*   Function to create new geometry_int_triangle object with copies of given points
+*   In params:
+*       geometry_int_point* first       first point of triangle
+*       geometry_int_point* second      second point of triangle
+*       geometry_int_point* third       third point of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_triangle*          pointer to created object, NULL if error occured
+*/
+geometry_int_triangle* geometry_int_triangle_new(geometry_int_point* first, geometry_int_point* second, geometry_int_point* third);
+
+/**
+*   Function to create new geometry_int_triangle object with copies of given points inside given arena
+*   Created object is released with arena, it must not be passed to geometry_int_triangle_destroy
+*   In params:
+*       geometry_arena* arena           arena to allocate object from
+*       geometry_int_point* first       first point of triangle
+*       geometry_int_point* second      second point of triangle
+*       geometry_int_point* third       third point of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_triangle*          pointer to created object, NULL if error occured
+*/
+geometry_int_triangle* geometry_int_triangle_new_in(geometry_arena* arena, geometry_int_point* first, geometry_int_point* second, geometry_int_point* third);
+
+/**
+*   Function to create new geometry_int_triangle object with copies of given points with memory taken from given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_int_point* first               first point of triangle
+*       geometry_int_point* second              second point of triangle
+*       geometry_int_point* third               third point of triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_int_triangle*          pointer to created object, NULL if error occured
+*/
+geometry_int_triangle* geometry_int_triangle_new_with(const geometry_allocator* allocator, geometry_int_point* first, geometry_int_point* second, geometry_int_point* third);
+
+/**
+*   Function to destroy given geometry_int_triangle object
+*   In params:
+*       geometry_int_triangle* triangle     triangle object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_triangle_destroy(geometry_int_triangle* triangle);
+
+/**
+*   Function to destroy given geometry_int_triangle object created with given allocator
+*   In params:
+*       const geometry_allocator* allocator     allocator triangle was created with, NULL for the one currently set
+*       geometry_int_triangle* triangle         triangle object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_int_triangle_destroy_with(const geometry_allocator* allocator, geometry_int_triangle* triangle);
+
+/**
+*   Function to get vertices of given triangle
+*   Returned points are stored inside the triangle, they are valid until triangle is destroyed
+*   and must not be passed to geometry_int_point_destroy
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       geometry_int_point** first          pointer to first point of given triangle
+*       geometry_int_point** second         pointer to second point of given triangle
+*       geometry_int_point** third          pointer to third point of given triangle
+*
+*   Return:
+*       none
+*/
+void geometry_int_triangle_getPoints(geometry_int_triangle* triangle, geometry_int_point** first, geometry_int_point** second, geometry_int_point** third);
+
+/**
+*   Function to check exactly if given triangle is right-angled
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if two sides of triangle (of positive length) are perpendicular
+*/
+bool geometry_int_triangle_isRight(geometry_int_triangle* triangle);
+
+/**
+*   Function to move triangle by vector
+*   In params:
+*       geometry_int_triangle* triangle         triangle to be moved
+*       geometry_int_coordinate vector_x        x coordinate of vector
+*       geometry_int_coordinate vector_y        y coordinate of vector
+*
+*   Out params:
+*       none (triangle object is changed)
+*
+*   Return:
+*       bool                                    true on success, false if moved triangle wouldn't fit
+*                                               in coordinate type (triangle is not changed then)
+*/
+bool geometry_int_triangle_moveByVector(geometry_int_triangle* triangle, geometry_int_coordinate vector_x, geometry_int_coordinate vector_y);
+
+/**
+*   Function to calculate area of given triangle
+*   Doubled area is calculated exactly, only conversion to geometry_real is rounded
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       area of given triangle, -1 if triangle is NULL
+*/
+geometry_real geometry_int_triangle_calculateArea(geometry_int_triangle* triangle);
+
+/**
+*   Function to calculate perimeter of given triangle
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       perimeter of given triangle, -1 if triangle is NULL
+*/
+geometry_real geometry_int_triangle_calculatePerimeter(geometry_int_triangle* triangle);
+
+/**
+*   Function to calculate hypotenuse of given triangle
+*   In params:
+*       geometry_int_triangle* triangle     triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real                       length of hypotenuse, -1 if triangle is NULL or is not right-angled
+*/
+geometry_real geometry_int_triangle_calculateHypotenuse(geometry_int_triangle* triangle);
+
+/**
+*   Function to check exactly if two triangles are disjoint (touching triangles are not disjoint)
+*   In params:
+*       geometry_int_triangle* first_triangle       first triangle
+*       geometry_int_triangle* second_triangle      second triangle
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                        true if triangles have no common point,
+*                                                   false otherwise or if error occured
+*/
+bool geometry_int_triangle_areDisjoint(geometry_int_triangle* first_triangle, geometry_int_triangle* second_triangle);
+
+#endif
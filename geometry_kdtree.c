@@ -0,0 +1,577 @@
+#include "geometry_kdtree.h"
+#include "geometry_stats.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#define GEOMETRY_KDTREE_NONE ((size_t)-1)
+// ranges of at most that many points are scanned instead of being split
+#define GEOMETRY_KDTREE_LEAF_SIZE 8
+// every level of traversal leaves at most one range waiting on stack and depth
+// of tree is below 64 for any number of points that fits in memory
+#define GEOMETRY_KDTREE_STACK_SIZE 128
+
+struct geometry_kdtree {
+    // coordinates[0] are x coordinates, coordinates[1] are y coordinates
+    geometry_real* coordinates[2];
+    // index of every point in array given on creation
+    size_t* indices;
+    // axis and coordinate at which range with median at given position was split
+    // (median itself moves later, when right half is split)
+    unsigned char* axes;
+    geometry_real* splits;
+    size_t count;
+    geometry_allocator allocator;
+};
+
+// Range of points waiting for traversal together with lower bound
+// of squared distance between query point and any point in range
+typedef struct geometry_kdtree_range {
+    size_t begin;
+    size_t end;
+    geometry_real bound;
+} geometry_kdtree_range;
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static void geometry_kdtree_swap(geometry_kdtree* kdtree, size_t first, size_t second);
+static void geometry_kdtree_select(geometry_kdtree* kdtree, int axis, size_t begin, size_t end, size_t nth);
+static void geometry_kdtree_build(geometry_kdtree* kdtree, size_t begin, size_t end);
+static void geometry_kdtree_siftDown(size_t* points, geometry_real* distances, size_t size, size_t position);
+static size_t geometry_kdtree_searchNearest(geometry_kdtree* kdtree, geometry_real x, geometry_real y, size_t k, size_t* points, geometry_real* distances);
+static size_t geometry_kdtree_searchRadius(geometry_kdtree* kdtree, geometry_real x, geometry_real y, geometry_real radius, size_t query, size_t* points, geometry_kdtree_match* matches, size_t found, size_t capacity);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to swap two points of tree
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       size_t first                position of first point
+*       size_t second               position of second point
+*
+*   Out params/return:
+*       none (tree is changed)
+*/
+static void geometry_kdtree_swap(geometry_kdtree* kdtree, size_t first, size_t second){
+    for(int axis = 0; axis < 2; axis++){
+        geometry_real coordinate = kdtree->coordinates[axis][first];
+        kdtree->coordinates[axis][first] = kdtree->coordinates[axis][second];
+        kdtree->coordinates[axis][second] = coordinate;
+    }
+    size_t index = kdtree->indices[first];
+    kdtree->indices[first] = kdtree->indices[second];
+    kdtree->indices[second] = index;
+}
+
+/**
+*   Function to reorder range of points so nth point is where it would be after sorting
+*   by given coordinate, points before it are not bigger and points after it are not smaller
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       int axis                    0 for x coordinate, 1 for y coordinate
+*       size_t begin                first point of range
+*       size_t end                  point after last point of range
+*       size_t nth                  position to be fixed
+*
+*   Out params/return:
+*       none (tree is changed)
+*/
+static void geometry_kdtree_select(geometry_kdtree* kdtree, int axis, size_t begin, size_t end, size_t nth){
+    geometry_real* values = kdtree->coordinates[axis];
+    while(end - begin > 1){
+        geometry_real pivot = values[begin + (end - begin) / 2];
+        ptrdiff_t i = (ptrdiff_t)begin;
+        ptrdiff_t j = (ptrdiff_t)end - 1;
+        while(i <= j){
+            while(values[i] < pivot){
+                i++;
+            }
+            while(values[j] > pivot){
+                j--;
+            }
+            if(i <= j){
+                geometry_kdtree_swap(kdtree, (size_t)i, (size_t)j);
+                i++;
+                j--;
+            }
+        }
+        // now points up to j are not bigger than pivot, points from i are not smaller
+        // and points between them are equal to pivot
+        if((ptrdiff_t)nth <= j){
+            end = (size_t)j + 1;
+        }
+        else if((ptrdiff_t)nth >= i){
+            begin = (size_t)i;
+        }
+        else{
+            return;
+        }
+    }
+}
+
+/**
+*   Function to split range of points at median along its longer side, recursively
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       size_t begin                first point of range
+*       size_t end                  point after last point of range
+*
+*   Out params/return:
+*       none (tree is changed)
+*/
+static void geometry_kdtree_build(geometry_kdtree* kdtree, size_t begin, size_t end){
+    if(end - begin <= GEOMETRY_KDTREE_LEAF_SIZE){
+        return;
+    }
+    geometry_real min_x = INFINITY;
+    geometry_real min_y = INFINITY;
+    geometry_real max_x = -INFINITY;
+    geometry_real max_y = -INFINITY;
+    for(size_t i = begin; i < end; i++){
+        min_x = GEOMETRY_FMIN(min_x, kdtree->coordinates[0][i]);
+        max_x = GEOMETRY_FMAX(max_x, kdtree->coordinates[0][i]);
+        min_y = GEOMETRY_FMIN(min_y, kdtree->coordinates[1][i]);
+        max_y = GEOMETRY_FMAX(max_y, kdtree->coordinates[1][i]);
+    }
+    int axis = max_x - min_x >= max_y - min_y ? 0 : 1;
+    size_t middle = begin + (end - begin) / 2;
+    geometry_kdtree_select(kdtree, axis, begin, end, middle);
+    kdtree->axes[middle] = (unsigned char)axis;
+    kdtree->splits[middle] = kdtree->coordinates[axis][middle];
+    geometry_kdtree_build(kdtree, begin, middle);
+    geometry_kdtree_build(kdtree, middle, end);
+}
+
+/**
+*   Function to restore max-heap order of found points (ordered by distance) below given position
+*   In params:
+*       size_t* points              indices of points
+*       geometry_real* distances    squared distances of points
+*       size_t size                 number of points in heap
+*       size_t position             position of element that may be too small for its place
+*
+*   Out params/return:
+*       none (arrays are changed)
+*/
+static void geometry_kdtree_siftDown(size_t* points, geometry_real* distances, size_t size, size_t position){
+    while(true){
+        size_t largest = position;
+        size_t left = 2 * position + 1;
+        size_t right = left + 1;
+        if(left < size && distances[left] > distances[largest]){
+            largest = left;
+        }
+        if(right < size && distances[right] > distances[largest]){
+            largest = right;
+        }
+        if(largest == position){
+            return;
+        }
+        geometry_real distance = distances[position];
+        distances[position] = distances[largest];
+        distances[largest] = distance;
+        size_t point = points[position];
+        points[position] = points[largest];
+        points[largest] = point;
+        position = largest;
+    }
+}
+
+/**
+*   Function to find k points closest to given point
+*   Found points are kept in max-heap, so the furthest of them is known at once
+*   and ranges that can't hold anything closer are skipped
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       geometry_real x, y          query point
+*       size_t k                    number of points to find, not bigger than number of points in tree
+*
+*   Out params:
+*       size_t* points              indices of found points, ordered from the closest one
+*       geometry_real* distances    distances of found points
+*
+*   Return:
+*       size_t                      number of found points
+*/
+static size_t geometry_kdtree_searchNearest(geometry_kdtree* kdtree, geometry_real x, geometry_real y, size_t k, size_t* points, geometry_real* distances){
+    if(k == 0){
+        return 0;
+    }
+    const geometry_real* xs = kdtree->coordinates[0];
+    const geometry_real* ys = kdtree->coordinates[1];
+    geometry_real query[2] = {x, y};
+    geometry_kdtree_range stack[GEOMETRY_KDTREE_STACK_SIZE];
+    size_t stack_size = 0;
+    size_t size = 0;
+    stack[stack_size++] = (geometry_kdtree_range){0, kdtree->count, 0};
+    while(stack_size > 0){
+        geometry_kdtree_range range = stack[--stack_size];
+        if(size == k && range.bound >= distances[0]){
+            continue;
+        }
+        if(range.end - range.begin <= GEOMETRY_KDTREE_LEAF_SIZE){
+            for(size_t i = range.begin; i < range.end; i++){
+                geometry_real dx = xs[i] - x;
+                geometry_real dy = ys[i] - y;
+                geometry_real distance = dx * dx + dy * dy;
+                if(size < k){
+                    // sift up new element
+                    size_t position = size++;
+                    while(position > 0 && distances[(position - 1) / 2] < distance){
+                        distances[position] = distances[(position - 1) / 2];
+                        points[position] = points[(position - 1) / 2];
+                        position = (position - 1) / 2;
+                    }
+                    distances[position] = distance;
+                    points[position] = kdtree->indices[i];
+                }
+                else if(distance < distances[0]){
+                    distances[0] = distance;
+                    points[0] = kdtree->indices[i];
+                    geometry_kdtree_siftDown(points, distances, size, 0);
+                }
+            }
+            continue;
+        }
+        size_t middle = range.begin + (range.end - range.begin) / 2;
+        int axis = kdtree->axes[middle];
+        geometry_real difference = query[axis] - kdtree->splits[middle];
+        geometry_kdtree_range left = {range.begin, middle, range.bound};
+        geometry_kdtree_range right = {middle, range.end, range.bound};
+        // far side is pushed first, so the near side is searched first
+        if(difference < 0){
+            right.bound = GEOMETRY_FMAX(range.bound, difference * difference);
+            stack[stack_size++] = right;
+            stack[stack_size++] = left;
+        }
+        else{
+            left.bound = GEOMETRY_FMAX(range.bound, difference * difference);
+            stack[stack_size++] = left;
+            stack[stack_size++] = right;
+        }
+    }
+    // heap sort gives points ordered from the closest one
+    for(size_t end = size; end > 1; end--){
+        geometry_real distance = distances[0];
+        distances[0] = distances[end - 1];
+        distances[end - 1] = distance;
+        size_t point = points[0];
+        points[0] = points[end - 1];
+        points[end - 1] = point;
+        geometry_kdtree_siftDown(points, distances, end - 1, 0);
+    }
+    for(size_t i = 0; i < size; i++){
+        distances[i] = GEOMETRY_SQRT(distances[i]);
+    }
+    return size;
+}
+
+/**
+*   Function to find all points within radius of given point
+*   Results are written to points array if it isn't NULL, to matches array otherwise
+*   In params:
+*       geometry_kdtree* kdtree             tree
+*       geometry_real x, y                  query point
+*       geometry_real radius                maximal distance
+*       size_t query                        index of query point written to matches
+*       size_t found                        number of results found before
+*       size_t capacity                     number of elements in output array
+*
+*   Out params:
+*       size_t* points                      indices of found points
+*       geometry_kdtree_match* matches      found pairs of query and point
+*
+*   Return:
+*       size_t                              number of results found before and now
+*/
+static size_t geometry_kdtree_searchRadius(geometry_kdtree* kdtree, geometry_real x, geometry_real y, geometry_real radius, size_t query, size_t* points, geometry_kdtree_match* matches, size_t found, size_t capacity){
+    const geometry_real* xs = kdtree->coordinates[0];
+    const geometry_real* ys = kdtree->coordinates[1];
+    geometry_real coordinates[2] = {x, y};
+    geometry_real squared_radius = radius * radius;
+    geometry_kdtree_range stack[GEOMETRY_KDTREE_STACK_SIZE];
+    size_t stack_size = 0;
+    stack[stack_size++] = (geometry_kdtree_range){0, kdtree->count, 0};
+    while(stack_size > 0){
+        geometry_kdtree_range range = stack[--stack_size];
+        if(range.bound > squared_radius){
+            continue;
+        }
+        if(range.end - range.begin <= GEOMETRY_KDTREE_LEAF_SIZE){
+            for(size_t i = range.begin; i < range.end; i++){
+                geometry_real dx = xs[i] - x;
+                geometry_real dy = ys[i] - y;
+                if(dx * dx + dy * dy <= squared_radius){
+                    if(found < capacity){
+                        if(points != NULL){
+                            points[found] = kdtree->indices[i];
+                        }
+                        else{
+                            matches[found].query = query;
+                            matches[found].point = kdtree->indices[i];
+                        }
+                    }
+                    found++;
+                }
+            }
+            continue;
+        }
+        size_t middle = range.begin + (range.end - range.begin) / 2;
+        int axis = kdtree->axes[middle];
+        geometry_real difference = coordinates[axis] - kdtree->splits[middle];
+        geometry_kdtree_range left = {range.begin, middle, range.bound};
+        geometry_kdtree_range right = {middle, range.end, range.bound};
+        if(difference < 0){
+            right.bound = GEOMETRY_FMAX(range.bound, difference * difference);
+        }
+        else{
+            left.bound = GEOMETRY_FMAX(range.bound, difference * difference);
+        }
+        stack[stack_size++] = right;
+        stack[stack_size++] = left;
+    }
+    return found;
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new geometry_kdtree object over points of given buffer
+*   In params:
+*       geometry_point_buffer* points   points, indices of points in buffer are used in results
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_kdtree*                pointer to created object, NULL if error occured
+*/
+geometry_kdtree* geometry_kdtree_new(geometry_point_buffer* points){
+    return geometry_kdtree_new_with(NULL, points);
+}
+
+/**
+*   Function to create new geometry_kdtree object over points of given buffer with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_point_buffer* points           points, indices of points in buffer are used in results
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_kdtree*                pointer to created object, NULL if error occured
+*/
+geometry_kdtree* geometry_kdtree_new_with(const geometry_allocator* allocator, geometry_point_buffer* points){
+    if(points == NULL){
+        return NULL;
+    }
+    geometry_real* xs = NULL;
+    geometry_real* ys = NULL;
+    geometry_point_buffer_getCoordinates(points, &xs, &ys);
+    return geometry_kdtree_newFlat_with(allocator, xs, ys, geometry_point_buffer_getSize(points));
+}
+
+/**
+*   Function to create new geometry_kdtree object over points given as arrays of coordinates
+*   In params:
+*       const geometry_real* xs         x coordinates of points
+*       const geometry_real* ys         y coordinates of points
+*       size_t count                    number of points
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_kdtree*                pointer to created object, NULL if error occured
+*/
+geometry_kdtree* geometry_kdtree_newFlat(const geometry_real* xs, const geometry_real* ys, size_t count){
+    return geometry_kdtree_newFlat_with(NULL, xs, ys, count);
+}
+
+/**
+*   Function to create new geometry_kdtree object over points given as arrays of coordinates with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       const geometry_real* xs                 x coordinates of points
+*       const geometry_real* ys                 y coordinates of points
+*       size_t count                            number of points
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_kdtree*                pointer to created object, NULL if error occured
+*/
+geometry_kdtree* geometry_kdtree_newFlat_with(const geometry_allocator* allocator, const geometry_real* xs, const geometry_real* ys, size_t count){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_KDTREE_NEW);
+    if((xs == NULL || ys == NULL) && count > 0){
+        return NULL;
+    }
+    if(count > SIZE_MAX / sizeof(geometry_real) || count > SIZE_MAX / sizeof(size_t)){
+        return NULL;
+    }
+    geometry_kdtree* new_kdtree = geometry_allocator_allocate(allocator, sizeof(*new_kdtree));
+    if(new_kdtree == NULL){
+        return NULL;
+    }
+    new_kdtree->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    allocator = &new_kdtree->allocator;
+    new_kdtree->coordinates[0] = geometry_allocator_allocate(allocator, count * sizeof(geometry_real) + 1);
+    new_kdtree->coordinates[1] = geometry_allocator_allocate(allocator, count * sizeof(geometry_real) + 1);
+    new_kdtree->indices = geometry_allocator_allocate(allocator, count * sizeof(size_t) + 1);
+    new_kdtree->axes = geometry_allocator_allocate(allocator, count + 1);
+    new_kdtree->splits = geometry_allocator_allocate(allocator, count * sizeof(geometry_real) + 1);
+    new_kdtree->count = count;
+    if(new_kdtree->coordinates[0] == NULL || new_kdtree->coordinates[1] == NULL || new_kdtree->indices == NULL || new_kdtree->axes == NULL || new_kdtree->splits == NULL){
+        geometry_kdtree_destroy(new_kdtree);
+        return NULL;
+    }
+    for(size_t i = 0; i < count; i++){
+        new_kdtree->coordinates[0][i] = xs[i];
+        new_kdtree->coordinates[1][i] = ys[i];
+        new_kdtree->indices[i] = i;
+    }
+    geometry_kdtree_build(new_kdtree, 0, count);
+    return new_kdtree;
+}
+
+/**
+*   Function to destroy given geometry_kdtree object
+*   In params:
+*       geometry_kdtree* kdtree     tree object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_kdtree_destroy(geometry_kdtree* kdtree){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_KDTREE_DESTROY);
+    if(kdtree == NULL){
+        return;
+    }
+    geometry_allocator allocator = kdtree->allocator;
+    geometry_allocator_free(&allocator, kdtree->coordinates[0]);
+    geometry_allocator_free(&allocator, kdtree->coordinates[1]);
+    geometry_allocator_free(&allocator, kdtree->indices);
+    geometry_allocator_free(&allocator, kdtree->axes);
+    geometry_allocator_free(&allocator, kdtree->splits);
+    geometry_allocator_free(&allocator, kdtree);
+}
+
+/**
+*   Function to find k points closest to given point
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       geometry_real x             x coordinate of point
+*       geometry_real y             y coordinate of point
+*       size_t k                    number of points to find
+*
+*   Out params:
+*       size_t* points              indices of found points, ordered from the closest one,
+*                                   array of at least k elements
+*       geometry_real* distances    distances of found points, array of at least k elements
+*
+*   Return:
+*       size_t                      number of found points (k, or less if tree has less points),
+*                                   (size_t)-1 if error occured
+*/
+size_t geometry_kdtree_findNearest(geometry_kdtree* kdtree, geometry_real x, geometry_real y, size_t k, size_t* points, geometry_real* distances){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_KDTREE_FIND_NEAREST);
+    if(kdtree == NULL || ((points == NULL || distances == NULL) && k > 0)){
+        return GEOMETRY_KDTREE_NONE;
+    }
+    return geometry_kdtree_searchNearest(kdtree, x, y, k < kdtree->count ? k : kdtree->count, points, distances);
+}
+
+/**
+*   Function to find all points not further from given point than radius
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       geometry_real x             x coordinate of point
+*       geometry_real y             y coordinate of point
+*       geometry_real radius        maximal distance
+*       size_t capacity             number of elements in points array
+*
+*   Out params:
+*       size_t* points              indices of found points in no particular order,
+*                                   at most capacity elements are written
+*
+*   Return:
+*       size_t                      number of all found points (may be larger than capacity),
+*                                   (size_t)-1 if error occured
+*/
+size_t geometry_kdtree_findInRadius(geometry_kdtree* kdtree, geometry_real x, geometry_real y, geometry_real radius, size_t* points, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_KDTREE_FIND_IN_RADIUS);
+    if(kdtree == NULL || !(radius >= 0) || (points == NULL && capacity > 0)){
+        return GEOMETRY_KDTREE_NONE;
+    }
+    return geometry_kdtree_searchRadius(kdtree, x, y, radius, 0, points, NULL, 0, capacity);
+}
+
+/**
+*   Function to find k closest points for every of given query points
+*   Works as geometry_kdtree_findNearest called for every query point,
+*   results of i-th query are written from index i * k. No memory is allocated.
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       const geometry_real* xs     x coordinates of query points
+*       const geometry_real* ys     y coordinates of query points
+*       size_t count                number of query points
+*       size_t k                    number of points to find for every query point
+*
+*   Out params:
+*       size_t* points              indices of found points, array of at least count * k elements
+*       geometry_real* distances    distances of found points, array of at least count * k elements
+*
+*   Return:
+*       size_t                      number of points found for every query point (k, or less
+*                                   if tree has less points), (size_t)-1 if error occured
+*/
+size_t geometry_kdtree_findNearestBatch(geometry_kdtree* kdtree, const geometry_real* xs, const geometry_real* ys, size_t count, size_t k, size_t* points, geometry_real* distances){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_KDTREE_FIND_NEAREST_BATCH);
+    if(kdtree == NULL || ((xs == NULL || ys == NULL) && count > 0) || ((points == NULL || distances == NULL) && count > 0 && k > 0)){
+        return GEOMETRY_KDTREE_NONE;
+    }
+    size_t found = k < kdtree->count ? k : kdtree->count;
+    for(size_t i = 0; i < count; i++){
+        geometry_kdtree_searchNearest(kdtree, xs[i], ys[i], found, points + i * k, distances + i * k);
+    }
+    return found;
+}
+
+/**
+*   Function to find points within radius of every of given query points
+*   Works as geometry_kdtree_findInRadius called for every query point, but results
+*   for all queries are written to one array. No memory is allocated.
+*   In params:
+*       geometry_kdtree* kdtree             tree
+*       const geometry_real* xs             x coordinates of query points
+*       const geometry_real* ys             y coordinates of query points
+*       size_t count                        number of query points
+*       geometry_real radius                maximal distance
+*       size_t capacity                     number of elements in matches array
+*
+*   Out params:
+*       geometry_kdtree_match* matches      found pairs of query and point, grouped by queries in
+*                                           increasing order, at most capacity elements are written
+*
+*   Return:
+*       size_t                              number of all found pairs (may be larger than capacity),
+*                                           (size_t)-1 if error occured
+*/
+size_t geometry_kdtree_findInRadiusBatch(geometry_kdtree* kdtree, const geometry_real* xs, const geometry_real* ys, size_t count, geometry_real radius, geometry_kdtree_match* matches, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_KDTREE_FIND_IN_RADIUS_BATCH);
+    if(kdtree == NULL || !(radius >= 0) || ((xs == NULL || ys == NULL) && count > 0) || (matches == NULL && capacity > 0)){
+        return GEOMETRY_KDTREE_NONE;
+    }
+    size_t found = 0;
+    for(size_t i = 0; i < count; i++){
+        found = geometry_kdtree_searchRadius(kdtree, xs[i], ys[i], radius, i, NULL, matches, found, capacity);
+    }
+    return found;
+}
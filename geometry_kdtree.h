@@ -0,0 +1,176 @@
+#ifndef GEOMETRY_KDTREE
+#define GEOMETRY_KDTREE
+
+#include "geometry_buffer.h"
+#include <stddef.h>
+
+// Static k-d tree over a fixed set of points.
+// Points are copied into one array and reordered in place - every range of points
+// is split at median along its longer side, left half lies before median, right half
+// after it, so tree needs no nodes or pointers at all. Ranges of a few points are
+// not split further and are scanned linearly.
+typedef struct geometry_kdtree geometry_kdtree;
+
+// Single result of batch radius query - index of query point and index of found point
+// (in arrays given on query and on creation)
+typedef struct geometry_kdtree_match {
+    size_t query;
+    size_t point;
+} geometry_kdtree_match;
+
+/*#################################################
+ GEOMETRY_KDTREE functions (methods) declarations
+##################################################*/
+
+/**
+*   Function to create new geometry_kdtree object over points of given buffer
+*   In params:
+*       geometry_point_buffer* points   points, indices of points in buffer are used in results
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_kdtree*                pointer to created object, NULL if error occured
+*/
+geometry_kdtree* geometry_kdtree_new(geometry_point_buffer* points);
+
+/**
+*   Function to create new geometry_kdtree object over points of given buffer with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_point_buffer* points           points, indices of points in buffer are used in results
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_kdtree*                pointer to created object, NULL if error occured
+*/
+geometry_kdtree* geometry_kdtree_new_with(const geometry_allocator* allocator, geometry_point_buffer* points);
+
+/**
+*   Function to create new geometry_kdtree object over points given as arrays of coordinates
+*   In params:
+*       const geometry_real* xs         x coordinates of points
+*       const geometry_real* ys         y coordinates of points
+*       size_t count                    number of points
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_kdtree*                pointer to created object, NULL if error occured
+*/
+geometry_kdtree* geometry_kdtree_newFlat(const geometry_real* xs, const geometry_real* ys, size_t count);
+
+/**
+*   Function to create new geometry_kdtree object over points given as arrays of coordinates with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       const geometry_real* xs                 x coordinates of points
+*       const geometry_real* ys                 y coordinates of points
+*       size_t count                            number of points
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_kdtree*                pointer to created object, NULL if error occured
+*/
+geometry_kdtree* geometry_kdtree_newFlat_with(const geometry_allocator* allocator, const geometry_real* xs, const geometry_real* ys, size_t count);
+
+/**
+*   Function to destroy given geometry_kdtree object
+*   In params:
+*       geometry_kdtree* kdtree     tree object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_kdtree_destroy(geometry_kdtree* kdtree);
+
+/**
+*   Function to find k points closest to given point
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       geometry_real x             x coordinate of point
+*       geometry_real y             y coordinate of point
+*       size_t k                    number of points to find
+*
+*   Out params:
+*       size_t* points              indices of found points, ordered from the closest one,
+*                                   array of at least k elements
+*       geometry_real* distances    distances of found points, array of at least k elements
+*
+*   Return:
+*       size_t                      number of found points (k, or less if tree has less points),
+*                                   (size_t)-1 if error occured
+*/
+size_t geometry_kdtree_findNearest(geometry_kdtree* kdtree, geometry_real x, geometry_real y, size_t k, size_t* points, geometry_real* distances);
+
+/**
+*   Function to find all points not further from given point than radius
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       geometry_real x             x coordinate of point
+*       geometry_real y             y coordinate of point
+*       geometry_real radius        maximal distance
+*       size_t capacity             number of elements in points array
+*
+*   Out params:
+*       size_t* points              indices of found points in no particular order,
+*                                   at most capacity elements are written
+*
+*   Return:
+*       size_t                      number of all found points (may be larger than capacity),
+*                                   (size_t)-1 if error occured
+*/
+size_t geometry_kdtree_findInRadius(geometry_kdtree* kdtree, geometry_real x, geometry_real y, geometry_real radius, size_t* points, size_t capacity);
+
+/**
+*   Function to find k closest points for every of given query points
+*   Works as geometry_kdtree_findNearest called for every query point,
+*   results of i-th query are written from index i * k. No memory is allocated.
+*   In params:
+*       geometry_kdtree* kdtree     tree
+*       const geometry_real* xs     x coordinates of query points
+*       const geometry_real* ys     y coordinates of query points
+*       size_t count                number of query points
+*       size_t k                    number of points to find for every query point
+*
+*   Out params:
+*       size_t* points              indices of found points, array of at least count * k elements
+*       geometry_real* distances    distances of found points, array of at least count * k elements
+*
+*   Return:
+*       size_t                      number of points found for every query point (k, or less
+*                                   if tree has less points), (size_t)-1 if error occured
+*/
+size_t geometry_kdtree_findNearestBatch(geometry_kdtree* kdtree, const geometry_real* xs, const geometry_real* ys, size_t count, size_t k, size_t* points, geometry_real* distances);
+
+/**
+*   Function to find points within radius of every of given query points
+*   Works as geometry_kdtree_findInRadius called for every query point, but results
+*   for all queries are written to one array. No memory is allocated.
+*   In params:
+*       geometry_kdtree* kdtree             tree
+*       const geometry_real* xs             x coordinates of query points
+*       const geometry_real* ys             y coordinates of query points
+*       size_t count                        number of query points
+*       geometry_real radius                maximal distance
+*       size_t capacity                     number of elements in matches array
+*
+*   Out params:
+*       geometry_kdtree_match* matches      found pairs of query and point, grouped by queries in
+*                                           increasing order, at most capacity elements are written
+*
+*   Return:
+*       size_t                              number of all found pairs (may be larger than capacity),
+*                                           (size_t)-1 if error occured
+*/
+size_t geometry_kdtree_findInRadiusBatch(geometry_kdtree* kdtree, const geometry_real* xs, const geometry_real* ys, size_t count, geometry_real radius, geometry_kdtree_match* matches, size_t capacity);
+
+#endif
@@ -0,0 +1,608 @@
+#include "geometry_mesh.h"
+#include "geometry_buffer.h"
+#include "geometry_stats.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#define GEOMETRY_MESH_MIN_CAPACITY 16
+#define GEOMETRY_MESH_MIN_SLOTS 64
+
+struct geometry_mesh {
+    // distinct vertices, moved and rotated with kernels of point buffer
+    geometry_point_buffer* vertices;
+    // three indices of vertices for every triangle
+    uint32_t* indices;
+    bool* is_right;
+    size_t triangle_count;
+    size_t triangle_capacity;
+    // hash table of vertex coordinates, slot holds index of vertex + 1, 0 means empty slot.
+    // It is left outdated by moves and rotations and rebuilt when next vertex is added
+    uint32_t* slots;
+    size_t slot_count;
+    bool slots_valid;
+    geometry_allocator allocator;
+};
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static size_t geometry_mesh_hash(double x, double y);
+static size_t geometry_mesh_findSlot(geometry_mesh* mesh, geometry_real x, geometry_real y, const geometry_real* xs, const geometry_real* ys);
+static bool geometry_mesh_rehash(geometry_mesh* mesh, size_t slot_count);
+static bool geometry_mesh_reserve(geometry_mesh* mesh, size_t capacity);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to calculate hash of vertex coordinates
+*   Coordinates are hashed as doubles (conversion from float is exact), so hash
+*   doesn't depend on size of geometry_real
+*   In params:
+*       double x            x coordinate, not negative zero
+*       double y            y coordinate, not negative zero
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t              hash value
+*/
+static size_t geometry_mesh_hash(double x, double y){
+    uint64_t x_bits;
+    uint64_t y_bits;
+    memcpy(&x_bits, &x, sizeof(x_bits));
+    memcpy(&y_bits, &y, sizeof(y_bits));
+    uint64_t hash = x_bits * 0x9E3779B97F4A7C15ULL ^ y_bits * 0xC2B2AE3D27D4EB4FULL;
+    hash ^= hash >> 29;
+    return (size_t)hash;
+}
+
+/**
+*   Function to find slot of vertex with given coordinates or empty slot where it should be placed
+*   In params:
+*       geometry_mesh* mesh        mesh with valid hash table
+*       geometry_real x            x coordinate
+*       geometry_real y            y coordinate
+*       const geometry_real* xs    x coordinates of vertices
+*       const geometry_real* ys    y coordinates of vertices
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                     index of slot
+*/
+static size_t geometry_mesh_findSlot(geometry_mesh* mesh, geometry_real x, geometry_real y, const geometry_real* xs, const geometry_real* ys){
+    size_t mask = mesh->slot_count - 1;
+    size_t slot = geometry_mesh_hash(x, y) & mask;
+    // linear probing, table is never more than half full
+    while(mesh->slots[slot] != 0){
+        uint32_t vertex = mesh->slots[slot] - 1;
+        if(xs[vertex] == x && ys[vertex] == y){
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+*   Function to build hash table of given size with all current vertices of mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*       size_t slot_count       number of slots, power of two
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if memory couldn't be allocated
+*/
+static bool geometry_mesh_rehash(geometry_mesh* mesh, size_t slot_count){
+    GEOMETRY_STATS_EVENT(GEOMETRY_STATS_MESH_REHASH);
+    uint32_t* new_slots = geometry_allocator_allocateZeroed(&mesh->allocator, slot_count, sizeof(*new_slots));
+    if(new_slots == NULL){
+        return false;
+    }
+    geometry_allocator_free(&mesh->allocator, mesh->slots);
+    mesh->slots = new_slots;
+    mesh->slot_count = slot_count;
+    geometry_real* xs;
+    geometry_real* ys;
+    geometry_point_buffer_getCoordinates(mesh->vertices, &xs, &ys);
+    size_t vertex_count = geometry_point_buffer_getSize(mesh->vertices);
+    for(size_t i = 0; i < vertex_count; i++){
+        // vertices moved onto each other keep their indices, only the first one is found by lookups
+        size_t slot = geometry_mesh_findSlot(mesh, xs[i] + 0.0, ys[i] + 0.0, xs, ys);
+        if(mesh->slots[slot] == 0){
+            mesh->slots[slot] = (uint32_t)(i + 1);
+        }
+    }
+    mesh->slots_valid = true;
+    return true;
+}
+
+/**
+*   Function to reserve memory for given number of triangles
+*   In params:
+*       geometry_mesh* mesh     mesh to grow
+*       size_t capacity         requested number of triangles
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if memory couldn't be reserved
+*/
+static bool geometry_mesh_reserve(geometry_mesh* mesh, size_t capacity){
+    if(capacity <= mesh->triangle_capacity){
+        return true;
+    }
+    if(capacity < GEOMETRY_MESH_MIN_CAPACITY){
+        capacity = GEOMETRY_MESH_MIN_CAPACITY;
+    }
+    if(capacity > SIZE_MAX / (3 * sizeof(uint32_t))){
+        return false;
+    }
+    uint32_t* new_indices = geometry_allocator_reallocate(&mesh->allocator, mesh->indices, mesh->triangle_capacity * 3 * sizeof(*new_indices), capacity * 3 * sizeof(*new_indices));
+    if(new_indices == NULL){
+        return false;
+    }
+    mesh->indices = new_indices;
+    bool* new_is_right = geometry_allocator_reallocate(&mesh->allocator, mesh->is_right, mesh->triangle_capacity * sizeof(*new_is_right), capacity * sizeof(*new_is_right));
+    if(new_is_right == NULL){
+        return false;
+    }
+    mesh->is_right = new_is_right;
+    mesh->triangle_capacity = capacity;
+    return true;
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new empty geometry_mesh object
+*   In params:
+*       size_t capacity         number of triangles for which memory is reserved upfront
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_mesh*          pointer to created object, NULL if error occured
+*/
+geometry_mesh* geometry_mesh_new(size_t capacity){
+    return geometry_mesh_new_with(NULL, capacity);
+}
+
+/**
+*   Function to create new empty geometry_mesh object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t capacity                         number of triangles for which memory is reserved upfront
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_mesh*          pointer to created object, NULL if error occured
+*/
+geometry_mesh* geometry_mesh_new_with(const geometry_allocator* allocator, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_NEW);
+    geometry_mesh* new_mesh = geometry_allocator_allocate(allocator, sizeof(*new_mesh));
+    if(new_mesh == NULL){
+        return NULL;
+    }
+    new_mesh->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    new_mesh->indices = NULL;
+    new_mesh->is_right = NULL;
+    new_mesh->triangle_count = 0;
+    new_mesh->triangle_capacity = 0;
+    new_mesh->slots = NULL;
+    new_mesh->slot_count = 0;
+    new_mesh->slots_valid = false;
+    // in connected mesh there are about half as many vertices as triangles
+    new_mesh->vertices = geometry_point_buffer_new_with(&new_mesh->allocator, capacity / 2);
+    if(new_mesh->vertices == NULL || !geometry_mesh_reserve(new_mesh, capacity)){
+        geometry_mesh_destroy(new_mesh);
+        return NULL;
+    }
+    return new_mesh;
+}
+
+/**
+*   Function to destroy given geometry_mesh object
+*   In params:
+*       geometry_mesh* mesh     mesh object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_mesh_destroy(geometry_mesh* mesh){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_DESTROY);
+    if(mesh == NULL){
+        return;
+    }
+    geometry_allocator allocator = mesh->allocator;
+    geometry_point_buffer_destroy(mesh->vertices);
+    geometry_allocator_free(&allocator, mesh->indices);
+    geometry_allocator_free(&allocator, mesh->is_right);
+    geometry_allocator_free(&allocator, mesh->slots);
+    geometry_allocator_free(&allocator, mesh);
+}
+
+/**
+*   Function to add vertex to given mesh, vertex with the same coordinates is reused
+*   In params:
+*       geometry_mesh* mesh     mesh
+*       geometry_real x         x coordinate
+*       geometry_real y         y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  index of vertex, GEOMETRY_MESH_NONE if error occured
+*/
+size_t geometry_mesh_addVertex(geometry_mesh* mesh, geometry_real x, geometry_real y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_ADD_VERTEX);
+    if(mesh == NULL){
+        return GEOMETRY_MESH_NONE;
+    }
+    // adding zero turns negative zero into positive one, so both give the same hash
+    x += 0.0;
+    y += 0.0;
+    size_t vertex_count = geometry_point_buffer_getSize(mesh->vertices);
+    if(vertex_count >= UINT32_MAX){
+        return GEOMETRY_MESH_NONE;
+    }
+    size_t slot_count = mesh->slot_count;
+    if(slot_count < GEOMETRY_MESH_MIN_SLOTS){
+        slot_count = GEOMETRY_MESH_MIN_SLOTS;
+    }
+    while(slot_count / 2 <= vertex_count){
+        slot_count *= 2;
+    }
+    if((!mesh->slots_valid || slot_count != mesh->slot_count) && !geometry_mesh_rehash(mesh, slot_count)){
+        return GEOMETRY_MESH_NONE;
+    }
+    geometry_real* xs;
+    geometry_real* ys;
+    geometry_point_buffer_getCoordinates(mesh->vertices, &xs, &ys);
+    size_t slot = geometry_mesh_findSlot(mesh, x, y, xs, ys);
+    if(mesh->slots[slot] != 0){
+        return mesh->slots[slot] - 1;
+    }
+    if(!geometry_point_buffer_push(mesh->vertices, x, y)){
+        return GEOMETRY_MESH_NONE;
+    }
+    mesh->slots[slot] = (uint32_t)(vertex_count + 1);
+    return vertex_count;
+}
+
+/**
+*   Function to add triangle given by indices of its vertices
+*   In params:
+*       geometry_mesh* mesh     mesh
+*       size_t first            index of first vertex
+*       size_t second           index of second vertex
+*       size_t third            index of third vertex
+*       bool is_right           true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if any index is out of range or error occured
+*/
+bool geometry_mesh_addTriangleByIndices(geometry_mesh* mesh, size_t first, size_t second, size_t third, bool is_right){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_ADD_TRIANGLE);
+    if(mesh == NULL){
+        return false;
+    }
+    size_t vertex_count = geometry_point_buffer_getSize(mesh->vertices);
+    if(first >= vertex_count || second >= vertex_count || third >= vertex_count){
+        return false;
+    }
+    if(mesh->triangle_count == mesh->triangle_capacity && !geometry_mesh_reserve(mesh, mesh->triangle_capacity * 2 + 1)){
+        return false;
+    }
+    uint32_t* indices = &mesh->indices[3 * mesh->triangle_count];
+    indices[0] = (uint32_t)first;
+    indices[1] = (uint32_t)second;
+    indices[2] = (uint32_t)third;
+    mesh->is_right[mesh->triangle_count] = is_right;
+    mesh->triangle_count++;
+    return true;
+}
+
+/**
+*   Function to add copy of given triangle, its vertices are merged with existing ones
+*   In params:
+*       geometry_mesh* mesh             mesh
+*       geometry_triangle* triangle     triangle to be added
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_mesh_addTriangle(geometry_mesh* mesh, geometry_triangle* triangle){
+    if(mesh == NULL || triangle == NULL){
+        return false;
+    }
+    geometry_real xs[3];
+    geometry_real ys[3];
+    geometry_triangle_getCoordinates(triangle, xs, ys);
+    size_t indices[3];
+    for(int i = 0; i < 3; i++){
+        indices[i] = geometry_mesh_addVertex(mesh, xs[i], ys[i]);
+        if(indices[i] == GEOMETRY_MESH_NONE){
+            return false;
+        }
+    }
+    return geometry_mesh_addTriangleByIndices(mesh, indices[0], indices[1], indices[2], geometry_triangle_getIsRight(triangle));
+}
+
+/**
+*   Function to get number of distinct vertices of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  number of vertices, 0 if mesh is NULL
+*/
+size_t geometry_mesh_getVertexCount(geometry_mesh* mesh){
+    if(mesh == NULL){
+        return 0;
+    }
+    return geometry_point_buffer_getSize(mesh->vertices);
+}
+
+/**
+*   Function to get number of triangles of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  number of triangles, 0 if mesh is NULL
+*/
+size_t geometry_mesh_getTriangleCount(geometry_mesh* mesh){
+    if(mesh == NULL){
+        return 0;
+    }
+    return mesh->triangle_count;
+}
+
+/**
+*   Function to get arrays of vertex coordinates of given mesh
+*   Arrays are valid until next vertex is added or mesh is destroyed
+*   In params:
+*       geometry_mesh* mesh         mesh
+*
+*   Out params:
+*       const geometry_real** xs    x coordinates of vertices
+*       const geometry_real** ys    y coordinates of vertices
+*
+*   Return:
+*       size_t                      number of vertices
+*/
+size_t geometry_mesh_getVertices(geometry_mesh* mesh, const geometry_real** xs, const geometry_real** ys){
+    if(mesh == NULL){
+        return 0;
+    }
+    geometry_real* vertex_xs;
+    geometry_real* vertex_ys;
+    geometry_point_buffer_getCoordinates(mesh->vertices, &vertex_xs, &vertex_ys);
+    *xs = vertex_xs;
+    *ys = vertex_ys;
+    return geometry_point_buffer_getSize(mesh->vertices);
+}
+
+/**
+*   Function to get index buffer of given mesh
+*   Array is valid until next triangle is added or mesh is destroyed
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const uint32_t*         indices of vertices, three for every triangle, NULL if mesh is NULL
+*/
+const uint32_t* geometry_mesh_getIndices(geometry_mesh* mesh){
+    if(mesh == NULL){
+        return NULL;
+    }
+    return mesh->indices;
+}
+
+/**
+*   Function to create geometry_triangle object with vertices of triangle of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*       size_t index            index of triangle
+*       geometry_arena* arena   arena to create triangle in, NULL to create it with allocator
+*                               of mesh (it has to be destroyed with geometry_triangle_destroy_with then)
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*      pointer to created object, NULL if index is out of range or error occured
+*/
+geometry_triangle* geometry_mesh_getTriangle(geometry_mesh* mesh, size_t index, geometry_arena* arena){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_GET_TRIANGLE);
+    if(mesh == NULL || index >= mesh->triangle_count){
+        return NULL;
+    }
+    geometry_real* vertex_xs;
+    geometry_real* vertex_ys;
+    geometry_point_buffer_getCoordinates(mesh->vertices, &vertex_xs, &vertex_ys);
+    geometry_real xs[3];
+    geometry_real ys[3];
+    for(int i = 0; i < 3; i++){
+        uint32_t vertex = mesh->indices[3 * index + i];
+        xs[i] = vertex_xs[vertex];
+        ys[i] = vertex_ys[vertex];
+    }
+    return geometry_triangle_newFromCoordinates(arena, &mesh->allocator, xs, ys, mesh->is_right[index]);
+}
+
+/**
+*   Function to move whole mesh by vector, every vertex is moved once
+*   In params:
+*       geometry_mesh* mesh       mesh to be moved
+*       geometry_real vector_x    x coordinate of vector
+*       geometry_real vector_y    y coordinate of vector
+*
+*   Out params/return:
+*       none (mesh object is changed)
+*/
+void geometry_mesh_moveByVector(geometry_mesh* mesh, geometry_real vector_x, geometry_real vector_y){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_MOVE_BY_VECTOR);
+    if(mesh == NULL){
+        return;
+    }
+    geometry_point_buffer_moveByVector(mesh->vertices, vector_x, vector_y);
+    mesh->slots_valid = false;
+}
+
+/**
+*   Function to rotate whole mesh through an angle around another point, every vertex is rotated once
+*   In params:
+*       geometry_mesh* mesh                 mesh to be rotated
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotations will be calculated
+*
+*   Out params/return:
+*       none (mesh object is changed)
+*/
+void geometry_mesh_rotateByAngle(geometry_mesh* mesh, geometry_real angle, geometry_point* reference_point){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_ROTATE_BY_ANGLE);
+    if(mesh == NULL || reference_point == NULL){
+        return;
+    }
+    geometry_point_buffer_rotateByAngle(mesh->vertices, angle, reference_point);
+    mesh->slots_valid = false;
+}
+
+/**
+*   Function to apply given transform to whole mesh, every vertex is transformed once
+*   In params:
+*       geometry_mesh* mesh                 mesh to be transformed
+*       geometry_transform* transform       transform to apply
+*
+*   Out params/return:
+*       none (mesh object is changed)
+*/
+void geometry_mesh_applyTransform(geometry_mesh* mesh, geometry_transform* transform){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_APPLY_TRANSFORM);
+    if(mesh == NULL || transform == NULL){
+        return;
+    }
+    geometry_point_buffer_applyTransform(mesh->vertices, transform);
+    mesh->slots_valid = false;
+}
+
+/**
+*   Function to calculate areas of all triangles of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       geometry_real* areas    array of at least triangle count elements
+*
+*   Return:
+*       bool                    true on success, false if error occured
+*/
+bool geometry_mesh_calculateAreas(geometry_mesh* mesh, geometry_real* areas){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_CALCULATE_AREAS);
+    if(mesh == NULL || areas == NULL){
+        return false;
+    }
+    geometry_real* xs;
+    geometry_real* ys;
+    geometry_point_buffer_getCoordinates(mesh->vertices, &xs, &ys);
+    const uint32_t* indices = mesh->indices;
+    // half of absolute cross product of two sides, vertices are gathered from shared arrays
+    for(size_t i = 0; i < mesh->triangle_count; i++){
+        uint32_t first = indices[3 * i];
+        uint32_t second = indices[3 * i + 1];
+        uint32_t third = indices[3 * i + 2];
+        geometry_real cross = (xs[second] - xs[first]) * (ys[third] - ys[first]) - (xs[third] - xs[first]) * (ys[second] - ys[first]);
+        areas[i] = GEOMETRY_FABS(cross) / 2;
+    }
+    return true;
+}
+
+/**
+*   Function to calculate perimeters of all triangles of given mesh
+*   In params:
+*       geometry_mesh* mesh          mesh
+*
+*   Out params:
+*       geometry_real* perimeters    array of at least triangle count elements
+*
+*   Return:
+*       bool                         true on success, false if error occured
+*/
+bool geometry_mesh_calculatePerimeters(geometry_mesh* mesh, geometry_real* perimeters){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_CALCULATE_PERIMETERS);
+    if(mesh == NULL || perimeters == NULL){
+        return false;
+    }
+    geometry_real* xs;
+    geometry_real* ys;
+    geometry_point_buffer_getCoordinates(mesh->vertices, &xs, &ys);
+    const uint32_t* indices = mesh->indices;
+    for(size_t i = 0; i < mesh->triangle_count; i++){
+        uint32_t first = indices[3 * i];
+        uint32_t second = indices[3 * i + 1];
+        uint32_t third = indices[3 * i + 2];
+        perimeters[i] = GEOMETRY_SQRT((xs[second] - xs[first]) * (xs[second] - xs[first]) + (ys[second] - ys[first]) * (ys[second] - ys[first]))
+            + GEOMETRY_SQRT((xs[third] - xs[second]) * (xs[third] - xs[second]) + (ys[third] - ys[second]) * (ys[third] - ys[second]))
+            + GEOMETRY_SQRT((xs[first] - xs[third]) * (xs[first] - xs[third]) + (ys[first] - ys[third]) * (ys[first] - ys[third]));
+    }
+    return true;
+}
+
+/**
+*   Function to calculate total area of triangles of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real           sum of areas of triangles, -1 if mesh is NULL
+*/
+geometry_real geometry_mesh_calculateArea(geometry_mesh* mesh){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_MESH_CALCULATE_AREA);
+    if(mesh == NULL){
+        return -1;
+    }
+    geometry_real* xs;
+    geometry_real* ys;
+    geometry_point_buffer_getCoordinates(mesh->vertices, &xs, &ys);
+    const uint32_t* indices = mesh->indices;
+    geometry_real area = 0;
+    for(size_t i = 0; i < mesh->triangle_count; i++){
+        uint32_t first = indices[3 * i];
+        uint32_t second = indices[3 * i + 1];
+        uint32_t third = indices[3 * i + 2];
+        area += GEOMETRY_FABS((xs[second] - xs[first]) * (ys[third] - ys[first]) - (xs[third] - xs[first]) * (ys[second] - ys[first]));
+    }
+    return area / 2;
+}
@@ -0,0 +1,253 @@
+#ifndef GEOMETRY_MESH
+#define GEOMETRY_MESH
+
+#include "geometry.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Indexed triangle mesh: every distinct vertex is stored once in shared array
+// of coordinates (structure of arrays, as in geometry_point_buffer) and triangles
+// are triples of indices into it. Connected triangles share their vertices instead
+// of keeping own copies, so mesh takes less memory than geometry_triangle objects
+// and moving or rotating whole mesh changes every vertex exactly once.
+// Vertices with equal coordinates are merged when added (hash table of coordinates).
+typedef struct geometry_mesh geometry_mesh;
+
+// Returned by geometry_mesh_addVertex on error
+#define GEOMETRY_MESH_NONE ((size_t)-1)
+
+/*##############################################
+ GEOMETRY_MESH functions (methods) declarations
+###############################################*/
+
+/**
+*   Function to create new empty geometry_mesh object
+*   In params:
+*       size_t capacity         number of triangles for which memory is reserved upfront
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_mesh*          pointer to created object, NULL if error occured
+*/
+geometry_mesh* geometry_mesh_new(size_t capacity);
+
+/**
+*   Function to create new empty geometry_mesh object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t capacity                         number of triangles for which memory is reserved upfront
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_mesh*          pointer to created object, NULL if error occured
+*/
+geometry_mesh* geometry_mesh_new_with(const geometry_allocator* allocator, size_t capacity);
+
+/**
+*   Function to destroy given geometry_mesh object
+*   In params:
+*       geometry_mesh* mesh     mesh object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_mesh_destroy(geometry_mesh* mesh);
+
+/**
+*   Function to add vertex to given mesh, vertex with the same coordinates is reused
+*   In params:
+*       geometry_mesh* mesh     mesh
+*       geometry_real x         x coordinate
+*       geometry_real y         y coordinate
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  index of vertex, GEOMETRY_MESH_NONE if error occured
+*/
+size_t geometry_mesh_addVertex(geometry_mesh* mesh, geometry_real x, geometry_real y);
+
+/**
+*   Function to add triangle given by indices of its vertices
+*   In params:
+*       geometry_mesh* mesh     mesh
+*       size_t first            index of first vertex
+*       size_t second           index of second vertex
+*       size_t third            index of third vertex
+*       bool is_right           true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if any index is out of range or error occured
+*/
+bool geometry_mesh_addTriangleByIndices(geometry_mesh* mesh, size_t first, size_t second, size_t third, bool is_right);
+
+/**
+*   Function to add copy of given triangle, its vertices are merged with existing ones
+*   In params:
+*       geometry_mesh* mesh             mesh
+*       geometry_triangle* triangle     triangle to be added
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_mesh_addTriangle(geometry_mesh* mesh, geometry_triangle* triangle);
+
+/**
+*   Function to get number of distinct vertices of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  number of vertices, 0 if mesh is NULL
+*/
+size_t geometry_mesh_getVertexCount(geometry_mesh* mesh);
+
+/**
+*   Function to get number of triangles of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  number of triangles, 0 if mesh is NULL
+*/
+size_t geometry_mesh_getTriangleCount(geometry_mesh* mesh);
+
+/**
+*   Function to get arrays of vertex coordinates of given mesh
+*   Arrays are valid until next vertex is added or mesh is destroyed
+*   In params:
+*       geometry_mesh* mesh         mesh
+*
+*   Out params:
+*       const geometry_real** xs    x coordinates of vertices
+*       const geometry_real** ys    y coordinates of vertices
+*
+*   Return:
+*       size_t                      number of vertices
+*/
+size_t geometry_mesh_getVertices(geometry_mesh* mesh, const geometry_real** xs, const geometry_real** ys);
+
+/**
+*   Function to get index buffer of given mesh
+*   Array is valid until next triangle is added or mesh is destroyed
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const uint32_t*         indices of vertices, three for every triangle, NULL if mesh is NULL
+*/
+const uint32_t* geometry_mesh_getIndices(geometry_mesh* mesh);
+
+/**
+*   Function to create geometry_triangle object with vertices of triangle of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*       size_t index            index of triangle
+*       geometry_arena* arena   arena to create triangle in, NULL to create it with allocator
+*                               of mesh (it has to be destroyed with geometry_triangle_destroy_with then)
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_triangle*      pointer to created object, NULL if index is out of range or error occured
+*/
+geometry_triangle* geometry_mesh_getTriangle(geometry_mesh* mesh, size_t index, geometry_arena* arena);
+
+/**
+*   Function to move whole mesh by vector, every vertex is moved once
+*   In params:
+*       geometry_mesh* mesh       mesh to be moved
+*       geometry_real vector_x    x coordinate of vector
+*       geometry_real vector_y    y coordinate of vector
+*
+*   Out params/return:
+*       none (mesh object is changed)
+*/
+void geometry_mesh_moveByVector(geometry_mesh* mesh, geometry_real vector_x, geometry_real vector_y);
+
+/**
+*   Function to rotate whole mesh through an angle around another point, every vertex is rotated once
+*   In params:
+*       geometry_mesh* mesh                 mesh to be rotated
+*       geometry_real angle                 angle to rotate through in radians calculated counterclockwise
+*       geometry_point* reference_point     point around which rotations will be calculated
+*
+*   Out params/return:
+*       none (mesh object is changed)
+*/
+void geometry_mesh_rotateByAngle(geometry_mesh* mesh, geometry_real angle, geometry_point* reference_point);
+
+/**
+*   Function to apply given transform to whole mesh, every vertex is transformed once
+*   In params:
+*       geometry_mesh* mesh                 mesh to be transformed
+*       geometry_transform* transform       transform to apply
+*
+*   Out params/return:
+*       none (mesh object is changed)
+*/
+void geometry_mesh_applyTransform(geometry_mesh* mesh, geometry_transform* transform);
+
+/**
+*   Function to calculate areas of all triangles of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       geometry_real* areas    array of at least triangle count elements
+*
+*   Return:
+*       bool                    true on success, false if error occured
+*/
+bool geometry_mesh_calculateAreas(geometry_mesh* mesh, geometry_real* areas);
+
+/**
+*   Function to calculate perimeters of all triangles of given mesh
+*   In params:
+*       geometry_mesh* mesh          mesh
+*
+*   Out params:
+*       geometry_real* perimeters    array of at least triangle count elements
+*
+*   Return:
+*       bool                         true on success, false if error occured
+*/
+bool geometry_mesh_calculatePerimeters(geometry_mesh* mesh, geometry_real* perimeters);
+
+/**
+*   Function to calculate total area of triangles of given mesh
+*   In params:
+*       geometry_mesh* mesh     mesh
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_real           sum of areas of triangles, -1 if mesh is NULL
+*/
+geometry_real geometry_mesh_calculateArea(geometry_mesh* mesh);
+
+#endif
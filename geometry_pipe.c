@@ -0,0 +1,720 @@
+// getopt is POSIX
+#define _POSIX_C_SOURCE 200809L
+#include "geometry.h"
+#include "geometry_pool.h"
+#include "geometry_text.h"
+#include "geometry_binary.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Command-line tool streaming shapes through the library.
+// Shapes are read from file or standard input (text format of geometry_text.h),
+// moved and rotated by given chain of transforms, and for every shape one CSV line
+// with requested metrics goes out:
+//      index,kind[,metric...][,coordinates...]
+// Metrics that don't apply to shape (e.g. area of segment) are left empty.
+// Input ends at first invalid line: every shape before it is written, then the line
+// is reported and exit status is 1, wherever boundary of batch is.
+// Reading, computing and writing run on three threads over a ring of batches,
+// so each of them works on its own batch while the others are busy.
+// Usage: geometry-pipe [options] [input]
+#define GEOMETRY_PIPE_USAGE \
+    "Usage: geometry-pipe [options] [input]\n" \
+    "  -m X,Y          move by vector (transforms are applied in given order)\n" \
+    "  -r ANGLE[,X,Y]  rotate by angle in radians around point (origin by default)\n" \
+    "  -c METRICS      comma separated list of: area, perimeter (length of segment),\n" \
+    "                  hypotenuse, intersects (1 if triangle intersects reference triangle,\n" \
+    "                  0 otherwise - intersections between input shapes are not computed),\n" \
+    "                  default area,perimeter\n" \
+    "  -x X1,Y1,X2,Y2,X3,Y3  reference triangle for intersects\n" \
+    "  -s              write coordinates of transformed shapes after metrics\n" \
+    "  -o FILE         output file, standard output by default\n" \
+    "  -b SIZE         number of shapes in batch\n" \
+    "  -j THREADS      threads computing metrics of triangles, 1 to 256, 1 by default\n"
+
+// number of batches in ring - one for every stage
+#define GEOMETRY_PIPE_SLOTS 3
+#define GEOMETRY_PIPE_DEFAULT_BATCH 4096
+#define GEOMETRY_PIPE_LINE_SIZE 1024
+#define GEOMETRY_PIPE_MAX_THREADS 256
+
+typedef enum geometry_pipe_metric {
+    GEOMETRY_PIPE_AREA,
+    GEOMETRY_PIPE_PERIMETER,
+    GEOMETRY_PIPE_HYPOTENUSE,
+    GEOMETRY_PIPE_INTERSECTS,
+    GEOMETRY_PIPE_METRIC_COUNT
+} geometry_pipe_metric;
+
+static const char* const geometry_pipe_metric_names[GEOMETRY_PIPE_METRIC_COUNT] = {
+    "area", "perimeter", "hypotenuse", "intersects"
+};
+
+static const char* const geometry_pipe_kind_names[] = {"point", "segment", "triangle"};
+
+// Stage that batch is waiting for
+typedef enum geometry_pipe_state {
+    GEOMETRY_PIPE_EMPTY,
+    GEOMETRY_PIPE_READ,
+    GEOMETRY_PIPE_COMPUTED
+} geometry_pipe_state;
+
+typedef struct geometry_pipe_slot {
+    geometry_pipe_state state;
+    // batch with no shapes marks end of input
+    size_t count;
+    // index of first shape of batch in whole input
+    size_t first;
+    geometry_text_kind* kinds;
+    double* points[2];
+    size_t point_count;
+    double* segments[4];
+    size_t segment_count;
+    double* triangles[6];
+    unsigned char* flags;
+    size_t triangle_count;
+    geometry_real* lengths;
+    geometry_real* metrics[GEOMETRY_PIPE_METRIC_COUNT];
+    bool* disjoint;
+} geometry_pipe_slot;
+
+typedef struct geometry_pipe {
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    // set by stage that failed, other stages stop at next batch
+    bool failed;
+    // set by reading stage at invalid line, input ends there but shapes before it are written
+    bool invalid;
+    geometry_pipe_slot slots[GEOMETRY_PIPE_SLOTS];
+    size_t capacity;
+    geometry_text_reader* reader;
+    geometry_text_writer* writer;
+    // coefficients of composed transform
+    double transform[6];
+    bool metrics[GEOMETRY_PIPE_METRIC_COUNT];
+    bool shapes;
+    geometry_triangle* reference;
+    geometry_pool* pool;
+    geometry_arena* arena;
+} geometry_pipe;
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static size_t geometry_pipe_parseNumbers(const char* text, double* numbers, size_t capacity);
+static bool geometry_pipe_parseCount(const char* text, size_t maximum, size_t* count);
+static bool geometry_pipe_parseMetrics(const char* text, bool metrics[GEOMETRY_PIPE_METRIC_COUNT]);
+static bool geometry_pipe_createSlot(geometry_pipe_slot* slot, size_t capacity);
+static void geometry_pipe_destroySlot(geometry_pipe_slot* slot);
+static bool geometry_pipe_wait(geometry_pipe* pipeline, geometry_pipe_slot* slot, geometry_pipe_state state);
+static void geometry_pipe_pass(geometry_pipe* pipeline, geometry_pipe_slot* slot, geometry_pipe_state state, bool failed);
+static void geometry_pipe_transform(const double transform[6], double* xs, double* ys, size_t count);
+static bool geometry_pipe_computeSlot(geometry_pipe* pipeline, geometry_pipe_slot* slot);
+static bool geometry_pipe_writeSlot(geometry_pipe* pipeline, geometry_pipe_slot* slot);
+static void* geometry_pipe_readStage(void* context);
+static void* geometry_pipe_writeStage(void* context);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to parse comma separated numbers of option
+*   In params:
+*       const char* text        text of option
+*       size_t capacity         number of elements in numbers array
+*
+*   Out params:
+*       double* numbers         parsed numbers
+*
+*   Return:
+*       size_t                  number of parsed numbers, (size_t)-1 if text is not valid
+*/
+static size_t geometry_pipe_parseNumbers(const char* text, double* numbers, size_t capacity){
+    size_t count = 0;
+    while(true){
+        if(count == capacity){
+            return (size_t)-1;
+        }
+        char* end;
+        numbers[count] = geometry_text_parseDouble(text, &end);
+        if(end == text){
+            return (size_t)-1;
+        }
+        count++;
+        if(*end == '\0'){
+            return count;
+        }
+        if(*end != ','){
+            return (size_t)-1;
+        }
+        text = end + 1;
+    }
+}
+
+/**
+*   Function to parse positive decimal integer of option
+*   In params:
+*       const char* text        text of option
+*       size_t maximum          largest accepted value
+*
+*   Out params:
+*       size_t* count           parsed number
+*
+*   Return:
+*       bool                    true on success, false if text is not number from 1 to maximum
+*/
+static bool geometry_pipe_parseCount(const char* text, size_t maximum, size_t* count){
+    size_t value = 0;
+    if(*text == '\0'){
+        return false;
+    }
+    for(; *text != '\0'; text++){
+        if(*text < '0' || *text > '9'){
+            return false;
+        }
+        size_t digit = (size_t)(*text - '0');
+        if(digit > maximum || value > (maximum - digit) / 10){
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    *count = value;
+    return value > 0;
+}
+
+/**
+*   Function to parse comma separated names of metrics
+*   In params:
+*       const char* text                                    text of option
+*
+*   Out params:
+*       bool metrics[GEOMETRY_PIPE_METRIC_COUNT]            true for every metric on list
+*
+*   Return:
+*       bool                                                true on success, false if unknown name was given
+*/
+static bool geometry_pipe_parseMetrics(const char* text, bool metrics[GEOMETRY_PIPE_METRIC_COUNT]){
+    for(int i = 0; i < GEOMETRY_PIPE_METRIC_COUNT; i++){
+        metrics[i] = false;
+    }
+    while(*text != '\0'){
+        size_t length = strcspn(text, ",");
+        bool found = false;
+        for(int i = 0; i < GEOMETRY_PIPE_METRIC_COUNT; i++){
+            if(strlen(geometry_pipe_metric_names[i]) == length && strncmp(text, geometry_pipe_metric_names[i], length) == 0){
+                metrics[i] = true;
+                found = true;
+            }
+        }
+        if(!found){
+            return false;
+        }
+        text += length;
+        if(*text == ','){
+            text++;
+        }
+    }
+    return true;
+}
+
+/**
+*   Function to allocate arrays of batch
+*   In params:
+*       size_t capacity             maximal number of shapes in batch
+*
+*   Out params:
+*       geometry_pipe_slot* slot    batch with allocated arrays
+*
+*   Return:
+*       bool                        true on success, false if error occured
+*/
+static bool geometry_pipe_createSlot(geometry_pipe_slot* slot, size_t capacity){
+    memset(slot, 0, sizeof(*slot));
+    slot->state = GEOMETRY_PIPE_EMPTY;
+    slot->kinds = malloc(capacity * sizeof(geometry_text_kind));
+    slot->flags = malloc(capacity);
+    slot->lengths = malloc(capacity * sizeof(geometry_real));
+    slot->disjoint = malloc(capacity * sizeof(bool));
+    bool allocated = slot->kinds != NULL && slot->flags != NULL && slot->lengths != NULL && slot->disjoint != NULL;
+    for(int i = 0; i < 2; i++){
+        slot->points[i] = malloc(capacity * sizeof(double));
+        allocated = allocated && slot->points[i] != NULL;
+    }
+    for(int i = 0; i < 4; i++){
+        slot->segments[i] = malloc(capacity * sizeof(double));
+        allocated = allocated && slot->segments[i] != NULL;
+    }
+    for(int i = 0; i < 6; i++){
+        slot->triangles[i] = malloc(capacity * sizeof(double));
+        allocated = allocated && slot->triangles[i] != NULL;
+    }
+    for(int i = 0; i < GEOMETRY_PIPE_METRIC_COUNT; i++){
+        slot->metrics[i] = malloc(capacity * sizeof(geometry_real));
+        allocated = allocated && slot->metrics[i] != NULL;
+    }
+    return allocated;
+}
+
+/**
+*   Function to free arrays of batch
+*   In params:
+*       geometry_pipe_slot* slot    batch
+*
+*   Out params/return:
+*       none
+*/
+static void geometry_pipe_destroySlot(geometry_pipe_slot* slot){
+    free(slot->kinds);
+    free(slot->flags);
+    free(slot->lengths);
+    free(slot->disjoint);
+    for(int i = 0; i < 2; i++){
+        free(slot->points[i]);
+    }
+    for(int i = 0; i < 4; i++){
+        free(slot->segments[i]);
+    }
+    for(int i = 0; i < 6; i++){
+        free(slot->triangles[i]);
+    }
+    for(int i = 0; i < GEOMETRY_PIPE_METRIC_COUNT; i++){
+        free(slot->metrics[i]);
+    }
+}
+
+/**
+*   Function to wait until batch gets to given stage
+*   In params:
+*       geometry_pipe* pipeline             pipeline
+*       geometry_pipe_slot* slot        batch
+*       geometry_pipe_state state       stage of caller
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true if batch is ready, false if other stage failed
+*/
+static bool geometry_pipe_wait(geometry_pipe* pipeline, geometry_pipe_slot* slot, geometry_pipe_state state){
+    pthread_mutex_lock(&pipeline->mutex);
+    while(slot->state != state && !pipeline->failed){
+        pthread_cond_wait(&pipeline->changed, &pipeline->mutex);
+    }
+    bool ready = !pipeline->failed;
+    pthread_mutex_unlock(&pipeline->mutex);
+    return ready;
+}
+
+/**
+*   Function to pass batch to next stage
+*   In params:
+*       geometry_pipe* pipeline             pipeline
+*       geometry_pipe_slot* slot        batch
+*       geometry_pipe_state state       next stage
+*       bool failed                     true if caller failed, so whole pipeline stops
+*
+*   Out params/return:
+*       none
+*/
+static void geometry_pipe_pass(geometry_pipe* pipeline, geometry_pipe_slot* slot, geometry_pipe_state state, bool failed){
+    pthread_mutex_lock(&pipeline->mutex);
+    slot->state = state;
+    if(failed){
+        pipeline->failed = true;
+    }
+    pthread_cond_broadcast(&pipeline->changed);
+    pthread_mutex_unlock(&pipeline->mutex);
+}
+
+/**
+*   Function to apply transform to arrays of coordinates
+*   In params:
+*       const double transform[6]   coefficients a, b, tx, c, d, ty of transform
+*       double* xs                  x coordinates
+*       double* ys                  y coordinates
+*       size_t count                number of points
+*
+*   Out params:
+*       none (coordinates are changed)
+*/
+static void geometry_pipe_transform(const double transform[6], double* xs, double* ys, size_t count){
+    for(size_t i = 0; i < count; i++){
+        double x = xs[i];
+        double y = ys[i];
+        xs[i] = transform[0] * x + transform[1] * y + transform[2];
+        ys[i] = transform[3] * x + transform[4] * y + transform[5];
+    }
+}
+
+/**
+*   Function to transform shapes of batch and calculate their metrics
+*   In params:
+*       geometry_pipe* pipeline             pipeline
+*       geometry_pipe_slot* slot        batch
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+static bool geometry_pipe_computeSlot(geometry_pipe* pipeline, geometry_pipe_slot* slot){
+    geometry_pipe_transform(pipeline->transform, slot->points[0], slot->points[1], slot->point_count);
+    for(int i = 0; i < 4; i += 2){
+        geometry_pipe_transform(pipeline->transform, slot->segments[i], slot->segments[i + 1], slot->segment_count);
+    }
+    for(int i = 0; i < 6; i += 2){
+        geometry_pipe_transform(pipeline->transform, slot->triangles[i], slot->triangles[i + 1], slot->triangle_count);
+    }
+    geometry_arena_reset(pipeline->arena);
+    for(size_t i = 0; i < slot->segment_count; i++){
+        geometry_point* start = geometry_point_new_in(pipeline->arena, slot->segments[0][i], slot->segments[1][i]);
+        geometry_point* end = geometry_point_new_in(pipeline->arena, slot->segments[2][i], slot->segments[3][i]);
+        geometry_segment* segment = geometry_segment_new_in(pipeline->arena, start, end);
+        if(segment == NULL){
+            return false;
+        }
+        slot->lengths[i] = geometry_segment_calculateLength(segment);
+    }
+    if(slot->triangle_count == 0){
+        return true;
+    }
+    geometry_triangle** triangles = geometry_arena_allocate(pipeline->arena, slot->triangle_count * sizeof(geometry_triangle*));
+    if(triangles == NULL){
+        return false;
+    }
+    for(size_t i = 0; i < slot->triangle_count; i++){
+        geometry_point* points[3];
+        for(int j = 0; j < 3; j++){
+            points[j] = geometry_point_new_in(pipeline->arena, slot->triangles[2 * j][i], slot->triangles[2 * j + 1][i]);
+        }
+        bool is_right = (slot->flags[i] & GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT) != 0;
+        triangles[i] = geometry_triangle_new_in(pipeline->arena, points[0], points[1], points[2], is_right);
+        if(triangles[i] == NULL){
+            return false;
+        }
+    }
+    bool computed = true;
+    if(pipeline->metrics[GEOMETRY_PIPE_AREA]){
+        computed = computed && geometry_triangle_calculateAreaBatch(pipeline->pool, triangles, slot->triangle_count, slot->metrics[GEOMETRY_PIPE_AREA]);
+    }
+    if(pipeline->metrics[GEOMETRY_PIPE_PERIMETER]){
+        computed = computed && geometry_triangle_calculatePerimeterBatch(pipeline->pool, triangles, slot->triangle_count, slot->metrics[GEOMETRY_PIPE_PERIMETER]);
+    }
+    if(pipeline->metrics[GEOMETRY_PIPE_HYPOTENUSE]){
+        computed = computed && geometry_triangle_calculateHypotenuseBatch(pipeline->pool, triangles, slot->triangle_count, slot->metrics[GEOMETRY_PIPE_HYPOTENUSE]);
+    }
+    if(pipeline->metrics[GEOMETRY_PIPE_INTERSECTS]){
+        computed = computed && geometry_triangle_areDisjointBatch(pipeline->reference, triangles, slot->triangle_count, slot->disjoint) != (size_t)-1;
+        for(size_t i = 0; computed && i < slot->triangle_count; i++){
+            slot->metrics[GEOMETRY_PIPE_INTERSECTS][i] = slot->disjoint[i] ? 0 : 1;
+        }
+    }
+    return computed;
+}
+
+/**
+*   Function to write lines of all shapes of batch
+*   In params:
+*       geometry_pipe* pipeline             pipeline
+*       geometry_pipe_slot* slot        batch
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+static bool geometry_pipe_writeSlot(geometry_pipe* pipeline, geometry_pipe_slot* slot){
+    // next shape of every kind
+    size_t positions[3] = {0, 0, 0};
+    char line[GEOMETRY_PIPE_LINE_SIZE];
+    for(size_t i = 0; i < slot->count; i++){
+        geometry_text_kind kind = slot->kinds[i];
+        size_t position = positions[kind]++;
+        size_t length = geometry_text_formatDouble((double)(slot->first + i), line);
+        line[length++] = ',';
+        size_t name_length = strlen(geometry_pipe_kind_names[kind]);
+        memcpy(line + length, geometry_pipe_kind_names[kind], name_length);
+        length += name_length;
+        for(int metric = 0; metric < GEOMETRY_PIPE_METRIC_COUNT; metric++){
+            if(!pipeline->metrics[metric]){
+                continue;
+            }
+            line[length++] = ',';
+            if(kind == GEOMETRY_TEXT_TRIANGLE){
+                length += geometry_text_formatDouble(slot->metrics[metric][position], line + length);
+            }
+            else if(kind == GEOMETRY_TEXT_SEGMENT && metric == GEOMETRY_PIPE_PERIMETER){
+                length += geometry_text_formatDouble(slot->lengths[position], line + length);
+            }
+        }
+        if(pipeline->shapes){
+            for(int j = 0; j < 6; j++){
+                double* coordinates = kind == GEOMETRY_TEXT_POINT ? (j < 2 ? slot->points[j] : NULL)
+                                      : kind == GEOMETRY_TEXT_SEGMENT ? (j < 4 ? slot->segments[j] : NULL) : slot->triangles[j];
+                if(coordinates == NULL){
+                    break;
+                }
+                line[length++] = ',';
+                length += geometry_text_formatDouble(coordinates[position], line + length);
+            }
+        }
+        line[length] = '\0';
+        if(!geometry_text_writer_writeLine(pipeline->writer, line)){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+*   Function run by reading thread - parses input batch after batch into ring
+*   In params:
+*       void* context       pipeline
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*               NULL
+*/
+static void* geometry_pipe_readStage(void* context){
+    geometry_pipe* pipeline = context;
+    size_t first = 0;
+    for(size_t batch = 0; ; batch++){
+        geometry_pipe_slot* slot = &pipeline->slots[batch % GEOMETRY_PIPE_SLOTS];
+        if(!geometry_pipe_wait(pipeline, slot, GEOMETRY_PIPE_EMPTY)){
+            return NULL;
+        }
+        size_t count = geometry_text_reader_read(pipeline->reader);
+        if(count == (size_t)-1){
+            // reader returned shapes of lines before invalid one in previous batches,
+            // so they are computed and written as usual, only empty last batch is passed
+            fprintf(stderr, "geometry-pipe: line %zu: invalid shape\n", geometry_text_reader_getLine(pipeline->reader));
+            pipeline->invalid = true;
+            slot->count = 0;
+            slot->first = first;
+            slot->point_count = 0;
+            slot->segment_count = 0;
+            slot->triangle_count = 0;
+            geometry_pipe_pass(pipeline, slot, GEOMETRY_PIPE_READ, false);
+            return NULL;
+        }
+        slot->count = count;
+        slot->first = first;
+        first += count;
+        memcpy(slot->kinds, geometry_text_reader_getKinds(pipeline->reader), count * sizeof(geometry_text_kind));
+        const double* coordinates[6];
+        const unsigned char* flags;
+        slot->point_count = geometry_text_reader_getPoints(pipeline->reader, &coordinates[0], &coordinates[1]);
+        for(int i = 0; i < 2; i++){
+            memcpy(slot->points[i], coordinates[i], slot->point_count * sizeof(double));
+        }
+        slot->segment_count = geometry_text_reader_getSegments(pipeline->reader, coordinates);
+        for(int i = 0; i < 4; i++){
+            memcpy(slot->segments[i], coordinates[i], slot->segment_count * sizeof(double));
+        }
+        slot->triangle_count = geometry_text_reader_getTriangles(pipeline->reader, coordinates, &flags);
+        for(int i = 0; i < 6; i++){
+            memcpy(slot->triangles[i], coordinates[i], slot->triangle_count * sizeof(double));
+        }
+        memcpy(slot->flags, flags, slot->triangle_count);
+        geometry_pipe_pass(pipeline, slot, GEOMETRY_PIPE_READ, false);
+        if(count == 0){
+            return NULL;
+        }
+    }
+}
+
+/**
+*   Function run by writing thread - writes computed batches from ring
+*   In params:
+*       void* context       pipeline
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*               NULL
+*/
+static void* geometry_pipe_writeStage(void* context){
+    geometry_pipe* pipeline = context;
+    for(size_t batch = 0; ; batch++){
+        geometry_pipe_slot* slot = &pipeline->slots[batch % GEOMETRY_PIPE_SLOTS];
+        if(!geometry_pipe_wait(pipeline, slot, GEOMETRY_PIPE_COMPUTED)){
+            return NULL;
+        }
+        // slot may be filled again as soon as it is passed, so end is checked before
+        bool last = slot->count == 0;
+        bool written = geometry_pipe_writeSlot(pipeline, slot);
+        if(last){
+            written = written && geometry_text_writer_flush(pipeline->writer);
+        }
+        if(!written){
+            fprintf(stderr, "geometry-pipe: write failed\n");
+        }
+        geometry_pipe_pass(pipeline, slot, GEOMETRY_PIPE_EMPTY, !written);
+        if(last || !written){
+            return NULL;
+        }
+    }
+}
+
+int main(int argc, char** argv){
+    geometry_pipe pipeline;
+    memset(&pipeline, 0, sizeof(pipeline));
+    pipeline.capacity = GEOMETRY_PIPE_DEFAULT_BATCH;
+    pipeline.metrics[GEOMETRY_PIPE_AREA] = true;
+    pipeline.metrics[GEOMETRY_PIPE_PERIMETER] = true;
+    const char* output_path = NULL;
+    size_t threads = 1;
+    bool has_reference = false;
+    double reference[6];
+    geometry_transform* transform = geometry_transform_new();
+    if(transform == NULL){
+        return 1;
+    }
+    int option;
+    bool valid = true;
+    while(valid && (option = getopt(argc, argv, "m:r:c:x:so:b:j:h")) != -1){
+        double numbers[6];
+        size_t count;
+        switch(option){
+            case 'm':
+                count = geometry_pipe_parseNumbers(optarg, numbers, 2);
+                valid = count == 2;
+                if(valid){
+                    geometry_transform_moveByVector(transform, numbers[0], numbers[1]);
+                }
+                break;
+            case 'r':
+                count = geometry_pipe_parseNumbers(optarg, numbers, 3);
+                valid = count == 1 || count == 3;
+                if(valid){
+                    geometry_point* center = geometry_point_new(count == 3 ? numbers[1] : 0, count == 3 ? numbers[2] : 0);
+                    geometry_transform_rotateByAngle(transform, numbers[0], center);
+                    geometry_point_destroy(center);
+                }
+                break;
+            case 'c':
+                valid = geometry_pipe_parseMetrics(optarg, pipeline.metrics);
+                break;
+            case 'x':
+                valid = geometry_pipe_parseNumbers(optarg, reference, 6) == 6;
+                has_reference = true;
+                break;
+            case 's':
+                pipeline.shapes = true;
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'b':
+                valid = geometry_pipe_parseCount(optarg, SIZE_MAX / sizeof(double), &pipeline.capacity);
+                break;
+            case 'j':
+                valid = geometry_pipe_parseCount(optarg, GEOMETRY_PIPE_MAX_THREADS, &threads);
+                break;
+            default:
+                valid = false;
+                break;
+        }
+    }
+    if(!valid || optind + 1 < argc || (pipeline.metrics[GEOMETRY_PIPE_INTERSECTS] && !has_reference)){
+        fputs(GEOMETRY_PIPE_USAGE, stderr);
+        geometry_transform_destroy(transform);
+        return 1;
+    }
+    geometry_real coefficients[6];
+    geometry_transform_getCoefficients(transform, coefficients);
+    for(int i = 0; i < 6; i++){
+        pipeline.transform[i] = coefficients[i];
+    }
+    geometry_transform_destroy(transform);
+
+    FILE* input = optind < argc ? fopen(argv[optind], "r") : stdin;
+    FILE* output = output_path != NULL ? fopen(output_path, "w") : stdout;
+    if(input == NULL || output == NULL){
+        fprintf(stderr, "geometry-pipe: can't open %s\n", input == NULL ? argv[optind] : output_path);
+        return 1;
+    }
+    pipeline.reader = geometry_text_reader_new(input, pipeline.capacity);
+    pipeline.writer = geometry_text_writer_new(output, GEOMETRY_TEXT_CSV);
+    pipeline.arena = geometry_arena_new(0);
+    pipeline.pool = threads != 1 ? geometry_pool_new(threads) : NULL;
+    bool created = pipeline.reader != NULL && pipeline.writer != NULL && pipeline.arena != NULL && (threads == 1 || pipeline.pool != NULL);
+    for(int i = 0; i < GEOMETRY_PIPE_SLOTS; i++){
+        created = geometry_pipe_createSlot(&pipeline.slots[i], pipeline.capacity) && created;
+    }
+    if(has_reference && created){
+        geometry_point* points[3];
+        for(int i = 0; i < 3; i++){
+            points[i] = geometry_point_new_in(pipeline.arena, reference[2 * i], reference[2 * i + 1]);
+        }
+        pipeline.reference = geometry_triangle_new(points[0], points[1], points[2], false);
+        created = pipeline.reference != NULL;
+    }
+    int result = 1;
+    if(created){
+        char header[GEOMETRY_PIPE_LINE_SIZE] = "# index,kind";
+        for(int i = 0; i < GEOMETRY_PIPE_METRIC_COUNT; i++){
+            if(pipeline.metrics[i]){
+                strcat(header, ",");
+                strcat(header, geometry_pipe_metric_names[i]);
+            }
+        }
+        if(pipeline.shapes){
+            strcat(header, ",coordinates");
+        }
+        geometry_text_writer_writeLine(pipeline.writer, header);
+        pthread_mutex_init(&pipeline.mutex, NULL);
+        pthread_cond_init(&pipeline.changed, NULL);
+        pthread_t reading;
+        pthread_t writing;
+        pthread_create(&reading, NULL, geometry_pipe_readStage, &pipeline);
+        pthread_create(&writing, NULL, geometry_pipe_writeStage, &pipeline);
+        // calling thread computes
+        for(size_t batch = 0; ; batch++){
+            geometry_pipe_slot* slot = &pipeline.slots[batch % GEOMETRY_PIPE_SLOTS];
+            if(!geometry_pipe_wait(&pipeline, slot, GEOMETRY_PIPE_READ)){
+                break;
+            }
+            bool last = slot->count == 0;
+            bool computed = geometry_pipe_computeSlot(&pipeline, slot);
+            if(!computed){
+                fprintf(stderr, "geometry-pipe: out of memory\n");
+            }
+            geometry_pipe_pass(&pipeline, slot, GEOMETRY_PIPE_COMPUTED, !computed);
+            if(last || !computed){
+                break;
+            }
+        }
+        pthread_join(reading, NULL);
+        pthread_join(writing, NULL);
+        pthread_cond_destroy(&pipeline.changed);
+        pthread_mutex_destroy(&pipeline.mutex);
+        result = pipeline.failed || pipeline.invalid ? 1 : 0;
+    }
+    else{
+        fprintf(stderr, "geometry-pipe: out of memory\n");
+    }
+    geometry_triangle_destroy(pipeline.reference);
+    for(int i = 0; i < GEOMETRY_PIPE_SLOTS; i++){
+        geometry_pipe_destroySlot(&pipeline.slots[i]);
+    }
+    geometry_pool_destroy(pipeline.pool);
+    geometry_arena_destroy(pipeline.arena);
+    geometry_text_writer_destroy(pipeline.writer);
+    geometry_text_reader_destroy(pipeline.reader);
+    if(input != stdin){
+        fclose(input);
+    }
+    if(output != stdout){
+        fclose(output);
+    }
+    return result;
+}
@@ -0,0 +1,776 @@
+#include "geometry_pool.h"
+#include "geometry_stats.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define GEOMETRY_POOL_DEFAULT_CHUNK_SIZE 1024
+#define GEOMETRY_POOL_CACHE_LINE 64
+
+// Way of splitting work of current run between threads
+typedef enum geometry_pool_mode {
+    GEOMETRY_POOL_CHUNKS,
+    GEOMETRY_POOL_STEALING
+} geometry_pool_mode;
+
+// Work-stealing deque (after Chase and Lev) of one thread. Items are consecutive indices,
+// item at position p is begin + p. Owner takes items from bottom, other threads steal
+// from top, only the last item needs compare-and-swap. Deques are filled before run
+// starts and nothing is pushed during run, so buffer of items never has to grow.
+typedef struct geometry_pool_deque {
+    size_t begin;
+    atomic_llong top;
+    atomic_llong bottom;
+    // deques of different threads are kept in different cache lines
+    char padding[GEOMETRY_POOL_CACHE_LINE - sizeof(size_t) - 2 * sizeof(atomic_llong)];
+} geometry_pool_deque;
+
+typedef struct geometry_pool_thread {
+    geometry_pool* pool;
+    size_t index;
+} geometry_pool_thread;
+
+struct geometry_pool {
+    pthread_t* threads;
+    geometry_pool_thread* thread_infos;
+    // one deque for every thread, the last one belongs to calling thread
+    geometry_pool_deque* deques;
+    // number of started threads, calling thread isn't counted
+    size_t worker_count;
+    size_t chunk_size;
+    pthread_mutex_t mutex;
+    // serializes geometry_pool_run calls
+    pthread_mutex_t run_mutex;
+    pthread_cond_t start;
+    pthread_cond_t finish;
+    // increased for every run, so sleeping threads know that new work came
+    unsigned long generation;
+    // number of threads that haven't finished current run yet
+    size_t active;
+    bool stopping;
+    // current run
+    geometry_pool_mode mode;
+    geometry_pool_task task;
+    geometry_pool_itemTask item_task;
+    void* context;
+    size_t count;
+    atomic_size_t next;
+    // memory of pool and of its batch functions is taken from it
+    geometry_allocator allocator;
+};
+
+// Which values of triangle batch function calculates
+typedef enum geometry_pool_metric {
+    GEOMETRY_POOL_AREA,
+    GEOMETRY_POOL_PERIMETER,
+    GEOMETRY_POOL_HYPOTENUSE
+} geometry_pool_metric;
+
+typedef struct geometry_pool_metricContext {
+    geometry_triangle** triangles;
+    geometry_real* results;
+    geometry_pool_metric metric;
+} geometry_pool_metricContext;
+
+// Pairs found by one thread, merged after run
+typedef struct geometry_pool_pairs {
+    geometry_pool_pair* pairs;
+    size_t count;
+    size_t capacity;
+    char padding[GEOMETRY_POOL_CACHE_LINE - sizeof(geometry_pool_pair*) - 2 * sizeof(size_t)];
+} geometry_pool_pairs;
+
+typedef struct geometry_pool_collisionContext {
+    geometry_triangle** triangles;
+    size_t count;
+    geometry_pool_pairs* found;
+    const geometry_allocator* allocator;
+    atomic_bool failed;
+} geometry_pool_collisionContext;
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static bool geometry_pool_pop(geometry_pool_deque* deque, size_t* item);
+static int geometry_pool_steal(geometry_pool_deque* deque, size_t* item);
+static void geometry_pool_workChunks(geometry_pool* pool);
+static void geometry_pool_workStealing(geometry_pool* pool, size_t thread);
+static void geometry_pool_work(geometry_pool* pool, size_t thread);
+static void* geometry_pool_worker(void* argument);
+static void geometry_pool_metricTask(size_t begin, size_t end, void* context);
+static bool geometry_pool_calculateMetric(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_real* results, geometry_pool_metric metric);
+static void geometry_pool_collisionTask(size_t index, size_t thread, void* context);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to take item from bottom of deque, may be called only by owner of deque
+*   In params:
+*       geometry_pool_deque* deque      deque
+*
+*   Out params:
+*       size_t* item                    taken item
+*
+*   Return:
+*       bool                            true if item was taken, false if deque is empty
+*/
+static bool geometry_pool_pop(geometry_pool_deque* deque, size_t* item){
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    // thieves must see decreased bottom before owner reads top
+    atomic_thread_fence(memory_order_seq_cst);
+    long long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if(top > bottom){
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+    *item = deque->begin + (size_t)bottom;
+    if(top < bottom){
+        return true;
+    }
+    // the last item - owner races with thieves for it
+    bool taken = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return taken;
+}
+
+/**
+*   Function to steal item from top of deque of other thread
+*   In params:
+*       geometry_pool_deque* deque      deque
+*
+*   Out params:
+*       size_t* item                    stolen item
+*
+*   Return:
+*       int                             1 if item was stolen, 0 if deque is empty,
+*                                       -1 if other thread took the item first
+*/
+static int geometry_pool_steal(geometry_pool_deque* deque, size_t* item){
+    long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if(top >= bottom){
+        return 0;
+    }
+    if(!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)){
+        return -1;
+    }
+    *item = deque->begin + (size_t)top;
+    return 1;
+}
+
+/**
+*   Function to take chunks of current run and process them until none is left
+*   In params:
+*       geometry_pool* pool     pool
+*
+*   Out params/return:
+*       none
+*/
+static void geometry_pool_workChunks(geometry_pool* pool){
+    while(true){
+        size_t begin = atomic_fetch_add_explicit(&pool->next, pool->chunk_size, memory_order_relaxed);
+        if(begin >= pool->count){
+            return;
+        }
+        size_t end = pool->count - begin < pool->chunk_size ? pool->count : begin + pool->chunk_size;
+        pool->task(begin, end, pool->context);
+    }
+}
+
+/**
+*   Function to process items of own deque, and then items stolen from other threads,
+*   until all deques are empty
+*   In params:
+*       geometry_pool* pool     pool
+*       size_t thread           index of thread
+*
+*   Out params/return:
+*       none
+*/
+static void geometry_pool_workStealing(geometry_pool* pool, size_t thread){
+    size_t thread_count = pool->worker_count + 1;
+    size_t item;
+    while(true){
+        if(geometry_pool_pop(&pool->deques[thread], &item)){
+            pool->item_task(item, thread, pool->context);
+            continue;
+        }
+        // nothing is pushed during run, so once every deque was seen empty, work is done
+        bool stolen = false;
+        bool contended = false;
+        for(size_t i = 1; i < thread_count && !stolen; i++){
+            int result = geometry_pool_steal(&pool->deques[(thread + i) % thread_count], &item);
+            stolen = result == 1;
+            contended = contended || result < 0;
+        }
+        if(stolen){
+            pool->item_task(item, thread, pool->context);
+        }
+        else if(!contended){
+            return;
+        }
+    }
+}
+
+/**
+*   Function to take part in current run
+*   In params:
+*       geometry_pool* pool     pool
+*       size_t thread           index of thread
+*
+*   Out params/return:
+*       none
+*/
+static void geometry_pool_work(geometry_pool* pool, size_t thread){
+    if(pool->mode == GEOMETRY_POOL_CHUNKS){
+        geometry_pool_workChunks(pool);
+    }
+    else{
+        geometry_pool_workStealing(pool, thread);
+    }
+}
+
+/**
+*   Function run by every thread of pool - it sleeps until new run starts,
+*   takes part in it and goes to sleep again
+*   In params:
+*       void* argument      geometry_pool_thread of thread
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       void*               NULL
+*/
+static void* geometry_pool_worker(void* argument){
+    geometry_pool_thread* info = argument;
+    geometry_pool* pool = info->pool;
+    unsigned long seen = 0;
+    while(true){
+        pthread_mutex_lock(&pool->mutex);
+        while(!pool->stopping && pool->generation == seen){
+            pthread_cond_wait(&pool->start, &pool->mutex);
+        }
+        if(pool->stopping){
+            pthread_mutex_unlock(&pool->mutex);
+            return NULL;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+        geometry_pool_work(pool, info->index);
+        pthread_mutex_lock(&pool->mutex);
+        pool->active--;
+        if(pool->active == 0){
+            pthread_cond_signal(&pool->finish);
+        }
+        pthread_mutex_unlock(&pool->mutex);
+    }
+}
+
+/**
+*   Function to calculate metric of triangles in given chunk
+*   In params:
+*       size_t begin        first triangle of chunk
+*       size_t end          triangle after last triangle of chunk
+*       void* context       geometry_pool_metricContext of batch
+*
+*   Out params/return:
+*       none (results are written)
+*/
+static void geometry_pool_metricTask(size_t begin, size_t end, void* context){
+    geometry_pool_metricContext* metric_context = context;
+    geometry_triangle** triangles = metric_context->triangles;
+    geometry_real* results = metric_context->results;
+    switch(metric_context->metric){
+        case GEOMETRY_POOL_AREA:
+            for(size_t i = begin; i < end; i++){
+                results[i] = geometry_triangle_calculateArea(triangles[i]);
+            }
+            break;
+        case GEOMETRY_POOL_PERIMETER:
+            for(size_t i = begin; i < end; i++){
+                results[i] = geometry_triangle_calculatePerimeter(triangles[i]);
+            }
+            break;
+        case GEOMETRY_POOL_HYPOTENUSE:
+            for(size_t i = begin; i < end; i++){
+                results[i] = geometry_triangle_calculateHypotenuse(triangles[i]);
+            }
+            break;
+    }
+}
+
+/**
+*   Function to calculate metric of given triangles on threads of pool
+*   Caches are filled before work is split, so threads only read triangles
+*   In params:
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       geometry_triangle** triangles   array of triangles
+*       size_t count                    number of triangles
+*       geometry_pool_metric metric     value to calculate
+*
+*   Out params:
+*       geometry_real* results          array of count results
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+static bool geometry_pool_calculateMetric(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_real* results, geometry_pool_metric metric){
+    if((triangles == NULL || results == NULL) && count > 0){
+        return false;
+    }
+    for(size_t i = 0; i < count; i++){
+        // afterwards metrics only read triangles, so threads may share them
+        // (the same triangle may be given many times)
+        geometry_triangle_fillCache(triangles[i]);
+    }
+    geometry_pool_metricContext context = {triangles, results, metric};
+    return geometry_pool_run(pool, count, geometry_pool_metricTask, &context);
+}
+
+/**
+*   Function to test one triangle against all triangles after it and keep intersecting pairs
+*   In params:
+*       size_t index        index of triangle
+*       size_t thread       index of thread, pairs go to its buffer
+*       void* context       geometry_pool_collisionContext of search
+*
+*   Out params/return:
+*       none (pairs are added to buffer)
+*/
+static void geometry_pool_collisionTask(size_t index, size_t thread, void* context){
+    geometry_pool_collisionContext* collision_context = context;
+    geometry_pool_pairs* found = &collision_context->found[thread];
+    geometry_triangle* triangle = collision_context->triangles[index];
+    for(size_t i = index + 1; i < collision_context->count; i++){
+        if(geometry_triangle_areDisjoint(triangle, collision_context->triangles[i])){
+            continue;
+        }
+        if(found->count == found->capacity){
+            size_t capacity = found->capacity * 2 + 16;
+            geometry_pool_pair* pairs = geometry_allocator_reallocate(collision_context->allocator, found->pairs, found->capacity * sizeof(*pairs), capacity * sizeof(*pairs));
+            if(pairs == NULL){
+                atomic_store_explicit(&collision_context->failed, true, memory_order_relaxed);
+                return;
+            }
+            found->pairs = pairs;
+            found->capacity = capacity;
+        }
+        found->pairs[found->count].first = index;
+        found->pairs[found->count].second = i;
+        found->count++;
+    }
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new geometry_pool object
+*   In params:
+*       size_t thread_count     number of threads doing work (together with calling one),
+*                               0 means number of processors available
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_pool*          pointer to created object, NULL if error occured
+*/
+geometry_pool* geometry_pool_new(size_t thread_count){
+    return geometry_pool_new_with(NULL, thread_count);
+}
+
+/**
+*   Function to create new geometry_pool object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t thread_count                     number of threads doing work (together with calling one),
+*                                               0 means number of processors available
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_pool*          pointer to created object, NULL if error occured
+*/
+geometry_pool* geometry_pool_new_with(const geometry_allocator* allocator, size_t thread_count){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POOL_NEW);
+    if(thread_count == 0){
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = processors > 0 ? (size_t)processors : 1;
+    }
+    geometry_pool* new_pool = geometry_allocator_allocate(allocator, sizeof(*new_pool));
+    if(new_pool == NULL){
+        return NULL;
+    }
+    new_pool->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    allocator = &new_pool->allocator;
+    new_pool->threads = geometry_allocator_allocate(allocator, (thread_count - 1) * sizeof(*new_pool->threads) + 1);
+    new_pool->thread_infos = geometry_allocator_allocate(allocator, thread_count * sizeof(*new_pool->thread_infos));
+    new_pool->deques = geometry_allocator_allocate(allocator, thread_count * sizeof(*new_pool->deques));
+    if(new_pool->threads == NULL || new_pool->thread_infos == NULL || new_pool->deques == NULL){
+        geometry_allocator_free(allocator, new_pool->threads);
+        geometry_allocator_free(allocator, new_pool->thread_infos);
+        geometry_allocator_free(allocator, new_pool->deques);
+        geometry_allocator_free(allocator, new_pool);
+        return NULL;
+    }
+    for(size_t i = 0; i < thread_count; i++){
+        new_pool->thread_infos[i].pool = new_pool;
+        new_pool->thread_infos[i].index = i;
+        new_pool->deques[i].begin = 0;
+        atomic_init(&new_pool->deques[i].top, 0);
+        atomic_init(&new_pool->deques[i].bottom, 0);
+    }
+    new_pool->worker_count = 0;
+    new_pool->chunk_size = GEOMETRY_POOL_DEFAULT_CHUNK_SIZE;
+    new_pool->generation = 0;
+    new_pool->active = 0;
+    new_pool->stopping = false;
+    new_pool->mode = GEOMETRY_POOL_CHUNKS;
+    new_pool->task = NULL;
+    new_pool->item_task = NULL;
+    new_pool->context = NULL;
+    new_pool->count = 0;
+    atomic_init(&new_pool->next, 0);
+    pthread_mutex_init(&new_pool->mutex, NULL);
+    pthread_mutex_init(&new_pool->run_mutex, NULL);
+    pthread_cond_init(&new_pool->start, NULL);
+    pthread_cond_init(&new_pool->finish, NULL);
+    for(size_t i = 0; i + 1 < thread_count; i++){
+        if(pthread_create(&new_pool->threads[i], NULL, geometry_pool_worker, &new_pool->thread_infos[i]) != 0){
+            geometry_pool_destroy(new_pool);
+            return NULL;
+        }
+        new_pool->worker_count++;
+    }
+    return new_pool;
+}
+
+/**
+*   Function to destroy given geometry_pool object, all its threads are stopped
+*   In params:
+*       geometry_pool* pool     pool object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_pool_destroy(geometry_pool* pool){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POOL_DESTROY);
+    if(pool == NULL){
+        return;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+    for(size_t i = 0; i < pool->worker_count; i++){
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->finish);
+    pthread_mutex_destroy(&pool->run_mutex);
+    pthread_mutex_destroy(&pool->mutex);
+    geometry_allocator allocator = pool->allocator;
+    geometry_allocator_free(&allocator, pool->threads);
+    geometry_allocator_free(&allocator, pool->thread_infos);
+    geometry_allocator_free(&allocator, pool->deques);
+    geometry_allocator_free(&allocator, pool);
+}
+
+/**
+*   Function to get number of threads doing work in given pool
+*   In params:
+*       geometry_pool* pool     pool
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  number of threads (together with calling one), 1 if pool is NULL
+*/
+size_t geometry_pool_getThreadCount(geometry_pool* pool){
+    if(pool == NULL){
+        return 1;
+    }
+    return pool->worker_count + 1;
+}
+
+/**
+*   Function to set number of indices taken by thread at once
+*   Small chunks balance uneven work better, big ones cost less synchronization
+*   In params:
+*       geometry_pool* pool     pool
+*       size_t chunk_size       number of indices in chunk, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if error occured
+*/
+bool geometry_pool_setChunkSize(geometry_pool* pool, size_t chunk_size){
+    if(pool == NULL || chunk_size == 0){
+        return false;
+    }
+    pthread_mutex_lock(&pool->run_mutex);
+    pool->chunk_size = chunk_size;
+    pthread_mutex_unlock(&pool->run_mutex);
+    return true;
+}
+
+/**
+*   Function to get number of indices taken by thread at once
+*   In params:
+*       geometry_pool* pool     pool
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  number of indices in chunk, 0 if pool is NULL
+*/
+size_t geometry_pool_getChunkSize(geometry_pool* pool){
+    if(pool == NULL){
+        return 0;
+    }
+    return pool->chunk_size;
+}
+
+/**
+*   Function to run task over range of indices on all threads of pool
+*   Returns after whole range is processed. Calls from many threads are
+*   run one after another. If pool is NULL, task is run on calling thread.
+*   In params:
+*       geometry_pool* pool             pool
+*       size_t count                    number of indices, range is from 0 to count (without count)
+*       geometry_pool_task task         function to run for every chunk
+*       void* context                   pointer passed to every task call
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_pool_run(geometry_pool* pool, size_t count, geometry_pool_task task, void* context){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POOL_RUN);
+    if(task == NULL){
+        return false;
+    }
+    if(count == 0){
+        return true;
+    }
+    if(pool == NULL){
+        task(0, count, context);
+        return true;
+    }
+    pthread_mutex_lock(&pool->run_mutex);
+    if(pool->worker_count == 0 || count <= pool->chunk_size){
+        // waking threads would cost more than the work itself
+        pthread_mutex_unlock(&pool->run_mutex);
+        task(0, count, context);
+        return true;
+    }
+    // every thread takes one chunk past the end, that can't overflow the counter
+    if(count > SIZE_MAX - pool->chunk_size * (pool->worker_count + 1)){
+        pthread_mutex_unlock(&pool->run_mutex);
+        return false;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    pool->mode = GEOMETRY_POOL_CHUNKS;
+    pool->task = task;
+    pool->context = context;
+    pool->count = count;
+    atomic_store_explicit(&pool->next, 0, memory_order_relaxed);
+    pool->active = pool->worker_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+    geometry_pool_work(pool, pool->worker_count);
+    pthread_mutex_lock(&pool->mutex);
+    while(pool->active > 0){
+        pthread_cond_wait(&pool->finish, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    pthread_mutex_unlock(&pool->run_mutex);
+    return true;
+}
+
+/**
+*   Function to run task for every index of range on all threads of pool, with work stealing
+*   Range is split evenly between threads, and thread that finished its part takes
+*   single indices from parts of other threads - so it suits tasks of very uneven cost.
+*   Returns after whole range is processed. If pool is NULL, task is run on calling thread.
+*   In params:
+*       geometry_pool* pool             pool
+*       size_t count                    number of indices, range is from 0 to count (without count)
+*       geometry_pool_itemTask task     function to run for every index
+*       void* context                   pointer passed to every task call
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_pool_runStealing(geometry_pool* pool, size_t count, geometry_pool_itemTask task, void* context){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_POOL_RUN_STEALING);
+    if(task == NULL){
+        return false;
+    }
+    if(pool == NULL || pool->worker_count == 0 || count < 2){
+        for(size_t i = 0; i < count; i++){
+            task(i, 0, context);
+        }
+        return true;
+    }
+    if(count > (size_t)LLONG_MAX){
+        return false;
+    }
+    pthread_mutex_lock(&pool->run_mutex);
+    size_t thread_count = pool->worker_count + 1;
+    size_t part = count / thread_count;
+    size_t rest = count % thread_count;
+    size_t begin = 0;
+    for(size_t i = 0; i < thread_count; i++){
+        size_t size = part + (i < rest);
+        pool->deques[i].begin = begin;
+        atomic_store_explicit(&pool->deques[i].top, 0, memory_order_relaxed);
+        atomic_store_explicit(&pool->deques[i].bottom, (long long)size, memory_order_relaxed);
+        begin += size;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    pool->mode = GEOMETRY_POOL_STEALING;
+    pool->item_task = task;
+    pool->context = context;
+    pool->count = count;
+    pool->active = pool->worker_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+    geometry_pool_work(pool, pool->worker_count);
+    pthread_mutex_lock(&pool->mutex);
+    while(pool->active > 0){
+        pthread_cond_wait(&pool->finish, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    pthread_mutex_unlock(&pool->run_mutex);
+    return true;
+}
+
+/**
+*   Function to calculate areas of given triangles on threads of pool
+*   In params:
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       geometry_triangle** triangles   array of triangles
+*       size_t count                    number of triangles
+*
+*   Out params:
+*       geometry_real* areas            array of count results, -1 for NULL triangles
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_triangle_calculateAreaBatch(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_real* areas){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_CALCULATE_AREA_BATCH);
+    return geometry_pool_calculateMetric(pool, triangles, count, areas, GEOMETRY_POOL_AREA);
+}
+
+/**
+*   Function to calculate perimeters of given triangles on threads of pool
+*   In params:
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       geometry_triangle** triangles   array of triangles
+*       size_t count                    number of triangles
+*
+*   Out params:
+*       geometry_real* perimeters       array of count results, -1 for NULL triangles
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_triangle_calculatePerimeterBatch(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_real* perimeters){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_CALCULATE_PERIMETER_BATCH);
+    return geometry_pool_calculateMetric(pool, triangles, count, perimeters, GEOMETRY_POOL_PERIMETER);
+}
+
+/**
+*   Function to calculate hypotenuses of given triangles on threads of pool
+*   In params:
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       geometry_triangle** triangles   array of triangles
+*       size_t count                    number of triangles
+*
+*   Out params:
+*       geometry_real* hypotenuses      array of count results, -1 for NULL triangles
+*                                       and triangles that are not right-angled
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_triangle_calculateHypotenuseBatch(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_real* hypotenuses){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_CALCULATE_HYPOTENUSE_BATCH);
+    return geometry_pool_calculateMetric(pool, triangles, count, hypotenuses, GEOMETRY_POOL_HYPOTENUSE);
+}
+
+/**
+*   Function to find all pairs of intersecting triangles in given array on threads of pool
+*   Every triangle is tested against triangles after it, rows of tests have very
+*   different cost, so they are spread over threads with work stealing
+*   In params:
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       geometry_triangle** triangles   array of triangles
+*       size_t count                    number of triangles
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_pool_pair* pairs       found pairs of indices, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all intersecting pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_triangle_calculateIntersectingPairs(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_pool_pair* pairs, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TRIANGLE_CALCULATE_INTERSECTING_PAIRS);
+    if((triangles == NULL && count > 0) || (pairs == NULL && capacity > 0)){
+        return (size_t)-1;
+    }
+    for(size_t i = 0; i < count; i++){
+        if(triangles[i] == NULL){
+            return (size_t)-1;
+        }
+        // afterwards tests only read triangles, so threads may share them
+        geometry_triangle_fillCache(triangles[i]);
+    }
+    size_t thread_count = geometry_pool_getThreadCount(pool);
+    geometry_pool_collisionContext context;
+    context.triangles = triangles;
+    context.count = count;
+    context.allocator = pool != NULL ? &pool->allocator : NULL;
+    context.found = geometry_allocator_allocateZeroed(context.allocator, thread_count, sizeof(*context.found));
+    if(context.found == NULL){
+        return (size_t)-1;
+    }
+    atomic_init(&context.failed, false);
+    bool success = geometry_pool_runStealing(pool, count, geometry_pool_collisionTask, &context)
+                    && !atomic_load_explicit(&context.failed, memory_order_relaxed);
+    size_t found = 0;
+    for(size_t i = 0; i < thread_count; i++){
+        for(size_t j = 0; j < context.found[i].count && success; j++){
+            if(found < capacity){
+                pairs[found] = context.found[i].pairs[j];
+            }
+            found++;
+        }
+        geometry_allocator_free(context.allocator, context.found[i].pairs);
+    }
+    geometry_allocator_free(context.allocator, context.found);
+    return success ? found : (size_t)-1;
+}
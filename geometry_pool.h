@@ -0,0 +1,228 @@
+#ifndef GEOMETRY_POOL
+#define GEOMETRY_POOL
+
+#include "geometry.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Pool of worker threads (pthreads) for batch computations.
+// Range of indices is cut into chunks and every thread, including the one
+// that started the work, takes next free chunk until none is left - so threads
+// that got cheap chunks just take more of them. For tasks of very uneven cost
+// every thread can instead get its own part of range and steal single indices
+// from other threads once its part is done. Threads sleep between runs,
+// so one pool can be created at start and reused for every batch.
+typedef struct geometry_pool geometry_pool;
+
+// Function run by pool for every chunk - it should process indices
+// from begin to end (without end), context is pointer given to geometry_pool_run
+typedef void (*geometry_pool_task)(size_t begin, size_t end, void* context);
+
+// Function run by pool with work stealing for every single index - thread is index
+// of thread running it (from 0 to thread count - 1), so results can be kept
+// in separate buffer for every thread and merged after run
+typedef void (*geometry_pool_itemTask)(size_t index, size_t thread, void* context);
+
+// Pair of indices of intersecting triangles, first < second
+typedef struct geometry_pool_pair {
+    size_t first;
+    size_t second;
+} geometry_pool_pair;
+
+/*###############################################
+ GEOMETRY_POOL functions (methods) declarations
+################################################*/
+
+/**
+*   Function to create new geometry_pool object
+*   In params:
+*       size_t thread_count     number of threads doing work (together with calling one),
+*                               0 means number of processors available
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_pool*          pointer to created object, NULL if error occured
+*/
+geometry_pool* geometry_pool_new(size_t thread_count);
+
+/**
+*   Function to create new geometry_pool object with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       size_t thread_count                     number of threads doing work (together with calling one),
+*                                               0 means number of processors available
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_pool*          pointer to created object, NULL if error occured
+*/
+geometry_pool* geometry_pool_new_with(const geometry_allocator* allocator, size_t thread_count);
+
+/**
+*   Function to destroy given geometry_pool object, all its threads are stopped
+*   In params:
+*       geometry_pool* pool     pool object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_pool_destroy(geometry_pool* pool);
+
+/**
+*   Function to get number of threads doing work in given pool
+*   In params:
+*       geometry_pool* pool     pool
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  number of threads (together with calling one), 1 if pool is NULL
+*/
+size_t geometry_pool_getThreadCount(geometry_pool* pool);
+
+/**
+*   Function to set number of indices taken by thread at once
+*   Small chunks balance uneven work better, big ones cost less synchronization
+*   In params:
+*       geometry_pool* pool     pool
+*       size_t chunk_size       number of indices in chunk, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true on success, false if error occured
+*/
+bool geometry_pool_setChunkSize(geometry_pool* pool, size_t chunk_size);
+
+/**
+*   Function to get number of indices taken by thread at once
+*   In params:
+*       geometry_pool* pool     pool
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                  number of indices in chunk, 0 if pool is NULL
+*/
+size_t geometry_pool_getChunkSize(geometry_pool* pool);
+
+/**
+*   Function to run task over range of indices on all threads of pool
+*   Returns after whole range is processed. Calls from many threads are
+*   run one after another. If pool is NULL, task is run on calling thread.
+*   In params:
+*       geometry_pool* pool             pool
+*       size_t count                    number of indices, range is from 0 to count (without count)
+*       geometry_pool_task task         function to run for every chunk
+*       void* context                   pointer passed to every task call
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_pool_run(geometry_pool* pool, size_t count, geometry_pool_task task, void* context);
+
+/**
+*   Function to run task for every index of range on all threads of pool, with work stealing
+*   Range is split evenly between threads, and thread that finished its part takes
+*   single indices from parts of other threads - so it suits tasks of very uneven cost.
+*   Returns after whole range is processed. If pool is NULL, task is run on calling thread.
+*   In params:
+*       geometry_pool* pool             pool
+*       size_t count                    number of indices, range is from 0 to count (without count)
+*       geometry_pool_itemTask task     function to run for every index
+*       void* context                   pointer passed to every task call
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_pool_runStealing(geometry_pool* pool, size_t count, geometry_pool_itemTask task, void* context);
+
+/*#####################################################
+ GEOMETRY_TRIANGLE batch functions declarations
+######################################################*/
+
+// Functions below fill cache of every triangle on calling thread before work is split,
+// so triangles shouldn't be used by other threads meanwhile; threads of pool only read
+// them, so the same triangle may appear in array many times
+
+/**
+*   Function to calculate areas of given triangles on threads of pool
+*   In params:
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       geometry_triangle** triangles   array of triangles
+*       size_t count                    number of triangles
+*
+*   Out params:
+*       geometry_real* areas            array of count results, -1 for NULL triangles
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_triangle_calculateAreaBatch(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_real* areas);
+
+/**
+*   Function to calculate perimeters of given triangles on threads of pool
+*   In params:
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       geometry_triangle** triangles   array of triangles
+*       size_t count                    number of triangles
+*
+*   Out params:
+*       geometry_real* perimeters       array of count results, -1 for NULL triangles
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_triangle_calculatePerimeterBatch(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_real* perimeters);
+
+/**
+*   Function to calculate hypotenuses of given triangles on threads of pool
+*   In params:
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       geometry_triangle** triangles   array of triangles
+*       size_t count                    number of triangles
+*
+*   Out params:
+*       geometry_real* hypotenuses      array of count results, -1 for NULL triangles
+*                                       and triangles that are not right-angled
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_triangle_calculateHypotenuseBatch(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_real* hypotenuses);
+
+/**
+*   Function to find all pairs of intersecting triangles in given array on threads of pool
+*   Every triangle is tested against triangles after it, rows of tests have very
+*   different cost, so they are spread over threads with work stealing
+*   In params:
+*       geometry_pool* pool             pool, NULL means calling thread only
+*       geometry_triangle** triangles   array of triangles
+*       size_t count                    number of triangles
+*       size_t capacity                 number of elements in pairs array
+*
+*   Out params:
+*       geometry_pool_pair* pairs       found pairs of indices, at most capacity elements are written,
+*                                       order of pairs is unspecified
+*
+*   Return:
+*       size_t                          number of all intersecting pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_triangle_calculateIntersectingPairs(geometry_pool* pool, geometry_triangle** triangles, size_t count, geometry_pool_pair* pairs, size_t capacity);
+
+#endif
@@ -0,0 +1,394 @@
+#include "geometry_predicates.h"
+#include "geometry_stats.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <float.h>
+#include <math.h>
+
+// Relative forward error bound of (a - b)(c - d) +- (e - f)(g - h) calculated in
+// double precision, epsilon is half of the distance between 1 and the next double
+#define GEOMETRY_PREDICATES_EPSILON (DBL_EPSILON / 2)
+#define GEOMETRY_PREDICATES_ERROR_BOUND ((3.0 + 16.0 * GEOMETRY_PREDICATES_EPSILON) * GEOMETRY_PREDICATES_EPSILON)
+// 2^27 + 1, splits double into two halves with 26 significant bits each
+#define GEOMETRY_PREDICATES_SPLITTER 134217729.0
+
+static atomic_ullong geometry_predicates_fallbacks = 0;
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static void geometry_predicates_twoSum(double a, double b, double* sum, double* error);
+static void geometry_predicates_fastTwoSum(double a, double b, double* sum, double* error);
+static void geometry_predicates_twoDiff(double a, double b, double* difference, double* error);
+static void geometry_predicates_twoProduct(double a, double b, double* product, double* error);
+static size_t geometry_predicates_scaleExpansion(const double* expansion, size_t length, double scale, double* result);
+static size_t geometry_predicates_sumExpansions(const double* first, size_t first_length, const double* second, size_t second_length, double* result);
+static size_t geometry_predicates_multiplyDifferences(double a, double b, double c, double d, double* result);
+static int geometry_predicates_exactSign(double a_x, double a_y, double b_x, double b_y, double c_x, double c_y, double d_x, double d_y, bool cross);
+static int geometry_predicates_adaptiveSign(double a_x, double a_y, double b_x, double b_y, double c_x, double c_y, double d_x, double d_y, bool cross);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+// Functions below are error-free transformations - result of an operation is
+// returned as rounded value and exact rounding error, sum of both is exact.
+// Expansions are arrays of such values ordered by increasing magnitude,
+// non-overlapping, so the sign of expansion is the sign of its last element.
+
+/**
+*   Function to calculate sum of two doubles with its rounding error
+*   In params:
+*       double a, b         summed values
+*
+*   Out params:
+*       double* sum         rounded sum
+*       double* error       rounding error, a + b = sum + error exactly
+*
+*   Return:
+*       none
+*/
+static void geometry_predicates_twoSum(double a, double b, double* sum, double* error){
+    double x = a + b;
+    double b_virtual = x - a;
+    double a_virtual = x - b_virtual;
+    double b_roundoff = b - b_virtual;
+    double a_roundoff = a - a_virtual;
+    *sum = x;
+    *error = a_roundoff + b_roundoff;
+}
+
+/**
+*   Function to calculate sum of two doubles with its rounding error, |a| >= |b| is required
+*   In params:
+*       double a, b         summed values
+*
+*   Out params:
+*       double* sum         rounded sum
+*       double* error       rounding error, a + b = sum + error exactly
+*
+*   Return:
+*       none
+*/
+static void geometry_predicates_fastTwoSum(double a, double b, double* sum, double* error){
+    double x = a + b;
+    double b_virtual = x - a;
+    *sum = x;
+    *error = b - b_virtual;
+}
+
+/**
+*   Function to calculate difference of two doubles with its rounding error
+*   In params:
+*       double a, b             values, b is subtracted from a
+*
+*   Out params:
+*       double* difference      rounded difference
+*       double* error           rounding error, a - b = difference + error exactly
+*
+*   Return:
+*       none
+*/
+static void geometry_predicates_twoDiff(double a, double b, double* difference, double* error){
+    double x = a - b;
+    double b_virtual = a - x;
+    double a_virtual = x + b_virtual;
+    double b_roundoff = b_virtual - b;
+    double a_roundoff = a - a_virtual;
+    *difference = x;
+    *error = a_roundoff + b_roundoff;
+}
+
+/**
+*   Function to calculate product of two doubles with its rounding error
+*   Fused multiply-add gives the error in one instruction where it is fast,
+*   elsewhere factors are split into halves which products are exact (Dekker)
+*   In params:
+*       double a, b         multiplied values
+*
+*   Out params:
+*       double* product     rounded product
+*       double* error       rounding error, a * b = product + error exactly
+*
+*   Return:
+*       none
+*/
+static void geometry_predicates_twoProduct(double a, double b, double* product, double* error){
+    double x = a * b;
+#ifdef FP_FAST_FMA
+    *error = fma(a, b, -x);
+#else
+    double a_split = GEOMETRY_PREDICATES_SPLITTER * a;
+    double a_high = a_split - (a_split - a);
+    double a_low = a - a_high;
+    double b_split = GEOMETRY_PREDICATES_SPLITTER * b;
+    double b_high = b_split - (b_split - b);
+    double b_low = b - b_high;
+    double error1 = x - a_high * b_high;
+    double error2 = error1 - a_low * b_high;
+    double error3 = error2 - a_high * b_low;
+    *error = a_low * b_low - error3;
+#endif
+    *product = x;
+}
+
+/**
+*   Function to multiply expansion by double, zero elements are dropped
+*   In params:
+*       const double* expansion     multiplied expansion
+*       size_t length               number of elements of expansion
+*       double scale                multiplier
+*
+*   Out params:
+*       double* result              product, at most 2 * length elements
+*
+*   Return:
+*       size_t                      number of elements of result
+*/
+static size_t geometry_predicates_scaleExpansion(const double* expansion, size_t length, double scale, double* result){
+    size_t result_length = 0;
+    double accumulated;
+    double error;
+    geometry_predicates_twoProduct(expansion[0], scale, &accumulated, &error);
+    if(error != 0){
+        result[result_length++] = error;
+    }
+    for(size_t i = 1; i < length; i++){
+        double product;
+        double product_error;
+        double sum;
+        geometry_predicates_twoProduct(expansion[i], scale, &product, &product_error);
+        geometry_predicates_twoSum(accumulated, product_error, &sum, &error);
+        if(error != 0){
+            result[result_length++] = error;
+        }
+        geometry_predicates_fastTwoSum(product, sum, &accumulated, &error);
+        if(error != 0){
+            result[result_length++] = error;
+        }
+    }
+    if(accumulated != 0 || result_length == 0){
+        result[result_length++] = accumulated;
+    }
+    return result_length;
+}
+
+/**
+*   Function to add two expansions, zero elements are dropped
+*   Elements of second expansion are added one by one, what is enough for short expansions
+*   In params:
+*       const double* first             first expansion
+*       size_t first_length             number of elements of first expansion
+*       const double* second            second expansion
+*       size_t second_length            number of elements of second expansion
+*
+*   Out params:
+*       double* result                  sum, at most first_length + second_length elements
+*
+*   Return:
+*       size_t                          number of elements of result
+*/
+static size_t geometry_predicates_sumExpansions(const double* first, size_t first_length, const double* second, size_t second_length, double* result){
+    size_t result_length = first_length;
+    for(size_t i = 0; i < first_length; i++){
+        result[i] = first[i];
+    }
+    for(size_t j = 0; j < second_length; j++){
+        double accumulated = second[j];
+        size_t grown_length = 0;
+        for(size_t i = 0; i < result_length; i++){
+            double error;
+            geometry_predicates_twoSum(accumulated, result[i], &accumulated, &error);
+            if(error != 0){
+                result[grown_length++] = error;
+            }
+        }
+        if(accumulated != 0 || grown_length == 0){
+            result[grown_length++] = accumulated;
+        }
+        result_length = grown_length;
+    }
+    return result_length;
+}
+
+/**
+*   Function to calculate exact product (a - b)(c - d)
+*   In params:
+*       double a, b, c, d       values
+*
+*   Out params:
+*       double* result          product as expansion, at most 8 elements
+*
+*   Return:
+*       size_t                  number of elements of result
+*/
+static size_t geometry_predicates_multiplyDifferences(double a, double b, double c, double d, double* result){
+    double first[2];
+    double second[2];
+    geometry_predicates_twoDiff(a, b, &first[1], &first[0]);
+    geometry_predicates_twoDiff(c, d, &second[1], &second[0]);
+    double high[4];
+    double low[4];
+    size_t high_length = geometry_predicates_scaleExpansion(second, 2, first[1], high);
+    size_t low_length = geometry_predicates_scaleExpansion(second, 2, first[0], low);
+    return geometry_predicates_sumExpansions(high, high_length, low, low_length, result);
+}
+
+/**
+*   Function to calculate exact sign of cross or dot product of vectors AB and CD
+*   In params:
+*       double a_x, ..., d_y        points A, B, C, D
+*       bool cross                  true for cross product, false for dot product
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                         sign of product
+*/
+static int geometry_predicates_exactSign(double a_x, double a_y, double b_x, double b_y, double c_x, double c_y, double d_x, double d_y, bool cross){
+    double left[8];
+    double right[8];
+    double determinant[16];
+    size_t left_length;
+    size_t right_length;
+    if(cross){
+        left_length = geometry_predicates_multiplyDifferences(b_x, a_x, d_y, c_y, left);
+        right_length = geometry_predicates_multiplyDifferences(b_y, a_y, d_x, c_x, right);
+        for(size_t i = 0; i < right_length; i++){
+            right[i] = -right[i];
+        }
+    }
+    else{
+        left_length = geometry_predicates_multiplyDifferences(b_x, a_x, d_x, c_x, left);
+        right_length = geometry_predicates_multiplyDifferences(b_y, a_y, d_y, c_y, right);
+    }
+    size_t length = geometry_predicates_sumExpansions(left, left_length, right, right_length, determinant);
+    double most_significant = determinant[length - 1];
+    return (most_significant > 0) - (most_significant < 0);
+}
+
+/**
+*   Function to calculate sign of cross or dot product of vectors AB and CD,
+*   exact calculation is done only if floating-point result is not certain
+*   In params:
+*       double a_x, ..., d_y        points A, B, C, D
+*       bool cross                  true for cross product, false for dot product
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                         sign of product
+*/
+static int geometry_predicates_adaptiveSign(double a_x, double a_y, double b_x, double b_y, double c_x, double c_y, double d_x, double d_y, bool cross){
+    double left;
+    double right;
+    if(cross){
+        left = (b_x - a_x) * (d_y - c_y);
+        right = -((b_y - a_y) * (d_x - c_x));
+    }
+    else{
+        left = (b_x - a_x) * (d_x - c_x);
+        right = (b_y - a_y) * (d_y - c_y);
+    }
+    double determinant = left + right;
+    double bound = GEOMETRY_PREDICATES_ERROR_BOUND * (fabs(left) + fabs(right));
+    if(determinant > bound){
+        return 1;
+    }
+    if(-determinant > bound){
+        return -1;
+    }
+    // difference of doubles is zero only if they are equal, so product is exactly zero
+    if(left == 0 && right == 0){
+        return 0;
+    }
+    atomic_fetch_add_explicit(&geometry_predicates_fallbacks, 1, memory_order_relaxed);
+    GEOMETRY_STATS_EVENT(GEOMETRY_STATS_PREDICATE_FALLBACK);
+    return geometry_predicates_exactSign(a_x, a_y, b_x, b_y, c_x, c_y, d_x, d_y, cross);
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to determine on which side of line going through first and second point
+*   lies third point, the result is always exact
+*   In params:
+*       double first_x, first_y         first point of line
+*       double second_x, second_y       second point of line
+*       double third_x, third_y         examined point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                             1 if third point lies on the left (points are counterclockwise),
+*                                       -1 if on the right, 0 if points are colinear
+*/
+int geometry_predicates_orientation(double first_x, double first_y, double second_x, double second_y, double third_x, double third_y){
+    return geometry_predicates_adaptiveSign(first_x, first_y, second_x, second_y, first_x, first_y, third_x, third_y, true);
+}
+
+/**
+*   Function to calculate exact sign of cross product of vectors AB and CD
+*   In params:
+*       double a_x, a_y         start of first vector
+*       double b_x, b_y         end of first vector
+*       double c_x, c_y         start of second vector
+*       double d_x, d_y         end of second vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                     1 if CD turns left from AB, -1 if right, 0 if vectors are parallel
+*/
+int geometry_predicates_crossSign(double a_x, double a_y, double b_x, double b_y, double c_x, double c_y, double d_x, double d_y){
+    return geometry_predicates_adaptiveSign(a_x, a_y, b_x, b_y, c_x, c_y, d_x, d_y, true);
+}
+
+/**
+*   Function to calculate exact sign of dot product of vectors AB and CD
+*   In params:
+*       double a_x, a_y         start of first vector
+*       double b_x, b_y         end of first vector
+*       double c_x, c_y         start of second vector
+*       double d_x, d_y         end of second vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                     1 if angle between vectors is acute, -1 if obtuse,
+*                               0 if vectors are perpendicular
+*/
+int geometry_predicates_dotSign(double a_x, double a_y, double b_x, double b_y, double c_x, double c_y, double d_x, double d_y){
+    return geometry_predicates_adaptiveSign(a_x, a_y, b_x, b_y, c_x, c_y, d_x, d_y, false);
+}
+
+/**
+*   Function to get number of times exact calculation was needed since start
+*   (or last reset), counted for all threads
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       unsigned long long      number of exact calculations
+*/
+unsigned long long geometry_predicates_getFallbackCount(void){
+    return atomic_load_explicit(&geometry_predicates_fallbacks, memory_order_relaxed);
+}
+
+/**
+*   Function to set counter of exact calculations to 0
+*   In params:
+*       none
+*
+*   Out params/return:
+*       none
+*/
+void geometry_predicates_resetFallbackCount(void){
+    atomic_store_explicit(&geometry_predicates_fallbacks, 0, memory_order_relaxed);
+}
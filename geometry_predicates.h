@@ -0,0 +1,89 @@
+#ifndef GEOMETRY_PREDICATES
+#define GEOMETRY_PREDICATES
+
+// Adaptive precision geometric predicates (after J. R. Shewchuk).
+// Sign of every determinant is first calculated in plain floating-point
+// arithmetic and accepted if it is larger than forward error bound of that
+// calculation. Only if it isn't, the determinant is calculated again exactly
+// with floating-point expansions - which is rare on real data, so results
+// are always correct at almost the cost of naive formulas.
+
+/*#####################################################
+ GEOMETRY_PREDICATES functions declarations
+######################################################*/
+
+/**
+*   Function to determine on which side of line going through first and second point
+*   lies third point, the result is always exact
+*   In params:
+*       double first_x, first_y         first point of line
+*       double second_x, second_y       second point of line
+*       double third_x, third_y         examined point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                             1 if third point lies on the left (points are counterclockwise),
+*                                       -1 if on the right, 0 if points are colinear
+*/
+int geometry_predicates_orientation(double first_x, double first_y, double second_x, double second_y, double third_x, double third_y);
+
+/**
+*   Function to calculate exact sign of cross product of vectors AB and CD
+*   In params:
+*       double a_x, a_y         start of first vector
+*       double b_x, b_y         end of first vector
+*       double c_x, c_y         start of second vector
+*       double d_x, d_y         end of second vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                     1 if CD turns left from AB, -1 if right, 0 if vectors are parallel
+*/
+int geometry_predicates_crossSign(double a_x, double a_y, double b_x, double b_y, double c_x, double c_y, double d_x, double d_y);
+
+/**
+*   Function to calculate exact sign of dot product of vectors AB and CD
+*   In params:
+*       double a_x, a_y         start of first vector
+*       double b_x, b_y         end of first vector
+*       double c_x, c_y         start of second vector
+*       double d_x, d_y         end of second vector
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                     1 if angle between vectors is acute, -1 if obtuse,
+*                               0 if vectors are perpendicular
+*/
+int geometry_predicates_dotSign(double a_x, double a_y, double b_x, double b_y, double c_x, double c_y, double d_x, double d_y);
+
+/**
+*   Function to get number of times exact calculation was needed since start
+*   (or last reset), counted for all threads
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       unsigned long long      number of exact calculations
+*/
+unsigned long long geometry_predicates_getFallbackCount(void);
+
+/**
+*   Function to set counter of exact calculations to 0
+*   In params:
+*       none
+*
+*   Out params/return:
+*       none
+*/
+void geometry_predicates_resetFallbackCount(void);
+
+#endif
@@ -0,0 +1,503 @@
+#include "geometry_rtree.h"
+#include "geometry_stats.h"
+#include "geometry_predicates.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#define GEOMETRY_RTREE_NONE ((size_t)-1)
+// number of children of every node (except the last ones on each level)
+#define GEOMETRY_RTREE_NODE_SIZE 8
+// depth of tree is at most 22 for 8 children in node, so at most 7 * 22 + 1 nodes wait on stack
+#define GEOMETRY_RTREE_STACK_SIZE 256
+
+typedef struct geometry_rtree_segment {
+    geometry_real start_x;
+    geometry_real start_y;
+    geometry_real end_x;
+    geometry_real end_y;
+    // index of segment in array given on creation
+    size_t index;
+} geometry_rtree_segment;
+
+// Node of tree - leaf points to range of segments, inner node to range of nodes
+typedef struct geometry_rtree_node {
+    geometry_real min_x;
+    geometry_real min_y;
+    geometry_real max_x;
+    geometry_real max_y;
+    size_t first;
+    size_t count;
+    bool leaf;
+} geometry_rtree_node;
+
+struct geometry_rtree {
+    geometry_rtree_segment* segments;
+    size_t segment_count;
+    geometry_rtree_node* nodes;
+    size_t node_count;
+    size_t root;
+    geometry_allocator allocator;
+};
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static int geometry_rtree_compareSegmentsX(const void* first, const void* second);
+static int geometry_rtree_compareSegmentsY(const void* first, const void* second);
+static int geometry_rtree_compareNodesX(const void* first, const void* second);
+static int geometry_rtree_compareNodesY(const void* first, const void* second);
+static void geometry_rtree_sortTiles(void* items, size_t count, size_t size, int (*compare_x)(const void*, const void*), int (*compare_y)(const void*, const void*));
+static bool geometry_rtree_matches(geometry_rtree_segment* segment, geometry_real x, geometry_real y, geometry_real tolerance);
+static size_t geometry_rtree_search(geometry_rtree* rtree, geometry_real x, geometry_real y, geometry_real tolerance, size_t point, size_t* segments, geometry_rtree_match* matches, size_t capacity, size_t found);
+static bool geometry_rtree_build(geometry_rtree* rtree);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Functions to compare segments and nodes by x or y coordinate of their centers, used by qsort
+*   In params:
+*       const void* first       first element
+*       const void* second      second element
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                     negative, zero or positive as first center is smaller, equal or bigger
+*/
+static int geometry_rtree_compareSegmentsX(const void* first, const void* second){
+    const geometry_rtree_segment* first_segment = first;
+    const geometry_rtree_segment* second_segment = second;
+    geometry_real first_center = first_segment->start_x + first_segment->end_x;
+    geometry_real second_center = second_segment->start_x + second_segment->end_x;
+    return (first_center > second_center) - (first_center < second_center);
+}
+
+static int geometry_rtree_compareSegmentsY(const void* first, const void* second){
+    const geometry_rtree_segment* first_segment = first;
+    const geometry_rtree_segment* second_segment = second;
+    geometry_real first_center = first_segment->start_y + first_segment->end_y;
+    geometry_real second_center = second_segment->start_y + second_segment->end_y;
+    return (first_center > second_center) - (first_center < second_center);
+}
+
+static int geometry_rtree_compareNodesX(const void* first, const void* second){
+    const geometry_rtree_node* first_node = first;
+    const geometry_rtree_node* second_node = second;
+    geometry_real first_center = first_node->min_x + first_node->max_x;
+    geometry_real second_center = second_node->min_x + second_node->max_x;
+    return (first_center > second_center) - (first_center < second_center);
+}
+
+static int geometry_rtree_compareNodesY(const void* first, const void* second){
+    const geometry_rtree_node* first_node = first;
+    const geometry_rtree_node* second_node = second;
+    geometry_real first_center = first_node->min_y + first_node->max_y;
+    geometry_real second_center = second_node->min_y + second_node->max_y;
+    return (first_center > second_center) - (first_center < second_center);
+}
+
+/**
+*   Function to order elements for Sort-Tile-Recursive packing
+*   Elements are sorted by x and cut into about sqrt(count / node size) slices,
+*   then each slice is sorted by y, so consecutive groups of node size elements lie close
+*   In params:
+*       void* items                             array of elements
+*       size_t count                            number of elements
+*       size_t size                             size of single element
+*       int (*compare_x)(const void*, const void*)      comparison by x coordinate
+*       int (*compare_y)(const void*, const void*)      comparison by y coordinate
+*
+*   Out params/return:
+*       none (items are reordered)
+*/
+static void geometry_rtree_sortTiles(void* items, size_t count, size_t size, int (*compare_x)(const void*, const void*), int (*compare_y)(const void*, const void*)){
+    size_t node_count = (count + GEOMETRY_RTREE_NODE_SIZE - 1) / GEOMETRY_RTREE_NODE_SIZE;
+    size_t slice_count = (size_t)ceil(sqrt((double)node_count));
+    size_t slice_size = slice_count * GEOMETRY_RTREE_NODE_SIZE;
+    qsort(items, count, size, compare_x);
+    for(size_t start = 0; start < count; start += slice_size){
+        size_t length = count - start < slice_size ? count - start : slice_size;
+        qsort((char*)items + start * size, length, size, compare_y);
+    }
+}
+
+/**
+*   Function to check if point lies on segment or within tolerance of it
+*   In params:
+*       geometry_rtree_segment* segment     segment
+*       geometry_real x, y                  point
+*       geometry_real tolerance             maximal distance
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if point matches segment
+*/
+static bool geometry_rtree_matches(geometry_rtree_segment* segment, geometry_real x, geometry_real y, geometry_real tolerance){
+    geometry_real side_x = segment->end_x - segment->start_x;
+    geometry_real side_y = segment->end_y - segment->start_y;
+    geometry_real offset_x = x - segment->start_x;
+    geometry_real offset_y = y - segment->start_y;
+    if(tolerance == 0){
+        // nodes were already checked against point, but segment's own box wasn't
+        return x >= GEOMETRY_FMIN(segment->start_x, segment->end_x) && x <= GEOMETRY_FMAX(segment->start_x, segment->end_x)
+            && y >= GEOMETRY_FMIN(segment->start_y, segment->end_y) && y <= GEOMETRY_FMAX(segment->start_y, segment->end_y)
+            && geometry_predicates_orientation(segment->start_x, segment->start_y, segment->end_x, segment->end_y, x, y) == 0;
+    }
+    // distance to the closest point of segment
+    geometry_real length = side_x * side_x + side_y * side_y;
+    geometry_real t = length > 0 ? (offset_x * side_x + offset_y * side_y) / length : 0;
+    t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    geometry_real distance_x = offset_x - t * side_x;
+    geometry_real distance_y = offset_y - t * side_y;
+    return distance_x * distance_x + distance_y * distance_y <= tolerance * tolerance;
+}
+
+/**
+*   Function to find segments matching given point, shared by single and batched queries
+*   In params:
+*       geometry_rtree* rtree               tree
+*       geometry_real x, y                  point
+*       geometry_real tolerance             maximal distance between point and segment
+*       size_t point                        index of point written to matches
+*       size_t capacity                     number of elements in segments or matches array
+*       size_t found                        number of results found so far
+*
+*   Out params:
+*       size_t* segments                    indices of found segments if not NULL
+*       geometry_rtree_match* matches       found pairs of point and segment if not NULL,
+*                                           results are written from position found and below capacity
+*
+*   Return:
+*       size_t                              found increased by number of segments matching point
+*/
+static size_t geometry_rtree_search(geometry_rtree* rtree, geometry_real x, geometry_real y, geometry_real tolerance, size_t point, size_t* segments, geometry_rtree_match* matches, size_t capacity, size_t found){
+    size_t stack[GEOMETRY_RTREE_STACK_SIZE];
+    size_t stack_size = 0;
+    if(rtree->root != GEOMETRY_RTREE_NONE){
+        stack[stack_size++] = rtree->root;
+    }
+    while(stack_size > 0){
+        geometry_rtree_node* node = &rtree->nodes[stack[--stack_size]];
+        if(x + tolerance < node->min_x || x - tolerance > node->max_x || y + tolerance < node->min_y || y - tolerance > node->max_y){
+            continue;
+        }
+        if(node->leaf){
+            for(size_t i = node->first; i < node->first + node->count; i++){
+                if(!geometry_rtree_matches(&rtree->segments[i], x, y, tolerance)){
+                    continue;
+                }
+                if(found < capacity && segments != NULL){
+                    segments[found] = rtree->segments[i].index;
+                }
+                if(found < capacity && matches != NULL){
+                    matches[found].point = point;
+                    matches[found].segment = rtree->segments[i].index;
+                }
+                found++;
+            }
+            continue;
+        }
+        for(size_t i = node->first; i < node->first + node->count; i++){
+            stack[stack_size++] = i;
+        }
+    }
+    return found;
+}
+
+/**
+*   Function to pack segments into nodes, level by level up to the root
+*   In params:
+*       geometry_rtree* rtree       tree with segments set
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true on success, false if memory couldn't be reserved
+*/
+static bool geometry_rtree_build(geometry_rtree* rtree){
+    size_t count = rtree->segment_count;
+    rtree->root = GEOMETRY_RTREE_NONE;
+    rtree->node_count = 0;
+    rtree->nodes = NULL;
+    if(count == 0){
+        return true;
+    }
+    size_t total = 0;
+    for(size_t level_count = count; level_count > 1 || total == 0; ){
+        level_count = (level_count + GEOMETRY_RTREE_NODE_SIZE - 1) / GEOMETRY_RTREE_NODE_SIZE;
+        total += level_count;
+    }
+    size_t leaf_count = (count + GEOMETRY_RTREE_NODE_SIZE - 1) / GEOMETRY_RTREE_NODE_SIZE;
+    if(total > SIZE_MAX / sizeof(*rtree->nodes)){
+        return false;
+    }
+    rtree->nodes = geometry_allocator_allocate(&rtree->allocator, total * sizeof(*rtree->nodes));
+    geometry_rtree_node* level = geometry_allocator_allocate(&rtree->allocator, leaf_count * sizeof(*level));
+    if(rtree->nodes == NULL || level == NULL){
+        geometry_allocator_free(&rtree->allocator, level);
+        return false;
+    }
+    geometry_rtree_sortTiles(rtree->segments, count, sizeof(*rtree->segments), geometry_rtree_compareSegmentsX, geometry_rtree_compareSegmentsY);
+    for(size_t i = 0; i < leaf_count; i++){
+        geometry_rtree_node* node = &level[i];
+        node->first = i * GEOMETRY_RTREE_NODE_SIZE;
+        node->count = count - node->first < GEOMETRY_RTREE_NODE_SIZE ? count - node->first : GEOMETRY_RTREE_NODE_SIZE;
+        node->leaf = true;
+        node->min_x = INFINITY;
+        node->min_y = INFINITY;
+        node->max_x = -INFINITY;
+        node->max_y = -INFINITY;
+        for(size_t j = node->first; j < node->first + node->count; j++){
+            geometry_rtree_segment* segment = &rtree->segments[j];
+            node->min_x = GEOMETRY_FMIN(node->min_x, GEOMETRY_FMIN(segment->start_x, segment->end_x));
+            node->min_y = GEOMETRY_FMIN(node->min_y, GEOMETRY_FMIN(segment->start_y, segment->end_y));
+            node->max_x = GEOMETRY_FMAX(node->max_x, GEOMETRY_FMAX(segment->start_x, segment->end_x));
+            node->max_y = GEOMETRY_FMAX(node->max_y, GEOMETRY_FMAX(segment->start_y, segment->end_y));
+        }
+    }
+    size_t level_count = leaf_count;
+    while(true){
+        // nodes of level are ordered and placed in tree, then grouped into parents
+        geometry_rtree_sortTiles(level, level_count, sizeof(*level), geometry_rtree_compareNodesX, geometry_rtree_compareNodesY);
+        size_t base = rtree->node_count;
+        for(size_t i = 0; i < level_count; i++){
+            rtree->nodes[base + i] = level[i];
+        }
+        rtree->node_count += level_count;
+        if(level_count == 1){
+            rtree->root = base;
+            break;
+        }
+        size_t parent_count = (level_count + GEOMETRY_RTREE_NODE_SIZE - 1) / GEOMETRY_RTREE_NODE_SIZE;
+        for(size_t i = 0; i < parent_count; i++){
+            geometry_rtree_node parent;
+            size_t first = i * GEOMETRY_RTREE_NODE_SIZE;
+            parent.first = base + first;
+            parent.count = level_count - first < GEOMETRY_RTREE_NODE_SIZE ? level_count - first : GEOMETRY_RTREE_NODE_SIZE;
+            parent.leaf = false;
+            parent.min_x = INFINITY;
+            parent.min_y = INFINITY;
+            parent.max_x = -INFINITY;
+            parent.max_y = -INFINITY;
+            for(size_t j = parent.first; j < parent.first + parent.count; j++){
+                geometry_rtree_node* child = &rtree->nodes[j];
+                parent.min_x = GEOMETRY_FMIN(parent.min_x, child->min_x);
+                parent.min_y = GEOMETRY_FMIN(parent.min_y, child->min_y);
+                parent.max_x = GEOMETRY_FMAX(parent.max_x, child->max_x);
+                parent.max_y = GEOMETRY_FMAX(parent.max_y, child->max_y);
+            }
+            level[i] = parent;
+        }
+        level_count = parent_count;
+    }
+    geometry_allocator_free(&rtree->allocator, level);
+    return true;
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new geometry_rtree object over given segments
+*   In params:
+*       geometry_segment** segments     array of segments
+*       size_t count                    number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rtree*                 pointer to created object, NULL if error occured
+*/
+geometry_rtree* geometry_rtree_new(geometry_segment** segments, size_t count){
+    return geometry_rtree_new_with(NULL, segments, count);
+}
+
+/**
+*   Function to create new geometry_rtree object over given segments with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_segment** segments             array of segments
+*       size_t count                            number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rtree*                 pointer to created object, NULL if error occured
+*/
+geometry_rtree* geometry_rtree_new_with(const geometry_allocator* allocator, geometry_segment** segments, size_t count){
+    if(segments == NULL && count > 0){
+        return NULL;
+    }
+    if(count > SIZE_MAX / 4 / sizeof(geometry_real)){
+        return NULL;
+    }
+    geometry_real* coordinates = geometry_allocator_allocate(allocator, 4 * count * sizeof(*coordinates) + 1);
+    if(coordinates == NULL){
+        return NULL;
+    }
+    for(size_t i = 0; i < count; i++){
+        geometry_point* start = NULL;
+        geometry_point* end = NULL;
+        if(segments[i] == NULL){
+            geometry_allocator_free(allocator, coordinates);
+            return NULL;
+        }
+        geometry_segment_getPoints(segments[i], &start, &end);
+        coordinates[4 * i] = geometry_point_getX(start);
+        coordinates[4 * i + 1] = geometry_point_getY(start);
+        coordinates[4 * i + 2] = geometry_point_getX(end);
+        coordinates[4 * i + 3] = geometry_point_getY(end);
+    }
+    geometry_rtree* new_rtree = geometry_rtree_newFlat_with(allocator, coordinates, count);
+    geometry_allocator_free(allocator, coordinates);
+    return new_rtree;
+}
+
+/**
+*   Function to create new geometry_rtree object over segments given as flat array of coordinates
+*   In params:
+*       const geometry_real* coordinates    array of 4 * count coordinates,
+*                                           start x, start y, end x, end y of each segment
+*       size_t count                        number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rtree*                     pointer to created object, NULL if error occured
+*/
+geometry_rtree* geometry_rtree_newFlat(const geometry_real* coordinates, size_t count){
+    return geometry_rtree_newFlat_with(NULL, coordinates, count);
+}
+
+/**
+*   Function to create new geometry_rtree object over segments given as flat array of coordinates with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       const geometry_real* coordinates        array of 4 * count coordinates,
+*                                               start x, start y, end x, end y of each segment
+*       size_t count                            number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rtree*                 pointer to created object, NULL if error occured
+*/
+geometry_rtree* geometry_rtree_newFlat_with(const geometry_allocator* allocator, const geometry_real* coordinates, size_t count){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_RTREE_NEW);
+    if(coordinates == NULL && count > 0){
+        return NULL;
+    }
+    if(count > SIZE_MAX / sizeof(geometry_rtree_segment)){
+        return NULL;
+    }
+    geometry_rtree* new_rtree = geometry_allocator_allocate(allocator, sizeof(*new_rtree));
+    geometry_rtree_segment* segments = geometry_allocator_allocate(allocator, count * sizeof(*segments) + 1);
+    if(new_rtree == NULL || segments == NULL){
+        geometry_allocator_free(allocator, new_rtree);
+        geometry_allocator_free(allocator, segments);
+        return NULL;
+    }
+    for(size_t i = 0; i < count; i++){
+        segments[i].start_x = coordinates[4 * i];
+        segments[i].start_y = coordinates[4 * i + 1];
+        segments[i].end_x = coordinates[4 * i + 2];
+        segments[i].end_y = coordinates[4 * i + 3];
+        segments[i].index = i;
+    }
+    new_rtree->segments = segments;
+    new_rtree->segment_count = count;
+    new_rtree->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    if(!geometry_rtree_build(new_rtree)){
+        geometry_rtree_destroy(new_rtree);
+        return NULL;
+    }
+    return new_rtree;
+}
+
+/**
+*   Function to destroy given geometry_rtree object
+*   In params:
+*       geometry_rtree* rtree       tree object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_rtree_destroy(geometry_rtree* rtree){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_RTREE_DESTROY);
+    if(rtree == NULL){
+        return;
+    }
+    geometry_allocator allocator = rtree->allocator;
+    geometry_allocator_free(&allocator, rtree->segments);
+    geometry_allocator_free(&allocator, rtree->nodes);
+    geometry_allocator_free(&allocator, rtree);
+}
+
+/**
+*   Function to find segments on which given point lies
+*   With tolerance 0 only segments going exactly through point are found,
+*   otherwise segments not further from point than tolerance
+*   In params:
+*       geometry_rtree* rtree       tree
+*       geometry_real x             x coordinate of point
+*       geometry_real y             y coordinate of point
+*       geometry_real tolerance     maximal distance between point and segment
+*       size_t capacity             number of elements in segments array
+*
+*   Out params:
+*       size_t* segments            indices of found segments, at most capacity elements are written
+*
+*   Return:
+*       size_t                      number of all found segments (may be larger than capacity),
+*                                   (size_t)-1 if error occured
+*/
+size_t geometry_rtree_queryPoint(geometry_rtree* rtree, geometry_real x, geometry_real y, geometry_real tolerance, size_t* segments, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_RTREE_QUERY_POINT);
+    if(rtree == NULL || !(tolerance >= 0) || (segments == NULL && capacity > 0)){
+        return GEOMETRY_RTREE_NONE;
+    }
+    return geometry_rtree_search(rtree, x, y, tolerance, 0, segments, NULL, capacity, 0);
+}
+
+/**
+*   Function to find segments on which given points lie
+*   Works as geometry_rtree_queryPoint called for every point, but results
+*   for all points are written to one array. Coordinates may come straight from
+*   geometry_point_buffer_getCoordinates. No memory is allocated.
+*   In params:
+*       geometry_rtree* rtree           tree
+*       const geometry_real* xs         x coordinates of points
+*       const geometry_real* ys         y coordinates of points
+*       size_t count                    number of points
+*       geometry_real tolerance         maximal distance between point and segment
+*       size_t capacity                 number of elements in matches array
+*
+*   Out params:
+*       geometry_rtree_match* matches   found pairs of point and segment, grouped by points in
+*                                       increasing order, at most capacity elements are written
+*
+*   Return:
+*       size_t                          number of all found pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_rtree_queryPoints(geometry_rtree* rtree, const geometry_real* xs, const geometry_real* ys, size_t count, geometry_real tolerance, geometry_rtree_match* matches, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_RTREE_QUERY_POINTS);
+    if(rtree == NULL || !(tolerance >= 0) || ((xs == NULL || ys == NULL) && count > 0) || (matches == NULL && capacity > 0)){
+        return GEOMETRY_RTREE_NONE;
+    }
+    size_t found = 0;
+    for(size_t point = 0; point < count; point++){
+        found = geometry_rtree_search(rtree, xs[point], ys[point], tolerance, point, NULL, matches, capacity, found);
+    }
+    return found;
+}
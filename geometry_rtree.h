@@ -0,0 +1,140 @@
+#ifndef GEOMETRY_RTREE
+#define GEOMETRY_RTREE
+
+#include "geometry.h"
+#include <stddef.h>
+
+// Static R-tree over a fixed set of segments, bulk loaded with
+// Sort-Tile-Recursive packing - segments are sorted into vertical slices
+// by x, every slice by y, and neighbours are grouped into full nodes.
+// Nodes are kept in one array, children of every node lie next to each other.
+// Segments are copied, so tree doesn't depend on given objects after creation.
+typedef struct geometry_rtree geometry_rtree;
+
+// Single result of batch point query - index of point and index of segment
+// (in arrays given on creation and on query) such that point lies on segment
+typedef struct geometry_rtree_match {
+    size_t point;
+    size_t segment;
+} geometry_rtree_match;
+
+/*################################################
+ GEOMETRY_RTREE functions (methods) declarations
+#################################################*/
+
+/**
+*   Function to create new geometry_rtree object over given segments
+*   In params:
+*       geometry_segment** segments     array of segments
+*       size_t count                    number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rtree*                 pointer to created object, NULL if error occured
+*/
+geometry_rtree* geometry_rtree_new(geometry_segment** segments, size_t count);
+
+/**
+*   Function to create new geometry_rtree object over given segments with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       geometry_segment** segments             array of segments
+*       size_t count                            number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rtree*                 pointer to created object, NULL if error occured
+*/
+geometry_rtree* geometry_rtree_new_with(const geometry_allocator* allocator, geometry_segment** segments, size_t count);
+
+/**
+*   Function to create new geometry_rtree object over segments given as flat array of coordinates
+*   In params:
+*       const geometry_real* coordinates    array of 4 * count coordinates,
+*                                           start x, start y, end x, end y of each segment
+*       size_t count                        number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rtree*                     pointer to created object, NULL if error occured
+*/
+geometry_rtree* geometry_rtree_newFlat(const geometry_real* coordinates, size_t count);
+
+/**
+*   Function to create new geometry_rtree object over segments given as flat array of coordinates with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       const geometry_real* coordinates        array of 4 * count coordinates,
+*                                               start x, start y, end x, end y of each segment
+*       size_t count                            number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_rtree*                 pointer to created object, NULL if error occured
+*/
+geometry_rtree* geometry_rtree_newFlat_with(const geometry_allocator* allocator, const geometry_real* coordinates, size_t count);
+
+/**
+*   Function to destroy given geometry_rtree object
+*   In params:
+*       geometry_rtree* rtree       tree object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_rtree_destroy(geometry_rtree* rtree);
+
+/**
+*   Function to find segments on which given point lies
+*   With tolerance 0 only segments going exactly through point are found,
+*   otherwise segments not further from point than tolerance
+*   In params:
+*       geometry_rtree* rtree       tree
+*       geometry_real x             x coordinate of point
+*       geometry_real y             y coordinate of point
+*       geometry_real tolerance     maximal distance between point and segment
+*       size_t capacity             number of elements in segments array
+*
+*   Out params:
+*       size_t* segments            indices of found segments, at most capacity elements are written
+*
+*   Return:
+*       size_t                      number of all found segments (may be larger than capacity),
+*                                   (size_t)-1 if error occured
+*/
+size_t geometry_rtree_queryPoint(geometry_rtree* rtree, geometry_real x, geometry_real y, geometry_real tolerance, size_t* segments, size_t capacity);
+
+/**
+*   Function to find segments on which given points lie
+*   Works as geometry_rtree_queryPoint called for every point, but results
+*   for all points are written to one array. Coordinates may come straight from
+*   geometry_point_buffer_getCoordinates. No memory is allocated.
+*   In params:
+*       geometry_rtree* rtree           tree
+*       const geometry_real* xs         x coordinates of points
+*       const geometry_real* ys         y coordinates of points
+*       size_t count                    number of points
+*       geometry_real tolerance         maximal distance between point and segment
+*       size_t capacity                 number of elements in matches array
+*
+*   Out params:
+*       geometry_rtree_match* matches   found pairs of point and segment, grouped by points in
+*                                       increasing order, at most capacity elements are written
+*
+*   Return:
+*       size_t                          number of all found pairs (may be larger than capacity),
+*                                       (size_t)-1 if error occured
+*/
+size_t geometry_rtree_queryPoints(geometry_rtree* rtree, const geometry_real* xs, const geometry_real* ys, size_t count, geometry_real tolerance, geometry_rtree_match* matches, size_t capacity);
+
+#endif
@@ -0,0 +1,397 @@
+// clock_gettime is POSIX
+#define _POSIX_C_SOURCE 199309L
+#include "geometry_stats.h"
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static const char* const geometry_stats_function_names[GEOMETRY_STATS_FUNCTION_COUNT] = {
+    "geometry_arena_new",
+    "geometry_arena_destroy",
+    "geometry_arena_reset",
+    "geometry_arena_allocate",
+    "geometry_rotation_new",
+    "geometry_rotation_destroy",
+    "geometry_transform_new",
+    "geometry_transform_destroy",
+    "geometry_transform_moveByVector",
+    "geometry_transform_rotateByAngle",
+    "geometry_transform_compose",
+    "geometry_transform_invert",
+    "geometry_point_new",
+    "geometry_point_new_in",
+    "geometry_point_destroy",
+    "geometry_point_moveByVector",
+    "geometry_point_rotateByAngle",
+    "geometry_point_rotateBy",
+    "geometry_point_applyTransform",
+    "geometry_point_calculateDistance",
+    "geometry_point_liesOnSegment",
+    "geometry_segment_new",
+    "geometry_segment_new_in",
+    "geometry_segment_destroy",
+    "geometry_segment_moveByVector",
+    "geometry_segment_rotateByAngle",
+    "geometry_segment_rotateBy",
+    "geometry_segment_applyTransform",
+    "geometry_segment_calculateLength",
+    "geometry_segment_areParallel",
+    "geometry_segment_arePerpendicular",
+    "geometry_segment_calculateIntersection",
+    "geometry_triangle_new",
+    "geometry_triangle_new_in",
+    "geometry_triangle_newFromCoordinates",
+    "geometry_triangle_destroy",
+    "geometry_triangle_getBoundingBox",
+    "geometry_triangle_getCentroid",
+    "geometry_triangle_getRightAngleVertex",
+    "geometry_triangle_fillCache",
+    "geometry_triangle_moveByVector",
+    "geometry_triangle_rotateByAngle",
+    "geometry_triangle_rotateBy",
+    "geometry_triangle_applyTransform",
+    "geometry_triangle_calculatePerimeter",
+    "geometry_triangle_calculateArea",
+    "geometry_triangle_areDisjoint",
+    "geometry_triangle_areDisjointBatch",
+    "geometry_triangle_areDisjointMatrix",
+    "geometry_triangle_calculateHypotenuse",
+    "geometry_point_buffer_new",
+    "geometry_point_buffer_destroy",
+    "geometry_point_buffer_reserve",
+    "geometry_point_buffer_push",
+    "geometry_point_buffer_moveByVector",
+    "geometry_point_buffer_rotateByAngle",
+    "geometry_point_buffer_applyTransform",
+    "geometry_point_buffer_calculateDistances",
+    "geometry_point_buffer_calculateDistanceMatrix",
+    "geometry_point_buffer_calculateSquaredDistanceMatrix",
+    "geometry_point_buffer_streamDistanceMatrix",
+    "geometry_segment_calculateIntersections",
+    "geometry_grid_new",
+    "geometry_grid_destroy",
+    "geometry_grid_insert",
+    "geometry_grid_remove",
+    "geometry_grid_update",
+    "geometry_grid_moveByVector",
+    "geometry_grid_calculateCandidatePairs",
+    "geometry_grid_calculateIntersectingPairs",
+    "geometry_grid_calculateIntersectingPairsParallel",
+    "geometry_bvh_new",
+    "geometry_bvh_destroy",
+    "geometry_bvh_insert",
+    "geometry_bvh_remove",
+    "geometry_bvh_update",
+    "geometry_bvh_refit",
+    "geometry_bvh_moveByVector",
+    "geometry_bvh_rotateByAngle",
+    "geometry_bvh_queryTriangle",
+    "geometry_bvh_queryPoint",
+    "geometry_bvh_castRay",
+    "geometry_bvh_calculateIntersectingPairs",
+    "geometry_rtree_new",
+    "geometry_rtree_destroy",
+    "geometry_rtree_queryPoint",
+    "geometry_rtree_queryPoints",
+    "geometry_kdtree_new",
+    "geometry_kdtree_destroy",
+    "geometry_kdtree_findNearest",
+    "geometry_kdtree_findInRadius",
+    "geometry_kdtree_findNearestBatch",
+    "geometry_kdtree_findInRadiusBatch",
+    "geometry_pool_new",
+    "geometry_pool_destroy",
+    "geometry_pool_run",
+    "geometry_pool_runStealing",
+    "geometry_triangle_calculateAreaBatch",
+    "geometry_triangle_calculatePerimeterBatch",
+    "geometry_triangle_calculateHypotenuseBatch",
+    "geometry_triangle_calculateIntersectingPairs",
+    "geometry_triangle_buffer_new",
+    "geometry_triangle_buffer_load",
+    "geometry_triangle_buffer_destroy",
+    "geometry_triangle_buffer_save",
+    "geometry_triangle_buffer_getTriangle",
+    "geometry_triangle_buffer_calculateAreas",
+    "geometry_triangle_buffer_calculatePerimeters",
+    "geometry_text_reader_new",
+    "geometry_text_reader_destroy",
+    "geometry_text_reader_read",
+    "geometry_text_writer_new",
+    "geometry_text_writer_destroy",
+    "geometry_text_writer_flush",
+    "geometry_text_writer_writePoints",
+    "geometry_text_writer_writeSegments",
+    "geometry_text_writer_writeTriangles",
+    "geometry_int_point_new",
+    "geometry_int_point_new_in",
+    "geometry_int_point_destroy",
+    "geometry_int_point_moveByVector",
+    "geometry_int_point_liesOnSegment",
+    "geometry_int_segment_new",
+    "geometry_int_segment_new_in",
+    "geometry_int_segment_destroy",
+    "geometry_int_segment_moveByVector",
+    "geometry_int_segment_calculateLength",
+    "geometry_int_segment_areParallel",
+    "geometry_int_segment_arePerpendicular",
+    "geometry_int_segment_areIntersecting",
+    "geometry_int_segment_calculateIntersection",
+    "geometry_int_triangle_new",
+    "geometry_int_triangle_new_in",
+    "geometry_int_triangle_destroy",
+    "geometry_int_triangle_isRight",
+    "geometry_int_triangle_moveByVector",
+    "geometry_int_triangle_calculateArea",
+    "geometry_int_triangle_calculatePerimeter",
+    "geometry_int_triangle_calculateHypotenuse",
+    "geometry_int_triangle_areDisjoint",
+    "geometry_mesh_new",
+    "geometry_mesh_destroy",
+    "geometry_mesh_addVertex",
+    "geometry_mesh_addTriangleByIndices",
+    "geometry_mesh_getTriangle",
+    "geometry_mesh_moveByVector",
+    "geometry_mesh_rotateByAngle",
+    "geometry_mesh_applyTransform",
+    "geometry_mesh_calculateAreas",
+    "geometry_mesh_calculatePerimeters",
+    "geometry_mesh_calculateArea",
+};
+
+static const char* const geometry_stats_event_names[GEOMETRY_STATS_EVENT_COUNT] = {
+    "triangle_shape_update",
+    "triangle_bounds_update",
+    "triangle_axes_update",
+    "predicate_fallback",
+    "grid_rehash",
+    "mesh_rehash",
+};
+
+#ifdef GEOMETRY_STATS
+
+static atomic_ullong geometry_stats_call_counts[GEOMETRY_STATS_FUNCTION_COUNT];
+static atomic_ullong geometry_stats_call_cycles[GEOMETRY_STATS_FUNCTION_COUNT];
+static atomic_ullong geometry_stats_events[GEOMETRY_STATS_EVENT_COUNT];
+static atomic_ullong geometry_stats_allocations;
+static atomic_ullong geometry_stats_frees;
+static atomic_ullong geometry_stats_allocated_bytes;
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static unsigned long long geometry_stats_now(void);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to read clock used for measuring calls
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       unsigned long long      processor cycles on x86, nanoseconds elsewhere
+*/
+static unsigned long long geometry_stats_now(void){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (unsigned long long)time.tv_sec * 1000000000ull + (unsigned long long)time.tv_nsec;
+#endif
+}
+
+#endif
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to check if library was compiled with statistics
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true if statistics are collected
+*/
+bool geometry_stats_isEnabled(void){
+#ifdef GEOMETRY_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+*   Function to copy current statistics
+*   Counters are read one by one, so calls running meanwhile may be seen partially
+*   In params:
+*       none
+*
+*   Out params:
+*       geometry_stats* stats       copied statistics, all zero if statistics are not collected
+*
+*   Return:
+*       bool                        true on success, false if stats is NULL or statistics are not collected
+*/
+bool geometry_stats_snapshot(geometry_stats* stats){
+    if(stats == NULL){
+        return false;
+    }
+    memset(stats, 0, sizeof(*stats));
+#ifdef GEOMETRY_STATS
+    for(size_t i = 0; i < GEOMETRY_STATS_FUNCTION_COUNT; i++){
+        stats->functions[i].count = atomic_load_explicit(&geometry_stats_call_counts[i], memory_order_relaxed);
+        stats->functions[i].cycles = atomic_load_explicit(&geometry_stats_call_cycles[i], memory_order_relaxed);
+    }
+    for(size_t i = 0; i < GEOMETRY_STATS_EVENT_COUNT; i++){
+        stats->events[i] = atomic_load_explicit(&geometry_stats_events[i], memory_order_relaxed);
+    }
+    stats->allocations = atomic_load_explicit(&geometry_stats_allocations, memory_order_relaxed);
+    stats->frees = atomic_load_explicit(&geometry_stats_frees, memory_order_relaxed);
+    stats->allocated_bytes = atomic_load_explicit(&geometry_stats_allocated_bytes, memory_order_relaxed);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+*   Function to set all statistics to zero
+*   In params:
+*       none
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_reset(void){
+#ifdef GEOMETRY_STATS
+    for(size_t i = 0; i < GEOMETRY_STATS_FUNCTION_COUNT; i++){
+        atomic_store_explicit(&geometry_stats_call_counts[i], 0, memory_order_relaxed);
+        atomic_store_explicit(&geometry_stats_call_cycles[i], 0, memory_order_relaxed);
+    }
+    for(size_t i = 0; i < GEOMETRY_STATS_EVENT_COUNT; i++){
+        atomic_store_explicit(&geometry_stats_events[i], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&geometry_stats_allocations, 0, memory_order_relaxed);
+    atomic_store_explicit(&geometry_stats_frees, 0, memory_order_relaxed);
+    atomic_store_explicit(&geometry_stats_allocated_bytes, 0, memory_order_relaxed);
+#endif
+}
+
+/**
+*   Function to get name of counted function
+*   In params:
+*       geometry_stats_function function    counted function
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const char*                         name of function, NULL if function is out of range
+*/
+const char* geometry_stats_getFunctionName(geometry_stats_function function){
+    if((size_t)function >= GEOMETRY_STATS_FUNCTION_COUNT){
+        return NULL;
+    }
+    return geometry_stats_function_names[function];
+}
+
+/**
+*   Function to get name of counted event
+*   In params:
+*       geometry_stats_event event          counted event
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const char*                         name of event, NULL if event is out of range
+*/
+const char* geometry_stats_getEventName(geometry_stats_event event){
+    if((size_t)event >= GEOMETRY_STATS_EVENT_COUNT){
+        return NULL;
+    }
+    return geometry_stats_event_names[event];
+}
+
+#ifdef GEOMETRY_STATS
+
+/**
+*   Function to start measuring call of function
+*   In params:
+*       geometry_stats_function function    called function
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_stats_scope                measured call, passed to geometry_stats_end
+*/
+geometry_stats_scope geometry_stats_begin(geometry_stats_function function){
+    geometry_stats_scope scope;
+    scope.function = function;
+    scope.start = geometry_stats_now();
+    return scope;
+}
+
+/**
+*   Function to finish measuring call of function and count it
+*   In params:
+*       geometry_stats_scope* scope         measured call
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_end(geometry_stats_scope* scope){
+    unsigned long long cycles = geometry_stats_now() - scope->start;
+    atomic_fetch_add_explicit(&geometry_stats_call_counts[scope->function], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&geometry_stats_call_cycles[scope->function], cycles, memory_order_relaxed);
+}
+
+/**
+*   Function to count event
+*   In params:
+*       geometry_stats_event event          event that happened
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_countEvent(geometry_stats_event event){
+    atomic_fetch_add_explicit(&geometry_stats_events[event], 1, memory_order_relaxed);
+}
+
+/**
+*   Function to count allocation
+*   In params:
+*       size_t size                         number of allocated bytes
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_countAllocation(size_t size){
+    atomic_fetch_add_explicit(&geometry_stats_allocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&geometry_stats_allocated_bytes, size, memory_order_relaxed);
+}
+
+/**
+*   Function to count release of memory
+*   In params:
+*       none
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_countFree(void){
+    atomic_fetch_add_explicit(&geometry_stats_frees, 1, memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,355 @@
+// guard can't be named GEOMETRY_STATS, that name turns statistics on
+#ifndef GEOMETRY_STATS_HEADER
+#define GEOMETRY_STATS_HEADER
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Statistics of library use: number of calls and time spent in functions,
+// number of slow paths taken and of allocations.
+// They are collected only when library is compiled with GEOMETRY_STATS defined
+// (e.g. make test_stats), otherwise all counting macros below are empty,
+// so instrumented functions are exactly the same as without statistics.
+// Time of call includes time of counted functions called inside it. It is measured
+// in processor cycles (time stamp counter) on x86, in nanoseconds elsewhere.
+// Counters are shared by all threads and updated atomically.
+
+// Functions for which calls are counted, constructors and destructors are counted
+// together with their _with variants
+typedef enum geometry_stats_function {
+    GEOMETRY_STATS_ARENA_NEW,
+    GEOMETRY_STATS_ARENA_DESTROY,
+    GEOMETRY_STATS_ARENA_RESET,
+    GEOMETRY_STATS_ARENA_ALLOCATE,
+    GEOMETRY_STATS_ROTATION_NEW,
+    GEOMETRY_STATS_ROTATION_DESTROY,
+    GEOMETRY_STATS_TRANSFORM_NEW,
+    GEOMETRY_STATS_TRANSFORM_DESTROY,
+    GEOMETRY_STATS_TRANSFORM_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_TRANSFORM_ROTATE_BY_ANGLE,
+    GEOMETRY_STATS_TRANSFORM_COMPOSE,
+    GEOMETRY_STATS_TRANSFORM_INVERT,
+    GEOMETRY_STATS_POINT_NEW,
+    GEOMETRY_STATS_POINT_NEW_IN,
+    GEOMETRY_STATS_POINT_DESTROY,
+    GEOMETRY_STATS_POINT_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_POINT_ROTATE_BY_ANGLE,
+    GEOMETRY_STATS_POINT_ROTATE_BY,
+    GEOMETRY_STATS_POINT_APPLY_TRANSFORM,
+    GEOMETRY_STATS_POINT_CALCULATE_DISTANCE,
+    GEOMETRY_STATS_POINT_LIES_ON_SEGMENT,
+    GEOMETRY_STATS_SEGMENT_NEW,
+    GEOMETRY_STATS_SEGMENT_NEW_IN,
+    GEOMETRY_STATS_SEGMENT_DESTROY,
+    GEOMETRY_STATS_SEGMENT_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_SEGMENT_ROTATE_BY_ANGLE,
+    GEOMETRY_STATS_SEGMENT_ROTATE_BY,
+    GEOMETRY_STATS_SEGMENT_APPLY_TRANSFORM,
+    GEOMETRY_STATS_SEGMENT_CALCULATE_LENGTH,
+    GEOMETRY_STATS_SEGMENT_ARE_PARALLEL,
+    GEOMETRY_STATS_SEGMENT_ARE_PERPENDICULAR,
+    GEOMETRY_STATS_SEGMENT_CALCULATE_INTERSECTION,
+    GEOMETRY_STATS_TRIANGLE_NEW,
+    GEOMETRY_STATS_TRIANGLE_NEW_IN,
+    GEOMETRY_STATS_TRIANGLE_NEW_FROM_COORDINATES,
+    GEOMETRY_STATS_TRIANGLE_DESTROY,
+    GEOMETRY_STATS_TRIANGLE_GET_BOUNDING_BOX,
+    GEOMETRY_STATS_TRIANGLE_GET_CENTROID,
+    GEOMETRY_STATS_TRIANGLE_GET_RIGHT_ANGLE_VERTEX,
+    GEOMETRY_STATS_TRIANGLE_FILL_CACHE,
+    GEOMETRY_STATS_TRIANGLE_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_TRIANGLE_ROTATE_BY_ANGLE,
+    GEOMETRY_STATS_TRIANGLE_ROTATE_BY,
+    GEOMETRY_STATS_TRIANGLE_APPLY_TRANSFORM,
+    GEOMETRY_STATS_TRIANGLE_CALCULATE_PERIMETER,
+    GEOMETRY_STATS_TRIANGLE_CALCULATE_AREA,
+    GEOMETRY_STATS_TRIANGLE_ARE_DISJOINT,
+    GEOMETRY_STATS_TRIANGLE_ARE_DISJOINT_BATCH,
+    GEOMETRY_STATS_TRIANGLE_ARE_DISJOINT_MATRIX,
+    GEOMETRY_STATS_TRIANGLE_CALCULATE_HYPOTENUSE,
+    GEOMETRY_STATS_POINT_BUFFER_NEW,
+    GEOMETRY_STATS_POINT_BUFFER_DESTROY,
+    GEOMETRY_STATS_POINT_BUFFER_RESERVE,
+    GEOMETRY_STATS_POINT_BUFFER_PUSH,
+    GEOMETRY_STATS_POINT_BUFFER_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_POINT_BUFFER_ROTATE_BY_ANGLE,
+    GEOMETRY_STATS_POINT_BUFFER_APPLY_TRANSFORM,
+    GEOMETRY_STATS_POINT_BUFFER_CALCULATE_DISTANCES,
+    GEOMETRY_STATS_POINT_BUFFER_CALCULATE_DISTANCE_MATRIX,
+    GEOMETRY_STATS_POINT_BUFFER_CALCULATE_SQUARED_DISTANCE_MATRIX,
+    GEOMETRY_STATS_POINT_BUFFER_STREAM_DISTANCE_MATRIX,
+    GEOMETRY_STATS_SEGMENT_CALCULATE_INTERSECTIONS,
+    GEOMETRY_STATS_GRID_NEW,
+    GEOMETRY_STATS_GRID_DESTROY,
+    GEOMETRY_STATS_GRID_INSERT,
+    GEOMETRY_STATS_GRID_REMOVE,
+    GEOMETRY_STATS_GRID_UPDATE,
+    GEOMETRY_STATS_GRID_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_GRID_CALCULATE_CANDIDATE_PAIRS,
+    GEOMETRY_STATS_GRID_CALCULATE_INTERSECTING_PAIRS,
+    GEOMETRY_STATS_GRID_CALCULATE_INTERSECTING_PAIRS_PARALLEL,
+    GEOMETRY_STATS_BVH_NEW,
+    GEOMETRY_STATS_BVH_DESTROY,
+    GEOMETRY_STATS_BVH_INSERT,
+    GEOMETRY_STATS_BVH_REMOVE,
+    GEOMETRY_STATS_BVH_UPDATE,
+    GEOMETRY_STATS_BVH_REFIT,
+    GEOMETRY_STATS_BVH_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_BVH_ROTATE_BY_ANGLE,
+    GEOMETRY_STATS_BVH_QUERY_TRIANGLE,
+    GEOMETRY_STATS_BVH_QUERY_POINT,
+    GEOMETRY_STATS_BVH_CAST_RAY,
+    GEOMETRY_STATS_BVH_CALCULATE_INTERSECTING_PAIRS,
+    GEOMETRY_STATS_RTREE_NEW,
+    GEOMETRY_STATS_RTREE_DESTROY,
+    GEOMETRY_STATS_RTREE_QUERY_POINT,
+    GEOMETRY_STATS_RTREE_QUERY_POINTS,
+    GEOMETRY_STATS_KDTREE_NEW,
+    GEOMETRY_STATS_KDTREE_DESTROY,
+    GEOMETRY_STATS_KDTREE_FIND_NEAREST,
+    GEOMETRY_STATS_KDTREE_FIND_IN_RADIUS,
+    GEOMETRY_STATS_KDTREE_FIND_NEAREST_BATCH,
+    GEOMETRY_STATS_KDTREE_FIND_IN_RADIUS_BATCH,
+    GEOMETRY_STATS_POOL_NEW,
+    GEOMETRY_STATS_POOL_DESTROY,
+    GEOMETRY_STATS_POOL_RUN,
+    GEOMETRY_STATS_POOL_RUN_STEALING,
+    GEOMETRY_STATS_TRIANGLE_CALCULATE_AREA_BATCH,
+    GEOMETRY_STATS_TRIANGLE_CALCULATE_PERIMETER_BATCH,
+    GEOMETRY_STATS_TRIANGLE_CALCULATE_HYPOTENUSE_BATCH,
+    GEOMETRY_STATS_TRIANGLE_CALCULATE_INTERSECTING_PAIRS,
+    GEOMETRY_STATS_TRIANGLE_BUFFER_NEW,
+    GEOMETRY_STATS_TRIANGLE_BUFFER_LOAD,
+    GEOMETRY_STATS_TRIANGLE_BUFFER_DESTROY,
+    GEOMETRY_STATS_TRIANGLE_BUFFER_SAVE,
+    GEOMETRY_STATS_TRIANGLE_BUFFER_GET_TRIANGLE,
+    GEOMETRY_STATS_TRIANGLE_BUFFER_CALCULATE_AREAS,
+    GEOMETRY_STATS_TRIANGLE_BUFFER_CALCULATE_PERIMETERS,
+    GEOMETRY_STATS_TEXT_READER_NEW,
+    GEOMETRY_STATS_TEXT_READER_DESTROY,
+    GEOMETRY_STATS_TEXT_READER_READ,
+    GEOMETRY_STATS_TEXT_WRITER_NEW,
+    GEOMETRY_STATS_TEXT_WRITER_DESTROY,
+    GEOMETRY_STATS_TEXT_WRITER_FLUSH,
+    GEOMETRY_STATS_TEXT_WRITER_WRITE_POINTS,
+    GEOMETRY_STATS_TEXT_WRITER_WRITE_SEGMENTS,
+    GEOMETRY_STATS_TEXT_WRITER_WRITE_TRIANGLES,
+    GEOMETRY_STATS_INT_POINT_NEW,
+    GEOMETRY_STATS_INT_POINT_NEW_IN,
+    GEOMETRY_STATS_INT_POINT_DESTROY,
+    GEOMETRY_STATS_INT_POINT_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_INT_POINT_LIES_ON_SEGMENT,
+    GEOMETRY_STATS_INT_SEGMENT_NEW,
+    GEOMETRY_STATS_INT_SEGMENT_NEW_IN,
+    GEOMETRY_STATS_INT_SEGMENT_DESTROY,
+    GEOMETRY_STATS_INT_SEGMENT_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_INT_SEGMENT_CALCULATE_LENGTH,
+    GEOMETRY_STATS_INT_SEGMENT_ARE_PARALLEL,
+    GEOMETRY_STATS_INT_SEGMENT_ARE_PERPENDICULAR,
+    GEOMETRY_STATS_INT_SEGMENT_ARE_INTERSECTING,
+    GEOMETRY_STATS_INT_SEGMENT_CALCULATE_INTERSECTION,
+    GEOMETRY_STATS_INT_TRIANGLE_NEW,
+    GEOMETRY_STATS_INT_TRIANGLE_NEW_IN,
+    GEOMETRY_STATS_INT_TRIANGLE_DESTROY,
+    GEOMETRY_STATS_INT_TRIANGLE_IS_RIGHT,
+    GEOMETRY_STATS_INT_TRIANGLE_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_INT_TRIANGLE_CALCULATE_AREA,
+    GEOMETRY_STATS_INT_TRIANGLE_CALCULATE_PERIMETER,
+    GEOMETRY_STATS_INT_TRIANGLE_CALCULATE_HYPOTENUSE,
+    GEOMETRY_STATS_INT_TRIANGLE_ARE_DISJOINT,
+    GEOMETRY_STATS_MESH_NEW,
+    GEOMETRY_STATS_MESH_DESTROY,
+    GEOMETRY_STATS_MESH_ADD_VERTEX,
+    GEOMETRY_STATS_MESH_ADD_TRIANGLE,
+    GEOMETRY_STATS_MESH_GET_TRIANGLE,
+    GEOMETRY_STATS_MESH_MOVE_BY_VECTOR,
+    GEOMETRY_STATS_MESH_ROTATE_BY_ANGLE,
+    GEOMETRY_STATS_MESH_APPLY_TRANSFORM,
+    GEOMETRY_STATS_MESH_CALCULATE_AREAS,
+    GEOMETRY_STATS_MESH_CALCULATE_PERIMETERS,
+    GEOMETRY_STATS_MESH_CALCULATE_AREA,
+    GEOMETRY_STATS_FUNCTION_COUNT
+} geometry_stats_function;
+
+// Slow paths and other rare events that are counted
+typedef enum geometry_stats_event {
+    // side lengths, area and perimeter of triangle calculated (cache miss)
+    GEOMETRY_STATS_TRIANGLE_SHAPE_UPDATE,
+    // bounding box and centroid of triangle calculated (cache miss)
+    GEOMETRY_STATS_TRIANGLE_BOUNDS_UPDATE,
+    // separating axes of triangle calculated (cache miss)
+    GEOMETRY_STATS_TRIANGLE_AXES_UPDATE,
+    // sign of predicate calculated exactly, as rounded one was uncertain
+    GEOMETRY_STATS_PREDICATE_FALLBACK,
+    // hash table of grid cells rebuilt
+    GEOMETRY_STATS_GRID_REHASH,
+    // hash table of mesh vertices rebuilt
+    GEOMETRY_STATS_MESH_REHASH,
+    GEOMETRY_STATS_EVENT_COUNT
+} geometry_stats_event;
+
+// Calls of single function
+typedef struct geometry_stats_calls {
+    unsigned long long count;
+    unsigned long long cycles;
+} geometry_stats_calls;
+
+// All statistics at some moment
+typedef struct geometry_stats {
+    geometry_stats_calls functions[GEOMETRY_STATS_FUNCTION_COUNT];
+    unsigned long long events[GEOMETRY_STATS_EVENT_COUNT];
+    unsigned long long allocations;
+    unsigned long long frees;
+    unsigned long long allocated_bytes;
+} geometry_stats;
+
+/*###############################################
+ GEOMETRY_STATS functions (methods) declarations
+################################################*/
+
+/**
+*   Function to check if library was compiled with statistics
+*   In params:
+*       none
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true if statistics are collected
+*/
+bool geometry_stats_isEnabled(void);
+
+/**
+*   Function to copy current statistics
+*   Counters are read one by one, so calls running meanwhile may be seen partially
+*   In params:
+*       none
+*
+*   Out params:
+*       geometry_stats* stats       copied statistics, all zero if statistics are not collected
+*
+*   Return:
+*       bool                        true on success, false if stats is NULL or statistics are not collected
+*/
+bool geometry_stats_snapshot(geometry_stats* stats);
+
+/**
+*   Function to set all statistics to zero
+*   In params:
+*       none
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_reset(void);
+
+/**
+*   Function to get name of counted function
+*   In params:
+*       geometry_stats_function function    counted function
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const char*                         name of function, NULL if function is out of range
+*/
+const char* geometry_stats_getFunctionName(geometry_stats_function function);
+
+/**
+*   Function to get name of counted event
+*   In params:
+*       geometry_stats_event event          counted event
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const char*                         name of event, NULL if event is out of range
+*/
+const char* geometry_stats_getEventName(geometry_stats_event event);
+
+/*#################################################
+ Counting used inside library
+##################################################*/
+
+#ifdef GEOMETRY_STATS
+
+// Call of function being measured, time is recorded when it goes out of scope
+typedef struct geometry_stats_scope {
+    geometry_stats_function function;
+    unsigned long long start;
+} geometry_stats_scope;
+
+/**
+*   Function to start measuring call of function
+*   In params:
+*       geometry_stats_function function    called function
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_stats_scope                measured call, passed to geometry_stats_end
+*/
+geometry_stats_scope geometry_stats_begin(geometry_stats_function function);
+
+/**
+*   Function to finish measuring call of function and count it
+*   In params:
+*       geometry_stats_scope* scope         measured call
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_end(geometry_stats_scope* scope);
+
+/**
+*   Function to count event
+*   In params:
+*       geometry_stats_event event          event that happened
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_countEvent(geometry_stats_event event);
+
+/**
+*   Function to count allocation
+*   In params:
+*       size_t size                         number of allocated bytes
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_countAllocation(size_t size);
+
+/**
+*   Function to count release of memory
+*   In params:
+*       none
+*
+*   Out params/return:
+*       none
+*/
+void geometry_stats_countFree(void);
+
+// Placed at beginning of function body, counts call and its time until function returns
+// (cleanup attribute of GCC and Clang runs geometry_stats_end on every return)
+#define GEOMETRY_STATS_FUNCTION(function) \
+    geometry_stats_scope geometry_stats_current_scope __attribute__((cleanup(geometry_stats_end))) = geometry_stats_begin(function)
+#define GEOMETRY_STATS_EVENT(event) geometry_stats_countEvent(event)
+#define GEOMETRY_STATS_ALLOCATION(size) geometry_stats_countAllocation(size)
+#define GEOMETRY_STATS_FREE() geometry_stats_countFree()
+
+#else
+
+#define GEOMETRY_STATS_FUNCTION(function) ((void)0)
+#define GEOMETRY_STATS_EVENT(event) ((void)0)
+#define GEOMETRY_STATS_ALLOCATION(size) ((void)0)
+#define GEOMETRY_STATS_FREE() ((void)0)
+
+#endif
+
+#endif
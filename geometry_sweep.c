@@ -0,0 +1,1018 @@
+#include "geometry_sweep.h"
+#include "geometry_stats.h"
+#include "geometry_predicates.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define GEOMETRY_SWEEP_NONE ((size_t)-1)
+#define GEOMETRY_SWEEP_ERROR ((size_t)-1)
+
+// Events at the same point are handled in this order: crossings first, so
+// segments passing through the point are already ordered as right of it,
+// then ends, so only segments going further right are left in status,
+// and starts at the end
+typedef enum geometry_sweep_event_type {
+    GEOMETRY_SWEEP_CROSS = 0,
+    GEOMETRY_SWEEP_END = 1,
+    GEOMETRY_SWEEP_START = 2
+} geometry_sweep_event_type;
+
+// Result of intersection test of two segments
+typedef enum geometry_sweep_contact {
+    GEOMETRY_SWEEP_DISJOINT = 0,
+    // interiors cross in one point, order of segments in status changes there
+    GEOMETRY_SWEEP_PROPER = 1,
+    // segments touch with an end or overlap, order in status doesn't change
+    GEOMETRY_SWEEP_TOUCH = 2
+} geometry_sweep_contact;
+
+// Segment with ends ordered, so left is smaller by x (then by y) than right
+typedef struct geometry_sweep_segment {
+    double left_x;
+    double left_y;
+    double right_x;
+    double right_y;
+} geometry_sweep_segment;
+
+typedef struct geometry_sweep_event {
+    double x;
+    double y;
+    geometry_sweep_event_type type;
+    size_t first;
+    size_t second;
+    // exact crossing point, (x, y) may be moved forward to current sweep position
+    double point_x;
+    double point_y;
+} geometry_sweep_event;
+
+// Node of sweep-line status - treap ordered by position of segments along sweep line
+typedef struct geometry_sweep_node {
+    size_t left;
+    size_t right;
+    size_t parent;
+    uint32_t priority;
+    size_t segment;
+} geometry_sweep_node;
+
+typedef struct geometry_sweep {
+    geometry_sweep_segment* segments;
+    size_t count;
+    geometry_sweep_node* nodes;
+    size_t* node_of_segment;
+    size_t node_count;
+    size_t root;
+    uint32_t random_state;
+    geometry_sweep_event* events;
+    size_t event_count;
+    size_t event_capacity;
+    // hash set of already reported pairs, key 0 marks empty slot
+    uint64_t* pairs;
+    size_t pair_count;
+    size_t pair_capacity;
+    size_t* block;
+    size_t block_capacity;
+    // segments which ended at the point of current event
+    size_t* ended;
+    size_t ended_count;
+    geometry_sweep_event current;
+    geometry_intersection* intersections;
+    size_t capacity;
+    bool failed;
+} geometry_sweep;
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static int geometry_sweep_orientation(double first_x, double first_y, double second_x, double second_y, double third_x, double third_y);
+static bool geometry_sweep_pointLess(double first_x, double first_y, double second_x, double second_y);
+static bool geometry_sweep_contains(geometry_sweep_segment* segment, double x, double y);
+static geometry_sweep_contact geometry_sweep_intersect(geometry_sweep_segment* first, geometry_sweep_segment* second, double* x, double* y);
+static int geometry_sweep_compareSlopes(geometry_sweep* sweep, size_t first, size_t second);
+static bool geometry_sweep_eventLess(geometry_sweep_event* first, geometry_sweep_event* second);
+static bool geometry_sweep_pushEvent(geometry_sweep* sweep, geometry_sweep_event* event);
+static geometry_sweep_event geometry_sweep_popEvent(geometry_sweep* sweep);
+static bool geometry_sweep_isReported(geometry_sweep* sweep, size_t first, size_t second);
+static void geometry_sweep_report(geometry_sweep* sweep, size_t first, size_t second, double x, double y);
+static void geometry_sweep_testPair(geometry_sweep* sweep, size_t lower_node, size_t upper_node);
+static size_t geometry_sweep_successor(geometry_sweep* sweep, size_t node);
+static size_t geometry_sweep_predecessor(geometry_sweep* sweep, size_t node);
+static void geometry_sweep_rotateUp(geometry_sweep* sweep, size_t node);
+static size_t geometry_sweep_insert(geometry_sweep* sweep, size_t segment);
+static void geometry_sweep_remove(geometry_sweep* sweep, size_t node);
+static void geometry_sweep_reportThroughPoint(geometry_sweep* sweep, size_t node, double x, double y);
+static void geometry_sweep_orderBlock(geometry_sweep* sweep, size_t lower, size_t upper, double x, double y);
+static void geometry_sweep_handleCross(geometry_sweep* sweep, geometry_sweep_event* event);
+static void geometry_sweep_orderThroughPoint(geometry_sweep* sweep, double x, double y);
+static size_t geometry_sweep_run(geometry_sweep_segment* segments, size_t count, geometry_intersection* intersections, size_t capacity);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to determine on which side of line going through first and second point
+*   lies third point
+*   In params:
+*       double first_x, first_y         first point of line
+*       double second_x, second_y       second point of line
+*       double third_x, third_y         examined point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                             1 if third point lies on the left, -1 if on the right,
+*                                       0 if points are colinear
+*/
+static int geometry_sweep_orientation(double first_x, double first_y, double second_x, double second_y, double third_x, double third_y){
+    return geometry_predicates_orientation(first_x, first_y, second_x, second_y, third_x, third_y);
+}
+
+/**
+*   Function to compare points in order of sweep - by x, then by y coordinate
+*   In params:
+*       double first_x, first_y         first point
+*       double second_x, second_y       second point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true if first point is swept before second one
+*/
+static bool geometry_sweep_pointLess(double first_x, double first_y, double second_x, double second_y){
+    return first_x < second_x || (first_x == second_x && first_y < second_y);
+}
+
+/**
+*   Function to determine if given point lies on given segment
+*   In params:
+*       geometry_sweep_segment* segment     segment
+*       double x, y                         point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if point lies on segment
+*/
+static bool geometry_sweep_contains(geometry_sweep_segment* segment, double x, double y){
+    if(geometry_sweep_pointLess(x, y, segment->left_x, segment->left_y) || geometry_sweep_pointLess(segment->right_x, segment->right_y, x, y)){
+        return false;
+    }
+    return geometry_sweep_orientation(segment->left_x, segment->left_y, segment->right_x, segment->right_y, x, y) == 0;
+}
+
+/**
+*   Function to test if two segments intersect and calculate their common point
+*   In params:
+*       geometry_sweep_segment* first       first segment
+*       geometry_sweep_segment* second      second segment
+*
+*   Out params:
+*       double* x, y                        common point if segments intersect
+*
+*   Return:
+*       geometry_sweep_contact              kind of intersection
+*/
+static geometry_sweep_contact geometry_sweep_intersect(geometry_sweep_segment* first, geometry_sweep_segment* second, double* x, double* y){
+    int second_left_side = geometry_sweep_orientation(first->left_x, first->left_y, first->right_x, first->right_y, second->left_x, second->left_y);
+    int second_right_side = geometry_sweep_orientation(first->left_x, first->left_y, first->right_x, first->right_y, second->right_x, second->right_y);
+    if(second_left_side == 0 && second_right_side == 0){
+        // colinear segments - common part goes from the later left end to the earlier right end
+        double start_x = first->left_x;
+        double start_y = first->left_y;
+        if(geometry_sweep_pointLess(start_x, start_y, second->left_x, second->left_y)){
+            start_x = second->left_x;
+            start_y = second->left_y;
+        }
+        if(geometry_sweep_pointLess(first->right_x, first->right_y, start_x, start_y) || geometry_sweep_pointLess(second->right_x, second->right_y, start_x, start_y)){
+            return GEOMETRY_SWEEP_DISJOINT;
+        }
+        *x = start_x;
+        *y = start_y;
+        return GEOMETRY_SWEEP_TOUCH;
+    }
+    int first_left_side = geometry_sweep_orientation(second->left_x, second->left_y, second->right_x, second->right_y, first->left_x, first->left_y);
+    int first_right_side = geometry_sweep_orientation(second->left_x, second->left_y, second->right_x, second->right_y, first->right_x, first->right_y);
+    if(second_left_side * second_right_side > 0 || first_left_side * first_right_side > 0){
+        return GEOMETRY_SWEEP_DISJOINT;
+    }
+    if(second_left_side == 0 || second_right_side == 0){
+        *x = second_left_side == 0 ? second->left_x : second->right_x;
+        *y = second_left_side == 0 ? second->left_y : second->right_y;
+        return GEOMETRY_SWEEP_TOUCH;
+    }
+    if(first_left_side == 0 || first_right_side == 0){
+        *x = first_left_side == 0 ? first->left_x : first->right_x;
+        *y = first_left_side == 0 ? first->left_y : first->right_y;
+        return GEOMETRY_SWEEP_TOUCH;
+    }
+    double first_dx = first->right_x - first->left_x;
+    double first_dy = first->right_y - first->left_y;
+    double second_dx = second->right_x - second->left_x;
+    double second_dy = second->right_y - second->left_y;
+    double denominator = first_dx * second_dy - first_dy * second_dx;
+    double parameter = ((second->left_x - first->left_x) * second_dy - (second->left_y - first->left_y) * second_dx) / denominator;
+    *x = first->left_x + parameter * first_dx;
+    *y = first->left_y + parameter * first_dy;
+    // rounding must not move the point outside of segments' x range
+    double min_x = first->left_x > second->left_x ? first->left_x : second->left_x;
+    double max_x = first->right_x < second->right_x ? first->right_x : second->right_x;
+    *x = *x < min_x ? min_x : (*x > max_x ? max_x : *x);
+    return GEOMETRY_SWEEP_PROPER;
+}
+
+/**
+*   Function to compare directions of two segments
+*   Of segments going through the same point, the one with smaller slope lies
+*   lower right of that point; vertical segments are the steepest
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t first                index of first segment
+*       size_t second               index of second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       int                         -1 if first segment lies lower, 1 if higher,
+*                                   ties are resolved by segment indices
+*/
+static int geometry_sweep_compareSlopes(geometry_sweep* sweep, size_t first, size_t second){
+    geometry_sweep_segment* first_segment = &sweep->segments[first];
+    geometry_sweep_segment* second_segment = &sweep->segments[second];
+    int turn = geometry_predicates_crossSign(first_segment->left_x, first_segment->left_y, first_segment->right_x, first_segment->right_y,
+                                                second_segment->left_x, second_segment->left_y, second_segment->right_x, second_segment->right_y);
+    if(turn != 0){
+        return -turn;
+    }
+    return first < second ? -1 : (first > second ? 1 : 0);
+}
+
+/**
+*   Function to compare events in order of processing
+*   In params:
+*       geometry_sweep_event* first         first event
+*       geometry_sweep_event* second        second event
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true if first event should be processed before second one
+*/
+static bool geometry_sweep_eventLess(geometry_sweep_event* first, geometry_sweep_event* second){
+    if(first->x != second->x){
+        return first->x < second->x;
+    }
+    if(first->y != second->y){
+        return first->y < second->y;
+    }
+    return first->type < second->type;
+}
+
+/**
+*   Function to add event to priority queue (binary heap)
+*   In params:
+*       geometry_sweep* sweep               sweep state
+*       geometry_sweep_event* event         event to add
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if memory couldn't be reserved
+*/
+static bool geometry_sweep_pushEvent(geometry_sweep* sweep, geometry_sweep_event* event){
+    if(sweep->event_count == sweep->event_capacity){
+        size_t new_capacity = sweep->event_capacity * 2 + 16;
+        geometry_sweep_event* new_events = geometry_allocator_reallocate(NULL, sweep->events, sweep->event_capacity * sizeof(*new_events), new_capacity * sizeof(*new_events));
+        if(new_events == NULL){
+            sweep->failed = true;
+            return false;
+        }
+        sweep->events = new_events;
+        sweep->event_capacity = new_capacity;
+    }
+    size_t index = sweep->event_count++;
+    while(index > 0){
+        size_t parent = (index - 1) / 2;
+        if(!geometry_sweep_eventLess(event, &sweep->events[parent])){
+            break;
+        }
+        sweep->events[index] = sweep->events[parent];
+        index = parent;
+    }
+    sweep->events[index] = *event;
+    return true;
+}
+
+/**
+*   Function to take the first event out of priority queue
+*   Queue must not be empty
+*   In params:
+*       geometry_sweep* sweep               sweep state
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_sweep_event                removed event
+*/
+static geometry_sweep_event geometry_sweep_popEvent(geometry_sweep* sweep){
+    geometry_sweep_event top = sweep->events[0];
+    geometry_sweep_event last = sweep->events[--sweep->event_count];
+    size_t index = 0;
+    while(true){
+        size_t child = 2 * index + 1;
+        if(child >= sweep->event_count){
+            break;
+        }
+        if(child + 1 < sweep->event_count && geometry_sweep_eventLess(&sweep->events[child + 1], &sweep->events[child])){
+            child++;
+        }
+        if(!geometry_sweep_eventLess(&sweep->events[child], &last)){
+            break;
+        }
+        sweep->events[index] = sweep->events[child];
+        index = child;
+    }
+    if(sweep->event_count > 0){
+        sweep->events[index] = last;
+    }
+    return top;
+}
+
+/**
+*   Function to check if pair of segments was already reported
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t first                index of first segment
+*       size_t second               index of second segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                        true if pair is already reported
+*/
+static bool geometry_sweep_isReported(geometry_sweep* sweep, size_t first, size_t second){
+    if(first > second){
+        size_t swap = first;
+        first = second;
+        second = swap;
+    }
+    uint64_t key = (uint64_t)first * sweep->count + second + 1;
+    size_t mask = sweep->pair_capacity - 1;
+    for(size_t slot = (size_t)(key * 0x9E3779B97F4A7C15ULL >> 17) & mask; sweep->pairs[slot] != 0; slot = (slot + 1) & mask){
+        if(sweep->pairs[slot] == key){
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+*   Function to report intersection of two segments, each pair is reported once
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t first                index of first segment
+*       size_t second               index of second segment
+*       double x, y                 common point of segments
+*
+*   Out params/return:
+*       none (sweep state and output are changed)
+*/
+static void geometry_sweep_report(geometry_sweep* sweep, size_t first, size_t second, double x, double y){
+    if(first > second){
+        size_t swap = first;
+        first = second;
+        second = swap;
+    }
+    // keep hash set at most half full
+    if(2 * (sweep->pair_count + 1) > sweep->pair_capacity){
+        size_t new_capacity = sweep->pair_capacity * 2;
+        uint64_t* new_pairs = geometry_allocator_allocateZeroed(NULL, new_capacity, sizeof(*new_pairs));
+        if(new_pairs == NULL){
+            sweep->failed = true;
+            return;
+        }
+        for(size_t i = 0; i < sweep->pair_capacity; i++){
+            uint64_t key = sweep->pairs[i];
+            if(key == 0){
+                continue;
+            }
+            size_t slot = (size_t)(key * 0x9E3779B97F4A7C15ULL >> 17) & (new_capacity - 1);
+            while(new_pairs[slot] != 0){
+                slot = (slot + 1) & (new_capacity - 1);
+            }
+            new_pairs[slot] = key;
+        }
+        geometry_allocator_free(NULL, sweep->pairs);
+        sweep->pairs = new_pairs;
+        sweep->pair_capacity = new_capacity;
+    }
+    uint64_t key = (uint64_t)first * sweep->count + second + 1;
+    size_t mask = sweep->pair_capacity - 1;
+    size_t slot = (size_t)(key * 0x9E3779B97F4A7C15ULL >> 17) & mask;
+    while(sweep->pairs[slot] != 0){
+        if(sweep->pairs[slot] == key){
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    sweep->pairs[slot] = key;
+    if(sweep->pair_count < sweep->capacity){
+        geometry_intersection* intersection = &sweep->intersections[sweep->pair_count];
+        intersection->first = first;
+        intersection->second = second;
+        intersection->x = x;
+        intersection->y = y;
+    }
+    sweep->pair_count++;
+}
+
+/**
+*   Function to test segments that became neighbours in status
+*   Touching segments are reported at once, crossing ones are scheduled
+*   for the point where their order has to be changed
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t lower_node           lower neighbour, may be GEOMETRY_SWEEP_NONE
+*       size_t upper_node           upper neighbour, may be GEOMETRY_SWEEP_NONE
+*
+*   Out params/return:
+*       none (sweep state is changed)
+*/
+static void geometry_sweep_testPair(geometry_sweep* sweep, size_t lower_node, size_t upper_node){
+    if(lower_node == GEOMETRY_SWEEP_NONE || upper_node == GEOMETRY_SWEEP_NONE){
+        return;
+    }
+    size_t first = sweep->nodes[lower_node].segment;
+    size_t second = sweep->nodes[upper_node].segment;
+    if(geometry_sweep_isReported(sweep, first, second)){
+        return;
+    }
+    double x;
+    double y;
+    geometry_sweep_contact contact = geometry_sweep_intersect(&sweep->segments[first], &sweep->segments[second], &x, &y);
+    if(contact == GEOMETRY_SWEEP_TOUCH){
+        geometry_sweep_report(sweep, first, second, x, y);
+    }
+    else if(contact == GEOMETRY_SWEEP_PROPER){
+        geometry_sweep_event event = {x, y, GEOMETRY_SWEEP_CROSS, first, second, x, y};
+        // rounding may put the point slightly behind the sweep line,
+        // order still has to be fixed, so it is done as soon as possible
+        if(geometry_sweep_eventLess(&event, &sweep->current)){
+            event.x = sweep->current.x;
+            event.y = sweep->current.y;
+        }
+        geometry_sweep_pushEvent(sweep, &event);
+    }
+}
+
+/**
+*   Function to find next node in status order
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t node                 node
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                      next (upper) node, GEOMETRY_SWEEP_NONE if there is none
+*/
+static size_t geometry_sweep_successor(geometry_sweep* sweep, size_t node){
+    geometry_sweep_node* nodes = sweep->nodes;
+    if(nodes[node].right != GEOMETRY_SWEEP_NONE){
+        node = nodes[node].right;
+        while(nodes[node].left != GEOMETRY_SWEEP_NONE){
+            node = nodes[node].left;
+        }
+        return node;
+    }
+    size_t parent = nodes[node].parent;
+    while(parent != GEOMETRY_SWEEP_NONE && nodes[parent].right == node){
+        node = parent;
+        parent = nodes[node].parent;
+    }
+    return parent;
+}
+
+/**
+*   Function to find previous node in status order
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t node                 node
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                      previous (lower) node, GEOMETRY_SWEEP_NONE if there is none
+*/
+static size_t geometry_sweep_predecessor(geometry_sweep* sweep, size_t node){
+    geometry_sweep_node* nodes = sweep->nodes;
+    if(nodes[node].left != GEOMETRY_SWEEP_NONE){
+        node = nodes[node].left;
+        while(nodes[node].right != GEOMETRY_SWEEP_NONE){
+            node = nodes[node].right;
+        }
+        return node;
+    }
+    size_t parent = nodes[node].parent;
+    while(parent != GEOMETRY_SWEEP_NONE && nodes[parent].left == node){
+        node = parent;
+        parent = nodes[node].parent;
+    }
+    return parent;
+}
+
+/**
+*   Function to rotate given node above its parent, order of nodes is kept
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t node                 node that goes up
+*
+*   Out params/return:
+*       none (status tree is changed)
+*/
+static void geometry_sweep_rotateUp(geometry_sweep* sweep, size_t node){
+    geometry_sweep_node* nodes = sweep->nodes;
+    size_t parent = nodes[node].parent;
+    size_t grandparent = nodes[parent].parent;
+    if(nodes[parent].left == node){
+        size_t middle = nodes[node].right;
+        nodes[parent].left = middle;
+        if(middle != GEOMETRY_SWEEP_NONE){
+            nodes[middle].parent = parent;
+        }
+        nodes[node].right = parent;
+    }
+    else{
+        size_t middle = nodes[node].left;
+        nodes[parent].right = middle;
+        if(middle != GEOMETRY_SWEEP_NONE){
+            nodes[middle].parent = parent;
+        }
+        nodes[node].left = parent;
+    }
+    nodes[parent].parent = node;
+    nodes[node].parent = grandparent;
+    if(grandparent == GEOMETRY_SWEEP_NONE){
+        sweep->root = node;
+    }
+    else if(nodes[grandparent].left == parent){
+        nodes[grandparent].left = node;
+    }
+    else{
+        nodes[grandparent].right = node;
+    }
+}
+
+/**
+*   Function to insert segment starting at current event point into status
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t segment              index of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                      node holding inserted segment
+*/
+static size_t geometry_sweep_insert(geometry_sweep* sweep, size_t segment){
+    geometry_sweep_node* nodes = sweep->nodes;
+    size_t node = sweep->node_count++;
+    // xorshift is enough to keep treap balanced
+    sweep->random_state ^= sweep->random_state << 13;
+    sweep->random_state ^= sweep->random_state >> 17;
+    sweep->random_state ^= sweep->random_state << 5;
+    nodes[node].left = GEOMETRY_SWEEP_NONE;
+    nodes[node].right = GEOMETRY_SWEEP_NONE;
+    nodes[node].parent = GEOMETRY_SWEEP_NONE;
+    nodes[node].priority = sweep->random_state;
+    nodes[node].segment = segment;
+    sweep->node_of_segment[segment] = node;
+    geometry_sweep_segment* inserted = &sweep->segments[segment];
+    size_t parent = GEOMETRY_SWEEP_NONE;
+    size_t current = sweep->root;
+    bool goes_left = false;
+    while(current != GEOMETRY_SWEEP_NONE){
+        geometry_sweep_segment* other = &sweep->segments[nodes[current].segment];
+        // position of the new segment's start relative to the other segment,
+        // when it lies on the other one, segment which goes higher right of it is higher
+        int side = geometry_sweep_orientation(other->left_x, other->left_y, other->right_x, other->right_y, inserted->left_x, inserted->left_y);
+        if(side == 0){
+            side = geometry_sweep_compareSlopes(sweep, segment, nodes[current].segment);
+        }
+        parent = current;
+        goes_left = side < 0;
+        current = goes_left ? nodes[current].left : nodes[current].right;
+    }
+    nodes[node].parent = parent;
+    if(parent == GEOMETRY_SWEEP_NONE){
+        sweep->root = node;
+    }
+    else if(goes_left){
+        nodes[parent].left = node;
+    }
+    else{
+        nodes[parent].right = node;
+    }
+    while(nodes[node].parent != GEOMETRY_SWEEP_NONE && nodes[nodes[node].parent].priority < nodes[node].priority){
+        geometry_sweep_rotateUp(sweep, node);
+    }
+    return node;
+}
+
+/**
+*   Function to remove node from status
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t node                 node to remove
+*
+*   Out params/return:
+*       none (status tree is changed)
+*/
+static void geometry_sweep_remove(geometry_sweep* sweep, size_t node){
+    geometry_sweep_node* nodes = sweep->nodes;
+    // rotate node down until it becomes a leaf
+    while(nodes[node].left != GEOMETRY_SWEEP_NONE || nodes[node].right != GEOMETRY_SWEEP_NONE){
+        size_t left = nodes[node].left;
+        size_t right = nodes[node].right;
+        if(right == GEOMETRY_SWEEP_NONE || (left != GEOMETRY_SWEEP_NONE && nodes[left].priority > nodes[right].priority)){
+            geometry_sweep_rotateUp(sweep, left);
+        }
+        else{
+            geometry_sweep_rotateUp(sweep, right);
+        }
+    }
+    size_t parent = nodes[node].parent;
+    if(parent == GEOMETRY_SWEEP_NONE){
+        sweep->root = GEOMETRY_SWEEP_NONE;
+    }
+    else if(nodes[parent].left == node){
+        nodes[parent].left = GEOMETRY_SWEEP_NONE;
+    }
+    else{
+        nodes[parent].right = GEOMETRY_SWEEP_NONE;
+    }
+}
+
+/**
+*   Function to report given segment together with all its neighbours going through given point
+*   Such neighbours lie next to each other in status, so only they are visited
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t node                 node of segment going through the point
+*       double x, y                 point
+*
+*   Out params/return:
+*       none (sweep state is changed)
+*/
+static void geometry_sweep_reportThroughPoint(geometry_sweep* sweep, size_t node, double x, double y){
+    size_t segment = sweep->nodes[node].segment;
+    for(size_t other = geometry_sweep_successor(sweep, node); other != GEOMETRY_SWEEP_NONE; other = geometry_sweep_successor(sweep, other)){
+        if(!geometry_sweep_contains(&sweep->segments[sweep->nodes[other].segment], x, y)){
+            break;
+        }
+        geometry_sweep_report(sweep, segment, sweep->nodes[other].segment, x, y);
+    }
+    for(size_t other = geometry_sweep_predecessor(sweep, node); other != GEOMETRY_SWEEP_NONE; other = geometry_sweep_predecessor(sweep, other)){
+        if(!geometry_sweep_contains(&sweep->segments[sweep->nodes[other].segment], x, y)){
+            break;
+        }
+        geometry_sweep_report(sweep, segment, sweep->nodes[other].segment, x, y);
+    }
+}
+
+/**
+*   Function to reorder group of neighbouring segments going through one point
+*   as they lie right of that point, every pair of the group is reported
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       size_t lower                lowest node of group
+*       size_t upper                highest node of group
+*       double x, y                 common point of segments
+*
+*   Out params/return:
+*       none (sweep state is changed)
+*/
+static void geometry_sweep_orderBlock(geometry_sweep* sweep, size_t lower, size_t upper, double x, double y){
+    size_t block_size = 0;
+    for(size_t node = lower; ; node = geometry_sweep_successor(sweep, node)){
+        if(block_size == sweep->block_capacity){
+            size_t new_capacity = sweep->block_capacity * 2 + 8;
+            size_t* new_block = geometry_allocator_reallocate(NULL, sweep->block, sweep->block_capacity * sizeof(*new_block), new_capacity * sizeof(*new_block));
+            if(new_block == NULL){
+                sweep->failed = true;
+                return;
+            }
+            sweep->block = new_block;
+            sweep->block_capacity = new_capacity;
+        }
+        sweep->block[block_size++] = node;
+        if(node == upper){
+            break;
+        }
+    }
+    // reorder segments of the group as they lie right of the crossing point,
+    // nodes stay in place, segments are moved between them
+    size_t* block = sweep->block;
+    for(size_t i = 0; i < block_size; i++){
+        block[i] = sweep->nodes[block[i]].segment;
+    }
+    for(size_t i = 1; i < block_size; i++){
+        size_t segment = block[i];
+        size_t j = i;
+        while(j > 0 && geometry_sweep_compareSlopes(sweep, segment, block[j - 1]) < 0){
+            block[j] = block[j - 1];
+            j--;
+        }
+        block[j] = segment;
+    }
+    size_t node = lower;
+    for(size_t i = 0; i < block_size; i++){
+        sweep->nodes[node].segment = block[i];
+        sweep->node_of_segment[block[i]] = node;
+        for(size_t j = 0; j < i; j++){
+            geometry_sweep_report(sweep, block[j], block[i], x, y);
+        }
+        node = geometry_sweep_successor(sweep, node);
+    }
+    geometry_sweep_testPair(sweep, geometry_sweep_predecessor(sweep, lower), lower);
+    geometry_sweep_testPair(sweep, upper, geometry_sweep_successor(sweep, upper));
+}
+
+/**
+*   Function to handle crossing of two segments
+*   Every segment lying between them in status goes through the same point,
+*   so whole group is reported and reordered by slope at once
+*   In params:
+*       geometry_sweep* sweep               sweep state
+*       geometry_sweep_event* event         crossing event
+*
+*   Out params/return:
+*       none (sweep state is changed)
+*/
+static void geometry_sweep_handleCross(geometry_sweep* sweep, geometry_sweep_event* event){
+    if(geometry_sweep_isReported(sweep, event->first, event->second)){
+        return;
+    }
+    size_t first_node = sweep->node_of_segment[event->first];
+    size_t second_node = sweep->node_of_segment[event->second];
+    // walk both ways from the first segment, cost is proportional to group size
+    size_t lower = GEOMETRY_SWEEP_NONE;
+    size_t upper = first_node;
+    size_t down = first_node;
+    while(lower == GEOMETRY_SWEEP_NONE && (upper != GEOMETRY_SWEEP_NONE || down != GEOMETRY_SWEEP_NONE)){
+        if(upper != GEOMETRY_SWEEP_NONE){
+            upper = geometry_sweep_successor(sweep, upper);
+            if(upper == second_node){
+                lower = first_node;
+            }
+        }
+        if(lower == GEOMETRY_SWEEP_NONE && down != GEOMETRY_SWEEP_NONE){
+            down = geometry_sweep_predecessor(sweep, down);
+            if(down == second_node){
+                lower = second_node;
+                upper = first_node;
+            }
+        }
+    }
+    if(lower == GEOMETRY_SWEEP_NONE){
+        geometry_sweep_report(sweep, event->first, event->second, event->point_x, event->point_y);
+        return;
+    }
+    geometry_sweep_orderBlock(sweep, lower, upper, event->point_x, event->point_y);
+}
+
+/**
+*   Function to find segments of status going through given point and order them by slope
+*   Crossing point is rounded, so crossing exactly at a point where other segment starts or ends
+*   may be scheduled just after that point. Segments going through the point are reordered before
+*   its first start or end is handled, otherwise segment starting there would be put between them
+*   in wrong order and separate segments that still have to be tested.
+*   In params:
+*       geometry_sweep* sweep       sweep state
+*       double x, y                 point of current event
+*
+*   Out params/return:
+*       none (sweep state is changed)
+*/
+static void geometry_sweep_orderThroughPoint(geometry_sweep* sweep, double x, double y){
+    size_t node = sweep->root;
+    while(node != GEOMETRY_SWEEP_NONE){
+        geometry_sweep_segment* segment = &sweep->segments[sweep->nodes[node].segment];
+        if(geometry_sweep_contains(segment, x, y)){
+            break;
+        }
+        int side = geometry_sweep_orientation(segment->left_x, segment->left_y, segment->right_x, segment->right_y, x, y);
+        if(side == 0){
+            // point on extension of vertical segment that ended below it
+            side = geometry_sweep_pointLess(x, y, segment->left_x, segment->left_y) ? -1 : 1;
+        }
+        node = side < 0 ? sweep->nodes[node].left : sweep->nodes[node].right;
+    }
+    if(node == GEOMETRY_SWEEP_NONE){
+        return;
+    }
+    size_t lower = node;
+    size_t upper = node;
+    for(size_t other = geometry_sweep_predecessor(sweep, lower); other != GEOMETRY_SWEEP_NONE; other = geometry_sweep_predecessor(sweep, other)){
+        if(!geometry_sweep_contains(&sweep->segments[sweep->nodes[other].segment], x, y)){
+            break;
+        }
+        lower = other;
+    }
+    for(size_t other = geometry_sweep_successor(sweep, upper); other != GEOMETRY_SWEEP_NONE; other = geometry_sweep_successor(sweep, other)){
+        if(!geometry_sweep_contains(&sweep->segments[sweep->nodes[other].segment], x, y)){
+            break;
+        }
+        upper = other;
+    }
+    if(lower != upper){
+        geometry_sweep_orderBlock(sweep, lower, upper, x, y);
+    }
+}
+
+/**
+*   Function to find all intersecting pairs among given segments with plane sweep
+*   In params:
+*       geometry_sweep_segment* segments            segments with ordered ends
+*       size_t count                                number of segments
+*       size_t capacity                             number of elements in intersections array
+*
+*   Out params:
+*       geometry_intersection* intersections        found intersections
+*
+*   Return:
+*       size_t                                      number of all intersecting pairs,
+*                                                   GEOMETRY_SWEEP_ERROR if error occured
+*/
+static size_t geometry_sweep_run(geometry_sweep_segment* segments, size_t count, geometry_intersection* intersections, size_t capacity){
+    if(count == 0){
+        return 0;
+    }
+    geometry_sweep sweep = {0};
+    sweep.segments = segments;
+    sweep.count = count;
+    sweep.root = GEOMETRY_SWEEP_NONE;
+    sweep.random_state = 2463534242u;
+    sweep.intersections = intersections;
+    sweep.capacity = intersections == NULL ? 0 : capacity;
+    sweep.nodes = geometry_allocator_allocate(NULL, count * sizeof(*sweep.nodes));
+    sweep.node_of_segment = geometry_allocator_allocate(NULL, count * sizeof(*sweep.node_of_segment));
+    sweep.ended = geometry_allocator_allocate(NULL, count * sizeof(*sweep.ended));
+    sweep.event_capacity = 2 * count + 16;
+    sweep.events = geometry_allocator_allocate(NULL, sweep.event_capacity * sizeof(*sweep.events));
+    sweep.pair_capacity = 64;
+    sweep.pairs = geometry_allocator_allocateZeroed(NULL, sweep.pair_capacity, sizeof(*sweep.pairs));
+    sweep.failed = sweep.nodes == NULL || sweep.node_of_segment == NULL || sweep.ended == NULL || sweep.events == NULL || sweep.pairs == NULL;
+    for(size_t i = 0; i < count && !sweep.failed; i++){
+        geometry_sweep_event start = {segments[i].left_x, segments[i].left_y, GEOMETRY_SWEEP_START, i, i, segments[i].left_x, segments[i].left_y};
+        geometry_sweep_event end = {segments[i].right_x, segments[i].right_y, GEOMETRY_SWEEP_END, i, i, segments[i].right_x, segments[i].right_y};
+        geometry_sweep_pushEvent(&sweep, &start);
+        // segment being a single point is handled whole at its start
+        if(geometry_sweep_pointLess(start.x, start.y, end.x, end.y)){
+            geometry_sweep_pushEvent(&sweep, &end);
+        }
+    }
+    while(sweep.event_count > 0 && !sweep.failed){
+        geometry_sweep_event event = geometry_sweep_popEvent(&sweep);
+        bool new_point = event.x != sweep.current.x || event.y != sweep.current.y || sweep.current.type == GEOMETRY_SWEEP_CROSS;
+        if(event.x != sweep.current.x || event.y != sweep.current.y){
+            sweep.ended_count = 0;
+        }
+        if(event.type != GEOMETRY_SWEEP_CROSS && new_point){
+            geometry_sweep_orderThroughPoint(&sweep, event.x, event.y);
+        }
+        sweep.current = event;
+        if(event.type == GEOMETRY_SWEEP_CROSS){
+            geometry_sweep_handleCross(&sweep, &event);
+        }
+        else if(event.type == GEOMETRY_SWEEP_END){
+            size_t node = sweep.node_of_segment[event.first];
+            geometry_sweep_reportThroughPoint(&sweep, node, event.x, event.y);
+            size_t lower = geometry_sweep_predecessor(&sweep, node);
+            size_t upper = geometry_sweep_successor(&sweep, node);
+            geometry_sweep_remove(&sweep, node);
+            geometry_sweep_testPair(&sweep, lower, upper);
+            sweep.ended[sweep.ended_count++] = event.first;
+        }
+        else{
+            size_t node = geometry_sweep_insert(&sweep, event.first);
+            geometry_sweep_reportThroughPoint(&sweep, node, event.x, event.y);
+            // segments ending here are already out of status
+            for(size_t i = 0; i < sweep.ended_count; i++){
+                geometry_sweep_report(&sweep, event.first, sweep.ended[i], event.x, event.y);
+            }
+            geometry_sweep_segment* segment = &sweep.segments[event.first];
+            if(segment->left_x == segment->right_x && segment->left_y == segment->right_y){
+                geometry_sweep_remove(&sweep, node);
+                sweep.ended[sweep.ended_count++] = event.first;
+                continue;
+            }
+            geometry_sweep_testPair(&sweep, geometry_sweep_predecessor(&sweep, node), node);
+            geometry_sweep_testPair(&sweep, node, geometry_sweep_successor(&sweep, node));
+        }
+    }
+    geometry_allocator_free(NULL, sweep.nodes);
+    geometry_allocator_free(NULL, sweep.node_of_segment);
+    geometry_allocator_free(NULL, sweep.ended);
+    geometry_allocator_free(NULL, sweep.events);
+    geometry_allocator_free(NULL, sweep.pairs);
+    geometry_allocator_free(NULL, sweep.block);
+    if(sweep.failed){
+        return GEOMETRY_SWEEP_ERROR;
+    }
+    return sweep.pair_count;
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to find all intersecting pairs among given segments
+*   Bentley-Ottmann plane sweep is used, so it takes O((n+k) log n) time
+*   for n segments and k intersections instead of checking every pair.
+*   Segments are treated as closed, so segments touching with their ends
+*   are reported too.
+*   In params:
+*       geometry_segment** segments                 array of segments
+*       size_t count                                number of segments
+*       size_t capacity                             number of elements in intersections array
+*
+*   Out params:
+*       geometry_intersection* intersections        found intersections, at most capacity elements
+*                                                   are written, order of pairs is unspecified
+*
+*   Return:
+*       size_t                                      number of all intersecting pairs (may be larger than capacity),
+*                                                   (size_t)-1 if error occured
+*/
+size_t geometry_segment_calculateIntersections(geometry_segment** segments, size_t count, geometry_intersection* intersections, size_t capacity){
+    if(segments == NULL && count > 0){
+        return GEOMETRY_SWEEP_ERROR;
+    }
+    double* coordinates = geometry_allocator_allocate(NULL, 4 * count * sizeof(*coordinates) + 1);
+    if(coordinates == NULL){
+        return GEOMETRY_SWEEP_ERROR;
+    }
+    for(size_t i = 0; i < count; i++){
+        geometry_point* start = NULL;
+        geometry_point* end = NULL;
+        if(segments[i] == NULL){
+            geometry_allocator_free(NULL, coordinates);
+            return GEOMETRY_SWEEP_ERROR;
+        }
+        geometry_segment_getPoints(segments[i], &start, &end);
+        coordinates[4 * i] = geometry_point_getX(start);
+        coordinates[4 * i + 1] = geometry_point_getY(start);
+        coordinates[4 * i + 2] = geometry_point_getX(end);
+        coordinates[4 * i + 3] = geometry_point_getY(end);
+    }
+    size_t result = geometry_segment_calculateIntersectionsFlat(coordinates, count, intersections, capacity);
+    geometry_allocator_free(NULL, coordinates);
+    return result;
+}
+
+/**
+*   Function to find all intersecting pairs among segments given as flat array of coordinates
+*   Works the same as geometry_segment_calculateIntersections
+*   In params:
+*       const double* coordinates                   array of 4 * count coordinates,
+*                                                   start x, start y, end x, end y of each segment
+*       size_t count                                number of segments
+*       size_t capacity                             number of elements in intersections array
+*
+*   Out params:
+*       geometry_intersection* intersections        found intersections, at most capacity elements
+*                                                   are written, order of pairs is unspecified
+*
+*   Return:
+*       size_t                                      number of all intersecting pairs (may be larger than capacity),
+*                                                   (size_t)-1 if error occured
+*/
+size_t geometry_segment_calculateIntersectionsFlat(const double* coordinates, size_t count, geometry_intersection* intersections, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_SEGMENT_CALCULATE_INTERSECTIONS);
+    if(coordinates == NULL && count > 0){
+        return GEOMETRY_SWEEP_ERROR;
+    }
+    geometry_sweep_segment* segments = geometry_allocator_allocate(NULL, count * sizeof(*segments) + 1);
+    if(segments == NULL){
+        return GEOMETRY_SWEEP_ERROR;
+    }
+    for(size_t i = 0; i < count; i++){
+        const double* segment = coordinates + 4 * i;
+        bool swap = geometry_sweep_pointLess(segment[2], segment[3], segment[0], segment[1]);
+        segments[i].left_x = swap ? segment[2] : segment[0];
+        segments[i].left_y = swap ? segment[3] : segment[1];
+        segments[i].right_x = swap ? segment[0] : segment[2];
+        segments[i].right_y = swap ? segment[1] : segment[3];
+    }
+    size_t result = geometry_sweep_run(segments, count, intersections, capacity);
+    geometry_allocator_free(NULL, segments);
+    return result;
+}
@@ -0,0 +1,62 @@
+#ifndef GEOMETRY_SWEEP
+#define GEOMETRY_SWEEP
+
+#include "geometry.h"
+#include <stddef.h>
+
+// Single result of batch segment intersection - indices of intersecting
+// segments in input array (first < second) and their common point.
+// For colinear overlapping segments the point is the first common point
+// in order of increasing x (then y) coordinate.
+typedef struct geometry_intersection {
+    size_t first;
+    size_t second;
+    double x;
+    double y;
+} geometry_intersection;
+
+/*###############################################################
+ GEOMETRY_SEGMENT batch intersection functions declarations
+################################################################*/
+
+/**
+*   Function to find all intersecting pairs among given segments
+*   Bentley-Ottmann plane sweep is used, so it takes O((n+k) log n) time
+*   for n segments and k intersections instead of checking every pair.
+*   Segments are treated as closed, so segments touching with their ends
+*   are reported too.
+*   In params:
+*       geometry_segment** segments                 array of segments
+*       size_t count                                number of segments
+*       size_t capacity                             number of elements in intersections array
+*
+*   Out params:
+*       geometry_intersection* intersections        found intersections, at most capacity elements
+*                                                   are written, order of pairs is unspecified
+*
+*   Return:
+*       size_t                                      number of all intersecting pairs (may be larger than capacity),
+*                                                   (size_t)-1 if error occured
+*/
+size_t geometry_segment_calculateIntersections(geometry_segment** segments, size_t count, geometry_intersection* intersections, size_t capacity);
+
+/**
+*   Function to find all intersecting pairs among segments given as flat array of coordinates
+*   Works the same as geometry_segment_calculateIntersections
+*   In params:
+*       const double* coordinates                   array of 4 * count coordinates,
+*                                                   start x, start y, end x, end y of each segment
+*       size_t count                                number of segments
+*       size_t capacity                             number of elements in intersections array
+*
+*   Out params:
+*       geometry_intersection* intersections        found intersections, at most capacity elements
+*                                                   are written, order of pairs is unspecified
+*
+*   Return:
+*       size_t                                      number of all intersecting pairs (may be larger than capacity),
+*                                                   (size_t)-1 if error occured
+*/
+size_t geometry_segment_calculateIntersectionsFlat(const double* coordinates, size_t count, geometry_intersection* intersections, size_t capacity);
+
+#endif
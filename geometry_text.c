@@ -0,0 +1,1113 @@
+#include "geometry_text.h"
+#include "geometry_binary.h"
+#include "geometry_stats.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <locale.h>
+
+// most numbers in one line - closed polygon has four vertices
+#define GEOMETRY_TEXT_MAX_NUMBERS 8
+// longest line of single shape written by writer
+#define GEOMETRY_TEXT_MAX_SHAPE_LINE 512
+// mantissas up to 2^53 are exact doubles
+#define GEOMETRY_TEXT_EXACT_MANTISSA (UINT64_C(1) << 53)
+// most significant digits kept in 64-bit mantissa
+#define GEOMETRY_TEXT_MAX_DIGITS 19
+// most decimal places written without formatting functions
+#define GEOMETRY_TEXT_MAX_DECIMALS 9
+// longest number converted by strtod without allocating memory for its copy
+#define GEOMETRY_TEXT_NUMBER_BUFFER 64
+
+// powers of ten that are exact doubles
+static const double geometry_text_powers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#define GEOMETRY_TEXT_MAX_POWER 22
+
+struct geometry_text_reader {
+    FILE* file;
+    // chunk of file, one byte more than chunk size for terminating 0 of last line
+    char* chunk;
+    // part of chunk that is not parsed yet
+    size_t begin;
+    size_t end;
+    bool finished;
+    bool failed;
+    size_t line;
+    size_t capacity;
+    geometry_text_kind* kinds;
+    size_t count;
+    double* points[2];
+    size_t point_count;
+    double* segments[4];
+    size_t segment_count;
+    double* triangles[6];
+    unsigned char* flags;
+    size_t triangle_count;
+    geometry_allocator allocator;
+};
+
+struct geometry_text_writer {
+    FILE* file;
+    char* chunk;
+    size_t size;
+    geometry_text_format format;
+    // set after first failed write, so errors are not lost between flushes
+    bool failed;
+    geometry_allocator allocator;
+};
+
+// LOCAL FUNCTIONS DECLARATIONS
+
+static bool geometry_text_isDigit(char character);
+static bool geometry_text_isSeparator(char character);
+static bool geometry_text_endsNumber(char character);
+static bool geometry_text_matchKeyword(const char* word, size_t length, const char* keyword);
+static double geometry_text_convert(const char* text, size_t length);
+static bool geometry_text_reader_parseLine(geometry_text_reader* reader, char* line);
+static bool geometry_text_reader_fill(geometry_text_reader* reader);
+static bool geometry_text_writer_reserve(geometry_text_writer* writer, size_t size);
+static void geometry_text_writer_writeShape(geometry_text_writer* writer, geometry_text_kind kind, const double* numbers, bool is_right);
+
+// LOCAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to check if character is decimal digit (locale independent)
+*   In params:
+*       char character      character
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                true if character is digit
+*/
+static bool geometry_text_isDigit(char character){
+    return character >= '0' && character <= '9';
+}
+
+/**
+*   Function to check if character separates numbers in line
+*   In params:
+*       char character      character
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                true if character is separator
+*/
+static bool geometry_text_isSeparator(char character){
+    return character == ',' || character == ' ' || character == '\t' || character == '(' || character == ')';
+}
+
+/**
+*   Function to check if character may follow number in line
+*   Numbers have to be separated, so "1-2" or "1.5.3" are not read as two numbers
+*   In params:
+*       char character      character after number
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                true if character is white space, comma, closing bracket or end of line
+*/
+static bool geometry_text_endsNumber(char character){
+    return character == ',' || character == ' ' || character == '\t' || character == ')' || character == '\0' || character == '\r';
+}
+
+/**
+*   Function to compare word with keyword ignoring case
+*   In params:
+*       const char* word        word, not terminated
+*       size_t length           length of word
+*       const char* keyword     upper case keyword
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                    true if word is keyword
+*/
+static bool geometry_text_matchKeyword(const char* word, size_t length, const char* keyword){
+    if(strlen(keyword) != length){
+        return false;
+    }
+    for(size_t i = 0; i < length; i++){
+        char character = word[i] >= 'a' && word[i] <= 'z' ? (char)(word[i] - 'a' + 'A') : word[i];
+        if(character != keyword[i]){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+*   Function to convert number with strtod independently of locale
+*   strtod expects decimal point of current locale (LC_NUMERIC), so number is copied
+*   with '.' replaced by that decimal point
+*   In params:
+*       const char* text        number already checked by geometry_text_parseDouble
+*       size_t length           length of number
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       double                  closest double, NAN if error occured
+*/
+static double geometry_text_convert(const char* text, size_t length){
+    const char* point = localeconv()->decimal_point;
+    size_t point_length = strlen(point);
+    // number has at most one decimal point
+    size_t size = length + point_length + 1;
+    char buffer[GEOMETRY_TEXT_NUMBER_BUFFER];
+    char* copy = size <= sizeof(buffer) ? buffer : geometry_allocator_allocate(NULL, size);
+    if(copy == NULL){
+        return NAN;
+    }
+    size_t copied = 0;
+    for(size_t i = 0; i < length; i++){
+        if(text[i] == '.'){
+            memcpy(copy + copied, point, point_length);
+            copied += point_length;
+        }
+        else{
+            copy[copied++] = text[i];
+        }
+    }
+    copy[copied] = '\0';
+    double value = strtod(copy, NULL);
+    if(copy != buffer){
+        geometry_allocator_free(NULL, copy);
+    }
+    return value;
+}
+
+/**
+*   Function to parse single line and append its shape to batch
+*   In params:
+*       geometry_text_reader* reader    reader with space for one more shape
+*       char* line                      line terminated with 0, without new line character
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success (also for skipped lines), false if line is not valid
+*/
+static bool geometry_text_reader_parseLine(geometry_text_reader* reader, char* line){
+    char* position = line;
+    while(*position == ' ' || *position == '\t'){
+        position++;
+    }
+    if(*position == '\0' || *position == '\r' || *position == '#'){
+        return true;
+    }
+    // 0 - CSV, otherwise kind of WKT shape plus one
+    int keyword = 0;
+    if((*position >= 'A' && *position <= 'Z') || (*position >= 'a' && *position <= 'z')){
+        char* word = position;
+        while((*position >= 'A' && *position <= 'Z') || (*position >= 'a' && *position <= 'z')){
+            position++;
+        }
+        size_t length = (size_t)(position - word);
+        if(geometry_text_matchKeyword(word, length, "POINT")){
+            keyword = GEOMETRY_TEXT_POINT + 1;
+        }
+        else if(geometry_text_matchKeyword(word, length, "LINESTRING")){
+            keyword = GEOMETRY_TEXT_SEGMENT + 1;
+        }
+        else if(geometry_text_matchKeyword(word, length, "POLYGON") || geometry_text_matchKeyword(word, length, "TRIANGLE")){
+            keyword = GEOMETRY_TEXT_TRIANGLE + 1;
+        }
+        else if(geometry_text_matchKeyword(word, length, "INF") || geometry_text_matchKeyword(word, length, "INFINITY") || geometry_text_matchKeyword(word, length, "NAN")){
+            // CSV line starting with non-finite number
+            position = word;
+        }
+        else{
+            return false;
+        }
+    }
+    double numbers[GEOMETRY_TEXT_MAX_NUMBERS];
+    size_t count = 0;
+    while(true){
+        while(geometry_text_isSeparator(*position)){
+            position++;
+        }
+        if(*position == '\0' || *position == '\r'){
+            break;
+        }
+        if(count == GEOMETRY_TEXT_MAX_NUMBERS){
+            return false;
+        }
+        char* end;
+        numbers[count] = geometry_text_parseDouble(position, &end);
+        if(end == position || !geometry_text_endsNumber(*end)){
+            return false;
+        }
+        position = end;
+        count++;
+    }
+    geometry_text_kind kind;
+    bool is_right = false;
+    if(keyword == 0){
+        if(count == 2){
+            kind = GEOMETRY_TEXT_POINT;
+        }
+        else if(count == 4){
+            kind = GEOMETRY_TEXT_SEGMENT;
+        }
+        else if(count == 6 || (count == 7 && (numbers[6] == 0 || numbers[6] == 1))){
+            kind = GEOMETRY_TEXT_TRIANGLE;
+            is_right = count == 7 && numbers[6] == 1;
+        }
+        else{
+            return false;
+        }
+    }
+    else{
+        kind = (geometry_text_kind)(keyword - 1);
+        size_t expected = kind == GEOMETRY_TEXT_POINT ? 2 : kind == GEOMETRY_TEXT_SEGMENT ? 4 : 6;
+        bool closed = kind == GEOMETRY_TEXT_TRIANGLE && count == 8 && numbers[6] == numbers[0] && numbers[7] == numbers[1];
+        if(count != expected && !closed){
+            return false;
+        }
+    }
+    if(kind == GEOMETRY_TEXT_POINT){
+        reader->points[0][reader->point_count] = numbers[0];
+        reader->points[1][reader->point_count] = numbers[1];
+        reader->point_count++;
+    }
+    else if(kind == GEOMETRY_TEXT_SEGMENT){
+        for(int i = 0; i < 4; i++){
+            reader->segments[i][reader->segment_count] = numbers[i];
+        }
+        reader->segment_count++;
+    }
+    else{
+        for(int i = 0; i < 6; i++){
+            reader->triangles[i][reader->triangle_count] = numbers[i];
+        }
+        reader->flags[reader->triangle_count] = is_right ? GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT : 0;
+        reader->triangle_count++;
+    }
+    reader->kinds[reader->count] = kind;
+    reader->count++;
+    return true;
+}
+
+/**
+*   Function to move unparsed part of chunk to its beginning and read more of file after it
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success (also at end of file), false if error occured
+*/
+static bool geometry_text_reader_fill(geometry_text_reader* reader){
+    size_t left = reader->end - reader->begin;
+    memmove(reader->chunk, reader->chunk + reader->begin, left);
+    reader->begin = 0;
+    reader->end = left;
+    size_t size = fread(reader->chunk + left, 1, GEOMETRY_TEXT_CHUNK_SIZE - left, reader->file);
+    reader->end += size;
+    if(size == 0){
+        if(ferror(reader->file)){
+            return false;
+        }
+        reader->finished = true;
+    }
+    return true;
+}
+
+/**
+*   Function to make sure there is space for given number of characters in chunk of writer
+*   In params:
+*       geometry_text_writer* writer    writer
+*       size_t size                     number of characters, at most chunk size
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+static bool geometry_text_writer_reserve(geometry_text_writer* writer, size_t size){
+    if(writer->size + size <= GEOMETRY_TEXT_CHUNK_SIZE){
+        return true;
+    }
+    if(fwrite(writer->chunk, 1, writer->size, writer->file) != writer->size){
+        writer->failed = true;
+    }
+    writer->size = 0;
+    return !writer->failed;
+}
+
+/**
+*   Function to write line of single shape to chunk of writer, that has space for it
+*   In params:
+*       geometry_text_writer* writer    writer
+*       geometry_text_kind kind         kind of shape
+*       const double* numbers           coordinates of shape
+*       bool is_right                   true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       none
+*/
+static void geometry_text_writer_writeShape(geometry_text_writer* writer, geometry_text_kind kind, const double* numbers, bool is_right){
+    static const char* const prefixes[] = {"POINT (", "LINESTRING (", "POLYGON (("};
+    static const char* const suffixes[] = {")", ")", "))"};
+    size_t count = kind == GEOMETRY_TEXT_POINT ? 2 : kind == GEOMETRY_TEXT_SEGMENT ? 4 : 6;
+    char* text = writer->chunk + writer->size;
+    if(writer->format == GEOMETRY_TEXT_CSV){
+        for(size_t i = 0; i < count; i++){
+            if(i > 0){
+                *text++ = ',';
+            }
+            text += geometry_text_formatDouble(numbers[i], text);
+        }
+        if(kind == GEOMETRY_TEXT_TRIANGLE){
+            *text++ = ',';
+            *text++ = is_right ? '1' : '0';
+        }
+    }
+    else{
+        size_t length = strlen(prefixes[kind]);
+        memcpy(text, prefixes[kind], length);
+        text += length;
+        // polygon is closed with its first vertex
+        size_t written = kind == GEOMETRY_TEXT_TRIANGLE ? 8 : count;
+        for(size_t i = 0; i < written; i++){
+            if(i > 0){
+                *text++ = i % 2 == 0 ? ',' : ' ';
+                if(i % 2 == 0){
+                    *text++ = ' ';
+                }
+            }
+            text += geometry_text_formatDouble(numbers[i % count], text);
+        }
+        length = strlen(suffixes[kind]);
+        memcpy(text, suffixes[kind], length);
+        text += length;
+    }
+    *text++ = '\n';
+    writer->size = (size_t)(text - writer->chunk);
+}
+
+// GLOBAL FUNCTIONS DEFINITIONS
+
+/**
+*   Function to create new geometry_text_reader object reading from given file
+*   In params:
+*       FILE* file              open file, it is not closed by reader
+*       size_t capacity         maximal number of shapes in one batch, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_text_reader*   pointer to created object, NULL if error occured
+*/
+geometry_text_reader* geometry_text_reader_new(FILE* file, size_t capacity){
+    return geometry_text_reader_new_with(NULL, file, capacity);
+}
+
+/**
+*   Function to create new geometry_text_reader object reading from given file with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       FILE* file                              open file, it is not closed by reader
+*       size_t capacity                         maximal number of shapes in one batch, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_text_reader*   pointer to created object, NULL if error occured
+*/
+geometry_text_reader* geometry_text_reader_new_with(const geometry_allocator* allocator, FILE* file, size_t capacity){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TEXT_READER_NEW);
+    if(file == NULL || capacity == 0 || capacity > SIZE_MAX / sizeof(double)){
+        return NULL;
+    }
+    geometry_text_reader* new_reader = geometry_allocator_allocateZeroed(allocator, 1, sizeof(*new_reader));
+    if(new_reader == NULL){
+        return NULL;
+    }
+    new_reader->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    allocator = &new_reader->allocator;
+    new_reader->file = file;
+    new_reader->capacity = capacity;
+    new_reader->chunk = geometry_allocator_allocate(allocator, GEOMETRY_TEXT_CHUNK_SIZE + 1);
+    new_reader->kinds = geometry_allocator_allocate(allocator, capacity * sizeof(geometry_text_kind));
+    new_reader->flags = geometry_allocator_allocate(allocator, capacity);
+    bool allocated = new_reader->chunk != NULL && new_reader->kinds != NULL && new_reader->flags != NULL;
+    for(int i = 0; i < 2; i++){
+        new_reader->points[i] = geometry_allocator_allocate(allocator, capacity * sizeof(double));
+        allocated = allocated && new_reader->points[i] != NULL;
+    }
+    for(int i = 0; i < 4; i++){
+        new_reader->segments[i] = geometry_allocator_allocate(allocator, capacity * sizeof(double));
+        allocated = allocated && new_reader->segments[i] != NULL;
+    }
+    for(int i = 0; i < 6; i++){
+        new_reader->triangles[i] = geometry_allocator_allocate(allocator, capacity * sizeof(double));
+        allocated = allocated && new_reader->triangles[i] != NULL;
+    }
+    if(!allocated){
+        geometry_text_reader_destroy(new_reader);
+        return NULL;
+    }
+    return new_reader;
+}
+
+/**
+*   Function to destroy given geometry_text_reader object
+*   In params:
+*       geometry_text_reader* reader    reader object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_text_reader_destroy(geometry_text_reader* reader){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TEXT_READER_DESTROY);
+    if(reader == NULL){
+        return;
+    }
+    geometry_allocator allocator = reader->allocator;
+    geometry_allocator_free(&allocator, reader->chunk);
+    geometry_allocator_free(&allocator, reader->kinds);
+    geometry_allocator_free(&allocator, reader->flags);
+    for(int i = 0; i < 2; i++){
+        geometry_allocator_free(&allocator, reader->points[i]);
+    }
+    for(int i = 0; i < 4; i++){
+        geometry_allocator_free(&allocator, reader->segments[i]);
+    }
+    for(int i = 0; i < 6; i++){
+        geometry_allocator_free(&allocator, reader->triangles[i]);
+    }
+    geometry_allocator_free(&allocator, reader);
+}
+
+/**
+*   Function to read next batch of shapes, arrays of previous batch are overwritten
+*   Invalid line ends batch - shapes of lines before it are returned and the next call fails,
+*   so no valid shape is lost, however lines are split into batches
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                          number of shapes in batch (at most capacity), 0 at end of file,
+*                                       (size_t)-1 if error occured - line that couldn't be parsed
+*                                       is given by geometry_text_reader_getLine
+*/
+size_t geometry_text_reader_read(geometry_text_reader* reader){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TEXT_READER_READ);
+    if(reader == NULL || reader->failed){
+        return (size_t)-1;
+    }
+    reader->count = 0;
+    reader->point_count = 0;
+    reader->segment_count = 0;
+    reader->triangle_count = 0;
+    while(reader->count < reader->capacity){
+        char* line = reader->chunk + reader->begin;
+        char* new_line = memchr(line, '\n', reader->end - reader->begin);
+        if(new_line != NULL){
+            reader->begin = (size_t)(new_line - reader->chunk) + 1;
+        }
+        else if(reader->finished){
+            if(reader->begin == reader->end){
+                break;
+            }
+            // last line without new line character
+            new_line = reader->chunk + reader->end;
+            reader->begin = reader->end;
+        }
+        else{
+            if(reader->begin == 0 && reader->end == GEOMETRY_TEXT_CHUNK_SIZE){
+                // line doesn't fit in chunk
+                reader->line++;
+                reader->failed = true;
+                break;
+            }
+            if(!geometry_text_reader_fill(reader)){
+                reader->failed = true;
+                break;
+            }
+            continue;
+        }
+        *new_line = '\0';
+        reader->line++;
+        if(!geometry_text_reader_parseLine(reader, line)){
+            reader->failed = true;
+            break;
+        }
+    }
+    // shapes read before error are returned, error is reported by next call
+    return reader->failed && reader->count == 0 ? (size_t)-1 : reader->count;
+}
+
+/**
+*   Function to get kinds of shapes of last batch in order of lines
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const geometry_text_kind*       array of kinds, as many as shapes in batch, NULL if reader is NULL
+*/
+const geometry_text_kind* geometry_text_reader_getKinds(geometry_text_reader* reader){
+    if(reader == NULL){
+        return NULL;
+    }
+    return reader->kinds;
+}
+
+/**
+*   Function to get points of last batch
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       const double** xs               x coordinates of points
+*       const double** ys               y coordinates of points
+*
+*   Return:
+*       size_t                          number of points, in order of lines
+*/
+size_t geometry_text_reader_getPoints(geometry_text_reader* reader, const double** xs, const double** ys){
+    if(reader == NULL || xs == NULL || ys == NULL){
+        return 0;
+    }
+    *xs = reader->points[0];
+    *ys = reader->points[1];
+    return reader->point_count;
+}
+
+/**
+*   Function to get segments of last batch
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       const double* coordinates[4]    arrays of start x, start y, end x and end y of segments
+*
+*   Return:
+*       size_t                          number of segments, in order of lines
+*/
+size_t geometry_text_reader_getSegments(geometry_text_reader* reader, const double* coordinates[4]){
+    if(reader == NULL || coordinates == NULL){
+        return 0;
+    }
+    for(int i = 0; i < 4; i++){
+        coordinates[i] = reader->segments[i];
+    }
+    return reader->segment_count;
+}
+
+/**
+*   Function to get triangles of last batch
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       const double* coordinates[6]    arrays of first x, first y, second x, second y,
+*                                       third x and third y of triangles
+*       const unsigned char** flags     flags of triangles, as in geometry_triangle_buffer
+*
+*   Return:
+*       size_t                          number of triangles, in order of lines
+*/
+size_t geometry_text_reader_getTriangles(geometry_text_reader* reader, const double* coordinates[6], const unsigned char** flags){
+    if(reader == NULL || coordinates == NULL || flags == NULL){
+        return 0;
+    }
+    for(int i = 0; i < 6; i++){
+        coordinates[i] = reader->triangles[i];
+    }
+    *flags = reader->flags;
+    return reader->triangle_count;
+}
+
+/**
+*   Function to get number of lines read so far
+*   After error it is number of line that couldn't be parsed
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                          number of lines, 0 if reader is NULL
+*/
+size_t geometry_text_reader_getLine(geometry_text_reader* reader){
+    if(reader == NULL){
+        return 0;
+    }
+    return reader->line;
+}
+
+/**
+*   Function to parse decimal number
+*   Numbers with at most 15 significant digits and small exponents are calculated
+*   exactly with single multiplication or division, the rest is passed to strtod,
+*   so result is always the closest double. Decimal point is always '.', whatever
+*   locale is set. inf, infinity and nan (of any case, with optional sign) are accepted.
+*   In params:
+*       const char* text        text starting with number
+*
+*   Out params:
+*       char** end              pointer to first character after number, text if no number was found
+*
+*   Return:
+*       double                  parsed number
+*/
+double geometry_text_parseDouble(const char* text, char** end){
+    const char* position = text;
+    bool negative = *position == '-';
+    if(*position == '-' || *position == '+'){
+        position++;
+    }
+    // non-finite numbers as written by geometry_text_formatDouble
+    bool infinite = geometry_text_matchKeyword(position, 3, "INF");
+    if(infinite || geometry_text_matchKeyword(position, 3, "NAN")){
+        size_t length = infinite && geometry_text_matchKeyword(position, 8, "INFINITY") ? 8 : 3;
+        if(end != NULL){
+            *end = (char*)position + length;
+        }
+        double value = infinite ? INFINITY : NAN;
+        return negative ? -value : value;
+    }
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool found = false;
+    // digits that didn't fit in mantissa, result needs strtod then
+    bool truncated = false;
+    for(; geometry_text_isDigit(*position); position++){
+        found = true;
+        if(digits < GEOMETRY_TEXT_MAX_DIGITS){
+            mantissa = mantissa * 10 + (uint64_t)(*position - '0');
+            digits += mantissa != 0;
+        }
+        else{
+            truncated = true;
+            exponent++;
+        }
+    }
+    if(*position == '.'){
+        position++;
+        for(; geometry_text_isDigit(*position); position++){
+            found = true;
+            if(digits < GEOMETRY_TEXT_MAX_DIGITS){
+                mantissa = mantissa * 10 + (uint64_t)(*position - '0');
+                digits += mantissa != 0;
+                exponent--;
+            }
+            else{
+                truncated = true;
+            }
+        }
+    }
+    if(!found){
+        if(end != NULL){
+            *end = (char*)text;
+        }
+        return 0;
+    }
+    if(*position == 'e' || *position == 'E'){
+        const char* exponent_position = position + 1;
+        bool exponent_negative = *exponent_position == '-';
+        if(*exponent_position == '-' || *exponent_position == '+'){
+            exponent_position++;
+        }
+        if(geometry_text_isDigit(*exponent_position)){
+            int value = 0;
+            for(; geometry_text_isDigit(*exponent_position); exponent_position++){
+                // larger exponents overflow or underflow anyway
+                if(value < 100000){
+                    value = value * 10 + (*exponent_position - '0');
+                }
+            }
+            exponent += exponent_negative ? -value : value;
+            position = exponent_position;
+        }
+    }
+    if(end != NULL){
+        *end = (char*)position;
+    }
+    if(!truncated && mantissa <= GEOMETRY_TEXT_EXACT_MANTISSA && exponent >= -GEOMETRY_TEXT_MAX_POWER && exponent <= GEOMETRY_TEXT_MAX_POWER){
+        // both mantissa and power of ten are exact, so single rounding gives the closest double
+        double value = (double)mantissa;
+        value = exponent < 0 ? value / geometry_text_powers[-exponent] : value * geometry_text_powers[exponent];
+        return negative ? -value : value;
+    }
+    return geometry_text_convert(text, (size_t)(position - text));
+}
+
+/**
+*   Function to create new geometry_text_writer object writing to given file
+*   In params:
+*       FILE* file                      open file, it is not closed by writer
+*       geometry_text_format format     format of lines
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_text_writer*           pointer to created object, NULL if error occured
+*/
+geometry_text_writer* geometry_text_writer_new(FILE* file, geometry_text_format format){
+    return geometry_text_writer_new_with(NULL, file, format);
+}
+
+/**
+*   Function to create new geometry_text_writer object writing to given file with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       FILE* file                              open file, it is not closed by writer
+*       geometry_text_format format             format of lines
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_text_writer*           pointer to created object, NULL if error occured
+*/
+geometry_text_writer* geometry_text_writer_new_with(const geometry_allocator* allocator, FILE* file, geometry_text_format format){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TEXT_WRITER_NEW);
+    if(file == NULL || (format != GEOMETRY_TEXT_CSV && format != GEOMETRY_TEXT_WKT)){
+        return NULL;
+    }
+    geometry_text_writer* new_writer = geometry_allocator_allocate(allocator, sizeof(*new_writer));
+    if(new_writer == NULL){
+        return NULL;
+    }
+    new_writer->allocator = allocator != NULL ? *allocator : geometry_get_allocator();
+    new_writer->chunk = geometry_allocator_allocate(&new_writer->allocator, GEOMETRY_TEXT_CHUNK_SIZE);
+    if(new_writer->chunk == NULL){
+        geometry_allocator_free(&new_writer->allocator, new_writer);
+        return NULL;
+    }
+    new_writer->file = file;
+    new_writer->size = 0;
+    new_writer->format = format;
+    new_writer->failed = false;
+    return new_writer;
+}
+
+/**
+*   Function to destroy given geometry_text_writer object, buffered lines are written first
+*   In params:
+*       geometry_text_writer* writer    writer object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_text_writer_destroy(geometry_text_writer* writer){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TEXT_WRITER_DESTROY);
+    if(writer == NULL){
+        return;
+    }
+    geometry_text_writer_flush(writer);
+    geometry_allocator allocator = writer->allocator;
+    geometry_allocator_free(&allocator, writer->chunk);
+    geometry_allocator_free(&allocator, writer);
+}
+
+/**
+*   Function to write buffered lines to file
+*   In params:
+*       geometry_text_writer* writer    writer
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if this or any earlier write failed
+*/
+bool geometry_text_writer_flush(geometry_text_writer* writer){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TEXT_WRITER_FLUSH);
+    if(writer == NULL){
+        return false;
+    }
+    if(writer->size > 0 && fwrite(writer->chunk, 1, writer->size, writer->file) != writer->size){
+        writer->failed = true;
+    }
+    writer->size = 0;
+    if(fflush(writer->file) != 0){
+        writer->failed = true;
+    }
+    return !writer->failed;
+}
+
+/**
+*   Function to write point
+*   In params:
+*       geometry_text_writer* writer    writer
+*       double x                        x coordinate of point
+*       double y                        y coordinate of point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writePoint(geometry_text_writer* writer, double x, double y){
+    if(writer == NULL || !geometry_text_writer_reserve(writer, GEOMETRY_TEXT_MAX_SHAPE_LINE)){
+        return false;
+    }
+    double numbers[2] = {x, y};
+    geometry_text_writer_writeShape(writer, GEOMETRY_TEXT_POINT, numbers, false);
+    return true;
+}
+
+/**
+*   Function to write segment
+*   In params:
+*       geometry_text_writer* writer    writer
+*       const double coordinates[4]     start x, start y, end x and end y of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writeSegment(geometry_text_writer* writer, const double coordinates[4]){
+    if(writer == NULL || coordinates == NULL || !geometry_text_writer_reserve(writer, GEOMETRY_TEXT_MAX_SHAPE_LINE)){
+        return false;
+    }
+    geometry_text_writer_writeShape(writer, GEOMETRY_TEXT_SEGMENT, coordinates, false);
+    return true;
+}
+
+/**
+*   Function to write triangle
+*   In params:
+*       geometry_text_writer* writer    writer
+*       const double coordinates[6]     first x, first y, second x, second y, third x and third y of triangle
+*       bool is_right                   true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writeTriangle(geometry_text_writer* writer, const double coordinates[6], bool is_right){
+    if(writer == NULL || coordinates == NULL || !geometry_text_writer_reserve(writer, GEOMETRY_TEXT_MAX_SHAPE_LINE)){
+        return false;
+    }
+    geometry_text_writer_writeShape(writer, GEOMETRY_TEXT_TRIANGLE, coordinates, is_right);
+    return true;
+}
+
+/**
+*   Function to write points given as arrays of coordinates
+*   In params:
+*       geometry_text_writer* writer    writer
+*       const double* xs                x coordinates of points
+*       const double* ys                y coordinates of points
+*       size_t count                    number of points
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writePoints(geometry_text_writer* writer, const double* xs, const double* ys, size_t count){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TEXT_WRITER_WRITE_POINTS);
+    if(writer == NULL || ((xs == NULL || ys == NULL) && count > 0)){
+        return false;
+    }
+    for(size_t i = 0; i < count; i++){
+        if(!geometry_text_writer_writePoint(writer, xs[i], ys[i])){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+*   Function to write segments given as arrays of coordinates
+*   In params:
+*       geometry_text_writer* writer        writer
+*       const double* const coordinates[4]  arrays of start x, start y, end x and end y of segments
+*       size_t count                        number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_text_writer_writeSegments(geometry_text_writer* writer, const double* const coordinates[4], size_t count){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TEXT_WRITER_WRITE_SEGMENTS);
+    if(writer == NULL || (coordinates == NULL && count > 0)){
+        return false;
+    }
+    for(size_t i = 0; i < count; i++){
+        double numbers[4];
+        for(int j = 0; j < 4; j++){
+            numbers[j] = coordinates[j][i];
+        }
+        if(!geometry_text_writer_writeSegment(writer, numbers)){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+*   Function to write triangles given as arrays of coordinates
+*   In params:
+*       geometry_text_writer* writer        writer
+*       const double* const coordinates[6]  arrays of first x, first y, second x, second y,
+*                                           third x and third y of triangles
+*       const unsigned char* flags          flags of triangles, as in geometry_triangle_buffer,
+*                                           NULL if no triangle is right-angled
+*       size_t count                        number of triangles
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_text_writer_writeTriangles(geometry_text_writer* writer, const double* const coordinates[6], const unsigned char* flags, size_t count){
+    GEOMETRY_STATS_FUNCTION(GEOMETRY_STATS_TEXT_WRITER_WRITE_TRIANGLES);
+    if(writer == NULL || (coordinates == NULL && count > 0)){
+        return false;
+    }
+    for(size_t i = 0; i < count; i++){
+        double numbers[6];
+        for(int j = 0; j < 6; j++){
+            numbers[j] = coordinates[j][i];
+        }
+        bool is_right = flags != NULL && (flags[i] & GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT) != 0;
+        if(!geometry_text_writer_writeTriangle(writer, numbers, is_right)){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+*   Function to write line of text as it is, e.g. comment or results that are not shapes
+*   In params:
+*       geometry_text_writer* writer    writer
+*       const char* line                text without new line character, shorter than chunk size
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writeLine(geometry_text_writer* writer, const char* line){
+    if(writer == NULL || line == NULL){
+        return false;
+    }
+    size_t length = strlen(line);
+    if(length >= GEOMETRY_TEXT_CHUNK_SIZE || !geometry_text_writer_reserve(writer, length + 1)){
+        return false;
+    }
+    memcpy(writer->chunk + writer->size, line, length);
+    writer->chunk[writer->size + length] = '\n';
+    writer->size += length + 1;
+    return true;
+}
+
+/**
+*   Function to format number so that geometry_text_parseDouble gives it back exactly
+*   Numbers with at most 9 decimal places are written as plain decimals without
+*   formatting functions, the rest with 17 significant digits and '.' as decimal point
+*   whatever locale is set. Non-finite numbers are written as inf, -inf or nan.
+*   In params:
+*       double value            number
+*
+*   Out params:
+*       char* text              buffer of at least 32 characters, text is terminated with 0
+*
+*   Return:
+*       size_t                  number of written characters (without terminating 0)
+*/
+size_t geometry_text_formatDouble(double value, char* text){
+    if(text == NULL){
+        return 0;
+    }
+    double magnitude = fabs(value);
+    for(int decimals = 0; decimals <= GEOMETRY_TEXT_MAX_DECIMALS && isfinite(value); decimals++){
+        double scaled = magnitude * geometry_text_powers[decimals];
+        if(scaled >= (double)GEOMETRY_TEXT_EXACT_MANTISSA){
+            break;
+        }
+        if(scaled != floor(scaled)){
+            continue;
+        }
+        uint64_t mantissa = (uint64_t)scaled;
+        // parser divides the same mantissa by the same power, so check gives exactly its result
+        if((double)mantissa / geometry_text_powers[decimals] != magnitude){
+            continue;
+        }
+        char digits[24];
+        int count = 0;
+        do{
+            digits[count++] = (char)('0' + mantissa % 10);
+            mantissa /= 10;
+        } while(mantissa > 0 || count <= decimals);
+        size_t length = 0;
+        if(signbit(value)){
+            text[length++] = '-';
+        }
+        while(count > 0){
+            if(count == decimals){
+                text[length++] = '.';
+            }
+            text[length++] = digits[--count];
+        }
+        text[length] = '\0';
+        return length;
+    }
+    int length = snprintf(text, 32, "%.17g", value);
+    if(length <= 0){
+        return 0;
+    }
+    // snprintf writes decimal point of current locale, files always use '.'
+    const char* point = localeconv()->decimal_point;
+    char* found = strcmp(point, ".") != 0 ? strstr(text, point) : NULL;
+    if(found != NULL){
+        size_t point_length = strlen(point);
+        *found = '.';
+        memmove(found + 1, found + point_length, strlen(found + point_length) + 1);
+        length -= (int)point_length - 1;
+    }
+    return (size_t)length;
+}
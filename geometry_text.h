@@ -0,0 +1,374 @@
+#ifndef GEOMETRY_TEXT
+#define GEOMETRY_TEXT
+
+#include "geometry.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Streaming reader and writer of text files with points, segments and triangles.
+// Every line holds one shape, either as CSV numbers:
+//      x,y                                 point
+//      x1,y1,x2,y2                         segment
+//      x1,y1,x2,y2,x3,y3[,is_right]        triangle, is_right is 0 or 1 (0 if missing)
+// or as WKT:
+//      POINT (x y)
+//      LINESTRING (x1 y1, x2 y2)
+//      POLYGON ((x1 y1, x2 y2, x3 y3, x1 y1))      triangle, closing vertex is optional,
+//                                                  TRIANGLE is accepted as well
+// Numbers are separated with white space or commas, lines with anything else
+// right after number (e.g. 1-2 or 1.5.3) are not valid.
+// Decimal point is '.' independently of locale, inf and nan are valid numbers.
+// Empty lines and lines starting with # are skipped.
+// Reader parses file in chunks of fixed size straight into arrays of coordinates
+// (structure of arrays) of fixed capacity, so memory used doesn't depend on size
+// of file - file is consumed batch after batch. Writer formats shapes into buffer
+// of fixed size that is written to file when full.
+typedef struct geometry_text_reader geometry_text_reader;
+typedef struct geometry_text_writer geometry_text_writer;
+
+// Kind of shape read from line
+typedef enum geometry_text_kind {
+    GEOMETRY_TEXT_POINT,
+    GEOMETRY_TEXT_SEGMENT,
+    GEOMETRY_TEXT_TRIANGLE
+} geometry_text_kind;
+
+// Text format written by writer
+typedef enum geometry_text_format {
+    GEOMETRY_TEXT_CSV,
+    // is_right flag of triangles is not written in WKT
+    GEOMETRY_TEXT_WKT
+} geometry_text_format;
+
+// Longest line that can be read, lines of chunk size or longer are errors
+#define GEOMETRY_TEXT_CHUNK_SIZE 65536
+
+/*#####################################################
+ GEOMETRY_TEXT_READER functions (methods) declarations
+######################################################*/
+
+/**
+*   Function to create new geometry_text_reader object reading from given file
+*   In params:
+*       FILE* file              open file, it is not closed by reader
+*       size_t capacity         maximal number of shapes in one batch, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_text_reader*   pointer to created object, NULL if error occured
+*/
+geometry_text_reader* geometry_text_reader_new(FILE* file, size_t capacity);
+
+/**
+*   Function to create new geometry_text_reader object reading from given file with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       FILE* file                              open file, it is not closed by reader
+*       size_t capacity                         maximal number of shapes in one batch, must be positive
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_text_reader*   pointer to created object, NULL if error occured
+*/
+geometry_text_reader* geometry_text_reader_new_with(const geometry_allocator* allocator, FILE* file, size_t capacity);
+
+/**
+*   Function to destroy given geometry_text_reader object
+*   In params:
+*       geometry_text_reader* reader    reader object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_text_reader_destroy(geometry_text_reader* reader);
+
+/**
+*   Function to read next batch of shapes, arrays of previous batch are overwritten
+*   Invalid line ends batch - shapes of lines before it are returned and the next call fails,
+*   so no valid shape is lost, however lines are split into batches
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                          number of shapes in batch (at most capacity), 0 at end of file,
+*                                       (size_t)-1 if error occured - line that couldn't be parsed
+*                                       is given by geometry_text_reader_getLine
+*/
+size_t geometry_text_reader_read(geometry_text_reader* reader);
+
+/**
+*   Function to get kinds of shapes of last batch in order of lines
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       const geometry_text_kind*       array of kinds, as many as shapes in batch, NULL if reader is NULL
+*/
+const geometry_text_kind* geometry_text_reader_getKinds(geometry_text_reader* reader);
+
+/**
+*   Function to get points of last batch
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       const double** xs               x coordinates of points
+*       const double** ys               y coordinates of points
+*
+*   Return:
+*       size_t                          number of points, in order of lines
+*/
+size_t geometry_text_reader_getPoints(geometry_text_reader* reader, const double** xs, const double** ys);
+
+/**
+*   Function to get segments of last batch
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       const double* coordinates[4]    arrays of start x, start y, end x and end y of segments
+*
+*   Return:
+*       size_t                          number of segments, in order of lines
+*/
+size_t geometry_text_reader_getSegments(geometry_text_reader* reader, const double* coordinates[4]);
+
+/**
+*   Function to get triangles of last batch
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       const double* coordinates[6]    arrays of first x, first y, second x, second y,
+*                                       third x and third y of triangles
+*       const unsigned char** flags     flags of triangles, as in geometry_triangle_buffer
+*
+*   Return:
+*       size_t                          number of triangles, in order of lines
+*/
+size_t geometry_text_reader_getTriangles(geometry_text_reader* reader, const double* coordinates[6], const unsigned char** flags);
+
+/**
+*   Function to get number of lines read so far
+*   After error it is number of line that couldn't be parsed
+*   In params:
+*       geometry_text_reader* reader    reader
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       size_t                          number of lines, 0 if reader is NULL
+*/
+size_t geometry_text_reader_getLine(geometry_text_reader* reader);
+
+/**
+*   Function to parse decimal number
+*   Numbers with at most 15 significant digits and small exponents are calculated
+*   exactly with single multiplication or division, the rest is passed to strtod,
+*   so result is always the closest double. Decimal point is always '.', whatever
+*   locale is set. inf, infinity and nan (of any case, with optional sign) are accepted.
+*   In params:
+*       const char* text        text starting with number
+*
+*   Out params:
+*       char** end              pointer to first character after number, text if no number was found
+*
+*   Return:
+*       double                  parsed number
+*/
+double geometry_text_parseDouble(const char* text, char** end);
+
+/*#####################################################
+ GEOMETRY_TEXT_WRITER functions (methods) declarations
+######################################################*/
+
+/**
+*   Function to create new geometry_text_writer object writing to given file
+*   In params:
+*       FILE* file                      open file, it is not closed by writer
+*       geometry_text_format format     format of lines
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_text_writer*           pointer to created object, NULL if error occured
+*/
+geometry_text_writer* geometry_text_writer_new(FILE* file, geometry_text_format format);
+
+/**
+*   Function to create new geometry_text_writer object writing to given file with memory taken from given allocator
+*   Object keeps allocator, all its memory is taken from it and released to it
+*   In params:
+*       const geometry_allocator* allocator     allocator, NULL for the one currently set
+*       FILE* file                              open file, it is not closed by writer
+*       geometry_text_format format             format of lines
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       geometry_text_writer*           pointer to created object, NULL if error occured
+*/
+geometry_text_writer* geometry_text_writer_new_with(const geometry_allocator* allocator, FILE* file, geometry_text_format format);
+
+/**
+*   Function to destroy given geometry_text_writer object, buffered lines are written first
+*   In params:
+*       geometry_text_writer* writer    writer object that should be freed
+*
+*   Out params/return:
+*       none
+*/
+void geometry_text_writer_destroy(geometry_text_writer* writer);
+
+/**
+*   Function to write buffered lines to file
+*   In params:
+*       geometry_text_writer* writer    writer
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if this or any earlier write failed
+*/
+bool geometry_text_writer_flush(geometry_text_writer* writer);
+
+/**
+*   Function to write point
+*   In params:
+*       geometry_text_writer* writer    writer
+*       double x                        x coordinate of point
+*       double y                        y coordinate of point
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writePoint(geometry_text_writer* writer, double x, double y);
+
+/**
+*   Function to write segment
+*   In params:
+*       geometry_text_writer* writer    writer
+*       const double coordinates[4]     start x, start y, end x and end y of segment
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writeSegment(geometry_text_writer* writer, const double coordinates[4]);
+
+/**
+*   Function to write triangle
+*   In params:
+*       geometry_text_writer* writer    writer
+*       const double coordinates[6]     first x, first y, second x, second y, third x and third y of triangle
+*       bool is_right                   true if triangle is right-angled
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writeTriangle(geometry_text_writer* writer, const double coordinates[6], bool is_right);
+
+/**
+*   Function to write points given as arrays of coordinates
+*   In params:
+*       geometry_text_writer* writer    writer
+*       const double* xs                x coordinates of points
+*       const double* ys                y coordinates of points
+*       size_t count                    number of points
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writePoints(geometry_text_writer* writer, const double* xs, const double* ys, size_t count);
+
+/**
+*   Function to write segments given as arrays of coordinates
+*   In params:
+*       geometry_text_writer* writer        writer
+*       const double* const coordinates[4]  arrays of start x, start y, end x and end y of segments
+*       size_t count                        number of segments
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_text_writer_writeSegments(geometry_text_writer* writer, const double* const coordinates[4], size_t count);
+
+/**
+*   Function to write triangles given as arrays of coordinates
+*   In params:
+*       geometry_text_writer* writer        writer
+*       const double* const coordinates[6]  arrays of first x, first y, second x, second y,
+*                                           third x and third y of triangles
+*       const unsigned char* flags          flags of triangles, as in geometry_triangle_buffer,
+*                                           NULL if no triangle is right-angled
+*       size_t count                        number of triangles
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                                true on success, false if error occured
+*/
+bool geometry_text_writer_writeTriangles(geometry_text_writer* writer, const double* const coordinates[6], const unsigned char* flags, size_t count);
+
+/**
+*   Function to write line of text as it is, e.g. comment or results that are not shapes
+*   In params:
+*       geometry_text_writer* writer    writer
+*       const char* line                text without new line character, shorter than chunk size
+*
+*   Out params:
+*       none
+*
+*   Return:
+*       bool                            true on success, false if error occured
+*/
+bool geometry_text_writer_writeLine(geometry_text_writer* writer, const char* line);
+
+/**
+*   Function to format number so that geometry_text_parseDouble gives it back exactly
+*   Numbers with at most 9 decimal places are written as plain decimals without
+*   formatting functions, the rest with 17 significant digits and '.' as decimal point
+*   whatever locale is set. Non-finite numbers are written as inf, -inf or nan.
+*   In params:
+*       double value            number
+*
+*   Out params:
+*       char* text              buffer of at least 32 characters, text is terminated with 0
+*
+*   Return:
+*       size_t                  number of written characters (without terminating 0)
+*/
+size_t geometry_text_formatDouble(double value, char* text);
+
+#endif
@@ -1,7 +1,38 @@
 #include "geometry.h"
+#include "geometry_buffer.h"
+#include "geometry_sweep.h"
+#include "geometry_grid.h"
+#include "geometry_bvh.h"
+#include "geometry_rtree.h"
+#include "geometry_kdtree.h"
+#include "geometry_pool.h"
+#include "geometry_predicates.h"
+#include "geometry_stats.h"
+#include "geometry_binary.h"
+#include "geometry_text.h"
+#include "geometry_int.h"
+#include "geometry_mesh.h"
 #include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdio.h>
+#include <locale.h>
+#include <math.h>
+
+// Tests are run in both precisions of geometry_real (make test and make test_f32).
+// Float keeps only about 7 significant digits, so in float mode computed values are
+// compared with tolerance relative to expected value, in double mode only with given one.
+#ifdef GEOMETRY_REAL_FLOAT
+#define GEOMETRY_TEST_RELATIVE_TOLERANCE 1e-5
+#else
+#define GEOMETRY_TEST_RELATIVE_TOLERANCE 0
+#endif
+
+static bool geometry_test_near(double actual, double expected, double tolerance){
+    return actual == expected || fabs(actual - expected) < fmax(tolerance, GEOMETRY_TEST_RELATIVE_TOLERANCE * fmax(1, fabs(expected)));
+}
 
 static void geometry_test_point_creationAndDestruction(){
     {   
@@ -39,7 +70,7 @@ static void geometry_test_point_getters(){
         double y = -123.0;
         geometry_point* point = geometry_point_new(x, y);
         // assert(point != NULL);
-        assert(geometry_point_getX(point) == x);
+        assert(geometry_test_near(geometry_point_getX(point), x, 0));
         assert(geometry_point_getY(point) == y);
         geometry_point_destroy(point);
     }
@@ -47,8 +78,8 @@ static void geometry_test_point_getters(){
     {
         geometry_point* point = geometry_point_new(1.123, 0.576);
         // assert(point != NULL);
-        assert(geometry_point_getX(point) == 1.123);
-        assert(geometry_point_getY(point) == 0.576);
+        assert(geometry_test_near(geometry_point_getX(point), 1.123, 0));
+        assert(geometry_test_near(geometry_point_getY(point), 0.576, 0));
         geometry_point_destroy(point);
     }
 
@@ -56,7 +87,7 @@ static void geometry_test_point_getters(){
         double y = -123.0;
         geometry_point* point = geometry_point_new(1.123, y);
         // assert(point != NULL);
-        assert(geometry_point_getX(point) == 1.123);
+        assert(geometry_test_near(geometry_point_getX(point), 1.123, 0));
         assert(geometry_point_getY(point) == y);
         geometry_point_destroy(point);
     }
@@ -66,7 +97,7 @@ static void geometry_test_point_getters(){
         geometry_point* point = geometry_point_new(x, 123.14);
         // assert(point != NULL);
         assert(geometry_point_getX(point) == x);
-        assert(geometry_point_getY(point) == 123.14);
+        assert(geometry_test_near(geometry_point_getY(point), 123.14, 0));
         geometry_point_destroy(point);
     }
 }
@@ -79,7 +110,7 @@ static void geometry_test_point_move(){
         double start_y = 3453.345;
         geometry_point* point = geometry_point_new(start_x, start_y);
         geometry_point_moveByVector(point, vector_x, vector_y);
-        assert(geometry_point_getX(point) == start_x + vector_x);
+        assert(geometry_test_near(geometry_point_getX(point), start_x + vector_x, 0));
         assert(geometry_point_getY(point) == start_y + vector_y);
         geometry_point_destroy(point);
     }
@@ -89,12 +120,45 @@ static void geometry_test_point_move(){
         double start_y = 123.097;
         geometry_point* point = geometry_point_new(start_x, start_y);
         geometry_point_moveByVector(point, 345.654, -0.001);
-        assert(geometry_point_getX(point) == start_x + 345.654);
-        assert(geometry_point_getY(point) == start_y - 0.001);
+        assert(geometry_test_near(geometry_point_getX(point), start_x + 345.654, 0));
+        assert(geometry_test_near(geometry_point_getY(point), start_y - 0.001, 0));
         geometry_point_destroy(point);
     }
 }
 
+static void geometry_test_point_rotate(){
+    {
+        geometry_point* point = geometry_point_new(2.0, 1.0);
+        geometry_point* reference = geometry_point_new(1.0, 1.0);
+        geometry_point_rotateByAngle(point, M_PI / 2, reference);
+        assert(geometry_test_near(geometry_point_getX(point), 1.0, 1e-12));
+        assert(fabs(geometry_point_getY(point) - 2.0) < 1e-12);
+        geometry_point_destroy(point);
+        geometry_point_destroy(reference);
+    }
+
+    {
+        geometry_point* by_angle = geometry_point_new(3.25, -7.5);
+        geometry_point* by_rotation = geometry_point_new(3.25, -7.5);
+        geometry_point* reference = geometry_point_new(-1.0, 0.5);
+        geometry_rotation* rotation = geometry_rotation_new(1.2345, reference);
+        assert(rotation != NULL);
+        geometry_point_rotateByAngle(by_angle, 1.2345, reference);
+        geometry_point_rotateBy(by_rotation, rotation);
+        assert(geometry_point_getX(by_angle) == geometry_point_getX(by_rotation));
+        assert(geometry_point_getY(by_angle) == geometry_point_getY(by_rotation));
+        geometry_rotation_destroy(rotation);
+        geometry_point_destroy(by_angle);
+        geometry_point_destroy(by_rotation);
+        geometry_point_destroy(reference);
+    }
+
+    {
+        assert(geometry_rotation_new(1.0, NULL) == NULL);
+        geometry_point_rotateBy(NULL, NULL);
+    }
+}
+
 static void geometry_test_point_distance(){
     {
         double first_x = 0;
@@ -217,10 +281,10 @@ static void geometry_test_segment_move(){
         geometry_point* got_start = NULL;
         geometry_point* got_end = NULL;
         geometry_segment_getPoints(segment, &got_start, &got_end);
-        assert(geometry_point_getX(got_start) == start_x + vector_x);
-        assert(geometry_point_getY(got_start) == start_y + vector_y);
-        assert(geometry_point_getX(got_end) == end_x + vector_x);
-        assert(geometry_point_getY(got_end) == end_y + vector_y);
+        assert(geometry_test_near(geometry_point_getX(got_start), start_x + vector_x, 0));
+        assert(geometry_test_near(geometry_point_getY(got_start), start_y + vector_y, 0));
+        assert(geometry_test_near(geometry_point_getX(got_end), end_x + vector_x, 0));
+        assert(geometry_test_near(geometry_point_getY(got_end), end_y + vector_y, 0));
         geometry_point_destroy(start);
         geometry_point_destroy(end);
         geometry_segment_destroy(segment);
@@ -238,10 +302,10 @@ static void geometry_test_segment_move(){
         geometry_point* got_start = NULL;
         geometry_point* got_end = NULL;
         geometry_segment_getPoints(segment, &got_start, &got_end);
-        assert(geometry_point_getX(got_start) == start_x + 123.412);
-        assert(geometry_point_getY(got_start) == start_y + 5.234);
-        assert(geometry_point_getX(got_end) == end_x + 123.412);
-        assert(geometry_point_getY(got_end) == end_y + 5.234);
+        assert(geometry_test_near(geometry_point_getX(got_start), start_x + 123.412, 0));
+        assert(geometry_test_near(geometry_point_getY(got_start), start_y + 5.234, 0));
+        assert(geometry_test_near(geometry_point_getX(got_end), end_x + 123.412, 0));
+        assert(geometry_test_near(geometry_point_getY(got_end), end_y + 5.234, 0));
         geometry_point_destroy(start);
         geometry_point_destroy(end);
         geometry_segment_destroy(segment);
@@ -439,6 +503,45 @@ static void geometry_test_triangle_gettersPoints(){
     }
 }
 
+static void geometry_test_triangle_pointsOwnership(){
+    {
+        geometry_point* first = geometry_point_new(1.0, 2.0);
+        geometry_point* second = geometry_point_new(3.0, 4.0);
+        geometry_point* third = geometry_point_new(5.0, 6.0);
+        geometry_triangle* triangle = geometry_triangle_new(first, second, third, false);
+        // triangle keeps its own copies of given points
+        geometry_point_moveByVector(first, 10.0, 10.0);
+        geometry_point_destroy(second);
+        geometry_point* got_first = NULL;
+        geometry_point* got_second = NULL;
+        geometry_point* got_third = NULL;
+        geometry_triangle_getPoints(triangle, &got_first, &got_second, &got_third);
+        assert(got_first != first);
+        assert(geometry_point_getX(got_first) == 1.0);
+        assert(geometry_point_getY(got_second) == 4.0);
+        // points got from triangle are the triangle's vertices
+        geometry_triangle_moveByVector(triangle, 1.0, 0.0);
+        assert(geometry_point_getX(got_third) == 6.0);
+        geometry_triangle_destroy(triangle);
+        geometry_point_destroy(first);
+        geometry_point_destroy(third);
+    }
+
+    {
+        geometry_point* start = geometry_point_new(1.0, 2.0);
+        geometry_point* end = geometry_point_new(3.0, 4.0);
+        geometry_segment* segment = geometry_segment_new(start, end);
+        geometry_point_destroy(start);
+        geometry_point_destroy(end);
+        geometry_point* got_start = NULL;
+        geometry_point* got_end = NULL;
+        geometry_segment_getPoints(segment, &got_start, &got_end);
+        assert(geometry_point_getX(got_start) == 1.0);
+        assert(geometry_point_getY(got_end) == 4.0);
+        geometry_segment_destroy(segment);
+    }
+}
+
 static void geometry_test_triangle_gettersIsRight(){
     {
         geometry_point* first = geometry_point_new(1.123, 3.543);
@@ -491,12 +594,12 @@ static void geometry_test_triangle_move(){
         geometry_point* got_second = NULL;
         geometry_point* got_third = NULL;
         geometry_triangle_getPoints(triangle, &got_first, &got_second, &got_third);
-        assert(geometry_point_getX(got_first) == first_x + vector_x);
-        assert(geometry_point_getY(got_first) == first_y + vector_y);
-        assert(geometry_point_getX(got_second) == second_x + vector_x);
-        assert(geometry_point_getY(got_second) == second_y + vector_y);
-        assert(geometry_point_getX(got_third) == third_x + vector_x);
-        assert(geometry_point_getY(got_third) == third_y + vector_y);
+        assert(geometry_test_near(geometry_point_getX(got_first), first_x + vector_x, 0));
+        assert(geometry_test_near(geometry_point_getY(got_first), first_y + vector_y, 0));
+        assert(geometry_test_near(geometry_point_getX(got_second), second_x + vector_x, 0));
+        assert(geometry_test_near(geometry_point_getY(got_second), second_y + vector_y, 0));
+        assert(geometry_test_near(geometry_point_getX(got_third), third_x + vector_x, 0));
+        assert(geometry_test_near(geometry_point_getY(got_third), third_y + vector_y, 0));
         geometry_triangle_destroy(triangle);
         geometry_point_destroy(first);
         geometry_point_destroy(second);
@@ -520,12 +623,12 @@ static void geometry_test_triangle_move(){
         geometry_point* got_second = NULL;
         geometry_point* got_third = NULL;
         geometry_triangle_getPoints(triangle, &got_first, &got_second, &got_third);
-        assert(geometry_point_getX(got_first) == first_x + 3.141592);
-        assert(geometry_point_getY(got_first) == first_y + 2.73);
-        assert(geometry_point_getX(got_second) == second_x + 3.141592);
-        assert(geometry_point_getY(got_second) == second_y + 2.73);
-        assert(geometry_point_getX(got_third) == third_x + 3.141592);
-        assert(geometry_point_getY(got_third) == third_y + 2.73);
+        assert(geometry_test_near(geometry_point_getX(got_first), first_x + 3.141592, 0));
+        assert(geometry_test_near(geometry_point_getY(got_first), first_y + 2.73, 0));
+        assert(geometry_test_near(geometry_point_getX(got_second), second_x + 3.141592, 0));
+        assert(geometry_test_near(geometry_point_getY(got_second), second_y + 2.73, 0));
+        assert(geometry_test_near(geometry_point_getX(got_third), third_x + 3.141592, 0));
+        assert(geometry_test_near(geometry_point_getY(got_third), third_y + 2.73, 0));
         geometry_triangle_destroy(triangle);
         geometry_point_destroy(first);
         geometry_point_destroy(second);
@@ -533,6 +636,150 @@ static void geometry_test_triangle_move(){
     }
 }
 
+static void geometry_test_triangle_rotate(){
+    {
+        geometry_point* first = geometry_point_new(1.0, 0.0);
+        geometry_point* second = geometry_point_new(0.0, 2.0);
+        geometry_point* third = geometry_point_new(-3.0, 0.0);
+        geometry_point* reference = geometry_point_new(0.0, 0.0);
+        geometry_triangle* by_angle = geometry_triangle_new(first, second, third, false);
+        geometry_triangle* by_rotation = geometry_triangle_new(first, second, third, false);
+        geometry_rotation* rotation = geometry_rotation_new(M_PI, reference);
+        geometry_triangle_rotateByAngle(by_angle, M_PI, reference);
+        geometry_triangle_rotateBy(by_rotation, rotation);
+        geometry_point* got[2][3];
+        geometry_triangle_getPoints(by_angle, &got[0][0], &got[0][1], &got[0][2]);
+        geometry_triangle_getPoints(by_rotation, &got[1][0], &got[1][1], &got[1][2]);
+        assert(fabs(geometry_point_getX(got[0][0]) + 1.0) < 1e-12);
+        assert(fabs(geometry_point_getY(got[0][1]) + 2.0) < 1e-12);
+        assert(fabs(geometry_point_getX(got[0][2]) - 3.0) < 1e-12);
+        for(int i = 0; i < 3; i++){
+            assert(geometry_point_getX(got[0][i]) == geometry_point_getX(got[1][i]));
+            assert(geometry_point_getY(got[0][i]) == geometry_point_getY(got[1][i]));
+        }
+        geometry_rotation_destroy(rotation);
+        geometry_triangle_destroy(by_angle);
+        geometry_triangle_destroy(by_rotation);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+        geometry_point_destroy(reference);
+    }
+
+    {
+        geometry_point* start = geometry_point_new(1.0, 1.0);
+        geometry_point* end = geometry_point_new(3.0, 1.0);
+        geometry_segment* segment = geometry_segment_new(start, end);
+        geometry_rotation* rotation = geometry_rotation_new(M_PI / 2, start);
+        geometry_segment_rotateBy(segment, rotation);
+        geometry_point* got_start = NULL;
+        geometry_point* got_end = NULL;
+        geometry_segment_getPoints(segment, &got_start, &got_end);
+        assert(geometry_point_getX(got_start) == 1.0);
+        assert(geometry_point_getY(got_start) == 1.0);
+        assert(geometry_test_near(geometry_point_getX(got_end), 1.0, 1e-12));
+        assert(fabs(geometry_point_getY(got_end) - 3.0) < 1e-12);
+        geometry_rotation_destroy(rotation);
+        geometry_segment_destroy(segment);
+        geometry_point_destroy(start);
+        geometry_point_destroy(end);
+    }
+}
+
+static void geometry_test_transform_chain(){
+    {
+        // chain of operations collapsed into one transform gives the same result
+        // as applying operations to the triangle one by one
+        geometry_point* first = geometry_point_new(1.5, -2.0);
+        geometry_point* second = geometry_point_new(4.0, 3.25);
+        geometry_point* third = geometry_point_new(-6.0, 0.5);
+        geometry_point* reference = geometry_point_new(2.0, 2.0);
+        geometry_triangle* stepwise = geometry_triangle_new(first, second, third, false);
+        geometry_triangle* transformed = geometry_triangle_new(first, second, third, false);
+        geometry_transform* transform = geometry_transform_new();
+        for(int i = 0; i < 10; i++){
+            geometry_triangle_moveByVector(stepwise, 0.5 * i, -1.0);
+            geometry_triangle_rotateByAngle(stepwise, 0.1 * i, reference);
+            geometry_transform_moveByVector(transform, 0.5 * i, -1.0);
+            geometry_transform_rotateByAngle(transform, 0.1 * i, reference);
+        }
+        geometry_triangle_applyTransform(transformed, transform);
+        geometry_point* got[2][3];
+        geometry_triangle_getPoints(stepwise, &got[0][0], &got[0][1], &got[0][2]);
+        geometry_triangle_getPoints(transformed, &got[1][0], &got[1][1], &got[1][2]);
+        for(int i = 0; i < 3; i++){
+            assert(geometry_test_near(geometry_point_getX(got[0][i]), geometry_point_getX(got[1][i]), 1e-9));
+            assert(geometry_test_near(geometry_point_getY(got[0][i]), geometry_point_getY(got[1][i]), 1e-9));
+        }
+        geometry_transform_destroy(transform);
+        geometry_triangle_destroy(stepwise);
+        geometry_triangle_destroy(transformed);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+        geometry_point_destroy(reference);
+    }
+}
+
+static void geometry_test_transform_composeAndInvert(){
+    {
+        geometry_point* reference = geometry_point_new(-1.0, 3.0);
+        geometry_transform* first = geometry_transform_new();
+        geometry_transform* second = geometry_transform_new();
+        geometry_transform_moveByVector(first, 3.0, -4.0);
+        geometry_transform_rotateByAngle(second, 0.7, reference);
+        geometry_transform* composed = geometry_transform_compose(first, second);
+        geometry_transform* inverse = geometry_transform_invert(composed);
+        assert(composed != NULL && inverse != NULL);
+        geometry_point* by_steps = geometry_point_new(5.0, 6.0);
+        geometry_point* by_composed = geometry_point_new(5.0, 6.0);
+        geometry_point_applyTransform(by_steps, first);
+        geometry_point_applyTransform(by_steps, second);
+        geometry_point_applyTransform(by_composed, composed);
+        assert(fabs(geometry_point_getX(by_steps) - geometry_point_getX(by_composed)) < 1e-12);
+        assert(fabs(geometry_point_getY(by_steps) - geometry_point_getY(by_composed)) < 1e-12);
+        geometry_point_applyTransform(by_composed, inverse);
+        assert(geometry_test_near(geometry_point_getX(by_composed), 5.0, 1e-12));
+        assert(geometry_test_near(geometry_point_getY(by_composed), 6.0, 1e-12));
+        geometry_point_destroy(by_steps);
+        geometry_point_destroy(by_composed);
+        geometry_transform_destroy(first);
+        geometry_transform_destroy(second);
+        geometry_transform_destroy(composed);
+        geometry_transform_destroy(inverse);
+        geometry_point_destroy(reference);
+    }
+
+    {
+        geometry_transform* transform = geometry_transform_new();
+        geometry_real coefficients[6];
+        geometry_transform_getCoefficients(transform, coefficients);
+        assert(coefficients[0] == 1 && coefficients[1] == 0 && coefficients[2] == 0);
+        assert(coefficients[3] == 0 && coefficients[4] == 1 && coefficients[5] == 0);
+        assert(geometry_transform_compose(transform, NULL) == NULL);
+        assert(geometry_transform_invert(NULL) == NULL);
+        geometry_transform_destroy(transform);
+    }
+
+    {
+        geometry_point* start = geometry_point_new(0.0, 0.0);
+        geometry_point* end = geometry_point_new(1.0, 0.0);
+        geometry_segment* segment = geometry_segment_new(start, end);
+        geometry_transform* transform = geometry_transform_new();
+        geometry_transform_moveByVector(transform, 2.0, 2.0);
+        geometry_segment_applyTransform(segment, transform);
+        geometry_point* got_start = NULL;
+        geometry_point* got_end = NULL;
+        geometry_segment_getPoints(segment, &got_start, &got_end);
+        assert(geometry_point_getX(got_start) == 2.0 && geometry_point_getY(got_start) == 2.0);
+        assert(geometry_point_getX(got_end) == 3.0 && geometry_point_getY(got_end) == 2.0);
+        geometry_transform_destroy(transform);
+        geometry_segment_destroy(segment);
+        geometry_point_destroy(start);
+        geometry_point_destroy(end);
+    }
+}
+
 static void geometry_test_triangle_primeter(){
     {
         double first_x = -3;
@@ -559,6 +806,2131 @@ static void geometry_test_triangle_primeter(){
     }
 }
 
+static void geometry_test_arena_allocation(){
+    {
+        geometry_arena* arena = geometry_arena_new(0);
+        assert(arena != NULL);
+        geometry_point* point = geometry_point_new_in(arena, 1.345, -123.0);
+        assert(point != NULL);
+        assert(geometry_test_near(geometry_point_getX(point), 1.345, 0));
+        assert(geometry_point_getY(point) == -123.0);
+        geometry_arena_destroy(arena);
+    }
+
+    {
+        // block smaller than a single object forces new blocks on every allocation
+        geometry_arena* arena = geometry_arena_new(1);
+        geometry_point* points[100];
+        for(int i = 0; i < 100; i++){
+            points[i] = geometry_point_new_in(arena, i, -i);
+            assert(points[i] != NULL);
+        }
+        for(int i = 0; i < 100; i++){
+            assert(geometry_point_getX(points[i]) == i);
+            assert(geometry_point_getY(points[i]) == -i);
+        }
+        geometry_arena_destroy(arena);
+    }
+
+    {
+        geometry_arena* arena = geometry_arena_new(0);
+        void* memory = geometry_arena_allocate(arena, 3);
+        void* aligned = geometry_arena_allocate(arena, sizeof(double));
+        assert(memory != NULL);
+        assert((size_t)aligned % _Alignof(double) == 0);
+        assert(geometry_arena_allocate(arena, 0) == NULL);
+        assert(geometry_arena_allocate(NULL, 8) == NULL);
+        geometry_arena_destroy(arena);
+    }
+
+    {
+        assert(geometry_point_new_in(NULL, 1.0, 2.0) == NULL);
+        geometry_arena_destroy(NULL);
+        geometry_arena_reset(NULL);
+    }
+}
+
+static void geometry_test_arena_reset(){
+    {
+        geometry_arena* arena = geometry_arena_new(256);
+        geometry_point* first = geometry_point_new_in(arena, 1.0, 2.0);
+        for(int i = 0; i < 1000; i++){
+            geometry_point_new_in(arena, i, i);
+        }
+        geometry_arena_reset(arena);
+        // memory is reused from the beginning after reset
+        geometry_point* again = geometry_point_new_in(arena, 3.0, 4.0);
+        assert(again == first);
+        assert(geometry_point_getX(again) == 3.0);
+        geometry_arena_destroy(arena);
+    }
+}
+
+static void geometry_test_arena_shapes(){
+    {
+        geometry_arena* arena = geometry_arena_new(0);
+        geometry_point* start = geometry_point_new_in(arena, 0, 3);
+        geometry_point* end = geometry_point_new_in(arena, 4, 0);
+        geometry_segment* segment = geometry_segment_new_in(arena, start, end);
+        assert(segment != NULL);
+        assert(geometry_segment_calculateLength(segment) == 5);
+        assert(geometry_segment_new_in(arena, NULL, end) == NULL);
+        assert(geometry_segment_new_in(NULL, start, end) == NULL);
+        geometry_arena_destroy(arena);
+    }
+
+    {
+        geometry_arena* arena = geometry_arena_new(0);
+        geometry_point* first = geometry_point_new_in(arena, -3, -1);
+        geometry_point* second = geometry_point_new_in(arena, 5, 5);
+        geometry_point* third = geometry_point_new_in(arena, 5, -1);
+        geometry_triangle* triangle = geometry_triangle_new_in(arena, first, second, third, true);
+        assert(triangle != NULL);
+        assert(geometry_triangle_getIsRight(triangle) == true);
+        assert(geometry_triangle_calculatePerimeter(triangle) == 24);
+        geometry_triangle_moveByVector(triangle, 1, 1);
+        geometry_point* got_first = NULL;
+        geometry_point* got_second = NULL;
+        geometry_point* got_third = NULL;
+        geometry_triangle_getPoints(triangle, &got_first, &got_second, &got_third);
+        assert(geometry_point_getX(got_first) == -2);
+        assert(geometry_point_getY(got_third) == 0);
+        assert(geometry_triangle_new_in(arena, first, NULL, third, false) == NULL);
+        assert(geometry_triangle_new_in(NULL, first, second, third, false) == NULL);
+        geometry_arena_destroy(arena);
+    }
+}
+static void geometry_test_pointBuffer_creationAndAccess(){
+    {
+        geometry_point_buffer* buffer = geometry_point_buffer_new(0);
+        assert(buffer != NULL);
+        assert(geometry_point_buffer_getSize(buffer) == 0);
+        for(int i = 0; i < 1000; i++){
+            assert(geometry_point_buffer_push(buffer, i, -i));
+        }
+        assert(geometry_point_buffer_getSize(buffer) == 1000);
+        assert(geometry_point_buffer_getX(buffer, 999) == 999);
+        assert(geometry_point_buffer_getY(buffer, 999) == -999);
+        assert(geometry_point_buffer_getX(buffer, 1000) == 0);
+        geometry_real* xs = NULL;
+        geometry_real* ys = NULL;
+        geometry_point_buffer_getCoordinates(buffer, &xs, &ys);
+        assert(xs[10] == 10 && ys[10] == -10);
+        geometry_point_buffer_clear(buffer);
+        assert(geometry_point_buffer_getSize(buffer) == 0);
+        geometry_point_buffer_destroy(buffer);
+    }
+
+    {
+        assert(geometry_point_buffer_getSize(NULL) == 0);
+        assert(geometry_point_buffer_push(NULL, 1, 1) == false);
+        geometry_point_buffer_destroy(NULL);
+    }
+}
+
+static void geometry_test_pointBuffer_kernels(){
+    {
+        geometry_point_buffer* buffer = geometry_point_buffer_new(4);
+        geometry_point_buffer_push(buffer, 1.5, 2.5);
+        geometry_point_buffer_push(buffer, -3.0, 4.0);
+        geometry_point_buffer_moveByVector(buffer, 1.0, -1.0);
+        assert(geometry_point_buffer_getX(buffer, 0) == 2.5);
+        assert(geometry_point_buffer_getY(buffer, 0) == 1.5);
+        assert(geometry_point_buffer_getX(buffer, 1) == -2.0);
+        assert(geometry_point_buffer_getY(buffer, 1) == 3.0);
+        geometry_point_buffer_destroy(buffer);
+    }
+
+    {
+        // batch rotation must give the same result as rotating points one by one
+        geometry_point_buffer* buffer = geometry_point_buffer_new(0);
+        geometry_point* points[37];
+        geometry_point* reference = geometry_point_new(0.5, -2.0);
+        for(int i = 0; i < 37; i++){
+            geometry_point_buffer_push(buffer, i * 0.25, 10.0 - i);
+            points[i] = geometry_point_new(i * 0.25, 10.0 - i);
+        }
+        geometry_point_buffer_rotateByAngle(buffer, 0.75, reference);
+        for(int i = 0; i < 37; i++){
+            geometry_point_rotateByAngle(points[i], 0.75, reference);
+            assert(fabs(geometry_point_buffer_getX(buffer, i) - geometry_point_getX(points[i])) < 1e-12);
+            assert(fabs(geometry_point_buffer_getY(buffer, i) - geometry_point_getY(points[i])) < 1e-12);
+            geometry_point_destroy(points[i]);
+        }
+        geometry_point_destroy(reference);
+        geometry_point_buffer_destroy(buffer);
+    }
+
+    {
+        geometry_point_buffer* buffer = geometry_point_buffer_new(0);
+        geometry_point_buffer_push(buffer, 0, 3);
+        geometry_point_buffer_push(buffer, 0, -3);
+        geometry_point_buffer_push(buffer, 4, 0);
+        geometry_point* point = geometry_point_new(4, 3);
+        geometry_real distances[3];
+        geometry_point_buffer_calculateDistances(buffer, point, distances);
+        assert(distances[0] == 4);
+        assert(geometry_test_near(distances[1], sqrt(4 * 4 + 6 * 6), 0));
+        assert(distances[2] == 3);
+        geometry_point_destroy(point);
+        geometry_point_buffer_destroy(buffer);
+    }
+
+    {
+        geometry_point_buffer* buffer = geometry_point_buffer_new(0);
+        geometry_point_buffer_push(buffer, 1.0, 2.0);
+        geometry_point* reference = geometry_point_new(0.0, 0.0);
+        geometry_transform* transform = geometry_transform_new();
+        geometry_transform_rotateByAngle(transform, M_PI / 2, reference);
+        geometry_transform_moveByVector(transform, 10.0, 0.0);
+        geometry_point_buffer_applyTransform(buffer, transform);
+        assert(fabs(geometry_point_buffer_getX(buffer, 0) - 8.0) < 1e-12);
+        assert(geometry_test_near(geometry_point_buffer_getY(buffer, 0), 1.0, 1e-12));
+        geometry_transform_destroy(transform);
+        geometry_point_destroy(reference);
+        geometry_point_buffer_destroy(buffer);
+    }
+}
+static void geometry_test_pointBuffer_distanceMatrixRow(size_t row, const geometry_real* distances, size_t count, void* context){
+    geometry_real* expected = context;
+    assert(count == 517);
+    for(size_t j = 0; j < count; j++){
+        assert(distances[j] == expected[row * count + j]);
+    }
+    expected[row * count] = -1;
+}
+static void geometry_test_pointBuffer_distanceMatrix(){
+    {
+        geometry_point_buffer* rows = geometry_point_buffer_new(0);
+        geometry_point_buffer* columns = geometry_point_buffer_new(0);
+        for(int i = 0; i < 300; i++){
+            geometry_point_buffer_push(rows, (i * 37 % 101) * 0.5, (i * 53 % 89) - 40.0);
+        }
+        for(int i = 0; i < 517; i++){
+            geometry_point_buffer_push(columns, (i * 29 % 97) - 20.0, (i * 61 % 83) * 0.25);
+        }
+        geometry_real* matrix = malloc(300 * 517 * sizeof(*matrix));
+        geometry_real* squared = malloc(300 * 517 * sizeof(*squared));
+        assert(geometry_point_buffer_calculateDistanceMatrix(rows, columns, matrix));
+        assert(geometry_point_buffer_calculateSquaredDistanceMatrix(rows, columns, squared));
+        for(size_t i = 0; i < 300; i++){
+            geometry_point* first = geometry_point_new(geometry_point_buffer_getX(rows, i), geometry_point_buffer_getY(rows, i));
+            for(size_t j = 0; j < 517; j++){
+                geometry_point* second = geometry_point_new(geometry_point_buffer_getX(columns, j), geometry_point_buffer_getY(columns, j));
+                assert(matrix[i * 517 + j] == geometry_point_calculateDistance(first, second));
+                assert(geometry_test_near(sqrt(squared[i * 517 + j]), matrix[i * 517 + j], 0));
+                geometry_point_destroy(second);
+            }
+            geometry_point_destroy(first);
+        }
+        assert(geometry_point_buffer_streamDistanceMatrix(rows, columns, false, geometry_test_pointBuffer_distanceMatrixRow, matrix));
+        for(size_t i = 0; i < 300; i++){
+            assert(matrix[i * 517] == -1);
+        }
+        free(squared);
+        free(matrix);
+        geometry_point_buffer_destroy(columns);
+        geometry_point_buffer_destroy(rows);
+    }
+
+    {
+        geometry_point_buffer* buffer = geometry_point_buffer_new(0);
+        for(int i = 0; i < 600; i++){
+            geometry_point_buffer_push(buffer, (i * 37 % 101) * 0.5, (i * 53 % 89) - 40.0);
+        }
+        geometry_real* matrix = malloc(600 * 600 * sizeof(*matrix));
+        assert(geometry_point_buffer_calculateSquaredDistanceMatrix(buffer, buffer, matrix));
+        for(size_t i = 0; i < 600; i++){
+            assert(matrix[i * 600 + i] == 0);
+            for(size_t j = 0; j < 600; j++){
+                geometry_real dx = geometry_point_buffer_getX(buffer, i) - geometry_point_buffer_getX(buffer, j);
+                geometry_real dy = geometry_point_buffer_getY(buffer, i) - geometry_point_buffer_getY(buffer, j);
+                assert(matrix[i * 600 + j] == dx * dx + dy * dy);
+            }
+        }
+        free(matrix);
+        geometry_point_buffer_destroy(buffer);
+    }
+
+    {
+        geometry_point_buffer* buffer = geometry_point_buffer_new(0);
+        geometry_real matrix[1];
+        assert(geometry_point_buffer_calculateDistanceMatrix(buffer, buffer, matrix));
+        assert(geometry_point_buffer_calculateDistanceMatrix(NULL, buffer, matrix) == false);
+        assert(geometry_point_buffer_streamDistanceMatrix(buffer, buffer, true, NULL, NULL) == false);
+        geometry_point_buffer_destroy(buffer);
+    }
+}
+static void geometry_test_triangle_area(){
+    {
+        geometry_point* first = geometry_point_new(-3, -1);
+        geometry_point* second = geometry_point_new(5, 5);
+        geometry_point* third = geometry_point_new(5, -1);
+        geometry_triangle* right = geometry_triangle_new(first, second, third, true);
+        geometry_triangle* general = geometry_triangle_new(first, second, third, false);
+        assert(geometry_triangle_calculateArea(right) == 24);
+        assert(geometry_triangle_calculateArea(general) == 24);
+        geometry_triangle_destroy(right);
+        geometry_triangle_destroy(general);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+    }
+
+    {
+        geometry_point* first = geometry_point_new(0, 0);
+        geometry_point* second = geometry_point_new(4, 0);
+        geometry_point* third = geometry_point_new(1, 3);
+        geometry_triangle* triangle = geometry_triangle_new(first, second, third, false);
+        assert(geometry_triangle_calculateArea(triangle) == 6);
+        geometry_triangle_destroy(triangle);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+    }
+
+    {
+        // small triangle far from (0,0), area is calculated from coordinates, not from rounded side lengths
+        geometry_point* first = geometry_point_new(20000, 20000);
+        geometry_point* second = geometry_point_new(20001, 20000);
+        geometry_point* third = geometry_point_new(20000, 20001);
+        geometry_triangle* right = geometry_triangle_new(first, second, third, true);
+        geometry_triangle* general = geometry_triangle_new(first, second, third, false);
+        assert(geometry_triangle_calculateArea(right) == 0.5);
+        assert(geometry_triangle_calculateArea(general) == 0.5);
+        geometry_triangle_destroy(right);
+        geometry_triangle_destroy(general);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+    }
+
+    {
+        assert(geometry_triangle_calculateArea(NULL) == -1);
+    }
+}
+
+static void geometry_test_triangle_hypotenuse(){
+    {
+        // right angle at every possible vertex
+        double coordinates[3][6] = {
+            {0, 0, 3, 0, 0, 4},
+            {3, 0, 0, 0, 0, 4},
+            {3, 0, 0, 4, 0, 0}
+        };
+        for(int i = 0; i < 3; i++){
+            geometry_point* first = geometry_point_new(coordinates[i][0], coordinates[i][1]);
+            geometry_point* second = geometry_point_new(coordinates[i][2], coordinates[i][3]);
+            geometry_point* third = geometry_point_new(coordinates[i][4], coordinates[i][5]);
+            geometry_triangle* triangle = geometry_triangle_new(first, second, third, true);
+            assert(geometry_triangle_calculateHypotenuse(triangle) == 5);
+            assert(geometry_triangle_calculateArea(triangle) == 6);
+            geometry_point* vertex = geometry_triangle_getRightAngleVertex(triangle);
+            assert(geometry_point_getX(vertex) == 0 && geometry_point_getY(vertex) == 0);
+            geometry_triangle_destroy(triangle);
+            geometry_point_destroy(first);
+            geometry_point_destroy(second);
+            geometry_point_destroy(third);
+        }
+    }
+
+    {
+        geometry_point* first = geometry_point_new(0, 0);
+        geometry_point* second = geometry_point_new(3, 0);
+        geometry_point* third = geometry_point_new(0, 4);
+        geometry_triangle* triangle = geometry_triangle_new(first, second, third, false);
+        assert(geometry_triangle_calculateHypotenuse(triangle) == -1);
+        assert(geometry_triangle_getRightAngleVertex(triangle) == NULL);
+        assert(geometry_triangle_calculateHypotenuse(NULL) == -1);
+        geometry_triangle_destroy(triangle);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+    }
+}
+
+static void geometry_test_triangle_cache(){
+    {
+        geometry_point* first = geometry_point_new(0, 0);
+        geometry_point* second = geometry_point_new(3, 0);
+        geometry_point* third = geometry_point_new(0, 6);
+        geometry_point* reference = geometry_point_new(-2, 1);
+        geometry_triangle* triangle = geometry_triangle_new(first, second, third, true);
+        geometry_real min_x, min_y, max_x, max_y, centroid_x, centroid_y;
+        geometry_triangle_getBoundingBox(triangle, &min_x, &min_y, &max_x, &max_y);
+        assert(min_x == 0 && min_y == 0 && max_x == 3 && max_y == 6);
+        geometry_triangle_getCentroid(triangle, &centroid_x, &centroid_y);
+        assert(centroid_x == 1 && centroid_y == 2);
+        double area = geometry_triangle_calculateArea(triangle);
+        double perimeter = geometry_triangle_calculatePerimeter(triangle);
+        // moving keeps cached values up to date
+        geometry_triangle_moveByVector(triangle, 10, -10);
+        geometry_triangle_getBoundingBox(triangle, &min_x, &min_y, &max_x, &max_y);
+        assert(min_x == 10 && min_y == -10 && max_x == 13 && max_y == -4);
+        geometry_triangle_getCentroid(triangle, &centroid_x, &centroid_y);
+        assert(centroid_x == 11 && centroid_y == -8);
+        // rotation keeps shape, but bounds have to change
+        geometry_triangle_rotateByAngle(triangle, M_PI / 2, reference);
+        assert(geometry_triangle_calculateArea(triangle) == area);
+        assert(geometry_triangle_calculatePerimeter(triangle) == perimeter);
+        geometry_point* got_first = NULL;
+        geometry_point* got_second = NULL;
+        geometry_point* got_third = NULL;
+        geometry_triangle_getPoints(triangle, &got_first, &got_second, &got_third);
+        geometry_triangle_getBoundingBox(triangle, &min_x, &min_y, &max_x, &max_y);
+        assert(min_x == fmin(geometry_point_getX(got_first), fmin(geometry_point_getX(got_second), geometry_point_getX(got_third))));
+        assert(max_y == fmax(geometry_point_getY(got_first), fmax(geometry_point_getY(got_second), geometry_point_getY(got_third))));
+        // direct changes of points are visible after invalidation
+        geometry_point_moveByVector(got_second, 0, 3);
+        geometry_triangle_invalidateCache(triangle);
+        assert(geometry_test_near(geometry_triangle_calculateArea(triangle), 2 * area, 1e-9));
+        geometry_triangle_destroy(triangle);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+        geometry_point_destroy(reference);
+    }
+
+    {
+        // moving vertex got from geometry_triangle_getPoints, cache is dropped when points are given out
+        geometry_point* first = geometry_point_new(0, 0);
+        geometry_point* second = geometry_point_new(4, 0);
+        geometry_point* third = geometry_point_new(0, 3);
+        geometry_triangle* triangle = geometry_triangle_new(first, second, third, true);
+        geometry_triangle* other = geometry_triangle_new(first, second, third, false);
+        geometry_triangle_moveByVector(other, 10, 0);
+        geometry_triangle_fillCache(triangle);
+        assert(geometry_triangle_calculateArea(triangle) == 6);
+        assert(geometry_triangle_areDisjoint(triangle, other));
+        geometry_point* got_first = NULL;
+        geometry_point* got_second = NULL;
+        geometry_point* got_third = NULL;
+        geometry_triangle_getPoints(triangle, &got_first, &got_second, &got_third);
+        geometry_point_moveByVector(got_second, 8, 0);
+        assert(geometry_triangle_calculateArea(triangle) == 18);
+        assert(geometry_test_near(geometry_triangle_calculatePerimeter(triangle), 15 + sqrt(153), 1e-12));
+        geometry_real min_x, min_y, max_x, max_y;
+        geometry_triangle_getBoundingBox(triangle, &min_x, &min_y, &max_x, &max_y);
+        assert(min_x == 0 && min_y == 0 && max_x == 12 && max_y == 3);
+        assert(!geometry_triangle_areDisjoint(triangle, other));
+        // getCoordinates only reads triangle, cache stays valid
+        geometry_real xs[3];
+        geometry_real ys[3];
+        geometry_triangle_getCoordinates(triangle, xs, ys);
+        assert(xs[0] == 0 && ys[0] == 0 && xs[1] == 12 && ys[1] == 0 && xs[2] == 0 && ys[2] == 3);
+        // the same for right angle vertex
+        geometry_point* vertex = geometry_triangle_getRightAngleVertex(triangle);
+        assert(vertex == got_first);
+        geometry_point_moveByVector(vertex, 0, -3);
+        assert(geometry_triangle_calculateArea(triangle) == 36);
+        geometry_triangle_getBoundingBox(triangle, &min_x, &min_y, &max_x, &max_y);
+        assert(min_x == 0 && min_y == -3 && max_x == 12 && max_y == 3);
+        geometry_triangle_destroy(triangle);
+        geometry_triangle_destroy(other);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+    }
+}
+
+static void geometry_test_segment_intersection(){
+    {
+        geometry_point* first_start = geometry_point_new(0, 0);
+        geometry_point* first_end = geometry_point_new(4, 4);
+        geometry_point* second_start = geometry_point_new(0, 4);
+        geometry_point* second_end = geometry_point_new(4, 0);
+        geometry_point* third_start = geometry_point_new(4, 4);
+        geometry_point* third_end = geometry_point_new(6, 1);
+        geometry_segment* first = geometry_segment_new(first_start, first_end);
+        geometry_segment* second = geometry_segment_new(second_start, second_end);
+        geometry_segment* third = geometry_segment_new(third_start, third_end);
+        geometry_point* crossing = geometry_segment_calculateIntersection(first, second);
+        assert(crossing != NULL);
+        assert(geometry_point_getX(crossing) == 2 && geometry_point_getY(crossing) == 2);
+        // touching with ends
+        geometry_point* touching = geometry_segment_calculateIntersection(first, third);
+        assert(touching != NULL);
+        assert(geometry_point_getX(touching) == 4 && geometry_point_getY(touching) == 4);
+        assert(geometry_segment_calculateIntersection(second, third) == NULL);
+        geometry_point_destroy(crossing);
+        geometry_point_destroy(touching);
+        geometry_segment_destroy(first);
+        geometry_segment_destroy(second);
+        geometry_segment_destroy(third);
+        geometry_point_destroy(first_start);
+        geometry_point_destroy(first_end);
+        geometry_point_destroy(second_start);
+        geometry_point_destroy(second_end);
+        geometry_point_destroy(third_start);
+        geometry_point_destroy(third_end);
+    }
+}
+
+// exact for small integer coordinates
+static int geometry_test_orientation(const double* segment, double x, double y){
+    double determinant = (segment[2] - segment[0]) * (y - segment[1]) - (segment[3] - segment[1]) * (x - segment[0]);
+    return (determinant > 0) - (determinant < 0);
+}
+
+static int geometry_test_onSegment(const double* segment, double x, double y){
+    return geometry_test_orientation(segment, x, y) == 0
+        && x >= fmin(segment[0], segment[2]) && x <= fmax(segment[0], segment[2])
+        && y >= fmin(segment[1], segment[3]) && y <= fmax(segment[1], segment[3]);
+}
+
+static int geometry_test_segmentsIntersect(const double* first, const double* second){
+    int first_start = geometry_test_orientation(first, second[0], second[1]);
+    int first_end = geometry_test_orientation(first, second[2], second[3]);
+    int second_start = geometry_test_orientation(second, first[0], first[1]);
+    int second_end = geometry_test_orientation(second, first[2], first[3]);
+    if(first_start * first_end < 0 && second_start * second_end < 0){
+        return 1;
+    }
+    return geometry_test_onSegment(first, second[0], second[1]) || geometry_test_onSegment(first, second[2], second[3])
+        || geometry_test_onSegment(second, first[0], first[1]) || geometry_test_onSegment(second, first[2], first[3]);
+}
+
+static void geometry_test_sweep_compare(const double* coordinates, size_t count){
+    size_t expected = 0;
+    char* intersecting = calloc(count * count, 1);
+    for(size_t i = 0; i < count; i++){
+        for(size_t j = i + 1; j < count; j++){
+            if(geometry_test_segmentsIntersect(coordinates + 4 * i, coordinates + 4 * j)){
+                intersecting[i * count + j] = 1;
+                expected++;
+            }
+        }
+    }
+    geometry_intersection* intersections = malloc((expected + 1) * sizeof(*intersections));
+    assert(geometry_segment_calculateIntersectionsFlat(coordinates, count, intersections, expected + 1) == expected);
+    for(size_t i = 0; i < expected; i++){
+        size_t first = intersections[i].first;
+        size_t second = intersections[i].second;
+        assert(first < second && second < count);
+        // every pair is reported once
+        assert(intersecting[first * count + second] == 1);
+        intersecting[first * count + second] = 2;
+        // common point lies within bounds of both segments
+        for(int k = 0; k < 2; k++){
+            const double* segment = coordinates + 4 * (k == 0 ? first : second);
+            assert(intersections[i].x >= fmin(segment[0], segment[2]) - 1e-9 && intersections[i].x <= fmax(segment[0], segment[2]) + 1e-9);
+            assert(intersections[i].y >= fmin(segment[1], segment[3]) - 1e-9 && intersections[i].y <= fmax(segment[1], segment[3]) + 1e-9);
+        }
+    }
+    free(intersections);
+    free(intersecting);
+}
+
+static void geometry_test_segment_batchIntersection(){
+    {
+        // star - all segments go through one point
+        double coordinates[] = {
+            0, 0, 4, 4,
+            0, 4, 4, 0,
+            2, 0, 2, 4,
+            0, 2, 4, 2,
+            1, 0, 3, 4,
+            2, 2, 5, 2
+        };
+        geometry_test_sweep_compare(coordinates, 6);
+        // results beyond capacity are only counted
+        geometry_intersection intersections[3];
+        assert(geometry_segment_calculateIntersectionsFlat(coordinates, 6, intersections, 3) == 15);
+        assert(geometry_segment_calculateIntersectionsFlat(coordinates, 6, NULL, 0) == 15);
+    }
+    {
+        // colinear overlaps, vertical segments, segments being a point
+        double coordinates[] = {
+            0, 0, 6, 0,
+            2, 0, 4, 0,
+            5, 0, 9, 0,
+            6, 0, 6, 3,
+            6, 1, 6, 5,
+            6, 3, 6, 3,
+            6, 3, 8, 1,
+            9, 0, 9, 0,
+            7, -1, 7, 7
+        };
+        geometry_test_sweep_compare(coordinates, 9);
+    }
+    {
+        // polyline - neighbours share ends
+        double coordinates[4 * 40];
+        srand(7);
+        double x = 0;
+        double y = 0;
+        for(size_t i = 0; i < 40; i++){
+            coordinates[4 * i] = x;
+            coordinates[4 * i + 1] = y;
+            x = rand() % 16;
+            y = rand() % 16;
+            coordinates[4 * i + 2] = x;
+            coordinates[4 * i + 3] = y;
+        }
+        geometry_test_sweep_compare(coordinates, 40);
+    }
+    {
+        // random segments on small grid, many shared and degenerate cases
+        double coordinates[4 * 200];
+        srand(11);
+        for(int round = 0; round < 50; round++){
+            size_t count = 1 + rand() % 200;
+            int grid = 2 + rand() % 12;
+            for(size_t i = 0; i < 4 * count; i++){
+                coordinates[i] = rand() % grid;
+            }
+            geometry_test_sweep_compare(coordinates, count);
+        }
+    }
+    {
+        // many segments on wider grid with forced vertical ones - crossings exactly at
+        // ends of other segments and colinear overlapping verticals, with rounded crossing points
+        double coordinates[4 * 300];
+        srand(3);
+        for(int round = 0; round < 20; round++){
+            size_t count = 200 + rand() % 101;
+            for(size_t i = 0; i < 4 * count; i++){
+                coordinates[i] = rand() % 50;
+            }
+            for(size_t i = 0; i < count; i += 3){
+                coordinates[4 * i + 2] = coordinates[4 * i];
+            }
+            geometry_test_sweep_compare(coordinates, count);
+        }
+    }
+    {
+        // pointer api works on the same data
+        geometry_point* points[4];
+        points[0] = geometry_point_new(0, 0);
+        points[1] = geometry_point_new(2, 2);
+        points[2] = geometry_point_new(0, 2);
+        points[3] = geometry_point_new(2, 0);
+        geometry_segment* segments[2];
+        segments[0] = geometry_segment_new(points[0], points[1]);
+        segments[1] = geometry_segment_new(points[2], points[3]);
+        geometry_intersection intersection;
+        assert(geometry_segment_calculateIntersections(segments, 2, &intersection, 1) == 1);
+        assert(intersection.first == 0 && intersection.second == 1);
+        assert(intersection.x == 1 && intersection.y == 1);
+        assert(geometry_segment_calculateIntersections(NULL, 2, &intersection, 1) == (size_t)-1);
+        geometry_segment_destroy(segments[0]);
+        geometry_segment_destroy(segments[1]);
+        for(int i = 0; i < 4; i++){
+            geometry_point_destroy(points[i]);
+        }
+    }
+}
+
+static int geometry_test_insideTriangle(const double* vertices, double x, double y){
+    double sides[3][4];
+    int positive = 0;
+    int negative = 0;
+    for(int i = 0; i < 3; i++){
+        sides[i][0] = vertices[2 * i];
+        sides[i][1] = vertices[2 * i + 1];
+        sides[i][2] = vertices[(2 * i + 2) % 6];
+        sides[i][3] = vertices[(2 * i + 3) % 6];
+        int side = geometry_test_orientation(sides[i], x, y);
+        positive += side > 0;
+        negative += side < 0;
+    }
+    if(positive == 0 && negative == 0){
+        // colinear vertices, triangle is just a segment
+        return geometry_test_onSegment(sides[0], x, y) || geometry_test_onSegment(sides[1], x, y) || geometry_test_onSegment(sides[2], x, y);
+    }
+    return positive == 0 || negative == 0;
+}
+
+static int geometry_test_trianglesIntersect(const double* first, const double* second){
+    for(int i = 0; i < 3; i++){
+        double first_side[4] = {first[2 * i], first[2 * i + 1], first[(2 * i + 2) % 6], first[(2 * i + 3) % 6]};
+        for(int j = 0; j < 3; j++){
+            double second_side[4] = {second[2 * j], second[2 * j + 1], second[(2 * j + 2) % 6], second[(2 * j + 3) % 6]};
+            if(geometry_test_segmentsIntersect(first_side, second_side)){
+                return 1;
+            }
+        }
+    }
+    return geometry_test_insideTriangle(first, second[0], second[1]) || geometry_test_insideTriangle(second, first[0], first[1]);
+}
+
+static void geometry_test_triangle_disjoint(){
+    {
+        geometry_point* points[6];
+        points[0] = geometry_point_new(0, 0);
+        points[1] = geometry_point_new(4, 0);
+        points[2] = geometry_point_new(0, 4);
+        points[3] = geometry_point_new(3, 3);
+        points[4] = geometry_point_new(5, 3);
+        points[5] = geometry_point_new(3, 5);
+        geometry_triangle* first = geometry_triangle_new(points[0], points[1], points[2], true);
+        geometry_triangle* second = geometry_triangle_new(points[3], points[4], points[5], true);
+        // bounding boxes overlap, but hypotenuse separates triangles
+        assert(geometry_triangle_areDisjoint(first, second));
+        geometry_triangle_moveByVector(second, -1, -1);
+        // touching at (2, 2)
+        assert(!geometry_triangle_areDisjoint(first, second));
+        geometry_triangle_moveByVector(second, -1, 0);
+        assert(!geometry_triangle_areDisjoint(first, second));
+        geometry_triangle_rotateByAngle(second, M_PI, points[0]);
+        assert(geometry_triangle_areDisjoint(first, second));
+        geometry_triangle_destroy(first);
+        geometry_triangle_destroy(second);
+        for(int i = 0; i < 6; i++){
+            geometry_point_destroy(points[i]);
+        }
+    }
+    {
+        // random triangles on small grid compared with checking sides and vertices
+        enum {COUNT = 60};
+        double vertices[COUNT][6];
+        geometry_triangle* triangles[COUNT];
+        bool disjoint[COUNT * COUNT];
+        srand(5);
+        for(int i = 0; i < COUNT; i++){
+            for(int k = 0; k < 6; k++){
+                vertices[i][k] = rand() % 10;
+            }
+            geometry_point* first = geometry_point_new(vertices[i][0], vertices[i][1]);
+            geometry_point* second = geometry_point_new(vertices[i][2], vertices[i][3]);
+            geometry_point* third = geometry_point_new(vertices[i][4], vertices[i][5]);
+            triangles[i] = geometry_triangle_new(first, second, third, false);
+            geometry_point_destroy(first);
+            geometry_point_destroy(second);
+            geometry_point_destroy(third);
+        }
+        size_t expected = 0;
+        for(int i = 0; i < COUNT; i++){
+            for(int j = 0; j < COUNT; j++){
+                int intersect = geometry_test_trianglesIntersect(vertices[i], vertices[j]);
+                assert(geometry_triangle_areDisjoint(triangles[i], triangles[j]) == !intersect);
+                expected += intersect;
+            }
+        }
+        assert(geometry_triangle_areDisjointMatrix(triangles, COUNT, triangles, COUNT, disjoint) == expected);
+        for(int i = 0; i < COUNT; i++){
+            size_t row_intersecting = geometry_triangle_areDisjointBatch(triangles[i], triangles, COUNT, disjoint + i * COUNT);
+            size_t row_expected = 0;
+            for(int j = 0; j < COUNT; j++){
+                assert(disjoint[i * COUNT + j] == !geometry_test_trianglesIntersect(vertices[i], vertices[j]));
+                row_expected += !disjoint[i * COUNT + j];
+            }
+            assert(row_intersecting == row_expected);
+        }
+        assert(geometry_triangle_areDisjointBatch(NULL, triangles, COUNT, disjoint) == (size_t)-1);
+        for(int i = 0; i < COUNT; i++){
+            geometry_triangle_destroy(triangles[i]);
+        }
+    }
+}
+
+static void geometry_test_grid_compare(geometry_grid* grid, geometry_triangle** triangles, size_t* ids, size_t count){
+    size_t expected_candidates = 0;
+    size_t expected_intersecting = 0;
+    for(size_t i = 0; i < count; i++){
+        for(size_t j = i + 1; j < count; j++){
+            geometry_real first_min_x, first_min_y, first_max_x, first_max_y;
+            geometry_real second_min_x, second_min_y, second_max_x, second_max_y;
+            geometry_triangle_getBoundingBox(triangles[i], &first_min_x, &first_min_y, &first_max_x, &first_max_y);
+            geometry_triangle_getBoundingBox(triangles[j], &second_min_x, &second_min_y, &second_max_x, &second_max_y);
+            if(first_max_x >= second_min_x && second_max_x >= first_min_x && first_max_y >= second_min_y && second_max_y >= first_min_y){
+                expected_candidates++;
+            }
+            expected_intersecting += !geometry_triangle_areDisjoint(triangles[i], triangles[j]);
+        }
+    }
+    geometry_grid_pair* pairs = malloc((expected_candidates + 1) * sizeof(*pairs));
+    assert(geometry_grid_calculateCandidatePairs(grid, pairs, expected_candidates + 1) == expected_candidates);
+    char* seen = calloc(count * count, 1);
+    for(size_t k = 0; k < expected_candidates; k++){
+        assert(pairs[k].first < pairs[k].second);
+        geometry_triangle* first = geometry_grid_getTriangle(grid, pairs[k].first);
+        geometry_triangle* second = geometry_grid_getTriangle(grid, pairs[k].second);
+        size_t i = 0;
+        size_t j = 0;
+        while(ids[i] != pairs[k].first){
+            i++;
+        }
+        while(ids[j] != pairs[k].second){
+            j++;
+        }
+        assert(first == triangles[i] && second == triangles[j]);
+        // no pair is reported twice
+        assert(!seen[i * count + j]);
+        seen[i * count + j] = 1;
+    }
+    assert(geometry_grid_calculateIntersectingPairs(grid, pairs, expected_candidates + 1) == expected_intersecting);
+    for(size_t k = 0; k < expected_intersecting; k++){
+        assert(!geometry_triangle_areDisjoint(geometry_grid_getTriangle(grid, pairs[k].first), geometry_grid_getTriangle(grid, pairs[k].second)));
+    }
+    free(seen);
+    free(pairs);
+}
+
+static void geometry_test_grid_pairs(){
+    {
+        enum {COUNT = 300};
+        geometry_triangle* triangles[COUNT];
+        size_t ids[COUNT];
+        geometry_grid* grid = geometry_grid_new(2.5);
+        assert(grid != NULL);
+        assert(geometry_grid_new(0) == NULL);
+        srand(3);
+        for(int i = 0; i < COUNT; i++){
+            double x = rand() % 100;
+            double y = rand() % 100;
+            geometry_point* first = geometry_point_new(x, y);
+            geometry_point* second = geometry_point_new(x + rand() % 6, y + rand() % 3);
+            geometry_point* third = geometry_point_new(x - rand() % 3, y + rand() % 6);
+            triangles[i] = geometry_triangle_new(first, second, third, false);
+            ids[i] = geometry_grid_insert(grid, triangles[i]);
+            assert(ids[i] != (size_t)-1);
+            geometry_point_destroy(first);
+            geometry_point_destroy(second);
+            geometry_point_destroy(third);
+        }
+        geometry_test_grid_compare(grid, triangles, ids, COUNT);
+        // incremental updates after moving and rotating
+        geometry_point* reference = geometry_point_new(50, 50);
+        for(int step = 0; step < 5; step++){
+            for(int i = 0; i < COUNT; i++){
+                if(i % 3 == 0){
+                    assert(geometry_grid_moveByVector(grid, ids[i], rand() % 7 - 3, rand() % 7 - 3));
+                }
+                else if(i % 3 == 1){
+                    geometry_triangle_rotateByAngle(triangles[i], 0.1, reference);
+                    assert(geometry_grid_update(grid, ids[i]));
+                }
+            }
+            geometry_test_grid_compare(grid, triangles, ids, COUNT);
+        }
+        geometry_point_destroy(reference);
+        // removed ids are reused
+        size_t removed = ids[COUNT - 1];
+        assert(geometry_grid_remove(grid, removed));
+        assert(!geometry_grid_remove(grid, removed));
+        assert(geometry_grid_getTriangle(grid, removed) == NULL);
+        geometry_test_grid_compare(grid, triangles, ids, COUNT - 1);
+        assert(geometry_grid_insert(grid, triangles[COUNT - 1]) == removed);
+        geometry_test_grid_compare(grid, triangles, ids, COUNT);
+        geometry_grid_destroy(grid);
+        for(int i = 0; i < COUNT; i++){
+            geometry_triangle_destroy(triangles[i]);
+        }
+    }
+}
+
+static void geometry_test_bvh_compare(geometry_bvh* bvh, geometry_triangle** triangles, size_t* ids, size_t count){
+    size_t expected_pairs = 0;
+    for(size_t i = 0; i < count; i++){
+        size_t expected = 0;
+        for(size_t j = 0; j < count; j++){
+            expected += !geometry_triangle_areDisjoint(triangles[i], triangles[j]);
+        }
+        expected_pairs += expected - 1;
+        size_t found[64];
+        assert(geometry_bvh_queryTriangle(bvh, triangles[i], found, 64) == expected);
+        int contains_self = 0;
+        for(size_t k = 0; k < expected && k < 64; k++){
+            contains_self |= found[k] == ids[i];
+            assert(!geometry_triangle_areDisjoint(geometry_bvh_getTriangle(bvh, found[k]), triangles[i]));
+        }
+        assert(contains_self);
+        // centroid lies inside triangle
+        geometry_real x, y;
+        geometry_triangle_getCentroid(triangles[i], &x, &y);
+        assert(geometry_bvh_queryPoint(bvh, x, y, found, 64) >= 1);
+    }
+    expected_pairs /= 2;
+    geometry_bvh_pair* pairs = malloc((expected_pairs + 1) * sizeof(*pairs));
+    assert(geometry_bvh_calculateIntersectingPairs(bvh, pairs, expected_pairs + 1) == expected_pairs);
+    for(size_t k = 0; k < expected_pairs; k++){
+        assert(pairs[k].first < pairs[k].second);
+        assert(!geometry_triangle_areDisjoint(geometry_bvh_getTriangle(bvh, pairs[k].first), geometry_bvh_getTriangle(bvh, pairs[k].second)));
+    }
+    free(pairs);
+}
+
+static void geometry_test_bvh_queries(){
+    {
+        enum {COUNT = 300};
+        geometry_triangle* triangles[COUNT];
+        size_t ids[COUNT];
+        geometry_bvh* bvh = geometry_bvh_new(0.5);
+        assert(bvh != NULL);
+        assert(geometry_bvh_new(-1) == NULL);
+        srand(13);
+        for(int i = 0; i < COUNT; i++){
+            double x = rand() % 100;
+            double y = rand() % 100;
+            geometry_point* first = geometry_point_new(x, y);
+            geometry_point* second = geometry_point_new(x + 1 + rand() % 5, y + rand() % 3);
+            geometry_point* third = geometry_point_new(x - rand() % 3, y + 1 + rand() % 5);
+            triangles[i] = geometry_triangle_new(first, second, third, false);
+            ids[i] = geometry_bvh_insert(bvh, triangles[i]);
+            assert(ids[i] != (size_t)-1);
+            geometry_point_destroy(first);
+            geometry_point_destroy(second);
+            geometry_point_destroy(third);
+        }
+        geometry_test_bvh_compare(bvh, triangles, ids, COUNT);
+        geometry_point* reference = geometry_point_new(50, 50);
+        for(int step = 0; step < 5; step++){
+            for(int i = 0; i < COUNT; i++){
+                if(i % 3 == 0){
+                    assert(geometry_bvh_moveByVector(bvh, ids[i], rand() % 7 - 3, rand() % 7 - 3));
+                }
+                else if(i % 3 == 1){
+                    assert(geometry_bvh_rotateByAngle(bvh, ids[i], 0.05, reference));
+                }
+                else{
+                    geometry_triangle_moveByVector(triangles[i], 0.25, 0);
+                }
+            }
+            // triangles changed directly are fixed with refit
+            geometry_bvh_refit(bvh);
+            geometry_test_bvh_compare(bvh, triangles, ids, COUNT);
+        }
+        geometry_point_destroy(reference);
+        assert(geometry_bvh_remove(bvh, ids[COUNT - 1]));
+        assert(!geometry_bvh_remove(bvh, ids[COUNT - 1]));
+        assert(geometry_bvh_getTriangle(bvh, ids[COUNT - 1]) == NULL);
+        geometry_test_bvh_compare(bvh, triangles, ids, COUNT - 1);
+        geometry_bvh_destroy(bvh);
+        for(int i = 0; i < COUNT; i++){
+            geometry_triangle_destroy(triangles[i]);
+        }
+    }
+    {
+        // row of triangles along x axis hit by rays
+        geometry_bvh* bvh = geometry_bvh_new(0);
+        geometry_triangle* triangles[4];
+        size_t ids[4];
+        for(int i = 0; i < 4; i++){
+            geometry_point* first = geometry_point_new(10 * i, -1);
+            geometry_point* second = geometry_point_new(10 * i + 2, -1);
+            geometry_point* third = geometry_point_new(10 * i, 1);
+            triangles[i] = geometry_triangle_new(first, second, third, true);
+            ids[i] = geometry_bvh_insert(bvh, triangles[i]);
+            geometry_point_destroy(first);
+            geometry_point_destroy(second);
+            geometry_point_destroy(third);
+        }
+        double t = -1;
+        assert(geometry_bvh_castRay(bvh, -5, 0, 1, 0, &t) == ids[0]);
+        assert(t == 5);
+        assert(geometry_bvh_castRay(bvh, 15, 0, 2, 0, &t) == ids[2]);
+        assert(t == 2.5);
+        assert(geometry_bvh_castRay(bvh, 15, 0, -1, 0, &t) == ids[1]);
+        assert(t == 4);
+        assert(geometry_bvh_castRay(bvh, 20.5, 0, -1, 0, &t) == ids[2]);
+        assert(t == 0);
+        assert(geometry_bvh_castRay(bvh, -5, 0, 0, 1, &t) == (size_t)-1);
+        assert(geometry_bvh_castRay(bvh, -5, 3, 1, 0, &t) == (size_t)-1);
+        // ray grazing the top vertex
+        assert(geometry_bvh_castRay(bvh, -5, 1, 1, 0, &t) == ids[0]);
+        assert(t == 5);
+        geometry_bvh_moveByVector(bvh, ids[0], 0, 5);
+        assert(geometry_bvh_castRay(bvh, -5, 0, 1, 0, &t) == ids[1]);
+        assert(t == 15);
+        geometry_bvh_destroy(bvh);
+        for(int i = 0; i < 4; i++){
+            geometry_triangle_destroy(triangles[i]);
+        }
+    }
+}
+
+static void geometry_test_rtree_points(){
+    {
+        enum {SEGMENTS = 500, POINTS = 2000};
+        geometry_real coordinates[4 * SEGMENTS];
+        geometry_real xs[POINTS];
+        geometry_real ys[POINTS];
+        srand(17);
+        for(int i = 0; i < SEGMENTS; i++){
+            coordinates[4 * i] = rand() % 40;
+            coordinates[4 * i + 1] = rand() % 40;
+            coordinates[4 * i + 2] = coordinates[4 * i] + rand() % 7 - 3;
+            coordinates[4 * i + 3] = coordinates[4 * i + 1] + rand() % 7 - 3;
+        }
+        for(int i = 0; i < POINTS; i++){
+            xs[i] = (rand() % 81) / 2.0;
+            ys[i] = (rand() % 81) / 2.0;
+        }
+        geometry_rtree* rtree = geometry_rtree_newFlat(coordinates, SEGMENTS);
+        assert(rtree != NULL);
+        double tolerances[3] = {0, 0.25, 1.5};
+        for(int k = 0; k < 3; k++){
+            double tolerance = tolerances[k];
+            size_t expected = 0;
+            for(int i = 0; i < POINTS; i++){
+                for(int j = 0; j < SEGMENTS; j++){
+                    double segment[4] = {coordinates[4 * j], coordinates[4 * j + 1], coordinates[4 * j + 2], coordinates[4 * j + 3]};
+                    int matches;
+                    if(tolerance == 0){
+                        matches = geometry_test_onSegment(segment, xs[i], ys[i]);
+                    }
+                    else{
+                        double side_x = segment[2] - segment[0];
+                        double side_y = segment[3] - segment[1];
+                        double length = side_x * side_x + side_y * side_y;
+                        double t = length > 0 ? fmin(1, fmax(0, ((xs[i] - segment[0]) * side_x + (ys[i] - segment[1]) * side_y) / length)) : 0;
+                        matches = hypot(xs[i] - segment[0] - t * side_x, ys[i] - segment[1] - t * side_y) <= tolerance;
+                    }
+                    expected += matches;
+                }
+            }
+            geometry_rtree_match* matches = malloc((expected + 1) * sizeof(*matches));
+            assert(geometry_rtree_queryPoints(rtree, xs, ys, POINTS, tolerance, matches, expected + 1) == expected);
+            // single point queries give the same segments
+            size_t position = 0;
+            for(int i = 0; i < POINTS; i++){
+                size_t found[64];
+                size_t count = geometry_rtree_queryPoint(rtree, xs[i], ys[i], tolerance, found, 64);
+                for(size_t j = 0; j < count; j++){
+                    assert(matches[position].point == (size_t)i);
+                    assert(matches[position].segment == found[j]);
+                    position++;
+                }
+            }
+            assert(position == expected);
+            free(matches);
+        }
+        assert(geometry_rtree_queryPoint(rtree, 0, 0, -1, NULL, 0) == (size_t)-1);
+        geometry_rtree_destroy(rtree);
+    }
+    {
+        geometry_point* start = geometry_point_new(0, 0);
+        geometry_point* end = geometry_point_new(4, 2);
+        geometry_segment* segment = geometry_segment_new(start, end);
+        geometry_rtree* rtree = geometry_rtree_new(&segment, 1);
+        size_t found;
+        assert(geometry_rtree_queryPoint(rtree, 2, 1, 0, &found, 1) == 1 && found == 0);
+        // lies on line, but not on segment
+        assert(geometry_rtree_queryPoint(rtree, 6, 3, 0, &found, 1) == 0);
+        geometry_rtree_destroy(rtree);
+        geometry_segment_destroy(segment);
+        geometry_point_destroy(start);
+        geometry_point_destroy(end);
+        rtree = geometry_rtree_newFlat(NULL, 0);
+        assert(geometry_rtree_queryPoint(rtree, 0, 0, 1, &found, 1) == 0);
+        geometry_rtree_destroy(rtree);
+        // sizes of arrays would overflow
+        geometry_real coordinates[4] = {0, 0, 1, 1};
+        assert(geometry_rtree_newFlat(coordinates, SIZE_MAX / 4 + 1) == NULL);
+        geometry_segment* missing = NULL;
+        assert(geometry_rtree_new(&missing, SIZE_MAX / 4 + 1) == NULL);
+    }
+}
+
+static void geometry_test_predicates_nearColinear(){
+    {
+        // points just off the line y = x, naive determinant gets many of them wrong
+        const double ulp = ldexp(1, -53);
+        geometry_predicates_resetFallbackCount();
+        for(int i = 0; i < 64; i++){
+            for(int j = 0; j < 64; j++){
+                double x = 0.5 + i * ulp;
+                double y = 0.5 + j * ulp;
+                int expected = (j > i) - (j < i);
+                assert(geometry_predicates_orientation(x, y, 12, 12, 24, 24) == expected);
+                assert(geometry_predicates_orientation(12, 12, 24, 24, x, y) == expected);
+                assert(geometry_predicates_orientation(24, 24, x, y, 12, 12) == expected);
+            }
+        }
+        unsigned long long fallbacks = geometry_predicates_getFallbackCount();
+        assert(fallbacks > 0);
+        // well separated points are decided by floating-point filter alone
+        assert(geometry_predicates_orientation(0, 0, 1, 0, 0, 1) == 1);
+        assert(geometry_predicates_orientation(0, 0, 1, 0, 0, -1) == -1);
+        assert(geometry_predicates_getFallbackCount() == fallbacks);
+        geometry_predicates_resetFallbackCount();
+        assert(geometry_predicates_getFallbackCount() == 0);
+    }
+    {
+        // directions differing only at the last bits
+        double big = ldexp(1, 30);
+        assert(geometry_predicates_crossSign(0, 0, big, big + 1, 0, 0, big + 1, big + 2) == -1);
+        assert(geometry_predicates_crossSign(0, 0, big, big + 1, 0, 0, big, big + 1) == 0);
+        assert(geometry_predicates_crossSign(0.1, 0.1, 0.3, 0.3, 1e15, 1e15, 1e15 + 2, 1e15 + 2) == 0);
+        assert(geometry_predicates_dotSign(0, 0, big, 1, 0, 0, -1, big) == 0);
+        assert(geometry_predicates_dotSign(0, 0, big, 1, 0, 0, -1, big + 1) == 1);
+        assert(geometry_predicates_dotSign(0, 0, big, 1, 0, 0, -1, big - 1) == -1);
+    }
+    {
+        geometry_point* start = geometry_point_new(0.1, 0.2);
+        geometry_point* end = geometry_point_new(0.7, 1.4);
+        geometry_point* middle = geometry_point_new(0.4, 0.8);
+        geometry_point* beyond = geometry_point_new(1.0, 2.0);
+        geometry_segment* segment = geometry_segment_new(start, end);
+        // doubling is exact, so all points lie exactly on y = 2x, even if products round differently
+        assert(geometry_point_liesOnSegment(middle, segment));
+        assert(geometry_point_liesOnSegment(start, segment));
+        assert(geometry_point_liesOnSegment(end, segment));
+        assert(!geometry_point_liesOnSegment(beyond, segment));
+        geometry_point_destroy(start);
+        geometry_point_destroy(end);
+        geometry_point_destroy(middle);
+        geometry_point_destroy(beyond);
+        geometry_segment_destroy(segment);
+    }
+    {
+        geometry_point* points[8];
+        points[0] = geometry_point_new(0, 0);
+        points[1] = geometry_point_new(3, 1);
+        points[2] = geometry_point_new(5, 5);
+        points[3] = geometry_point_new(11, 7);
+        points[4] = geometry_point_new(2, 2);
+        points[5] = geometry_point_new(1, 5);
+        points[6] = geometry_point_new(7, 0);
+        points[7] = geometry_point_new(6, 4);
+        geometry_segment* first = geometry_segment_new(points[0], points[1]);
+        geometry_segment* parallel = geometry_segment_new(points[2], points[3]);
+        geometry_segment* perpendicular = geometry_segment_new(points[4], points[5]);
+        geometry_segment* other = geometry_segment_new(points[6], points[7]);
+        assert(geometry_segment_areParallel(first, parallel));
+        assert(geometry_segment_areParallel(parallel, first));
+        assert(!geometry_segment_areParallel(first, perpendicular));
+        assert(!geometry_segment_areParallel(first, other));
+        assert(geometry_segment_arePerpendicular(first, perpendicular));
+        assert(geometry_segment_arePerpendicular(perpendicular, parallel));
+        assert(!geometry_segment_arePerpendicular(first, parallel));
+        assert(!geometry_segment_arePerpendicular(first, other));
+        geometry_segment_destroy(first);
+        geometry_segment_destroy(parallel);
+        geometry_segment_destroy(perpendicular);
+        geometry_segment_destroy(other);
+        for(int i = 0; i < 8; i++){
+            geometry_point_destroy(points[i]);
+        }
+    }
+}
+
+static int geometry_test_kdtree_compareDistances(const void* first, const void* second){
+    double first_distance = *(const double*)first;
+    double second_distance = *(const double*)second;
+    return (first_distance > second_distance) - (first_distance < second_distance);
+}
+static void geometry_test_kdtree_queries(){
+    {
+        enum {POINTS = 3000, QUERIES = 200, K = 7};
+        geometry_point_buffer* buffer = geometry_point_buffer_new(POINTS);
+        srand(23);
+        for(int i = 0; i < POINTS; i++){
+            // many repeated coordinates, so splits see equal values
+            geometry_point_buffer_push(buffer, rand() % 100, (rand() % 4000) / 40.0);
+        }
+        geometry_real* xs = NULL;
+        geometry_real* ys = NULL;
+        geometry_point_buffer_getCoordinates(buffer, &xs, &ys);
+        geometry_kdtree* kdtree = geometry_kdtree_new(buffer);
+        assert(kdtree != NULL);
+        geometry_real query_xs[QUERIES];
+        geometry_real query_ys[QUERIES];
+        for(int i = 0; i < QUERIES; i++){
+            query_xs[i] = (rand() % 1300) / 10.0 - 15;
+            query_ys[i] = (rand() % 1300) / 10.0 - 15;
+        }
+        size_t batch_points[QUERIES * K];
+        geometry_real batch_distances[QUERIES * K];
+        assert(geometry_kdtree_findNearestBatch(kdtree, query_xs, query_ys, QUERIES, K, batch_points, batch_distances) == K);
+        double radius = 4.5;
+        size_t expected_pairs = 0;
+        static double all_distances[POINTS];
+        for(int i = 0; i < QUERIES; i++){
+            for(int j = 0; j < POINTS; j++){
+                all_distances[j] = hypot(xs[j] - query_xs[i], ys[j] - query_ys[i]);
+                expected_pairs += all_distances[j] <= radius;
+            }
+            size_t points[K];
+            geometry_real distances[K];
+            assert(geometry_kdtree_findNearest(kdtree, query_xs[i], query_ys[i], K, points, distances) == K);
+            for(int j = 0; j < K; j++){
+                assert(points[j] == batch_points[i * K + j]);
+                assert(geometry_test_near(distances[j], hypot(xs[points[j]] - query_xs[i], ys[points[j]] - query_ys[i]), 1e-12));
+            }
+            qsort(all_distances, POINTS, sizeof(double), geometry_test_kdtree_compareDistances);
+            for(int j = 0; j < K; j++){
+                assert(geometry_test_near(distances[j], all_distances[j], 1e-12));
+            }
+        }
+        geometry_kdtree_match* matches = malloc((expected_pairs + 1) * sizeof(*matches));
+        assert(geometry_kdtree_findInRadiusBatch(kdtree, query_xs, query_ys, QUERIES, radius, matches, expected_pairs + 1) == expected_pairs);
+        size_t position = 0;
+        for(int i = 0; i < QUERIES; i++){
+            size_t found[256];
+            size_t count = geometry_kdtree_findInRadius(kdtree, query_xs[i], query_ys[i], radius, found, 256);
+            assert(count <= 256);
+            assert(geometry_kdtree_findInRadius(kdtree, query_xs[i], query_ys[i], radius, NULL, 0) == count);
+            for(size_t j = 0; j < count; j++){
+                assert(matches[position].query == (size_t)i);
+                assert(matches[position].point == found[j]);
+                assert(hypot(xs[found[j]] - query_xs[i], ys[found[j]] - query_ys[i]) <= radius);
+                position++;
+            }
+        }
+        assert(position == expected_pairs);
+        free(matches);
+        geometry_kdtree_destroy(kdtree);
+        geometry_point_buffer_destroy(buffer);
+    }
+
+    {
+        geometry_real xs[3] = {0, 5, 1};
+        geometry_real ys[3] = {0, 5, 1};
+        geometry_kdtree* kdtree = geometry_kdtree_newFlat(xs, ys, 3);
+        size_t points[5];
+        geometry_real distances[5];
+        assert(geometry_kdtree_findNearest(kdtree, 4, 4, 5, points, distances) == 3);
+        assert(points[0] == 1 && points[1] == 2 && points[2] == 0);
+        assert(geometry_test_near(distances[0], sqrt(2), 0));
+        assert(geometry_kdtree_findNearest(kdtree, 4, 4, 0, NULL, NULL) == 0);
+        assert(geometry_kdtree_findInRadius(kdtree, 0, 0, -1, NULL, 0) == (size_t)-1);
+        geometry_kdtree_destroy(kdtree);
+
+        kdtree = geometry_kdtree_newFlat(NULL, NULL, 0);
+        assert(kdtree != NULL);
+        assert(geometry_kdtree_findNearest(kdtree, 0, 0, 2, points, distances) == 0);
+        assert(geometry_kdtree_findInRadius(kdtree, 0, 0, 1, points, 5) == 0);
+        geometry_kdtree_destroy(kdtree);
+        assert(geometry_kdtree_new(NULL) == NULL);
+        // sizes of arrays would overflow
+        assert(geometry_kdtree_newFlat(xs, ys, SIZE_MAX / sizeof(size_t) + 1) == NULL);
+    }
+}
+
+static void geometry_test_pool_countTask(size_t begin, size_t end, void* context){
+    int* visits = context;
+    for(size_t i = begin; i < end; i++){
+        visits[i]++;
+    }
+}
+static void geometry_test_pool_batch(){
+    {
+        enum {COUNT = 100000};
+        geometry_pool* pool = geometry_pool_new(4);
+        assert(pool != NULL);
+        assert(geometry_pool_getThreadCount(pool) == 4);
+        assert(geometry_pool_setChunkSize(pool, 0) == false);
+        assert(geometry_pool_setChunkSize(pool, 100));
+        assert(geometry_pool_getChunkSize(pool) == 100);
+        int* visits = calloc(COUNT, sizeof(*visits));
+        for(int run = 0; run < 20; run++){
+            assert(geometry_pool_run(pool, COUNT - run * 1000, geometry_test_pool_countTask, visits));
+        }
+        for(int i = 0; i < COUNT; i++){
+            int expected = 0;
+            for(int run = 0; run < 20; run++){
+                expected += i < COUNT - run * 1000;
+            }
+            assert(visits[i] == expected);
+        }
+        assert(geometry_pool_run(pool, 10, NULL, NULL) == false);
+        assert(geometry_pool_run(NULL, 10, geometry_test_pool_countTask, visits));
+        assert(visits[9] == 21);
+        free(visits);
+        geometry_pool_destroy(pool);
+    }
+
+    {
+        enum {COUNT = 5000};
+        geometry_pool* pool = geometry_pool_new(0);
+        assert(pool != NULL && geometry_pool_getThreadCount(pool) >= 1);
+        geometry_pool_setChunkSize(pool, 64);
+        geometry_triangle** triangles = malloc(COUNT * sizeof(*triangles));
+        for(int i = 0; i < COUNT; i++){
+            geometry_point* first = geometry_point_new(i % 7, 0);
+            geometry_point* second = geometry_point_new(i % 7, 1 + i % 5);
+            geometry_point* third = geometry_point_new(i % 7 + 1 + i % 3, 0);
+            triangles[i] = i % 11 == 0 ? NULL : geometry_triangle_new(first, second, third, i % 2 == 0);
+            geometry_point_destroy(first);
+            geometry_point_destroy(second);
+            geometry_point_destroy(third);
+        }
+        geometry_real* areas = malloc(COUNT * sizeof(*areas));
+        geometry_real* perimeters = malloc(COUNT * sizeof(*perimeters));
+        geometry_real* hypotenuses = malloc(COUNT * sizeof(*hypotenuses));
+        assert(geometry_triangle_calculateAreaBatch(pool, triangles, COUNT, areas));
+        assert(geometry_triangle_calculatePerimeterBatch(pool, triangles, COUNT, perimeters));
+        assert(geometry_triangle_calculateHypotenuseBatch(pool, triangles, COUNT, hypotenuses));
+        for(int i = 0; i < COUNT; i++){
+            assert(areas[i] == geometry_triangle_calculateArea(triangles[i]));
+            assert(perimeters[i] == geometry_triangle_calculatePerimeter(triangles[i]));
+            assert(hypotenuses[i] == geometry_triangle_calculateHypotenuse(triangles[i]));
+            assert(triangles[i] != NULL || areas[i] == -1);
+        }
+        assert(geometry_triangle_calculateAreaBatch(NULL, triangles, COUNT, areas));
+        assert(geometry_triangle_calculateAreaBatch(pool, NULL, COUNT, areas) == false);
+        for(int i = 0; i < COUNT; i++){
+            geometry_triangle_destroy(triangles[i]);
+        }
+        free(hypotenuses);
+        free(perimeters);
+        free(areas);
+        free(triangles);
+        geometry_pool_destroy(pool);
+    }
+
+    {
+        // the same triangle given many times, its cache is filled before threads start
+        enum {COUNT = 4096};
+        geometry_pool* pool = geometry_pool_new(4);
+        geometry_pool_setChunkSize(pool, 16);
+        geometry_point* first = geometry_point_new(0, 0);
+        geometry_point* second = geometry_point_new(3, 0);
+        geometry_point* third = geometry_point_new(0, 4);
+        geometry_triangle* triangle = geometry_triangle_new(first, second, third, true);
+        geometry_triangle* triangles[COUNT];
+        geometry_real areas[COUNT];
+        geometry_real hypotenuses[COUNT];
+        for(int i = 0; i < COUNT; i++){
+            triangles[i] = triangle;
+        }
+        assert(geometry_triangle_calculateAreaBatch(pool, triangles, COUNT, areas));
+        geometry_triangle_moveByVector(triangle, 1, 1);
+        geometry_triangle_invalidateCache(triangle);
+        assert(geometry_triangle_calculateHypotenuseBatch(pool, triangles, COUNT, hypotenuses));
+        for(int i = 0; i < COUNT; i++){
+            assert(areas[i] == 6);
+            assert(hypotenuses[i] == 5);
+        }
+        geometry_triangle_destroy(triangle);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+        geometry_pool_destroy(pool);
+    }
+}
+
+static void geometry_test_pool_collisions(){
+    {
+        enum {COUNT = 400};
+        geometry_triangle* triangles[COUNT];
+        size_t ids[COUNT];
+        geometry_grid* grid = geometry_grid_new(4);
+        srand(31);
+        for(int i = 0; i < COUNT; i++){
+            // dense cluster in one corner, so cells have very different cost
+            double x = i % 4 == 0 ? rand() % 200 : rand() % 20;
+            double y = i % 4 == 0 ? rand() % 200 : rand() % 20;
+            geometry_point* first = geometry_point_new(x, y);
+            geometry_point* second = geometry_point_new(x + rand() % 6, y + rand() % 3);
+            geometry_point* third = geometry_point_new(x - rand() % 3, y + rand() % 6);
+            triangles[i] = geometry_triangle_new(first, second, third, false);
+            ids[i] = geometry_grid_insert(grid, triangles[i]);
+            geometry_point_destroy(first);
+            geometry_point_destroy(second);
+            geometry_point_destroy(third);
+        }
+        char* expected = calloc(COUNT * COUNT, 1);
+        size_t expected_count = 0;
+        for(int i = 0; i < COUNT; i++){
+            for(int j = i + 1; j < COUNT; j++){
+                expected[i * COUNT + j] = !geometry_triangle_areDisjoint(triangles[i], triangles[j]);
+                expected_count += expected[i * COUNT + j];
+            }
+        }
+        geometry_pool* pool = geometry_pool_new(4);
+        geometry_pool_pair* pairs = malloc((expected_count + 1) * sizeof(*pairs));
+        geometry_grid_pair* grid_pairs = malloc((expected_count + 1) * sizeof(*grid_pairs));
+        for(int run = 0; run < 2; run++){
+            geometry_pool* used_pool = run == 0 ? pool : NULL;
+            char* seen = calloc(COUNT * COUNT, 1);
+            assert(geometry_triangle_calculateIntersectingPairs(used_pool, triangles, COUNT, pairs, expected_count + 1) == expected_count);
+            for(size_t k = 0; k < expected_count; k++){
+                assert(pairs[k].first < pairs[k].second);
+                assert(expected[pairs[k].first * COUNT + pairs[k].second]);
+                assert(!seen[pairs[k].first * COUNT + pairs[k].second]);
+                seen[pairs[k].first * COUNT + pairs[k].second] = 1;
+            }
+            assert(geometry_grid_calculateIntersectingPairsParallel(grid, used_pool, grid_pairs, expected_count + 1) == expected_count);
+            for(size_t k = 0; k < expected_count; k++){
+                size_t i = 0;
+                size_t j = 0;
+                while(ids[i] != grid_pairs[k].first){
+                    i++;
+                }
+                while(ids[j] != grid_pairs[k].second){
+                    j++;
+                }
+                size_t first = i < j ? i : j;
+                size_t second = i < j ? j : i;
+                assert(seen[first * COUNT + second] == 1);
+                seen[first * COUNT + second] = 2;
+            }
+            free(seen);
+        }
+        assert(geometry_triangle_calculateIntersectingPairs(pool, triangles, COUNT, NULL, 0) == expected_count);
+        geometry_triangle* removed = triangles[7];
+        triangles[7] = NULL;
+        assert(geometry_triangle_calculateIntersectingPairs(pool, triangles, COUNT, pairs, expected_count + 1) == (size_t)-1);
+        triangles[7] = removed;
+        free(grid_pairs);
+        free(pairs);
+        free(expected);
+        geometry_pool_destroy(pool);
+        geometry_grid_destroy(grid);
+        for(int i = 0; i < COUNT; i++){
+            geometry_triangle_destroy(triangles[i]);
+        }
+    }
+}
+
+typedef struct geometry_test_allocatorCounter {
+    atomic_size_t allocations;
+    atomic_size_t frees;
+} geometry_test_allocatorCounter;
+
+static void* geometry_test_allocator_allocate(size_t size, void* user_data){
+    geometry_test_allocatorCounter* counter = user_data;
+    atomic_fetch_add(&counter->allocations, 1);
+    return malloc(size);
+}
+
+static void geometry_test_allocator_free(void* pointer, void* user_data){
+    geometry_test_allocatorCounter* counter = user_data;
+    atomic_fetch_add(&counter->frees, 1);
+    free(pointer);
+}
+
+static void geometry_test_allocator_hooks(){
+    {
+        geometry_test_allocatorCounter counter;
+        atomic_init(&counter.allocations, 0);
+        atomic_init(&counter.frees, 0);
+        assert(geometry_set_allocator(geometry_test_allocator_allocate, geometry_test_allocator_free, &counter));
+        assert(geometry_get_allocator().user_data == &counter);
+        geometry_point* first = geometry_point_new(0.0, 0.0);
+        geometry_point* second = geometry_point_new(2.0, 2.0);
+        geometry_point* third = geometry_point_new(2.0, 0.0);
+        assert(atomic_load(&counter.allocations) == 3);
+        geometry_segment* segments[2] = {geometry_segment_new(first, second), geometry_segment_new(second, third)};
+        geometry_triangle* triangle = geometry_triangle_new(first, second, third, true);
+        geometry_transform* transform = geometry_transform_new();
+        geometry_transform* inverse = geometry_transform_invert(transform);
+        geometry_rotation* rotation = geometry_rotation_new(1.0, first);
+        geometry_point_buffer* buffer = geometry_point_buffer_new(0);
+        // growing buffer moves its coordinates to new memory
+        for(int i = 0; i < 1000; i++){
+            assert(geometry_point_buffer_push(buffer, i, -i));
+        }
+        assert(geometry_point_buffer_getX(buffer, 999) == 999);
+        assert(geometry_point_buffer_getY(buffer, 0) == 0);
+        geometry_kdtree* kdtree = geometry_kdtree_new(buffer);
+        geometry_grid* grid = geometry_grid_new(1.0);
+        assert(geometry_grid_insert(grid, triangle) != (size_t)-1);
+        geometry_intersection intersections[1];
+        assert(geometry_segment_calculateIntersections(segments, 2, intersections, 1) == 1);
+        geometry_grid_destroy(grid);
+        geometry_kdtree_destroy(kdtree);
+        geometry_point_buffer_destroy(buffer);
+        geometry_rotation_destroy(rotation);
+        geometry_transform_destroy(inverse);
+        geometry_transform_destroy(transform);
+        geometry_triangle_destroy(triangle);
+        geometry_segment_destroy(segments[0]);
+        geometry_segment_destroy(segments[1]);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+        assert(atomic_load(&counter.allocations) > 20);
+        assert(atomic_load(&counter.allocations) == atomic_load(&counter.frees));
+
+        // default allocator is back after setting NULL functions
+        assert(geometry_set_allocator(NULL, NULL, NULL));
+        size_t allocations = atomic_load(&counter.allocations);
+        geometry_point* point = geometry_point_new(1.0, 1.0);
+        geometry_point_destroy(point);
+        assert(atomic_load(&counter.allocations) == allocations);
+        assert(geometry_get_allocator().user_data == NULL);
+    }
+
+    {
+        geometry_test_allocatorCounter counter;
+        atomic_init(&counter.allocations, 0);
+        atomic_init(&counter.frees, 0);
+        assert(!geometry_set_allocator(geometry_test_allocator_allocate, NULL, &counter));
+        assert(!geometry_set_allocator(NULL, geometry_test_allocator_free, &counter));
+        assert(geometry_get_allocator().user_data == NULL);
+    }
+
+    {
+        // allocator given to single call is used only by that object
+        geometry_test_allocatorCounter counter;
+        atomic_init(&counter.allocations, 0);
+        atomic_init(&counter.frees, 0);
+        geometry_allocator allocator = {geometry_test_allocator_allocate, geometry_test_allocator_free, &counter};
+        geometry_point* point = geometry_point_new_with(&allocator, 1.0, 2.0);
+        geometry_point* other = geometry_point_new(2.0, 1.0);
+        assert(atomic_load(&counter.allocations) == 1);
+        geometry_segment* segment = geometry_segment_new_with(&allocator, point, other);
+        geometry_triangle* triangle = geometry_triangle_new_with(&allocator, point, other, other, false);
+        geometry_transform* transform = geometry_transform_new_with(&allocator);
+        geometry_rotation* rotation = geometry_rotation_new_with(&allocator, 1.0, point);
+        assert(atomic_load(&counter.allocations) == 5);
+        geometry_rotation_destroy_with(&allocator, rotation);
+        geometry_transform_destroy_with(&allocator, transform);
+        geometry_triangle_destroy_with(&allocator, triangle);
+        geometry_segment_destroy_with(&allocator, segment);
+        geometry_point_destroy_with(&allocator, point);
+        geometry_point_destroy(other);
+        assert(atomic_load(&counter.frees) == 5);
+
+        // objects holding memory keep their allocator, also for later growth
+        geometry_arena* arena = geometry_arena_new_with(&allocator, 1);
+        for(int i = 0; i < 10; i++){
+            assert(geometry_point_new_in(arena, i, i) != NULL);
+        }
+        assert(atomic_load(&counter.allocations) > 15);
+        geometry_arena_destroy(arena);
+        geometry_pool* pool = geometry_pool_new_with(&allocator, 2);
+        geometry_triangle* triangles[20];
+        for(int i = 0; i < 20; i++){
+            geometry_point* vertices[3] = {geometry_point_new(i * 0.1, 0.0), geometry_point_new(i * 0.1 + 5.0, 0.0), geometry_point_new(i * 0.1, 5.0)};
+            triangles[i] = geometry_triangle_new(vertices[0], vertices[1], vertices[2], true);
+            for(int j = 0; j < 3; j++){
+                geometry_point_destroy(vertices[j]);
+            }
+        }
+        size_t allocations = atomic_load(&counter.allocations);
+        assert(geometry_triangle_calculateIntersectingPairs(pool, triangles, 20, NULL, 0) == 20 * 19 / 2);
+        assert(atomic_load(&counter.allocations) > allocations);
+        for(int i = 0; i < 20; i++){
+            geometry_triangle_destroy(triangles[i]);
+        }
+        geometry_pool_destroy(pool);
+        assert(atomic_load(&counter.allocations) == atomic_load(&counter.frees));
+    }
+}
+
+static void geometry_test_stats_counters(){
+    {
+        assert(strcmp(geometry_stats_getFunctionName(GEOMETRY_STATS_POINT_NEW), "geometry_point_new") == 0);
+        assert(strcmp(geometry_stats_getFunctionName(GEOMETRY_STATS_TRIANGLE_CALCULATE_INTERSECTING_PAIRS), "geometry_triangle_calculateIntersectingPairs") == 0);
+        assert(strcmp(geometry_stats_getEventName(GEOMETRY_STATS_PREDICATE_FALLBACK), "predicate_fallback") == 0);
+        assert(geometry_stats_getFunctionName(GEOMETRY_STATS_FUNCTION_COUNT) == NULL);
+        assert(geometry_stats_getEventName(GEOMETRY_STATS_EVENT_COUNT) == NULL);
+        assert(!geometry_stats_snapshot(NULL));
+    }
+
+    if(!geometry_stats_isEnabled()){
+        geometry_stats stats;
+        geometry_point* point = geometry_point_new(1.0, 1.0);
+        geometry_point_destroy(point);
+        assert(!geometry_stats_snapshot(&stats));
+        assert(stats.functions[GEOMETRY_STATS_POINT_NEW].count == 0);
+        assert(stats.allocations == 0);
+        return;
+    }
+
+    {
+        geometry_stats stats;
+        geometry_stats_reset();
+        geometry_point* first = geometry_point_new(0.0, 0.0);
+        geometry_point* second = geometry_point_new(3.0, 4.0);
+        geometry_point* third = geometry_point_new(3.0, 0.0);
+        assert(geometry_point_calculateDistance(first, second) == 5.0);
+        geometry_triangle* triangle = geometry_triangle_new(first, second, third, true);
+        assert(geometry_triangle_calculateArea(triangle) == 6.0);
+        assert(geometry_triangle_calculatePerimeter(triangle) == 12.0);
+        geometry_triangle_destroy(triangle);
+        geometry_point_destroy(first);
+        geometry_point_destroy(second);
+        geometry_point_destroy(third);
+        assert(geometry_stats_snapshot(&stats));
+        assert(stats.functions[GEOMETRY_STATS_POINT_NEW].count == 3);
+        assert(stats.functions[GEOMETRY_STATS_POINT_DESTROY].count == 3);
+        assert(stats.functions[GEOMETRY_STATS_POINT_CALCULATE_DISTANCE].count == 1);
+        assert(stats.functions[GEOMETRY_STATS_TRIANGLE_CALCULATE_AREA].count == 1);
+        assert(stats.functions[GEOMETRY_STATS_SEGMENT_NEW].count == 0);
+        // shape of triangle is calculated once and then read from cache
+        assert(stats.events[GEOMETRY_STATS_TRIANGLE_SHAPE_UPDATE] == 1);
+        assert(stats.allocations == 4);
+        assert(stats.frees == 4);
+        assert(stats.allocated_bytes >= 3 * 2 * sizeof(double));
+        geometry_stats_reset();
+        assert(geometry_stats_snapshot(&stats));
+        assert(stats.functions[GEOMETRY_STATS_POINT_NEW].count == 0);
+        assert(stats.allocations == 0);
+    }
+}
+
+static void geometry_test_triangle_buffer_writeFile(const char* path, uint32_t coordinate_size, const double coordinates[6], unsigned char flags){
+    // header as in geometry_binary.h, all numbers little-endian
+    unsigned char header[64] = "GEOMTRI";
+    header[8] = 1;
+    header[12] = 64;
+    header[16] = 1;
+    header[24] = (unsigned char)coordinate_size;
+    FILE* file = fopen(path, "wb");
+    assert(file != NULL);
+    fwrite(header, 1, sizeof(header), file);
+    for(int i = 0; i < 6; i++){
+        unsigned char bytes[8];
+        uint64_t bits = 0;
+        if(coordinate_size == sizeof(float)){
+            float value = (float)coordinates[i];
+            uint32_t float_bits;
+            memcpy(&float_bits, &value, sizeof(float_bits));
+            bits = float_bits;
+        }
+        else{
+            memcpy(&bits, &coordinates[i], sizeof(bits));
+        }
+        for(int j = 0; j < 8; j++){
+            bytes[j] = (unsigned char)(bits >> (8 * j));
+        }
+        fwrite(bytes, 1, coordinate_size == sizeof(float) ? sizeof(float) : sizeof(double), file);
+    }
+    fputc(flags, file);
+    fclose(file);
+}
+static void geometry_test_triangle_buffer_file(){
+    const char* path = "test_triangles.bin";
+    geometry_point* a = geometry_point_new(0, 0);
+    geometry_point* b = geometry_point_new(3, 0);
+    geometry_point* c = geometry_point_new(0, 4);
+    geometry_point* d = geometry_point_new(-1.5, 2.25);
+    geometry_triangle* triangles[2];
+    triangles[0] = geometry_triangle_new(a, b, c, true);
+    triangles[1] = geometry_triangle_new(b, d, c, false);
+
+    geometry_triangle_buffer* buffer = geometry_triangle_buffer_new(triangles, 2);
+    assert(buffer != NULL);
+    assert(geometry_triangle_buffer_save(buffer, path));
+    geometry_triangle_buffer_destroy(buffer);
+
+    buffer = geometry_triangle_buffer_load(path);
+    assert(buffer != NULL);
+    assert(geometry_triangle_buffer_getSize(buffer) == 2);
+    const geometry_real* xs;
+    const geometry_real* ys;
+    assert(geometry_triangle_buffer_getCoordinates(buffer, 1, &xs, &ys));
+    assert(xs[0] == 3 && ys[0] == 0 && xs[1] == -1.5 && ys[1] == 2.25);
+    assert(!geometry_triangle_buffer_getCoordinates(buffer, 3, &xs, &ys));
+    assert(geometry_triangle_buffer_getIsRight(buffer, 0));
+    assert(!geometry_triangle_buffer_getIsRight(buffer, 1));
+    assert(!geometry_triangle_buffer_getIsRight(buffer, 2));
+    assert(geometry_triangle_buffer_getFlags(buffer)[0] == GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT);
+
+    geometry_real areas[2];
+    geometry_real perimeters[2];
+    assert(geometry_triangle_buffer_calculateAreas(buffer, areas));
+    assert(geometry_triangle_buffer_calculatePerimeters(buffer, perimeters));
+    for(size_t i = 0; i < 2; i++){
+        assert(areas[i] == geometry_triangle_calculateArea(triangles[i]));
+        assert(fabs(perimeters[i] - geometry_triangle_calculatePerimeter(triangles[i])) < 1e-9);
+    }
+
+    geometry_arena* arena = geometry_arena_new(0);
+    geometry_triangle* copy = geometry_triangle_buffer_getTriangle(buffer, 0, arena);
+    assert(copy != NULL && geometry_triangle_getIsRight(copy));
+    assert(geometry_triangle_calculateHypotenuse(copy) == 5);
+    geometry_arena_destroy(arena);
+    copy = geometry_triangle_buffer_getTriangle(buffer, 1, NULL);
+    assert(copy != NULL && !geometry_triangle_getIsRight(copy));
+    assert(geometry_triangle_calculateArea(copy) == areas[1]);
+    geometry_triangle_destroy(copy);
+    assert(geometry_triangle_buffer_getTriangle(buffer, 2, NULL) == NULL);
+    geometry_triangle_buffer_destroy(buffer);
+
+    // without arena triangle is taken from allocator of buffer, nothing else is allocated
+    geometry_test_allocatorCounter counter;
+    atomic_init(&counter.allocations, 0);
+    atomic_init(&counter.frees, 0);
+    geometry_allocator allocator = {geometry_test_allocator_allocate, geometry_test_allocator_free, &counter};
+    buffer = geometry_triangle_buffer_new_with(&allocator, triangles, 2);
+    size_t allocations = atomic_load(&counter.allocations);
+    copy = geometry_triangle_buffer_getTriangle(buffer, 1, NULL);
+    assert(copy != NULL && atomic_load(&counter.allocations) == allocations + 1 && atomic_load(&counter.frees) == 0);
+    assert(geometry_triangle_calculateArea(copy) == areas[1]);
+    geometry_triangle_destroy_with(&allocator, copy);
+    geometry_triangle_buffer_destroy(buffer);
+    assert(atomic_load(&counter.allocations) == atomic_load(&counter.frees));
+
+    // files with coordinates of both precisions are loaded, the one not matching
+    // geometry_real is converted, zero coordinate size (older files) means doubles
+    {
+        const double coordinates[6] = {0, 0, 3, 0, 0, 4};
+        uint32_t sizes[3] = {sizeof(double), sizeof(float), 0};
+        for(int i = 0; i < 3; i++){
+            geometry_test_triangle_buffer_writeFile(path, sizes[i], coordinates, GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT);
+            buffer = geometry_triangle_buffer_load(path);
+            assert(buffer != NULL && geometry_triangle_buffer_getSize(buffer) == 1);
+            assert(geometry_triangle_buffer_getCoordinates(buffer, 1, &xs, &ys) && xs[0] == 3 && ys[0] == 0);
+            assert(geometry_triangle_buffer_getCoordinates(buffer, 2, &xs, &ys) && xs[0] == 0 && ys[0] == 4);
+            assert(geometry_triangle_buffer_getIsRight(buffer, 0));
+            geometry_triangle_buffer_destroy(buffer);
+        }
+        geometry_test_triangle_buffer_writeFile(path, 2, coordinates, 0);
+        assert(geometry_triangle_buffer_load(path) == NULL);
+    }
+
+    // file with wrong magic and truncated file are rejected
+    FILE* file = fopen(path, "r+b");
+    assert(file != NULL);
+    fputc('X', file);
+    fclose(file);
+    assert(geometry_triangle_buffer_load(path) == NULL);
+    file = fopen(path, "wb");
+    assert(file != NULL);
+    fwrite("GEOMTRI", 1, 8, file);
+    fclose(file);
+    assert(geometry_triangle_buffer_load(path) == NULL);
+    remove(path);
+    assert(geometry_triangle_buffer_load(path) == NULL);
+
+    // empty buffer round trip
+    buffer = geometry_triangle_buffer_new(NULL, 0);
+    assert(buffer != NULL);
+    assert(geometry_triangle_buffer_save(buffer, path));
+    geometry_triangle_buffer_destroy(buffer);
+    buffer = geometry_triangle_buffer_load(path);
+    assert(buffer != NULL && geometry_triangle_buffer_getSize(buffer) == 0);
+    geometry_triangle_buffer_destroy(buffer);
+    remove(path);
+
+    geometry_triangle_destroy(triangles[0]);
+    geometry_triangle_destroy(triangles[1]);
+    geometry_point_destroy(a);
+    geometry_point_destroy(b);
+    geometry_point_destroy(c);
+    geometry_point_destroy(d);
+}
+
+static void geometry_test_text_numbers(){
+    char* end;
+    const char* texts[] = {"0", "-0.5", "+12.25e2", "3.14159", "1e-300", "123456789012345678901234", "0.1", "2.5E-3", "17."};
+    for(size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++){
+        assert(geometry_text_parseDouble(texts[i], &end) == strtod(texts[i], NULL));
+        assert(*end == '\0');
+    }
+    assert(geometry_text_parseDouble("1.5e", &end) == 1.5 && *end == 'e');
+    assert(geometry_text_parseDouble("x", &end) == 0 && *end == 'x');
+
+    char text[32];
+    assert(geometry_text_formatDouble(-2.5, text) == 4 && strcmp(text, "-2.5") == 0);
+    assert(geometry_text_formatDouble(0.001, text) == 5 && strcmp(text, "0.001") == 0);
+    assert(geometry_text_formatDouble(42, text) == 2 && strcmp(text, "42") == 0);
+    srand(7);
+    for(int i = 0; i < 10000; i++){
+        double value = (rand() - RAND_MAX / 2) / (double)(rand() + 1) * pow(10, rand() % 40 - 20);
+        if(i % 2 == 0){
+            value = round(value * 1000) / 1000;
+        }
+        geometry_text_formatDouble(value, text);
+        assert(geometry_text_parseDouble(text, &end) == value);
+        assert(*end == '\0');
+    }
+
+    // non-finite numbers are written and read back
+    assert(geometry_text_parseDouble("inf", &end) == INFINITY && *end == '\0');
+    assert(geometry_text_parseDouble("-Infinity,", &end) == -INFINITY && *end == ',');
+    assert(isnan(geometry_text_parseDouble("NaN", &end)) && *end == '\0');
+    assert(geometry_text_parseDouble("in", &end) == 0 && *end == 'i');
+    double non_finite[] = {INFINITY, -INFINITY, NAN};
+    for(int i = 0; i < 3; i++){
+        geometry_text_formatDouble(non_finite[i], text);
+        double value = geometry_text_parseDouble(text, &end);
+        assert(*end == '\0' && (isnan(non_finite[i]) ? isnan(value) : value == non_finite[i]));
+    }
+
+    // decimal point is '.' also when locale uses comma, if any such locale is installed
+    const char* long_text = "0.12345678901234567890123";
+    double long_value = geometry_text_parseDouble(long_text, NULL);
+    assert(long_value == strtod(long_text, NULL));
+    const char* locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "pl_PL.UTF-8", "de_DE"};
+    for(size_t i = 0; i < sizeof(locales) / sizeof(locales[0]); i++){
+        if(setlocale(LC_NUMERIC, locales[i]) == NULL || strcmp(localeconv()->decimal_point, ".") == 0){
+            continue;
+        }
+        assert(geometry_text_parseDouble(long_text, &end) == long_value && *end == '\0');
+        assert(geometry_text_parseDouble("0.5", &end) == 0.5);
+        geometry_text_formatDouble(0.1 + 0.2, text);
+        assert(strchr(text, '.') != NULL && strchr(text, ',') == NULL);
+        assert(geometry_text_parseDouble(text, &end) == 0.1 + 0.2 && *end == '\0');
+        setlocale(LC_NUMERIC, "C");
+        break;
+    }
+}
+
+static void geometry_test_text_reader(){
+    FILE* file = tmpfile();
+    assert(file != NULL);
+    fputs("# comment\n"
+          "1,2\n"
+          "\n"
+          "0,0,3,0,0,4,1\r\n"
+          "POINT (-1.5 2)\n"
+          "  linestring(0 0, 1 1)\n"
+          "POLYGON ((0 0, 1 0, 0 1, 0 0))\n"
+          "5,6,7,8", file);
+    rewind(file);
+    geometry_text_reader* reader = geometry_text_reader_new(file, 3);
+    assert(reader != NULL);
+    assert(geometry_text_reader_read(reader) == 3);
+    const geometry_text_kind* kinds = geometry_text_reader_getKinds(reader);
+    assert(kinds[0] == GEOMETRY_TEXT_POINT && kinds[1] == GEOMETRY_TEXT_TRIANGLE && kinds[2] == GEOMETRY_TEXT_POINT);
+    const double* xs;
+    const double* ys;
+    assert(geometry_text_reader_getPoints(reader, &xs, &ys) == 2);
+    assert(xs[0] == 1 && ys[0] == 2 && xs[1] == -1.5 && ys[1] == 2);
+    const double* coordinates[6];
+    const unsigned char* flags;
+    assert(geometry_text_reader_getTriangles(reader, coordinates, &flags) == 1);
+    assert(coordinates[2][0] == 3 && coordinates[5][0] == 4 && flags[0] == GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT);
+
+    assert(geometry_text_reader_read(reader) == 3);
+    assert(geometry_text_reader_getSegments(reader, coordinates) == 2);
+    assert(coordinates[2][0] == 1 && coordinates[0][1] == 5 && coordinates[3][1] == 8);
+    assert(geometry_text_reader_getTriangles(reader, coordinates, &flags) == 1);
+    assert(coordinates[1][0] == 0 && coordinates[4][0] == 0 && flags[0] == 0);
+    assert(geometry_text_reader_getPoints(reader, &xs, &ys) == 0);
+    assert(geometry_text_reader_read(reader) == 0);
+    assert(geometry_text_reader_getLine(reader) == 8);
+    geometry_text_reader_destroy(reader);
+    fclose(file);
+
+    // invalid line ends batch with shapes before it, next read reports it and reading stops
+    file = tmpfile();
+    assert(file != NULL);
+    fputs("1,2\n1,2,3\n4,5\n", file);
+    rewind(file);
+    reader = geometry_text_reader_new(file, 16);
+    assert(geometry_text_reader_read(reader) == 1);
+    assert(geometry_text_reader_getPoints(reader, &xs, &ys) == 1 && xs[0] == 1 && ys[0] == 2);
+    assert(geometry_text_reader_read(reader) == (size_t)-1);
+    assert(geometry_text_reader_getLine(reader) == 2);
+    assert(geometry_text_reader_read(reader) == (size_t)-1);
+    geometry_text_reader_destroy(reader);
+    fclose(file);
+
+    // non-finite numbers in both formats
+    file = tmpfile();
+    assert(file != NULL);
+    fputs("inf,-2\nPOINT (nan -inf)\n", file);
+    rewind(file);
+    reader = geometry_text_reader_new(file, 16);
+    assert(geometry_text_reader_read(reader) == 2);
+    assert(geometry_text_reader_getPoints(reader, &xs, &ys) == 2);
+    assert(xs[0] == INFINITY && ys[0] == -2 && isnan(xs[1]) && ys[1] == -INFINITY);
+    geometry_text_reader_destroy(reader);
+    fclose(file);
+
+    // numbers have to be separated with white space or comma
+    const char* malformed[] = {"1-2\n", "1.5.3\n", "1,2x\n", "POINT (1 2e)\n", "1e5e3,0\n", "0,0,1,0,0,1(1)\n"};
+    for(size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++){
+        file = tmpfile();
+        assert(file != NULL);
+        fputs("1,2\n", file);
+        fputs(malformed[i], file);
+        rewind(file);
+        reader = geometry_text_reader_new(file, 16);
+        assert(geometry_text_reader_read(reader) == 1);
+        assert(geometry_text_reader_read(reader) == (size_t)-1);
+        assert(geometry_text_reader_getLine(reader) == 2);
+        geometry_text_reader_destroy(reader);
+        fclose(file);
+    }
+    assert(geometry_text_reader_new(NULL, 16) == NULL);
+}
+
+static void geometry_test_text_writer(){
+    // many points, so chunks of reader and writer are refilled several times
+    size_t count = 20000;
+    double* xs = malloc(count * sizeof(double));
+    double* ys = malloc(count * sizeof(double));
+    for(size_t i = 0; i < count; i++){
+        xs[i] = i * 0.125 - 7;
+        ys[i] = 1.0 / (i + 3);
+    }
+    double segment[4] = {0, 0, -1, 2.5};
+    double triangle_coordinates[6] = {0, 0, 3, 0, 0, 4};
+    const double* triangles[6];
+    for(int i = 0; i < 6; i++){
+        triangles[i] = &triangle_coordinates[i];
+    }
+    unsigned char flag = GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT;
+    for(int format = GEOMETRY_TEXT_CSV; format <= GEOMETRY_TEXT_WKT; format++){
+        FILE* file = tmpfile();
+        assert(file != NULL);
+        geometry_text_writer* writer = geometry_text_writer_new(file, (geometry_text_format)format);
+        assert(writer != NULL);
+        assert(geometry_text_writer_writeLine(writer, "# points"));
+        assert(geometry_text_writer_writePoints(writer, xs, ys, count));
+        assert(geometry_text_writer_writeSegment(writer, segment));
+        assert(geometry_text_writer_writeTriangles(writer, triangles, &flag, 1));
+        assert(geometry_text_writer_flush(writer));
+        geometry_text_writer_destroy(writer);
+        rewind(file);
+
+        geometry_text_reader* reader = geometry_text_reader_new(file, 4096);
+        size_t points = 0;
+        size_t read;
+        const double* read_xs;
+        const double* read_ys;
+        const double* coordinates[6];
+        const unsigned char* flags;
+        while((read = geometry_text_reader_read(reader)) != 0){
+            assert(read != (size_t)-1);
+            size_t batch = geometry_text_reader_getPoints(reader, &read_xs, &read_ys);
+            for(size_t i = 0; i < batch; i++){
+                assert(read_xs[i] == xs[points + i] && read_ys[i] == ys[points + i]);
+            }
+            points += batch;
+            if(geometry_text_reader_getSegments(reader, coordinates) == 1){
+                assert(coordinates[1][0] == 0 && coordinates[2][0] == -1 && coordinates[3][0] == 2.5);
+            }
+            if(geometry_text_reader_getTriangles(reader, coordinates, &flags) == 1){
+                assert(coordinates[2][0] == 3 && coordinates[5][0] == 4);
+                assert(flags[0] == (format == GEOMETRY_TEXT_CSV ? GEOMETRY_TRIANGLE_BUFFER_FLAG_IS_RIGHT : 0));
+            }
+        }
+        assert(points == count);
+        geometry_text_reader_destroy(reader);
+        fclose(file);
+    }
+    free(xs);
+    free(ys);
+}
+
+static void geometry_test_int_predicates(){
+    // coordinates near limits of 32 bits, products of their differences don't fit in 64 bits
+    geometry_int_point* start = geometry_int_point_new(-2147483647, -2147483647);
+    geometry_int_point* end = geometry_int_point_new(2147483647, 2147483645);
+    geometry_int_segment* segment = geometry_int_segment_new(start, end);
+    geometry_int_point* point = geometry_int_point_new(0, -1);
+    assert(geometry_int_point_liesOnSegment(point, segment));
+    assert(geometry_int_point_moveByVector(point, 0, 1));
+    assert(!geometry_int_point_liesOnSegment(point, segment));
+    assert(!geometry_int_point_moveByVector(end, 1, 0));
+    assert(geometry_int_point_getX(end) == 2147483647 && geometry_int_point_getY(end) == 2147483645);
+    assert(!geometry_int_segment_moveByVector(segment, 0, -2));
+    geometry_int_point* segment_start;
+    geometry_int_point* segment_end;
+    geometry_int_segment_getPoints(segment, &segment_start, &segment_end);
+    assert(geometry_int_point_getY(segment_start) == -2147483647);
+
+    geometry_int_point_destroy(start);
+    geometry_int_point_destroy(end);
+    start = geometry_int_point_new(0, 0);
+    end = geometry_int_point_new(2147483646, 2147483645);
+    geometry_int_segment* first = geometry_int_segment_new(start, end);
+    assert(geometry_int_point_moveByVector(start, 0, 1));
+    assert(geometry_int_point_moveByVector(end, 0, 1));
+    geometry_int_segment* second = geometry_int_segment_new(start, end);
+    assert(geometry_int_segment_areParallel(first, second));
+    assert(!geometry_int_segment_areIntersecting(first, second));
+    assert(geometry_int_point_moveByVector(end, 1, 0));
+    geometry_int_segment* third = geometry_int_segment_new(start, end);
+    assert(!geometry_int_segment_areParallel(first, third));
+    assert(!geometry_int_segment_arePerpendicular(first, third));
+    geometry_int_segment_destroy(first);
+    geometry_int_segment_destroy(second);
+    geometry_int_segment_destroy(third);
+
+    // intersections
+    geometry_int_point* a = geometry_int_point_new(0, 0);
+    geometry_int_point* b = geometry_int_point_new(4, 4);
+    geometry_int_point* c = geometry_int_point_new(0, 4);
+    geometry_int_point* d = geometry_int_point_new(4, 0);
+    first = geometry_int_segment_new(a, b);
+    second = geometry_int_segment_new(c, d);
+    third = geometry_int_segment_new(a, c);
+    assert(geometry_int_segment_areIntersecting(first, second));
+    geometry_point* intersection = geometry_int_segment_calculateIntersection(first, second);
+    assert(intersection != NULL && geometry_point_getX(intersection) == 2 && geometry_point_getY(intersection) == 2);
+    geometry_point_destroy(intersection);
+    intersection = geometry_int_segment_calculateIntersection(first, third);
+    assert(intersection != NULL && geometry_point_getX(intersection) == 0 && geometry_point_getY(intersection) == 0);
+    geometry_point_destroy(intersection);
+    // inexact intersection is rounded once, as division of exactly representable coordinates
+    geometry_int_point* steep_start = geometry_int_point_new(0, 0);
+    geometry_int_point* steep_end = geometry_int_point_new(1000000000, 2000000000);
+    geometry_int_point* falling_start = geometry_int_point_new(0, 2000000000);
+    geometry_int_point* falling_end = geometry_int_point_new(2000000000, 0);
+    geometry_int_segment* steep = geometry_int_segment_new(steep_start, steep_end);
+    geometry_int_segment* falling = geometry_int_segment_new(falling_start, falling_end);
+    intersection = geometry_int_segment_calculateIntersection(steep, falling);
+    assert(intersection != NULL);
+    assert(geometry_point_getX(intersection) == (geometry_real)2000000000 / 3);
+    assert(geometry_point_getY(intersection) == (geometry_real)4000000000 / 3);
+    geometry_point_destroy(intersection);
+    intersection = geometry_int_segment_calculateIntersection(falling, steep);
+    assert(intersection != NULL && geometry_point_getX(intersection) == (geometry_real)2000000000 / 3);
+    geometry_point_destroy(intersection);
+    geometry_int_segment_destroy(steep);
+    geometry_int_segment_destroy(falling);
+    geometry_int_point_destroy(steep_start);
+    geometry_int_point_destroy(steep_end);
+    geometry_int_point_destroy(falling_start);
+    geometry_int_point_destroy(falling_end);
+    assert(geometry_int_segment_arePerpendicular(first, second));
+    assert(geometry_int_segment_calculateLength(third) == 4);
+    // overlapping colinear segments intersect, but have no single intersection point
+    geometry_int_segment_destroy(second);
+    second = geometry_int_segment_new(a, b);
+    assert(geometry_int_segment_moveByVector(second, 2, 2));
+    assert(geometry_int_segment_areIntersecting(first, second));
+    assert(geometry_int_segment_calculateIntersection(first, second) == NULL);
+    assert(geometry_int_segment_moveByVector(second, 3, 3));
+    assert(!geometry_int_segment_areIntersecting(first, second));
+    geometry_int_segment_destroy(first);
+    geometry_int_segment_destroy(second);
+    geometry_int_segment_destroy(third);
+
+    // triangles
+    geometry_int_point_destroy(a);
+    geometry_int_point_destroy(b);
+    geometry_int_point_destroy(c);
+    a = geometry_int_point_new(-2000000000, -2000000000);
+    b = geometry_int_point_new(2000000000, -2000000000);
+    c = geometry_int_point_new(-2000000000, 2000000000);
+    geometry_int_triangle* big = geometry_int_triangle_new(a, b, c);
+    assert(geometry_int_triangle_isRight(big));
+    assert(geometry_test_near(geometry_int_triangle_calculateArea(big), 8e18, 0));
+    assert(geometry_test_near(geometry_int_triangle_calculateHypotenuse(big), sqrt(32e18), 1));
+    assert(geometry_test_near(geometry_int_triangle_calculatePerimeter(big), 8e9 + sqrt(32e18), 1));
+    geometry_int_point_destroy(a);
+    geometry_int_point_destroy(b);
+    geometry_int_point_destroy(c);
+    geometry_int_point_destroy(d);
+    a = geometry_int_point_new(-10, -10);
+    b = geometry_int_point_new(-7, -9);
+    c = geometry_int_point_new(-9, -7);
+    geometry_int_triangle* small = geometry_int_triangle_new(a, b, c);
+    assert(!geometry_int_triangle_isRight(small));
+    assert(geometry_int_triangle_calculateHypotenuse(small) == -1);
+    // small lies inside big, borders don't meet
+    assert(!geometry_int_triangle_areDisjoint(big, small));
+    // touching vertices
+    assert(geometry_int_triangle_moveByVector(small, 2000000010, -1999999990));
+    assert(!geometry_int_triangle_areDisjoint(small, big));
+    assert(geometry_int_triangle_moveByVector(small, 1, 0));
+    assert(geometry_int_triangle_areDisjoint(small, big));
+    assert(!geometry_int_triangle_moveByVector(small, 2147483647, 0));
+
+    geometry_arena* arena = geometry_arena_new(0);
+    geometry_int_triangle* copy = geometry_int_triangle_new_in(arena, a, b, c);
+    geometry_int_point* first_vertex;
+    geometry_int_point* second_vertex;
+    geometry_int_point* third_vertex;
+    geometry_int_triangle_getPoints(copy, &first_vertex, &second_vertex, &third_vertex);
+    assert(geometry_int_point_getX(second_vertex) == -7 && geometry_int_point_getY(third_vertex) == -7);
+    assert(geometry_int_triangle_calculateArea(copy) == 4);
+    geometry_arena_destroy(arena);
+
+    geometry_int_triangle_destroy(big);
+    geometry_int_triangle_destroy(small);
+    geometry_int_point_destroy(a);
+    geometry_int_point_destroy(b);
+    geometry_int_point_destroy(c);
+    geometry_int_point_destroy(start);
+    geometry_int_point_destroy(end);
+    geometry_int_point_destroy(point);
+    geometry_int_segment_destroy(segment);
+}
+
+static void geometry_test_mesh_sharedVertices(){
+    // grid of unit squares, each split into two right triangles
+    size_t side = 20;
+    geometry_mesh* mesh = geometry_mesh_new(0);
+    assert(mesh != NULL);
+    for(size_t i = 0; i < side; i++){
+        for(size_t j = 0; j < side; j++){
+            geometry_point* a = geometry_point_new(i, j);
+            geometry_point* b = geometry_point_new(i + 1, j);
+            geometry_point* c = geometry_point_new(i, j + 1);
+            geometry_point* d = geometry_point_new(i + 1, j + 1);
+            geometry_triangle* lower = geometry_triangle_new(a, b, c, true);
+            geometry_triangle* upper = geometry_triangle_new(d, c, b, true);
+            assert(geometry_mesh_addTriangle(mesh, lower));
+            assert(geometry_mesh_addTriangle(mesh, upper));
+            geometry_triangle_destroy(lower);
+            geometry_triangle_destroy(upper);
+            geometry_point_destroy(a);
+            geometry_point_destroy(b);
+            geometry_point_destroy(c);
+            geometry_point_destroy(d);
+        }
+    }
+    size_t triangles = 2 * side * side;
+    assert(geometry_mesh_getTriangleCount(mesh) == triangles);
+    assert(geometry_mesh_getVertexCount(mesh) == (side + 1) * (side + 1));
+    assert(geometry_mesh_addVertex(mesh, -0.0, 0) == geometry_mesh_addVertex(mesh, 0, 0));
+    assert(!geometry_mesh_addTriangleByIndices(mesh, 0, 1, (side + 1) * (side + 1), false));
+
+    geometry_real* areas = malloc(triangles * sizeof(*areas));
+    geometry_real* perimeters = malloc(triangles * sizeof(*perimeters));
+    assert(geometry_mesh_calculateAreas(mesh, areas));
+    assert(geometry_mesh_calculatePerimeters(mesh, perimeters));
+    for(size_t i = 0; i < triangles; i++){
+        assert(areas[i] == 0.5);
+        assert(geometry_test_near(perimeters[i], 2 + sqrt(2), 1e-12));
+    }
+    assert(geometry_mesh_calculateArea(mesh) == side * side);
+
+    // every vertex is moved once, shared vertices stay shared
+    geometry_mesh_moveByVector(mesh, 10, -5);
+    const geometry_real* xs;
+    const geometry_real* ys;
+    size_t vertices = geometry_mesh_getVertices(mesh, &xs, &ys);
+    const uint32_t* indices = geometry_mesh_getIndices(mesh);
+    assert(xs[indices[0]] == 10 && ys[indices[0]] == -5);
+    // vertices are looked up by moved coordinates
+    assert(geometry_mesh_addVertex(mesh, 10, -5) == indices[0]);
+    assert(geometry_mesh_addVertex(mesh, 0, 0) == vertices);
+
+    geometry_point* center = geometry_point_new(10, -5);
+    geometry_mesh_rotateByAngle(mesh, M_PI / 2, center);
+    assert(fabs(geometry_mesh_calculateArea(mesh) - side * side) < 1e-9);
+    geometry_mesh_getVertices(mesh, &xs, &ys);
+    assert(fabs(xs[indices[1]] - 10) < 1e-12 && fabs(ys[indices[1]] + 4) < 1e-12);
+    geometry_transform* transform = geometry_transform_new();
+    geometry_transform_moveByVector(transform, 1, 1);
+    geometry_mesh_applyTransform(mesh, transform);
+    geometry_mesh_getVertices(mesh, &xs, &ys);
+    assert(xs[indices[0]] == 11 && ys[indices[0]] == -4);
+    geometry_transform_destroy(transform);
+
+    geometry_arena* arena = geometry_arena_new(0);
+    geometry_triangle* triangle = geometry_mesh_getTriangle(mesh, 0, arena);
+    assert(triangle != NULL && geometry_triangle_getIsRight(triangle));
+    assert(fabs(geometry_triangle_calculateArea(triangle) - 0.5) < 1e-12);
+    assert(geometry_mesh_getTriangle(mesh, triangles, arena) == NULL);
+    geometry_arena_destroy(arena);
+    triangle = geometry_mesh_getTriangle(mesh, 0, NULL);
+    assert(triangle != NULL && geometry_triangle_getIsRight(triangle));
+    assert(fabs(geometry_triangle_calculateArea(triangle) - 0.5) < 1e-12);
+    // triangle object and mesh calculate area with the same equation
+    assert(geometry_mesh_calculateAreas(mesh, areas));
+    assert(geometry_triangle_calculateArea(triangle) == areas[0]);
+    geometry_triangle_destroy(triangle);
+
+    // without arena triangle is taken from allocator of mesh, nothing else is allocated
+    geometry_test_allocatorCounter counter;
+    atomic_init(&counter.allocations, 0);
+    atomic_init(&counter.frees, 0);
+    geometry_allocator allocator = {geometry_test_allocator_allocate, geometry_test_allocator_free, &counter};
+    geometry_mesh* other = geometry_mesh_new_with(&allocator, 1);
+    assert(geometry_mesh_addVertex(other, 0, 0) == 0);
+    assert(geometry_mesh_addVertex(other, 2, 0) == 1);
+    assert(geometry_mesh_addVertex(other, 0, 2) == 2);
+    assert(geometry_mesh_addTriangleByIndices(other, 0, 1, 2, true));
+    size_t allocations = atomic_load(&counter.allocations);
+    size_t frees = atomic_load(&counter.frees);
+    triangle = geometry_mesh_getTriangle(other, 0, NULL);
+    assert(triangle != NULL && atomic_load(&counter.allocations) == allocations + 1 && atomic_load(&counter.frees) == frees);
+    assert(geometry_triangle_calculateArea(triangle) == 2);
+    geometry_triangle_destroy_with(&allocator, triangle);
+    geometry_mesh_destroy(other);
+    assert(atomic_load(&counter.allocations) == atomic_load(&counter.frees));
+
+    geometry_point_destroy(center);
+    free(areas);
+    free(perimeters);
+    geometry_mesh_destroy(mesh);
+}
 
 int main(){
     geometry_test_point_creationAndDestruction();
@@ -570,13 +2942,47 @@ int main(){
     geometry_test_triangle_creationAndDestruction();
     geometry_test_triangle_gettersPoints();
     geometry_test_triangle_gettersIsRight();
+    geometry_test_triangle_pointsOwnership();
 
     geometry_test_point_move();
+    geometry_test_point_rotate();
     geometry_test_segment_move();
     geometry_test_triangle_move();
+    geometry_test_triangle_rotate();
+    geometry_test_transform_chain();
+    geometry_test_transform_composeAndInvert();
 
     geometry_test_point_distance();
     geometry_test_segment_length();
     geometry_test_triangle_primeter();
+    geometry_test_triangle_area();
+    geometry_test_triangle_hypotenuse();
+    geometry_test_triangle_cache();
+    geometry_test_predicates_nearColinear();
+    geometry_test_segment_intersection();
+    geometry_test_segment_batchIntersection();
+    geometry_test_triangle_disjoint();
+    geometry_test_grid_pairs();
+    geometry_test_bvh_queries();
+    geometry_test_rtree_points();
+    geometry_test_kdtree_queries();
+    geometry_test_pool_batch();
+    geometry_test_pool_collisions();
+
+    geometry_test_arena_allocation();
+    geometry_test_arena_reset();
+    geometry_test_arena_shapes();
+    geometry_test_allocator_hooks();
+    geometry_test_stats_counters();
+    geometry_test_triangle_buffer_file();
+    geometry_test_text_numbers();
+    geometry_test_text_reader();
+    geometry_test_text_writer();
+    geometry_test_int_predicates();
+    geometry_test_mesh_sharedVertices();
+
+    geometry_test_pointBuffer_creationAndAccess();
+    geometry_test_pointBuffer_distanceMatrix();
+    geometry_test_pointBuffer_kernels();
     return 0;
 }